@@ -274,6 +274,8 @@ public:
 
     /**
      * Returns a map with variable information
+     * @param keys subset of info keys to compute (Type, AvailableStepsCount,
+     * Shape, SingleValue, Value, Min, Max), empty (default): all keys
      * @return map:
      * <pre>
      * key: variable name
@@ -282,7 +284,9 @@ public:
      *      string value: variable info value
      * </pre>
      */
-    std::map<std::string, Params> AvailableVariables();
+    std::map<std::string, Params>
+    AvailableVariables(const std::vector<std::string> &keys =
+                           std::vector<std::string>());
 
     /**
      * Returns a map with available attributes information associated to a
@@ -40,6 +40,7 @@ StepStatus Engine::BeginStep(const StepMode mode, const float timeoutSeconds)
     {
         return StepStatus::EndOfStream;
     }
+    pybind11::gil_scoped_release release;
     return m_Engine->BeginStep(mode, timeoutSeconds);
 }
 
@@ -50,6 +51,7 @@ StepStatus Engine::BeginStep()
     {
         return StepStatus::EndOfStream;
     }
+    pybind11::gil_scoped_release release;
     return m_Engine->BeginStep();
 }
 
@@ -74,9 +76,11 @@ void Engine::Put(Variable variable, const pybind11::array &array,
 #define declare_type(T)                                                        \
     else if (type == helper::GetType<T>())                                     \
     {                                                                          \
+        const T *data = reinterpret_cast<const T *>(array.data());             \
+        pybind11::gil_scoped_release release;                                  \
         m_Engine->Put(                                                         \
-            *dynamic_cast<core::Variable<T> *>(variable.m_VariableBase),       \
-            reinterpret_cast<const T *>(array.data()), launch);                \
+            *dynamic_cast<core::Variable<T> *>(variable.m_VariableBase), data, \
+            launch);                                                           \
     }
     ADIOS2_FOREACH_NUMPY_TYPE_1ARG(declare_type)
 #undef declare_type
@@ -120,6 +124,7 @@ void Engine::PerformPuts()
     {
         return;
     }
+    pybind11::gil_scoped_release release;
     m_Engine->PerformPuts();
 }
 
@@ -145,9 +150,11 @@ void Engine::Get(Variable variable, pybind11::array &array, const Mode launch)
 #define declare_type(T)                                                        \
     else if (type == helper::GetType<T>())                                     \
     {                                                                          \
+        T *data = reinterpret_cast<T *>(const_cast<void *>(array.data()));     \
+        pybind11::gil_scoped_release release;                                  \
         m_Engine->Get(                                                         \
-            *dynamic_cast<core::Variable<T> *>(variable.m_VariableBase),       \
-            reinterpret_cast<T *>(const_cast<void *>(array.data())), launch);  \
+            *dynamic_cast<core::Variable<T> *>(variable.m_VariableBase), data, \
+            launch);                                                           \
     }
     ADIOS2_FOREACH_NUMPY_TYPE_1ARG(declare_type)
 #undef declare_type
@@ -197,6 +204,7 @@ void Engine::PerformGets()
     {
         return;
     }
+    pybind11::gil_scoped_release release;
     m_Engine->PerformGets();
 }
 
@@ -207,6 +215,7 @@ void Engine::EndStep()
     {
         return;
     }
+    pybind11::gil_scoped_release release;
     m_Engine->EndStep();
 }
 
@@ -217,6 +226,7 @@ void Engine::Flush(const int transportIndex)
     {
         return;
     }
+    pybind11::gil_scoped_release release;
     m_Engine->Flush(transportIndex);
 }
 
@@ -227,6 +237,7 @@ void Engine::Close(const int transportIndex)
     {
         return;
     }
+    pybind11::gil_scoped_release release;
     m_Engine->Close(transportIndex);
 }
 
@@ -11,6 +11,7 @@
 #include "py11File.h"
 
 #include <algorithm>
+#include <functional> //std::function
 #include <iostream>
 
 #include "adios2/ADIOSMPI.h"
@@ -67,9 +68,10 @@ size_t File::AddTransport(const std::string type, const Params &parameters)
     return m_Stream->m_IO->AddTransport(type, parameters);
 }
 
-std::map<std::string, adios2::Params> File::AvailableVariables() noexcept
+std::map<std::string, adios2::Params>
+File::AvailableVariables(const std::vector<std::string> &keys) noexcept
 {
-    return m_Stream->m_IO->GetAvailableVariables();
+    return m_Stream->m_IO->GetAvailableVariables(keys);
 }
 
 std::map<std::string, adios2::Params> File::AvailableAttributes() noexcept
@@ -133,6 +135,7 @@ void File::Write(const std::string &name, const pybind11::array &array,
     else if (pybind11::isinstance<                                             \
                  pybind11::array_t<T, pybind11::array::c_style>>(array))       \
     {                                                                          \
+        pybind11::gil_scoped_release release;                                  \
         m_Stream->Write(name, reinterpret_cast<const T *>(array.data()),       \
                         shape, start, count, vParams(), endStep);              \
     }
@@ -158,6 +161,7 @@ void File::Write(const std::string &name, const pybind11::array &array,
     else if (pybind11::isinstance<                                             \
                  pybind11::array_t<T, pybind11::array::c_style>>(array))       \
     {                                                                          \
+        pybind11::gil_scoped_release release;                                  \
         m_Stream->Write(name, reinterpret_cast<const T *>(array.data()),       \
                         shape, start, count, operations, endStep);             \
     }
@@ -181,11 +185,13 @@ void File::Write(const std::string &name, const pybind11::array &array,
 void File::Write(const std::string &name, const std::string &stringValue,
                  const bool endStep)
 {
+    pybind11::gil_scoped_release release;
     m_Stream->Write(name, stringValue, endStep);
 }
 
 bool File::GetStep() const
 {
+    pybind11::gil_scoped_release release;
     return const_cast<File *>(this)->m_Stream->GetStep();
 }
 
@@ -207,7 +213,11 @@ pybind11::array File::Read(const std::string &name)
 
     if (type == helper::GetType<std::string>())
     {
-        const std::string value = m_Stream->Read<std::string>(name).front();
+        std::string value;
+        {
+            pybind11::gil_scoped_release release;
+            value = m_Stream->Read<std::string>(name).front();
+        }
         pybind11::array pyArray(pybind11::dtype::of<char>(),
                                 Dims{value.size()});
         char *pyPtr =
@@ -220,20 +230,10 @@ pybind11::array File::Read(const std::string &name)
     {                                                                          \
         core::Variable<T> &variable =                                          \
             *m_Stream->m_IO->InquireVariable<T>(name);                         \
-        Dims pyCount;                                                          \
-        if (variable.m_SingleValue)                                            \
-        {                                                                      \
-            pyCount = {1};                                                     \
-            pybind11::array pyArray(pybind11::dtype::of<T>(), pyCount);        \
-            m_Stream->Read<T>(name, reinterpret_cast<T *>(                     \
-                                        const_cast<void *>(pyArray.data())));  \
-            return pyArray;                                                    \
-        }                                                                      \
-        else                                                                   \
-        {                                                                      \
-            const Dims zerosStart(variable.m_Shape.size(), 0);                 \
-            return Read(name, zerosStart, variable.m_Shape);                   \
-        }                                                                      \
+        const Dims pyCount = variable.m_SingleValue ? Dims{1}                  \
+                                                    : variable.m_Shape;        \
+        pybind11::array pyArray(pybind11::dtype::of<T>(), pyCount);            \
+        return Read(name, pyArray);                                            \
     }
     ADIOS2_FOREACH_NUMPY_TYPE_1ARG(declare_type)
 #undef declare_type
@@ -258,10 +258,7 @@ pybind11::array File::Read(const std::string &name, const Dims &selectionStart,
     else if (type == helper::GetType<T>())                                     \
     {                                                                          \
         pybind11::array pyArray(pybind11::dtype::of<T>(), selectionCount);     \
-        m_Stream->Read<T>(                                                     \
-            name, reinterpret_cast<T *>(const_cast<void *>(pyArray.data())),   \
-            Box<Dims>(selectionStart, selectionCount));                        \
-        return pyArray;                                                        \
+        return Read(name, selectionStart, selectionCount, pyArray);            \
     }
     ADIOS2_FOREACH_NUMPY_TYPE_1ARG(declare_type)
 #undef declare_type
@@ -293,11 +290,8 @@ pybind11::array File::Read(const std::string &name, const Dims &selectionStart,
     else if (type == helper::GetType<T>())                                     \
     {                                                                          \
         pybind11::array pyArray(pybind11::dtype::of<T>(), shapePy);            \
-        m_Stream->Read<T>(                                                     \
-            name, reinterpret_cast<T *>(const_cast<void *>(pyArray.data())),   \
-            Box<Dims>(selectionStart, selectionCount),                         \
-            Box<size_t>(stepSelectionStart, stepSelectionCount));              \
-        return pyArray;                                                        \
+        return Read(name, selectionStart, selectionCount, stepSelectionStart,  \
+                    stepSelectionCount, pyArray);                              \
     }
     ADIOS2_FOREACH_NUMPY_TYPE_1ARG(declare_type)
 #undef declare_type
@@ -310,6 +304,183 @@ pybind11::array File::Read(const std::string &name, const Dims &selectionStart,
     return pybind11::array();
 }
 
+pybind11::array File::Read(const std::string &name, pybind11::array &out)
+{
+    const std::string type = m_Stream->m_IO->InquireVariableType(name);
+
+    if (type.empty())
+    {
+    }
+#define declare_type(T)                                                        \
+    else if (type == helper::GetType<T>())                                     \
+    {                                                                          \
+        core::Variable<T> &variable =                                          \
+            *m_Stream->m_IO->InquireVariable<T>(name);                         \
+        if (!variable.m_SingleValue)                                           \
+        {                                                                      \
+            const Dims zerosStart(variable.m_Shape.size(), 0);                 \
+            return Read(name, zerosStart, variable.m_Shape, out);              \
+        }                                                                      \
+                                                                               \
+        T *data = OutData<T>(out, 1, name);                                    \
+        {                                                                      \
+            pybind11::gil_scoped_release release;                              \
+            m_Stream->Read<T>(name, data);                                     \
+        }                                                                      \
+        return out;                                                            \
+    }
+    ADIOS2_FOREACH_NUMPY_TYPE_1ARG(declare_type)
+#undef declare_type
+
+    throw std::invalid_argument(
+        "ERROR: adios2 file read variable " + name +
+        ", type can't be mapped to a numpy type, in call to read\n");
+}
+
+pybind11::array File::Read(const std::string &name, const Dims &selectionStart,
+                           const Dims &selectionCount, pybind11::array &out)
+{
+    const std::string type = m_Stream->m_IO->InquireVariableType(name);
+
+    if (type.empty())
+    {
+    }
+#define declare_type(T)                                                        \
+    else if (type == helper::GetType<T>())                                     \
+    {                                                                          \
+        T *data =                                                              \
+            OutData<T>(out, helper::GetTotalSize(selectionCount), name);       \
+        {                                                                      \
+            pybind11::gil_scoped_release release;                              \
+            m_Stream->Read<T>(name, data,                                      \
+                              Box<Dims>(selectionStart, selectionCount));      \
+        }                                                                      \
+        return out;                                                            \
+    }
+    ADIOS2_FOREACH_NUMPY_TYPE_1ARG(declare_type)
+#undef declare_type
+
+    throw std::invalid_argument(
+        "ERROR: adios2 file read variable " + name +
+        ", type can't be mapped to a numpy type, in call to read\n");
+}
+
+pybind11::array File::Read(const std::string &name, const Dims &selectionStart,
+                           const Dims &selectionCount,
+                           const size_t stepSelectionStart,
+                           const size_t stepSelectionCount,
+                           pybind11::array &out)
+{
+    const std::string type = m_Stream->m_IO->InquireVariableType(name);
+
+    if (type.empty())
+    {
+    }
+#define declare_type(T)                                                        \
+    else if (type == helper::GetType<T>())                                     \
+    {                                                                          \
+        T *data = OutData<T>(out,                                              \
+                             stepSelectionCount *                              \
+                                 helper::GetTotalSize(selectionCount),         \
+                             name);                                            \
+        {                                                                      \
+            pybind11::gil_scoped_release release;                              \
+            m_Stream->Read<T>(                                                 \
+                name, data, Box<Dims>(selectionStart, selectionCount),         \
+                Box<size_t>(stepSelectionStart, stepSelectionCount));          \
+        }                                                                      \
+        return out;                                                            \
+    }
+    ADIOS2_FOREACH_NUMPY_TYPE_1ARG(declare_type)
+#undef declare_type
+
+    throw std::invalid_argument(
+        "ERROR: adios2 file read variable " + name +
+        ", type can't be mapped to a numpy type, in call to read\n");
+}
+
+std::vector<pybind11::array>
+File::ReadMany(const std::vector<std::string> &names,
+               const std::vector<pybind11::array> &outs)
+{
+    if (!outs.empty() && outs.size() != names.size())
+    {
+        throw std::invalid_argument(
+            "ERROR: adios2 file read_many got " + std::to_string(outs.size()) +
+            " out arrays for " + std::to_string(names.size()) +
+            " variables, in call to read_many\n");
+    }
+
+    core::Engine *engine = m_Stream->m_Engine;
+    if (engine == nullptr)
+    {
+        throw std::invalid_argument("ERROR: adios2 file " + m_Name +
+                                    " is not open for reading, in call to "
+                                    "read_many\n");
+    }
+
+    std::vector<pybind11::array> arrays;
+    arrays.reserve(names.size());
+    // gets are only issued once all arrays are validated, a pending get
+    // into an array released by an exception would outlive it
+    std::vector<std::function<void()>> gets;
+    gets.reserve(names.size());
+
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        const std::string &name = names[i];
+        const std::string type = m_Stream->m_IO->InquireVariableType(name);
+
+        if (type.empty())
+        {
+            throw std::invalid_argument(
+                "ERROR: adios2 file read_many variable " + name +
+                " not found, in call to read_many\n");
+        }
+#define declare_type(T)                                                        \
+    else if (type == helper::GetType<T>())                                     \
+    {                                                                          \
+        core::Variable<T> &variable =                                          \
+            *m_Stream->m_IO->InquireVariable<T>(name);                         \
+        const Dims pyCount = variable.m_SingleValue ? Dims{1}                  \
+                                                    : variable.m_Shape;        \
+        pybind11::array pyArray =                                              \
+            outs.empty() ? pybind11::array(pybind11::dtype::of<T>(), pyCount)  \
+                         : outs[i];                                            \
+        T *data = OutData<T>(pyArray, helper::GetTotalSize(pyCount), name);    \
+        arrays.push_back(pyArray);                                             \
+                                                                               \
+        gets.push_back([engine, &variable, data]() {                           \
+            if (!variable.m_SingleValue)                                       \
+            {                                                                  \
+                variable.SetSelection(Box<Dims>(                               \
+                    Dims(variable.m_Shape.size(), 0), variable.m_Shape));      \
+            }                                                                  \
+            engine->Get(variable, data, adios2::Mode::Deferred);               \
+        });                                                                    \
+    }
+        ADIOS2_FOREACH_NUMPY_TYPE_1ARG(declare_type)
+#undef declare_type
+        else
+        {
+            throw std::invalid_argument(
+                "ERROR: adios2 file read_many variable " + name +
+                ", type can't be mapped to a numpy type, in call to "
+                "read_many\n");
+        }
+    }
+
+    {
+        pybind11::gil_scoped_release release;
+        for (auto &get : gets)
+        {
+            get();
+        }
+        engine->PerformGets();
+    }
+    return arrays;
+}
+
 pybind11::array File::ReadAttribute(const std::string &name,
                                     const std::string &variableName,
                                     const std::string separator)
@@ -363,10 +534,15 @@ File::ReadAttributeString(const std::string &name,
     return data;
 }
 
-void File::EndStep() { m_Stream->EndStep(); }
+void File::EndStep()
+{
+    pybind11::gil_scoped_release release;
+    m_Stream->EndStep();
+}
 
 void File::Close()
 {
+    pybind11::gil_scoped_release release;
     m_Stream->Close();
     m_Stream.reset();
 }
@@ -402,5 +578,38 @@ adios2::Mode File::ToMode(const std::string mode) const
     return modeCpp;
 }
 
+template <class T>
+T *File::OutData(pybind11::array &out, const size_t elements,
+                 const std::string &name) const
+{
+    if (!pybind11::isinstance<
+            pybind11::array_t<T, pybind11::array::c_style>>(out))
+    {
+        throw std::invalid_argument(
+            "ERROR: adios2 file read variable " + name +
+            ", out numpy array type doesn't match variable type " +
+            helper::GetType<T>() +
+            " or is not c_style memory contiguous, in call to read\n");
+    }
+
+    if (!out.writeable())
+    {
+        throw std::invalid_argument("ERROR: adios2 file read variable " +
+                                    name +
+                                    ", out numpy array is not writeable, in "
+                                    "call to read\n");
+    }
+
+    if (static_cast<size_t>(out.size()) != elements)
+    {
+        throw std::invalid_argument(
+            "ERROR: adios2 file read variable " + name + ", out numpy array " +
+            "has " + std::to_string(out.size()) + " elements, selection has " +
+            std::to_string(elements) + ", in call to read\n");
+    }
+
+    return reinterpret_cast<T *>(out.mutable_data());
+}
+
 } // end namespace py11
 } // end namespace adios2
@@ -49,7 +49,9 @@ public:
     size_t AddTransport(const std::string type,
                         const Params &parameters = Params());
 
-    std::map<std::string, adios2::Params> AvailableVariables() noexcept;
+    std::map<std::string, adios2::Params>
+    AvailableVariables(const std::vector<std::string> &keys =
+                           std::vector<std::string>()) noexcept;
 
     std::map<std::string, adios2::Params> AvailableAttributes() noexcept;
 
@@ -101,6 +103,36 @@ public:
                          const size_t stepSelectionStart,
                          const size_t stepSelectionCount);
 
+    /**
+     * Read versions into a caller-provided array, reused across steps
+     * @param out writable c_style numpy array with the variable type and
+     * as many elements as the selection
+     * @return out
+     */
+    pybind11::array Read(const std::string &name, pybind11::array &out);
+
+    pybind11::array Read(const std::string &name, const Dims &selectionStart,
+                         const Dims &selectionCount, pybind11::array &out);
+
+    pybind11::array Read(const std::string &name, const Dims &selectionStart,
+                         const Dims &selectionCount,
+                         const size_t stepSelectionStart,
+                         const size_t stepSelectionCount,
+                         pybind11::array &out);
+
+    /**
+     * Reads entire variables for current step with deferred gets and a
+     * single PerformGets
+     * @param names variables to be read
+     * @param outs empty: arrays are allocated, otherwise one array per name
+     * with the Read out requirements
+     * @return arrays in names order
+     */
+    std::vector<pybind11::array>
+    ReadMany(const std::vector<std::string> &names,
+             const std::vector<pybind11::array> &outs =
+                 std::vector<pybind11::array>());
+
     pybind11::array ReadAttribute(const std::string &name,
                                   const std::string &variableName = "",
                                   const std::string separator = "/");
@@ -122,6 +154,11 @@ private:
     std::shared_ptr<core::Stream> m_Stream;
 
     adios2::Mode ToMode(const std::string mode) const;
+
+    /** out data pointer, throws if out can't hold elements of type T */
+    template <class T>
+    T *OutData(pybind11::array &out, const size_t elements,
+               const std::string &name) const;
 };
 
 } // end namespace py11
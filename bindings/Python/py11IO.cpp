@@ -262,10 +262,11 @@ void IO::FlushAll()
     m_IO->FlushAll();
 }
 
-std::map<std::string, Params> IO::AvailableVariables()
+std::map<std::string, Params>
+IO::AvailableVariables(const std::vector<std::string> &keys)
 {
     helper::CheckForNullptr(m_IO, "in call to IO::AvailableVariables");
-    return m_IO->GetAvailableVariables();
+    return m_IO->GetAvailableVariables(keys);
 }
 
 std::map<std::string, Params> IO::AvailableAttributes()
@@ -95,7 +95,9 @@ public:
 
     void LockDefinitions();
 
-    std::map<std::string, Params> AvailableVariables();
+    std::map<std::string, Params>
+    AvailableVariables(const std::vector<std::string> &keys =
+                           std::vector<std::string>());
 
     std::map<std::string, Params> AvailableAttributes();
 
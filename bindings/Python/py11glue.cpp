@@ -353,7 +353,8 @@ PYBIND11_MODULE(adios2, m)
                          adios2::py11::MPI4PY_Comm comm)) &
                          adios2::py11::IO::Open)
 #endif
-        .def("AvailableVariables", &adios2::py11::IO::AvailableVariables)
+        .def("AvailableVariables", &adios2::py11::IO::AvailableVariables,
+             pybind11::arg("keys") = std::vector<std::string>())
         .def("AvailableAttributes", &adios2::py11::IO::AvailableAttributes)
         .def("FlushAll", &adios2::py11::IO::FlushAll)
         .def("EngineType", &adios2::py11::IO::EngineType)
@@ -571,9 +572,16 @@ PYBIND11_MODULE(adios2, m)
         )md")
 
         .def("available_variables", &adios2::py11::File::AvailableVariables,
-             pybind11::return_value_policy::move, R"md(
+             pybind11::return_value_policy::move,
+             pybind11::arg("keys") = std::vector<std::string>(), R"md(
              Returns a 2-level dictionary with variable information. 
              Read mode only.
+
+             Parameters
+                 keys
+                     list of information keys to compute, e.g.
+                     ['Type', 'Shape'], skipping Min/Max speeds up browsing
+                     large files, default: all keys
              
              Returns
                  variables dictionary
@@ -923,6 +931,112 @@ PYBIND11_MODULE(adios2, m)
                     resulting array from selection 
         )md")
 
+        .def("read",
+             (pybind11::array(adios2::py11::File::*)(const std::string &,
+                                                     pybind11::array &)) &
+                 adios2::py11::File::Read,
+             pybind11::arg("name"), pybind11::arg("out"), R"md(
+             Reads entire variable for current step into an existing array,
+             reuse it across steps to avoid allocations
+
+             Parameters
+                 name
+                     variable name
+
+                 out
+                     writable, c-contiguous numpy array of the variable
+                     type with as many elements as the variable
+
+             Returns
+                 array: numpy
+                     out
+        )md")
+
+        .def("read",
+             (pybind11::array(adios2::py11::File::*)(
+                 const std::string &, const adios2::Dims &,
+                 const adios2::Dims &, pybind11::array &)) &
+                 adios2::py11::File::Read,
+             pybind11::arg("name"), pybind11::arg("start"),
+             pybind11::arg("count"), pybind11::arg("out"), R"md(
+             Reads a selection piece in dimension for current step into an
+             existing array
+
+             Parameters
+                 name
+                     variable name
+
+                 start
+                     variable local offset selection
+
+                 count
+                     variable local dimension selection from start
+
+                 out
+                     writable, c-contiguous numpy array of the variable
+                     type with as many elements as the selection
+
+             Returns
+                 array: numpy
+                     out
+        )md")
+
+        .def("read",
+             (pybind11::array(adios2::py11::File::*)(
+                 const std::string &, const adios2::Dims &,
+                 const adios2::Dims &, const size_t, const size_t,
+                 pybind11::array &)) &
+                 adios2::py11::File::Read,
+             pybind11::arg("name"), pybind11::arg("start"),
+             pybind11::arg("count"), pybind11::arg("step_start"),
+             pybind11::arg("step_count"), pybind11::arg("out"), R"md(
+             Random access read of a selection of steps into an existing
+             array, only valid with File Engines
+
+             Parameters
+                 name
+                     variable to be read
+
+                 start
+                     variable offset dimensions
+
+                 count
+                     variable local dimensions from offset
+
+                 step_start
+                     variable step start
+
+                 step_count
+                     variable number of steps to read
+
+                 out
+                     writable, c-contiguous numpy array of the variable
+                     type with step_count times the selection elements
+
+             Returns
+                 array: numpy
+                     out
+        )md")
+
+        .def("read_many", &adios2::py11::File::ReadMany,
+             pybind11::arg("names"),
+             pybind11::arg("outs") = std::vector<pybind11::array>(), R"md(
+             Reads entire variables for current step in a single batch,
+             with deferred gets performed at once
+
+             Parameters
+                 names
+                     list of variable names
+
+                 outs
+                     optional list of existing arrays, one per name, with
+                     the same requirements as read out
+
+             Returns
+                 list of numpy arrays
+                     values of the variables in names order
+        )md")
+
         .def("read_attribute",
              (pybind11::array(adios2::py11::File::*)(
                  const std::string &, const std::string &, const std::string)) &
@@ -182,4 +182,45 @@ std::string ToString(SelectionType value)
     }
 }
 
+std::string ToString(DataType value)
+{
+    switch (value)
+    {
+    case DataType::None:
+        return "DataType::None";
+    case DataType::String:
+        return "DataType::String";
+    case DataType::Int8:
+        return "DataType::Int8";
+    case DataType::Int16:
+        return "DataType::Int16";
+    case DataType::Int32:
+        return "DataType::Int32";
+    case DataType::Int64:
+        return "DataType::Int64";
+    case DataType::UInt8:
+        return "DataType::UInt8";
+    case DataType::UInt16:
+        return "DataType::UInt16";
+    case DataType::UInt32:
+        return "DataType::UInt32";
+    case DataType::UInt64:
+        return "DataType::UInt64";
+    case DataType::Float:
+        return "DataType::Float";
+    case DataType::Double:
+        return "DataType::Double";
+    case DataType::LongDouble:
+        return "DataType::LongDouble";
+    case DataType::FloatComplex:
+        return "DataType::FloatComplex";
+    case DataType::DoubleComplex:
+        return "DataType::DoubleComplex";
+    case DataType::Compound:
+        return "DataType::Compound";
+    default:
+        return "ToString: Unknown DataType";
+    }
+}
+
 } // end namespace adios2
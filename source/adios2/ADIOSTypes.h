@@ -120,6 +120,27 @@ enum class SelectionType
     Auto         ///< Let the engine decide what to return
 };
 
+/** Type of a variable or attribute, integer counterpart of the type string */
+enum class DataType
+{
+    None, ///< unknown or undefined type
+    String,
+    Int8,
+    Int16,
+    Int32,
+    Int64,
+    UInt8,
+    UInt16,
+    UInt32,
+    UInt64,
+    Float,
+    Double,
+    LongDouble,
+    FloatComplex,
+    DoubleComplex,
+    Compound ///< struct type, see VariableCompound
+};
+
 // Types
 using std::size_t;
 
@@ -159,6 +180,10 @@ constexpr size_t DefaultInitialBufferSize = 16 * 1024;
  *  Needs to be studied for optimizing applications */
 constexpr uint64_t DefaultMaxBufferSize = MaxSizeT - 1;
 
+/** default size of bp buffer chunks, holding payloads that don't fit in the
+ * buffer instead of growing it, 16Mb, in bytes */
+constexpr size_t DefaultBufferChunkSize = 16 * 1024 * 1024;
+
 /** default buffer growth factor. Needs to be studied
  * for optimizing applications*/
 constexpr float DefaultBufferGrowthFactor = 1.05f;
@@ -193,6 +218,18 @@ using Steps = size_t;
 template <class T>
 using Box = std::pair<T, T>;
 
+namespace core
+{
+/** buffer in a vectored write, same layout as POSIX struct iovec */
+struct iovec
+{
+    /** start of the buffer */
+    const void *iov_base;
+    /** size of the buffer in bytes */
+    size_t iov_len;
+};
+} // end namespace core
+
 /**
  * TypeInfo
  * used to map from primitive types to stdint-based types
@@ -217,6 +254,7 @@ std::string ToString(StepMode value);
 std::string ToString(StepStatus value);
 std::string ToString(TimeUnit value);
 std::string ToString(SelectionType value);
+std::string ToString(DataType value);
 
 /**
  * os << [adios2_type] enables output of adios2 enums/classes directly
@@ -20,6 +20,8 @@
 // OPERATORS
 
 // compress
+#include "adios2/operator/compress/CompressShuffleLZ.h"
+
 #ifdef ADIOS2_HAVE_BZIP2
 #include "adios2/operator/compress/CompressBZip2.h"
 #endif
@@ -192,6 +194,13 @@ Operator &ADIOS::DefineOperator(const std::string name, const std::string type,
             "bzip2 library, in call to DefineOperator\n");
 #endif
     }
+    else if (typeLowerCase == "compress")
+    {
+        auto itPair = m_Operators.emplace(
+            name, std::make_shared<compress::CompressShuffleLZ>(parameters,
+                                                                m_DebugMode));
+        operatorPtr = itPair.first->second;
+    }
     else if (typeLowerCase == "zfp")
     {
 #ifdef ADIOS2_HAVE_ZFP
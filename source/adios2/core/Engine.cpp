@@ -80,6 +80,12 @@ void Engine::Flush(const int /*transportIndex*/) { ThrowUp("Flush"); }
 
 size_t Engine::Steps() const { return DoSteps(); }
 
+void Engine::NotifyRemoveVariable(const VariableBase & /*variable*/) noexcept
+{
+}
+
+void Engine::NotifyRemoveAllVariables() noexcept {}
+
 // PROTECTED
 void Engine::Init() {}
 void Engine::InitParameters() {}
@@ -428,6 +428,16 @@ public:
 
     size_t Steps() const;
 
+    /**
+     * Called by IO::RemoveVariable before variable is destroyed, engines
+     * keeping its handle, e.g. for deferred Put/Get, must drop it
+     * @param variable to be removed
+     */
+    virtual void NotifyRemoveVariable(const VariableBase &variable) noexcept;
+
+    /** Called by IO::RemoveAllVariables, see NotifyRemoveVariable */
+    virtual void NotifyRemoveAllVariables() noexcept;
+
 protected:
     /** from ADIOS class passed to Engine created with Open
      *  if no new communicator is passed */
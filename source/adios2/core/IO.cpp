@@ -11,6 +11,7 @@
 #include "IO.h"
 #include "IO.tcc"
 
+#include <algorithm> // std::find
 #include <sstream>
 
 #include "adios2/ADIOSMPI.h"
@@ -172,7 +173,16 @@ bool IO::RemoveVariable(const std::string &name) noexcept
     else if (type == helper::GetType<T>())                                     \
     {                                                                          \
         auto &variableMap = GetVariableMap<T>();                               \
-        variableMap.erase(index);                                              \
+        auto itTypedVariable = variableMap.find(index);                        \
+        if (itTypedVariable != variableMap.end())                              \
+        {                                                                      \
+            for (auto &enginePair : m_Engines)                                 \
+            {                                                                  \
+                enginePair.second->NotifyRemoveVariable(                       \
+                    itTypedVariable->second);                                  \
+            }                                                                  \
+            variableMap.erase(itTypedVariable);                                \
+        }                                                                      \
         isRemoved = true;                                                      \
     }
         ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
@@ -190,6 +200,10 @@ bool IO::RemoveVariable(const std::string &name) noexcept
 void IO::RemoveAllVariables() noexcept
 {
     TAU_SCOPED_TIMER("IO::RemoveAllVariables");
+    for (auto &enginePair : m_Engines)
+    {
+        enginePair.second->NotifyRemoveAllVariables();
+    }
     m_Variables.clear();
 #define declare_type(T) GetVariableMap<T>().clear();
     ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
@@ -242,44 +256,74 @@ void IO::RemoveAllAttributes() noexcept
 #undef declare_type
 }
 
-std::map<std::string, Params> IO::GetAvailableVariables() noexcept
+std::map<std::string, Params>
+IO::GetAvailableVariables(const std::vector<std::string> &keys) noexcept
 {
     TAU_SCOPED_TIMER("IO::GetAvailableVariables");
-    std::map<std::string, Params> variablesInfo;
-    for (const auto &variablePair : m_Variables)
-    {
-        const std::string name(variablePair.first);
-        const std::string type = InquireVariableType(name);
+    auto lf_IsKey = [&](const std::string &key) -> bool {
+        return keys.empty() ||
+               std::find(keys.begin(), keys.end(), key) != keys.end();
+    };
+
+    // only requested keys are computed, Min and Max come from one MinMax call
+    const bool isType = lf_IsKey("Type");
+    const bool isStepsCount = lf_IsKey("AvailableStepsCount");
+    const bool isShape = lf_IsKey("Shape");
+    const bool isSingleValue = lf_IsKey("SingleValue");
+    const bool isValue = lf_IsKey("Value");
+    const bool isMin = lf_IsKey("Min");
+    const bool isMax = lf_IsKey("Max");
 
-        if (type == "compound")
-        {
-        }
+    std::map<std::string, Params> variablesInfo;
+    // walk the typed maps directly, no name lookup or type string dispatch
 #define declare_template_instantiation(T)                                      \
-    else if (type == helper::GetType<T>())                                     \
+    for (auto &variablePair : GetVariableMap<T>())                             \
     {                                                                          \
-        variablesInfo[name]["Type"] = type;                                    \
-        Variable<T> &variable = *InquireVariable<T>(name);                     \
-        variablesInfo[name]["AvailableStepsCount"] =                           \
-            helper::ValueToString(variable.m_AvailableStepsCount);             \
-        variablesInfo[name]["Shape"] = helper::VectorToCSV(variable.Shape());  \
+        Variable<T> &variable = variablePair.second;                           \
+        if (m_ReadStreaming && !variable.IsValidStep(m_EngineStep + 1))        \
+        {                                                                      \
+            continue;                                                          \
+        }                                                                      \
+        Params &info = variablesInfo[variable.m_Name];                         \
+        if (isType)                                                            \
+        {                                                                      \
+            info["Type"] = variable.m_Type;                                    \
+        }                                                                      \
+        if (isStepsCount)                                                      \
+        {                                                                      \
+            info["AvailableStepsCount"] =                                      \
+                helper::ValueToString(variable.m_AvailableStepsCount);         \
+        }                                                                      \
+        if (isShape)                                                           \
+        {                                                                      \
+            info["Shape"] = helper::VectorToCSV(variable.Shape());             \
+        }                                                                      \
+        if (isSingleValue)                                                     \
+        {                                                                      \
+            info["SingleValue"] = variable.m_SingleValue ? "true" : "false";   \
+        }                                                                      \
         if (variable.m_SingleValue)                                            \
         {                                                                      \
-            variablesInfo[name]["SingleValue"] = "true";                       \
-            variablesInfo[name]["Value"] =                                     \
-                helper::ValueToString(variable.m_Value);                       \
+            if (isValue)                                                       \
+            {                                                                  \
+                info["Value"] = helper::ValueToString(variable.m_Value);       \
+            }                                                                  \
         }                                                                      \
-        else                                                                   \
+        else if (isMin || isMax)                                               \
         {                                                                      \
-            variablesInfo[name]["SingleValue"] = "false";                      \
-            variablesInfo[name]["Min"] =                                       \
-                helper::ValueToString(variable.Min());                         \
-            variablesInfo[name]["Max"] =                                       \
-                helper::ValueToString(variable.Max());                         \
+            const std::pair<T, T> minMax = variable.MinMax();                  \
+            if (isMin)                                                         \
+            {                                                                  \
+                info["Min"] = helper::ValueToString(minMax.first);             \
+            }                                                                  \
+            if (isMax)                                                         \
+            {                                                                  \
+                info["Max"] = helper::ValueToString(minMax.second);            \
+            }                                                                  \
         }                                                                      \
     }
-        ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
+    ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
 #undef declare_template_instantiation
-    }
 
     return variablesInfo;
 }
@@ -673,33 +717,21 @@ void IO::ResetVariablesStepSelection(const bool zeroStart,
                                      const std::string hint)
 {
     TAU_SCOPED_TIMER("IO::other");
-    const auto &variablesData = GetVariablesDataMap();
-
-    for (const auto &variableData : variablesData)
-    {
-        const std::string name = variableData.first;
-        const std::string type = InquireVariableType(name);
-
-        if (type.empty())
-        {
-            continue;
-        }
-
-        if (type == "compound")
-        {
-        }
-// using relative start
+// using relative start, walk the typed maps directly
 #define declare_type(T)                                                        \
-    else if (type == helper::GetType<T>())                                     \
+    for (auto &variablePair : GetVariableMap<T>())                             \
     {                                                                          \
-        Variable<T> *variable = InquireVariable<T>(name);                      \
-        variable->CheckRandomAccessConflict(hint);                             \
-        variable->ResetStepsSelection(zeroStart);                              \
-        variable->m_RandomAccess = false;                                      \
+        Variable<T> &variable = variablePair.second;                           \
+        if (m_ReadStreaming && !variable.IsValidStep(m_EngineStep + 1))        \
+        {                                                                      \
+            continue;                                                          \
+        }                                                                      \
+        variable.CheckRandomAccessConflict(hint);                              \
+        variable.ResetStepsSelection(zeroStart);                               \
+        variable.m_RandomAccess = false;                                       \
     }
-        ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
+    ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
 #undef declare_type
-    }
 }
 
 void IO::LockDefinitions() noexcept { m_DefinitionsLocked = true; };
@@ -248,11 +248,14 @@ public:
 
     /**
      * @brief Retrieve map with variables info. Use when reading.
+     * @param keys subset of info keys to compute, e.g. {"Type", "Shape"},
+     * empty (default): all keys
      * @return map with current variables and info
-     * keys: Type, Min, Max, Value, AvailableStepsStart,
-     * AvailableStepsCount, Shape, Start, Count, SingleValue
+     * keys: Type, Min, Max, Value, AvailableStepsCount, Shape, SingleValue
      */
-    std::map<std::string, Params> GetAvailableVariables() noexcept;
+    std::map<std::string, Params> GetAvailableVariables(
+        const std::vector<std::string> &keys =
+            std::vector<std::string>()) noexcept;
 
     /**
      * @brief Gets an existing variable of primitive type by name
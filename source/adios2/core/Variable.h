@@ -146,6 +146,17 @@ public:
     AllStepsBlocksInfo() const;
 
 private:
+    /** read mode MinMax from blocks metadata, memoized for one step and block
+     * since blocks of a step don't change once read */
+    struct MinMaxCache
+    {
+        const Engine *ReadEngine = nullptr;
+        size_t Step = 0;
+        size_t BlockID = 0;
+        std::pair<T, T> MinMax;
+    };
+    mutable MinMaxCache m_MinMaxCache;
+
     Dims DoShape(const size_t step) const;
 
     Dims DoCount() const;
@@ -154,6 +165,8 @@ private:
 
     std::pair<T, T> DoMinMax(const size_t step) const;
 
+    std::pair<T, T> DoMinMaxBlocks(const size_t step) const;
+
     std::vector<std::vector<typename Variable<T>::Info>>
     DoAllStepsBlocksInfo() const;
 
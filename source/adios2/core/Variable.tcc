@@ -110,71 +110,85 @@ std::pair<T, T> Variable<T>::DoMinMax(const size_t step) const
 {
     CheckRandomAccess(step, "MinMax");
 
-    std::pair<T, T> minMax;
-    minMax.first = {};
-    minMax.second = {};
-
     if (m_Engine != nullptr && !m_FirstStreamingStep)
     {
         const size_t stepInput =
             (step == DefaultSizeT) ? m_Engine->CurrentStep() : step;
-
-        const std::vector<typename Variable<T>::Info> blocksInfo =
-            m_Engine->BlocksInfo<T>(*this, stepInput);
-
-        if (blocksInfo.size() == 0)
+        const size_t blockID =
+            (m_ShapeID == ShapeID::LocalArray) ? m_BlockID : 0;
+
+        // the cache is keyed by step, so it is invalidated by every new
+        // streaming step
+        if (m_MinMaxCache.ReadEngine != m_Engine ||
+            m_MinMaxCache.Step != stepInput ||
+            m_MinMaxCache.BlockID != blockID)
         {
-            return minMax;
+            m_MinMaxCache.MinMax = DoMinMaxBlocks(stepInput);
+            m_MinMaxCache.ReadEngine = m_Engine;
+            m_MinMaxCache.Step = stepInput;
+            m_MinMaxCache.BlockID = blockID;
         }
+        return m_MinMaxCache.MinMax;
+    }
 
-        if (m_ShapeID == ShapeID::LocalArray)
+    return std::pair<T, T>(m_Min, m_Max);
+}
+
+template <class T>
+std::pair<T, T> Variable<T>::DoMinMaxBlocks(const size_t step) const
+{
+    std::pair<T, T> minMax;
+    minMax.first = {};
+    minMax.second = {};
+
+    const std::vector<typename Variable<T>::Info> blocksInfo =
+        m_Engine->BlocksInfo<T>(*this, step);
+
+    if (blocksInfo.size() == 0)
+    {
+        return minMax;
+    }
+
+    if (m_ShapeID == ShapeID::LocalArray)
+    {
+        if (m_DebugMode && m_BlockID >= blocksInfo.size())
         {
-            if (m_DebugMode && m_BlockID >= blocksInfo.size())
-            {
-                throw std::invalid_argument(
-                    "ERROR: BlockID " + std::to_string(m_BlockID) +
-                    " does not exist for LocalArray variable " + m_Name +
-                    ", in call to MinMax, Min or Maxn");
-            }
-            minMax.first = blocksInfo[m_BlockID].Min;
-            minMax.second = blocksInfo[m_BlockID].Max;
-            return minMax;
+            throw std::invalid_argument(
+                "ERROR: BlockID " + std::to_string(m_BlockID) +
+                " does not exist for LocalArray variable " + m_Name +
+                ", in call to MinMax, Min or Maxn");
         }
+        minMax.first = blocksInfo[m_BlockID].Min;
+        minMax.second = blocksInfo[m_BlockID].Max;
+        return minMax;
+    }
 
-        const bool isValue =
-            ((blocksInfo.front().Shape.size() == 1 &&
-              blocksInfo.front().Shape.front() == LocalValueDim) ||
-             m_ShapeID == ShapeID::GlobalValue)
-                ? true
-                : false;
+    const bool isValue =
+        ((blocksInfo.front().Shape.size() == 1 &&
+          blocksInfo.front().Shape.front() == LocalValueDim) ||
+         m_ShapeID == ShapeID::GlobalValue)
+            ? true
+            : false;
 
-        minMax.first =
-            isValue ? blocksInfo.front().Value : blocksInfo.front().Min;
-        minMax.second =
-            isValue ? blocksInfo.front().Value : blocksInfo.front().Max;
+    minMax.first = isValue ? blocksInfo.front().Value : blocksInfo.front().Min;
+    minMax.second = isValue ? blocksInfo.front().Value : blocksInfo.front().Max;
 
-        for (const typename Variable<T>::Info &blockInfo : blocksInfo)
-        {
-            const T minValue = isValue ? blockInfo.Value : blockInfo.Min;
+    for (const typename Variable<T>::Info &blockInfo : blocksInfo)
+    {
+        const T minValue = isValue ? blockInfo.Value : blockInfo.Min;
 
-            if (helper::LessThan<T>(minValue, minMax.first))
-            {
-                minMax.first = minValue;
-            }
+        if (helper::LessThan<T>(minValue, minMax.first))
+        {
+            minMax.first = minValue;
+        }
 
-            const T maxValue = isValue ? blockInfo.Value : blockInfo.Max;
+        const T maxValue = isValue ? blockInfo.Value : blockInfo.Max;
 
-            if (helper::GreaterThan<T>(maxValue, minMax.second))
-            {
-                minMax.second = maxValue;
-            }
+        if (helper::GreaterThan<T>(maxValue, minMax.second))
+        {
+            minMax.second = maxValue;
         }
     }
-    else
-    {
-        minMax.first = m_Min;
-        minMax.second = m_Max;
-    }
     return minMax;
 }
 
@@ -28,8 +28,9 @@ VariableBase::VariableBase(const std::string &name, const std::string type,
                            const size_t elementSize, const Dims &shape,
                            const Dims &start, const Dims &count,
                            const bool constantDims, const bool debugMode)
-: m_Name(name), m_Type(type), m_ElementSize(elementSize), m_Shape(shape),
-  m_Start(start), m_Count(count), m_ConstantDims(constantDims),
+: m_Name(name), m_Type(type),
+  m_DataType(helper::GetDataTypeFromString(type)), m_ElementSize(elementSize),
+  m_Shape(shape), m_Start(start), m_Count(count), m_ConstantDims(constantDims),
   m_DebugMode(debugMode)
 {
     InitShapeType();
@@ -41,6 +41,9 @@ public:
     /** primitive from <T> or compound from struct */
     const std::string m_Type;
 
+    /** m_Type as enum, switch on it instead of comparing type strings */
+    const DataType m_DataType;
+
     /** Variable -> sizeof(T),
      *  VariableCompound -> from constructor sizeof(struct) */
     const size_t m_ElementSize;
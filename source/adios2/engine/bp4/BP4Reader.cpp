@@ -11,7 +11,13 @@
 #include "BP4Reader.h"
 #include "BP4Reader.tcc"
 
-#include "adios2/helper/adiosFunctions.h" // MPI BroadcastVector
+#include <algorithm> //std::sort
+#include <chrono>
+#include <map>
+#include <utility> //std::move
+
+#include "adios2/helper/adiosFunctions.h"  // MPI BroadcastVector
+#include "adios2/helper/adiosThreadPool.h" //helper::GetThreadPool
 #include "adios2/toolkit/profiling/taustubs/tautimer.hpp"
 
 namespace adios2
@@ -26,7 +32,8 @@ BP4Reader::BP4Reader(IO &io, const std::string &name, const Mode mode,
 : Engine("BP4Reader", io, name, mode, mpiComm),
   m_BP4Deserializer(mpiComm, m_DebugMode), m_FileManager(mpiComm, m_DebugMode),
   m_SubFileManager(mpiComm, m_DebugMode),
-  m_FileMetadataIndexManager(mpiComm, m_DebugMode)
+  m_FileMetadataIndexManager(mpiComm, m_DebugMode),
+  m_PrefetchFileManager(mpiComm, m_DebugMode)
 {
     TAU_SCOPED_TIMER("BP4Reader::Open");
     Init();
@@ -63,16 +70,38 @@ StepStatus BP4Reader::BeginStep(StepMode mode, const float timeoutSeconds)
         ++m_CurrentStep;
     }
 
-    // used to inquire for variables in streaming mode
-    m_IO.m_ReadStreaming = true;
-    m_IO.m_EngineStep = m_CurrentStep;
-
     if (m_CurrentStep >= m_BP4Deserializer.m_MetadataSet.StepsCount)
     {
         m_IO.m_ReadStreaming = false;
-        return StepStatus::EndOfStream;
+        StepStatus status = StepStatus::EndOfStream;
+        if (m_BP4Deserializer.m_StreamReader)
+        {
+            status = WaitForNewSteps(timeoutSeconds);
+        }
+
+        if (status != StepStatus::OK)
+        {
+            if (status == StepStatus::NotReady)
+            {
+                // the next BeginStep retries the same step
+                if (m_CurrentStep == 0)
+                {
+                    m_FirstStep = true;
+                }
+                else
+                {
+                    --m_CurrentStep;
+                }
+            }
+            return status;
+        }
     }
 
+    // used to inquire for variables in streaming mode, set after new steps
+    // are parsed as parsing inquires variables of all steps
+    m_IO.m_ReadStreaming = true;
+    m_IO.m_EngineStep = m_CurrentStep;
+
     /*
     const auto &variablesData = m_IO.GetVariablesDataMap();
 
@@ -108,6 +137,7 @@ void BP4Reader::EndStep()
 {
     TAU_SCOPED_TIMER("BP4Reader::EndStep");
     PerformGets();
+    StartPrefetch();
 }
 
 void BP4Reader::PerformGets()
@@ -118,30 +148,42 @@ void BP4Reader::PerformGets()
         return;
     }
 
-    for (const std::string &name : m_BP4Deserializer.m_DeferredVariables)
+    for (VariableBase *variableBase : m_BP4Deserializer.m_DeferredVariables)
     {
-        const std::string type = m_IO.InquireVariableType(name);
-
-        if (type == "compound")
+        switch (variableBase->m_DataType)
         {
-        }
 #define declare_type(T)                                                        \
-    else if (type == helper::GetType<T>())                                     \
+    case helper::GetDataType<T>():                                             \
     {                                                                          \
-        Variable<T> &variable =                                                \
-            FindVariable<T>(name, "in call to PerformGets, EndStep or Close"); \
+        Variable<T> &variable = *static_cast<Variable<T> *>(variableBase);     \
         for (auto &blockInfo : variable.m_BlocksInfo)                          \
         {                                                                      \
             m_BP4Deserializer.SetVariableBlockInfo(variable, blockInfo);       \
         }                                                                      \
-        ReadVariableBlocks(variable);                                          \
+        PlanVariableBlocks(variable);                                          \
         variable.m_BlocksInfo.clear();                                         \
+        break;                                                                 \
     }
-        ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
+            ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
 #undef declare_type
+        default:
+            break;
+        }
     }
 
-    m_BP4Deserializer.m_DeferredVariables.clear();
+    // all deferred variables are read together
+    PerformReads();
+    m_BP4Deserializer.ClearDeferredVariables();
+}
+
+void BP4Reader::NotifyRemoveVariable(const VariableBase &variable) noexcept
+{
+    m_BP4Deserializer.RemoveDeferredVariable(variable);
+}
+
+void BP4Reader::NotifyRemoveAllVariables() noexcept
+{
+    m_BP4Deserializer.ClearDeferredVariables();
 }
 
 // PRIVATE
@@ -157,6 +199,7 @@ void BP4Reader::Init()
         }
     }
 
+    m_BP4Deserializer.InitParameters(m_IO.m_Parameters);
     InitTransports();
     InitBuffer();
 }
@@ -173,55 +216,519 @@ void BP4Reader::InitTransports()
 
     if (m_BP4Deserializer.m_RankMPI == 0)
     {
+        const bool profile = m_BP4Deserializer.m_Profiler.IsActive;
+
+        /* Open file to save the metadata index table, the writer creates it
+         * after md.0, so md.0 exists once md.idx is found */
+        const std::string metadataIndexFile(
+            m_BP4Deserializer.GetBPMetadataIndexFileName(m_Name));
+
+        const auto openTimeout = std::chrono::duration<double>(
+            m_BP4Deserializer.m_OpenTimeoutSecs);
+        const auto pollingPeriod = std::chrono::duration<double>(
+            m_BP4Deserializer.m_BeginStepPollingFrequencySecs);
+        const auto startTime = std::chrono::steady_clock::now();
+
+        while (true)
+        {
+            try
+            {
+                m_FileMetadataIndexManager.OpenFiles(
+                    {metadataIndexFile}, adios2::Mode::Read,
+                    m_IO.m_TransportsParameters, profile);
+                break;
+            }
+            catch (std::ios_base::failure &)
+            {
+                const auto elapsed =
+                    std::chrono::steady_clock::now() - startTime;
+                if (elapsed >= openTimeout)
+                {
+                    throw;
+                }
+                std::this_thread::sleep_for(
+                    std::min(pollingPeriod,
+                             std::chrono::duration<double>(openTimeout -
+                                                           elapsed)));
+            }
+        }
+
         const std::string metadataFile(
             m_BP4Deserializer.GetBPMetadataFileName(m_Name));
 
-        const bool profile = m_BP4Deserializer.m_Profiler.IsActive;
         m_FileManager.OpenFiles({metadataFile}, adios2::Mode::Read,
                                 m_IO.m_TransportsParameters, profile);
-
-        /* Open file to save the metadata index table */
-        const std::string metadataIndexFile(
-            m_BP4Deserializer.GetBPMetadataIndexFileName(m_Name));
-        m_FileMetadataIndexManager.OpenFiles(
-            {metadataIndexFile}, adios2::Mode::Read,
-            m_IO.m_TransportsParameters, profile);
     }
 }
 
 void BP4Reader::InitBuffer()
 {
     // Put all metadata in buffer
+    std::vector<char> newMetadataIndex;
+    std::vector<char> newMetadata;
     if (m_BP4Deserializer.m_RankMPI == 0)
     {
-        const size_t fileSize = m_FileManager.GetFileSize(0);
-        m_BP4Deserializer.m_Metadata.Resize(
-            fileSize, "allocating metadata buffer, in call to BP4Reader Open");
+        ReadNewMetadata(newMetadataIndex, newMetadata);
+    }
 
-        m_FileManager.ReadFile(m_BP4Deserializer.m_Metadata.m_Buffer.data(),
-                               fileSize);
+    // fills IO with Variables and Attributes
+    ProcessNewMetadata(newMetadataIndex, newMetadata);
 
-        const size_t metadataIndexFileSize =
-            m_FileMetadataIndexManager.GetFileSize(0);
-        m_BP4Deserializer.m_MetadataIndex.Resize(
-            metadataIndexFileSize,
-            "allocating metadata index buffer, in call to BPFileReader Open");
-        m_FileMetadataIndexManager.ReadFile(
-            m_BP4Deserializer.m_MetadataIndex.m_Buffer.data(),
-            metadataIndexFileSize);
+    if (m_MDIndexFileProcessedSize == 0)
+    {
+        // no step written yet, StreamReader waits for them in BeginStep
+        m_BP4Deserializer.m_MetadataSet.StepsCount = 0;
     }
-    // broadcast buffer to all ranks from zero
-    helper::BroadcastVector(m_BP4Deserializer.m_Metadata.m_Buffer, m_MPIComm);
+}
+
+bool BP4Reader::ReadNewMetadata(std::vector<char> &newMetadataIndex,
+                                std::vector<char> &newMetadata)
+{
+    TAU_SCOPED_TIMER("BP4Reader::ReadNewMetadata");
+    // md.idx: 48 bytes header followed by 48 bytes records, one per step
+    const size_t headerSize = 48;
+    const size_t recordSize = 48;
 
+    newMetadataIndex.clear();
+    newMetadata.clear();
+
+    if (m_FileMetadataIndexManager.GetFileSize(0) < headerSize)
+    {
+        // the writer hasn't finished its first step
+        return false;
+    }
+
+    // the flag is read before the file size, a writer clears it after
+    // appending its last record, so no record can be missed
+    char activeFlag = 0;
+    m_FileMetadataIndexManager.ReadFile(&activeFlag, 1,
+                                        m_BP4Deserializer.m_ActiveFlagPosition);
+    m_WriterIsActive = (activeFlag != 0);
+
+    // a record might be partially written, only read whole ones
+    const size_t metadataIndexFileSize =
+        m_FileMetadataIndexManager.GetFileSize(0);
+    const size_t metadataIndexEnd =
+        headerSize +
+        (metadataIndexFileSize - headerSize) / recordSize * recordSize;
+
+    if (metadataIndexEnd <= std::max(m_MDIndexFileProcessedSize, headerSize))
+    {
+        return false;
+    }
+
+    newMetadataIndex.resize(metadataIndexEnd - m_MDIndexFileProcessedSize);
+    m_FileMetadataIndexManager.ReadFile(newMetadataIndex.data(),
+                                        newMetadataIndex.size(),
+                                        m_MDIndexFileProcessedSize);
+
+    // currentStepEndPos of the last record is the md.0 size required
+    const bool isLittleEndian = (m_MDIndexFileProcessedSize == 0)
+                                    ? (newMetadataIndex[28] == 0)
+                                    : m_BP4Deserializer.m_Minifooter.IsLittleEndian;
+    size_t position = newMetadataIndex.size() - 8;
+    const size_t metadataEnd = static_cast<size_t>(helper::ReadValue<uint64_t>(
+        newMetadataIndex, position, isLittleEndian));
+
+    if (m_FileManager.GetFileSize(0) < metadataEnd)
+    {
+        // md.0 contents not visible yet, retry at the next poll
+        newMetadataIndex.clear();
+        return false;
+    }
+
+    newMetadata.resize(metadataEnd - m_MDFileProcessedSize);
+    m_FileManager.ReadFile(newMetadata.data(), newMetadata.size(),
+                           m_MDFileProcessedSize);
+    return true;
+}
+
+void BP4Reader::ProcessNewMetadata(std::vector<char> &newMetadataIndex,
+                                   std::vector<char> &newMetadata)
+{
     // broadcast metadata index buffer to all ranks from zero
-    helper::BroadcastVector(m_BP4Deserializer.m_MetadataIndex.m_Buffer,
-                            m_MPIComm);
+    helper::BroadcastVector(newMetadataIndex, m_MPIComm);
+    if (newMetadataIndex.empty())
+    {
+        return;
+    }
+
+    // broadcast buffer to all ranks from zero
+    helper::BroadcastVector(newMetadata, m_MPIComm);
+
+    const bool hasHeader = (m_MDIndexFileProcessedSize == 0);
+    const size_t parsedSteps =
+        hasHeader ? 0 : m_BP4Deserializer.m_MetadataSet.StepsCount;
+
+    // index positions are absolute offsets in md.0, keep all of it
+    std::vector<char> &metadata = m_BP4Deserializer.m_Metadata.m_Buffer;
+    if (metadata.empty())
+    {
+        metadata.swap(newMetadata);
+    }
+    else
+    {
+        metadata.insert(metadata.end(), newMetadata.begin(), newMetadata.end());
+    }
+    m_BP4Deserializer.m_MetadataIndex.m_Buffer.swap(newMetadataIndex);
 
     /* Parse metadata index table */
-    m_BP4Deserializer.ParseMetadataIndex(m_BP4Deserializer.m_MetadataIndex);
+    m_BP4Deserializer.ParseMetadataIndex(m_BP4Deserializer.m_MetadataIndex,
+                                         hasHeader);
 
-    // fills IO with Variables and Attributes
-    m_BP4Deserializer.ParseMetadata(m_BP4Deserializer.m_Metadata, *this);
+    // fills IO with Variables and Attributes of the new steps
+    m_BP4Deserializer.ParseMetadata(m_BP4Deserializer.m_Metadata, *this,
+                                    parsedSteps);
+
+    m_MDFileProcessedSize = metadata.size();
+    m_MDIndexFileProcessedSize +=
+        m_BP4Deserializer.m_MetadataIndex.m_Buffer.size();
+}
+
+StepStatus BP4Reader::WaitForNewSteps(const float timeoutSeconds)
+{
+    TAU_SCOPED_TIMER("BP4Reader::WaitForNewSteps");
+    std::vector<char> newMetadataIndex;
+    std::vector<char> newMetadata;
+    size_t status = static_cast<size_t>(StepStatus::OK);
+
+    // only rank 0 polls, the outcome is broadcast so all ranks agree
+    if (m_BP4Deserializer.m_RankMPI == 0)
+    {
+        const auto timeout = std::chrono::duration<double>(timeoutSeconds);
+        const auto pollingPeriod = std::chrono::duration<double>(
+            m_BP4Deserializer.m_BeginStepPollingFrequencySecs);
+        const auto startTime = std::chrono::steady_clock::now();
+
+        while (true)
+        {
+            if (ReadNewMetadata(newMetadataIndex, newMetadata))
+            {
+                status = static_cast<size_t>(StepStatus::OK);
+                break;
+            }
+
+            if (!m_WriterIsActive)
+            {
+                status = static_cast<size_t>(StepStatus::EndOfStream);
+                break;
+            }
+
+            const auto elapsed = std::chrono::steady_clock::now() - startTime;
+            if (timeoutSeconds >= 0.f && elapsed >= timeout)
+            {
+                status = static_cast<size_t>(StepStatus::NotReady);
+                break;
+            }
+
+            if (timeoutSeconds >= 0.f)
+            {
+                std::this_thread::sleep_for(std::min(
+                    pollingPeriod,
+                    std::chrono::duration<double>(timeout - elapsed)));
+            }
+            else
+            {
+                std::this_thread::sleep_for(pollingPeriod);
+            }
+        }
+    }
+
+    status = helper::BroadcastValue(status, m_MPIComm);
+    if (status == static_cast<size_t>(StepStatus::OK))
+    {
+        ProcessNewMetadata(newMetadataIndex, newMetadata);
+    }
+
+    return static_cast<StepStatus>(status);
+}
+
+void BP4Reader::PerformReads()
+{
+    if (m_ReadRequests.empty())
+    {
+        return;
+    }
+
+    TAU_SCOPED_TIMER("BP4Reader::PerformReads");
+    std::vector<ReadRequest> requests;
+    requests.swap(m_ReadRequests);
+
+    WaitPrefetch();
+    const std::vector<ReadRange> ranges = CoalesceReadRequests(requests);
+
+    // one queue of ranges per subfile, subfiles are opened here as
+    // m_SubFileManager.m_Transports is not thread-safe
+    std::map<size_t, std::vector<const ReadRange *>> subFileQueues;
+    std::set<size_t> pinned;
+    for (const ReadRange &range : ranges)
+    {
+        if (GetPrefetchData(range) == nullptr)
+        {
+            pinned.insert(range.SubStreamID);
+        }
+    }
+    for (const ReadRange &range : ranges)
+    {
+        if (pinned.count(range.SubStreamID) == 1)
+        {
+            OpenSubFile(m_SubFileManager, m_OpenSubFiles, range.SubStreamID,
+                        pinned);
+        }
+        subFileQueues[range.SubStreamID].push_back(&range);
+    }
+
+    auto lf_ReadQueues =
+        [&](const std::vector<const std::vector<const ReadRange *> *> &queues) {
+            std::vector<char> buffer;
+            for (const auto *queue : queues)
+            {
+                // the whole access pattern of a subfile is known, let the
+                // transport prefetch it
+                for (const ReadRange *range : *queue)
+                {
+                    if (GetPrefetchData(*range) == nullptr)
+                    {
+                        m_SubFileManager.WillReadFile(
+                            range->Offset, range->Size, range->SubStreamID);
+                    }
+                }
+
+                for (const ReadRange *range : *queue)
+                {
+                    // clip straight from prefetched or transport memory
+                    // (e.g. MMAP) if possible, otherwise read into a scratch
+                    // buffer
+                    const char *data = GetPrefetchData(*range);
+                    if (data == nullptr)
+                    {
+                        data = m_SubFileManager.GetFileData(
+                            range->Offset, range->Size, range->SubStreamID);
+                    }
+                    if (data == nullptr)
+                    {
+                        buffer.resize(range->Size);
+                        m_SubFileManager.ReadFile(buffer.data(), range->Size,
+                                                  range->Offset,
+                                                  range->SubStreamID);
+                        data = buffer.data();
+                    }
+
+                    for (size_t r = range->Begin; r < range->End; ++r)
+                    {
+                        const ReadRequest &request = requests[r];
+                        request.Clip(data + request.Offset - range->Offset);
+                    }
+                }
+            }
+        };
+
+    // a subfile is only accessed by a single worker
+    const size_t threads = std::min(
+        static_cast<size_t>(m_BP4Deserializer.GetThreads()),
+        subFileQueues.size());
+
+    std::vector<std::vector<const std::vector<const ReadRange *> *>>
+        workerQueues(threads);
+    size_t q = 0;
+    for (const auto &subFileQueue : subFileQueues)
+    {
+        workerQueues[q % threads].push_back(&subFileQueue.second);
+        ++q;
+    }
+
+    helper::GetThreadPool().ParallelFor(
+        threads, static_cast<unsigned int>(threads),
+        [&](const size_t t) { lf_ReadQueues(workerQueues[t]); });
+}
+
+std::vector<BP4Reader::ReadRange>
+BP4Reader::CoalesceReadRequests(std::vector<ReadRequest> &requests) const
+{
+    std::sort(requests.begin(), requests.end(),
+              [](const ReadRequest &a, const ReadRequest &b) {
+                  return (a.SubStreamID == b.SubStreamID)
+                             ? a.Offset < b.Offset
+                             : a.SubStreamID < b.SubStreamID;
+              });
+
+    const size_t gap = m_BP4Deserializer.m_ReadCoalesceGap;
+    std::vector<ReadRange> ranges;
+
+    for (size_t i = 0; i < requests.size(); ++i)
+    {
+        const ReadRequest &request = requests[i];
+        const size_t requestEnd = request.Offset + request.Size;
+
+        if (!ranges.empty())
+        {
+            ReadRange &range = ranges.back();
+            const size_t rangeEnd = range.Offset + range.Size;
+            const size_t mergedSize =
+                std::max(rangeEnd, requestEnd) - range.Offset;
+
+            if (request.SubStreamID == range.SubStreamID &&
+                request.Offset <= rangeEnd + gap &&
+                mergedSize <= m_MaxCoalescedReadSize)
+            {
+                range.Size = mergedSize;
+                range.End = i + 1;
+                continue;
+            }
+        }
+
+        ranges.push_back(
+            {request.SubStreamID, request.Offset, request.Size, i, i + 1});
+    }
+
+    return ranges;
+}
+
+void BP4Reader::OpenSubFile(const size_t subStreamID)
+{
+    OpenSubFile(m_SubFileManager, m_OpenSubFiles, subStreamID, {subStreamID});
+}
+
+void BP4Reader::OpenSubFile(transportman::TransportMan &fileManager,
+                            std::list<size_t> &openSubFiles,
+                            const size_t subStreamID,
+                            const std::set<size_t> &pinned)
+{
+    if (fileManager.m_Transports.count(subStreamID) == 1)
+    {
+        auto itSubFile =
+            std::find(openSubFiles.begin(), openSubFiles.end(), subStreamID);
+        openSubFiles.splice(openSubFiles.begin(), openSubFiles, itSubFile);
+        return;
+    }
+
+    const std::string subFileName = m_BP4Deserializer.GetBPSubFileName(
+        m_Name, subStreamID, m_BP4Deserializer.m_Minifooter.HasSubFiles);
+
+    // honors the user File transport library (e.g. MMAP)
+    fileManager.OpenFileID(subFileName, subStreamID, Mode::Read,
+                           m_IO.m_TransportsParameters.front(),
+                           m_BP4Deserializer.m_Profiler.IsActive);
+    openSubFiles.push_front(subStreamID);
+
+    const size_t maxOpenSubFiles = m_BP4Deserializer.m_MaxOpenSubFiles;
+    if (maxOpenSubFiles == 0)
+    {
+        return;
+    }
+
+    auto itSubFile = openSubFiles.end();
+    while (openSubFiles.size() > maxOpenSubFiles &&
+           itSubFile != openSubFiles.begin())
+    {
+        --itSubFile;
+        if (*itSubFile == subStreamID || pinned.count(*itSubFile) == 1)
+        {
+            continue;
+        }
+
+        fileManager.CloseFiles(static_cast<int>(*itSubFile));
+        fileManager.m_Transports.erase(*itSubFile);
+        itSubFile = openSubFiles.erase(itSubFile);
+    }
+}
+
+void BP4Reader::StartPrefetch()
+{
+    std::vector<std::function<void(std::vector<ReadRequest> &)>> plans;
+    plans.swap(m_PrefetchPlans);
+
+    // discards a prefetch that wasn't used
+    WaitPrefetch();
+    m_PrefetchRanges.clear();
+
+    if (plans.empty() ||
+        m_CurrentStep + 1 >= m_BP4Deserializer.m_MetadataSet.StepsCount)
+    {
+        return;
+    }
+
+    std::vector<ReadRequest> requests;
+    for (const auto &plan : plans)
+    {
+        plan(requests);
+    }
+
+    std::vector<ReadRange> ranges = CoalesceReadRequests(requests);
+    if (ranges.empty())
+    {
+        return;
+    }
+
+    // subfiles are opened here, the background task only reads
+    std::set<size_t> pinned;
+    for (const ReadRange &range : ranges)
+    {
+        pinned.insert(range.SubStreamID);
+    }
+    for (const size_t subStreamID : pinned)
+    {
+        OpenSubFile(m_PrefetchFileManager, m_PrefetchOpenSubFiles, subStreamID,
+                    pinned);
+    }
+
+    m_PrefetchStep = m_CurrentStep + 1;
+    m_Prefetch = std::async(std::launch::async, [this, ranges]() {
+        std::vector<PrefetchRange> prefetchRanges;
+        prefetchRanges.reserve(ranges.size());
+
+        for (const ReadRange &range : ranges)
+        {
+            PrefetchRange prefetchRange;
+            prefetchRange.SubStreamID = range.SubStreamID;
+            prefetchRange.Offset = range.Offset;
+            prefetchRange.Data.resize(range.Size);
+            m_PrefetchFileManager.ReadFile(prefetchRange.Data.data(),
+                                           range.Size, range.Offset,
+                                           range.SubStreamID);
+            prefetchRanges.push_back(std::move(prefetchRange));
+        }
+        return prefetchRanges;
+    });
+}
+
+void BP4Reader::WaitPrefetch()
+{
+    if (!m_Prefetch.valid())
+    {
+        return;
+    }
+
+    try
+    {
+        m_PrefetchRanges = m_Prefetch.get();
+    }
+    catch (std::exception &)
+    {
+        // ranges that failed to prefetch are read again by PerformReads
+        m_PrefetchRanges.clear();
+    }
+}
+
+const char *BP4Reader::GetPrefetchData(const ReadRange &range) const noexcept
+{
+    if (m_PrefetchStep != m_CurrentStep)
+    {
+        return nullptr;
+    }
+
+    for (const PrefetchRange &prefetchRange : m_PrefetchRanges)
+    {
+        if (prefetchRange.SubStreamID == range.SubStreamID &&
+            prefetchRange.Offset <= range.Offset &&
+            range.Offset + range.Size <=
+                prefetchRange.Offset + prefetchRange.Data.size())
+        {
+            return prefetchRange.Data.data() +
+                   (range.Offset - prefetchRange.Offset);
+        }
+    }
+    return nullptr;
 }
 
 #define declare_type(T)                                                        \
@@ -242,8 +749,19 @@ void BP4Reader::DoClose(const int transportIndex)
 {
     TAU_SCOPED_TIMER("BP4Reader::Close");
     PerformGets();
+    m_PrefetchPlans.clear();
+    WaitPrefetch();
+    m_PrefetchRanges.clear();
+    m_PrefetchFileManager.CloseFiles();
     m_SubFileManager.CloseFiles();
     m_FileManager.CloseFiles();
+    m_FileMetadataIndexManager.CloseFiles();
+
+    // the SubStreams parameter also splits the readers' comm
+    if (m_BP4Deserializer.m_SubStreams > 1)
+    {
+        m_BP4Deserializer.m_Aggregator->Close();
+    }
 }
 
 #define declare_type(T)                                                        \
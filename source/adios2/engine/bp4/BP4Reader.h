@@ -11,6 +11,14 @@
 #ifndef ADIOS2_ENGINE_BP4_BP4READER_H_
 #define ADIOS2_ENGINE_BP4_BP4READER_H_
 
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <functional>
+#include <future>
+#include <list>
+#include <set>
+#include <vector>
+/// \endcond
+
 #include "adios2/ADIOSConfig.h"
 #include "adios2/core/Engine.h"
 #include "adios2/toolkit/format/bp4/BP4.h" //format::BP4Deserializer
@@ -48,6 +56,9 @@ public:
 
     void PerformGets() final;
 
+    void NotifyRemoveVariable(const VariableBase &variable) noexcept final;
+    void NotifyRemoveAllVariables() noexcept final;
+
 private:
     format::BP4Deserializer m_BP4Deserializer;
     transportman::TransportMan m_FileManager;
@@ -59,10 +70,101 @@ private:
     size_t m_CurrentStep = 0;
     bool m_FirstStep = true;
 
+    /** md.0 and md.idx bytes already read and parsed, new steps appended by
+     * a writer are read from these positions on */
+    size_t m_MDFileProcessedSize = 0;
+    size_t m_MDIndexFileProcessedSize = 0;
+
+    /** rank 0 only: md.idx header active flag at the last poll */
+    bool m_WriterIsActive = true;
+
+    /** Raw payload (no operations) read collected from Get requests */
+    struct ReadRequest
+    {
+        size_t SubStreamID = 0;
+        size_t Offset = 0;
+        size_t Size = 0;
+        /** clips the payload into the Get destination, called with a pointer
+         * to the first payload byte */
+        std::function<void(const char *)> Clip;
+    };
+
+    /** pending reads, planned by PlanVariableBlocks, run by PerformReads */
+    std::vector<ReadRequest> m_ReadRequests;
+
+    /** requests [Begin, End) merged into a single subfile read */
+    struct ReadRange
+    {
+        size_t SubStreamID;
+        size_t Offset;
+        size_t Size;
+        size_t Begin;
+        size_t End;
+    };
+
+    /** subfile ids open in m_SubFileManager, most recently used first */
+    std::list<size_t> m_OpenSubFiles;
+
+    /** Prefetch=On: subfile range read in the background */
+    struct PrefetchRange
+    {
+        size_t SubStreamID;
+        size_t Offset;
+        std::vector<char> Data;
+    };
+
+    /** Prefetch=On: replay the selections of the current step on the next
+     * step, adding its raw payload reads (without Clip) */
+    std::vector<std::function<void(std::vector<ReadRequest> &)>>
+        m_PrefetchPlans;
+
+    /** ranges of step m_PrefetchStep being read in the background */
+    std::future<std::vector<PrefetchRange>> m_Prefetch;
+
+    /** ranges of step m_PrefetchStep already read, used by PerformReads */
+    std::vector<PrefetchRange> m_PrefetchRanges;
+
+    size_t m_PrefetchStep = 0;
+
+    /** own subfile handles, only used by the background prefetch */
+    transportman::TransportMan m_PrefetchFileManager;
+    std::list<size_t> m_PrefetchOpenSubFiles;
+
+    /** upper bound for a single merged read */
+    static constexpr size_t m_MaxCoalescedReadSize = 64 * 1024 * 1024;
+
     void Init();
     void InitTransports();
     void InitBuffer();
 
+    /**
+     * Rank 0 only: reads md.idx entries and the md.0 bytes they point to
+     * that were appended since the last call, only whole step records are
+     * consumed
+     * @param newMetadataIndex output new md.idx bytes
+     * @param newMetadata output new md.0 bytes
+     * @return true: new steps were read
+     */
+    bool ReadNewMetadata(std::vector<char> &newMetadataIndex,
+                         std::vector<char> &newMetadata);
+
+    /**
+     * Broadcasts metadata read by ReadNewMetadata and parses the new steps
+     * on all ranks
+     * @param newMetadataIndex
+     * @param newMetadata
+     */
+    void ProcessNewMetadata(std::vector<char> &newMetadataIndex,
+                            std::vector<char> &newMetadata);
+
+    /**
+     * StreamReader mode: polls md.idx until new steps show up, the writer
+     * closes the file or timeoutSeconds expires
+     * @param timeoutSeconds < 0: wait until the writer closes the file
+     * @return OK, EndOfStream or NotReady on all ranks
+     */
+    StepStatus WaitForNewSteps(const float timeoutSeconds);
+
 #define declare_type(T)                                                        \
     void DoGetSync(Variable<T> &, T *) final;                                  \
     void DoGetDeferred(Variable<T> &, T *) final;
@@ -80,6 +182,64 @@ private:
     template <class T>
     void ReadVariableBlocks(Variable<T> &variable);
 
+    /**
+     * Adds raw payload reads of variable.m_BlocksInfo to m_ReadRequests,
+     * blocks with operations are read right away
+     * @param variable
+     */
+    template <class T>
+    void PlanVariableBlocks(Variable<T> &variable);
+
+    /**
+     * Sorts m_ReadRequests by (subfile, offset), merges requests closer than
+     * ReadCoalesceGap and reads them with up to Threads workers, one queue
+     * per subfile, clipping each request as soon as its range is read
+     */
+    void PerformReads();
+
+    /**
+     * Sorts requests by (subfile, offset) and merges those closer than
+     * ReadCoalesceGap
+     * @param requests sorted in place
+     * @return merged ranges in (subfile, offset) order
+     */
+    std::vector<ReadRange>
+    CoalesceReadRequests(std::vector<ReadRequest> &requests) const;
+
+    /** Opens a data subfile on first access */
+    void OpenSubFile(const size_t subStreamID);
+
+    /**
+     * Opens a data subfile on first access and marks it as the most recently
+     * used, then closes the least recently used beyond MaxOpenSubFiles
+     * @param fileManager subfile transports
+     * @param openSubFiles open subfile ids in fileManager, most recently used
+     * first
+     * @param pinned subfiles that are not closed, e.g. in use by a read
+     */
+    void OpenSubFile(transportman::TransportMan &fileManager,
+                     std::list<size_t> &openSubFiles,
+                     const size_t subStreamID, const std::set<size_t> &pinned);
+
+    /**
+     * Prefetch=On: adds the next step reads of variable with blockInfo
+     * selection to m_PrefetchPlans, only for streaming reads
+     */
+    template <class T>
+    void AddPrefetchPlan(const Variable<T> &variable,
+                         const typename Variable<T>::Info &blockInfo);
+
+    /** Prefetch=On: reads in the background the ranges of m_PrefetchPlans
+     * at the next step */
+    void StartPrefetch();
+
+    /** waits for the background prefetch, its ranges are kept only if they
+     * belong to the current step */
+    void WaitPrefetch();
+
+    /** prefetched data of a whole range, nullptr if not prefetched */
+    const char *GetPrefetchData(const ReadRange &range) const noexcept;
+
 #define declare_type(T)                                                        \
     std::map<size_t, std::vector<typename Variable<T>::Info>>                  \
     DoAllStepsBlocksInfo(const Variable<T> &variable) const final;             \
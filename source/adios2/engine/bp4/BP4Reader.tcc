@@ -13,6 +13,11 @@
 
 #include "BP4Reader.h"
 
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <iterator> //std::next
+#include <stdexcept>
+/// \endcond
+
 #include "adios2/helper/adiosFunctions.h"
 
 namespace adios2
@@ -57,18 +62,30 @@ void BP4Reader::GetDeferredCommon(Variable<T> &variable, T *data)
 
     // returns immediately without populating data
     m_BP4Deserializer.InitVariableBlockInfo(variable, data);
-    m_BP4Deserializer.m_DeferredVariables.insert(variable.m_Name);
+    m_BP4Deserializer.AddDeferredVariable(variable);
 }
 
 template <class T>
 void BP4Reader::ReadVariableBlocks(Variable<T> &variable)
 {
-    const bool profile = m_BP4Deserializer.m_Profiler.IsActive;
+    PlanVariableBlocks(variable);
+    PerformReads();
+}
 
+template <class T>
+void BP4Reader::PlanVariableBlocks(Variable<T> &variable)
+{
     for (typename Variable<T>::Info &blockInfo : variable.m_BlocksInfo)
     {
+        AddPrefetchPlan(variable, blockInfo);
+
         T *originalBlockData = blockInfo.Data;
 
+        const Dims blockStart = (variable.m_ShapeID == ShapeID::LocalArray &&
+                                 blockInfo.Start.empty())
+                                    ? Dims(blockInfo.Count.size(), 0)
+                                    : blockInfo.Start;
+
         for (const auto &stepPair : blockInfo.StepBlockSubStreamsInfo)
         {
             for (const helper::SubStreamBoxInfo &subStreamBoxInfo :
@@ -79,20 +96,36 @@ void BP4Reader::ReadVariableBlocks(Variable<T> &variable)
                     continue;
                 }
 
-                // check if subfile is already opened
-                if (m_SubFileManager.m_Transports.count(
-                        subStreamBoxInfo.SubStreamID) == 0)
+                if (subStreamBoxInfo.OperationsInfo.empty())
                 {
-                    const std::string subFileName =
-                        m_BP4Deserializer.GetBPSubFileName(
-                            m_Name, subStreamBoxInfo.SubStreamID,
-                            m_BP4Deserializer.m_Minifooter.HasSubFiles);
-
-                    m_SubFileManager.OpenFileID(
-                        subFileName, subStreamBoxInfo.SubStreamID, Mode::Read,
-                        {{"transport", "File"}}, profile);
+                    // copies, the request outlives variable.m_BlocksInfo
+                    ReadRequest request;
+                    request.SubStreamID = subStreamBoxInfo.SubStreamID;
+                    request.Offset = subStreamBoxInfo.Seeks.first;
+                    request.Size = subStreamBoxInfo.Seeks.second -
+                                   subStreamBoxInfo.Seeks.first;
+
+                    T *data = blockInfo.Data;
+                    const Dims blockCount = blockInfo.Count;
+                    const Box<Dims> blockBox = subStreamBoxInfo.BlockBox;
+                    const Box<Dims> intersectionBox =
+                        subStreamBoxInfo.IntersectionBox;
+
+                    request.Clip = [this, data, blockStart, blockCount,
+                                    blockBox,
+                                    intersectionBox](const char *payload) {
+                        m_BP4Deserializer.ClipRawPayload(
+                            data, blockStart, blockCount, payload, blockBox,
+                            intersectionBox);
+                    };
+
+                    m_ReadRequests.push_back(std::move(request));
+                    continue;
                 }
 
+                // operations (e.g. compression) are read one block at a time
+                OpenSubFile(subStreamBoxInfo.SubStreamID);
+
                 char *buffer = nullptr;
                 size_t payloadSize = 0, payloadStart = 0;
 
@@ -114,6 +147,87 @@ void BP4Reader::ReadVariableBlocks(Variable<T> &variable)
     } // deferred blocks loop
 }
 
+template <class T>
+void BP4Reader::AddPrefetchPlan(const Variable<T> &variable,
+                                const typename Variable<T>::Info &blockInfo)
+{
+    if (!m_BP4Deserializer.m_Prefetch || !m_IO.m_ReadStreaming ||
+        variable.m_RandomAccess)
+    {
+        return;
+    }
+
+    // the next BeginStep advances the steps selection by one
+    typename Variable<T>::Info info;
+    info.Shape = blockInfo.Shape;
+    info.Start = blockInfo.Start;
+    info.Count = blockInfo.Count;
+    info.StepsStart = blockInfo.StepsStart + 1;
+    info.StepsCount = blockInfo.StepsCount;
+    info.BlockID = blockInfo.BlockID;
+    info.Selection = blockInfo.Selection;
+
+    const std::string name = variable.m_Name;
+
+    m_PrefetchPlans.push_back([this, name,
+                               info](std::vector<ReadRequest> &requests) {
+        Variable<T> *nextVariable = m_IO.InquireVariable<T>(name);
+        if (nextVariable == nullptr)
+        {
+            return;
+        }
+
+        const auto &indices = nextVariable->m_AvailableStepBlockIndexOffsets;
+        if (info.StepsStart + info.StepsCount > indices.size())
+        {
+            return;
+        }
+
+        if (nextVariable->m_ShapeID == ShapeID::LocalArray)
+        {
+            auto itStep = std::next(indices.begin(), info.StepsStart);
+            for (size_t i = 0; i < info.StepsCount; ++i, ++itStep)
+            {
+                if (info.BlockID >= itStep->second.size())
+                {
+                    return;
+                }
+            }
+        }
+
+        typename Variable<T>::Info nextInfo = info;
+        try
+        {
+            m_BP4Deserializer.SetVariableBlockInfo(*nextVariable, nextInfo);
+        }
+        catch (std::invalid_argument &)
+        {
+            // selection doesn't fit the next step, nothing to prefetch
+            return;
+        }
+
+        for (const auto &stepPair : nextInfo.StepBlockSubStreamsInfo)
+        {
+            for (const helper::SubStreamBoxInfo &subStreamBoxInfo :
+                 stepPair.second)
+            {
+                if (subStreamBoxInfo.ZeroBlock ||
+                    !subStreamBoxInfo.OperationsInfo.empty())
+                {
+                    continue;
+                }
+
+                ReadRequest request;
+                request.SubStreamID = subStreamBoxInfo.SubStreamID;
+                request.Offset = subStreamBoxInfo.Seeks.first;
+                request.Size = subStreamBoxInfo.Seeks.second -
+                               subStreamBoxInfo.Seeks.first;
+                requests.push_back(std::move(request));
+            }
+        }
+    });
+}
+
 } // end namespace engine
 } // end namespace core
 } // end namespace adios2
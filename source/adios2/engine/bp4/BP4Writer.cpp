@@ -11,10 +11,15 @@
 #include "BP4Writer.h"
 #include "BP4Writer.tcc"
 
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <algorithm> //std::fill, std::min
+/// \endcond
+
 #include "adios2/ADIOSMPI.h"
 #include "adios2/ADIOSMacros.h"
 #include "adios2/core/IO.h"
-#include "adios2/helper/adiosFunctions.h" //CheckIndexRange
+#include "adios2/helper/adiosFunctions.h"  //CheckIndexRange
+#include "adios2/helper/adiosThreadPool.h" //helper::GetThreadPool
 #include "adios2/toolkit/profiling/taustubs/tautimer.hpp"
 #include "adios2/toolkit/transport/file/FileFStream.h"
 
@@ -39,12 +44,12 @@ BP4Writer::BP4Writer(IO &io, const std::string &name, const Mode mode,
     Init();
 }
 
-BP4Writer::~BP4Writer() = default;
+BP4Writer::~BP4Writer() { AsyncStop(); }
 
 StepStatus BP4Writer::BeginStep(StepMode mode, const float timeoutSeconds)
 {
     TAU_SCOPED_TIMER("BP4Writer::BeginStep");
-    m_BP4Serializer.m_DeferredVariables.clear();
+    m_BP4Serializer.ClearDeferredVariables();
     m_BP4Serializer.m_DeferredVariablesDataSize = 0;
     m_IO.m_ReadStreaming = false;
     return StepStatus::OK;
@@ -58,53 +63,31 @@ size_t BP4Writer::CurrentStep() const
 void BP4Writer::PerformPuts()
 {
     TAU_SCOPED_TIMER("BP4Writer::PerformPuts");
-    if (m_BP4Serializer.m_DeferredVariables.empty())
-    {
-        return;
-    }
-
-    m_BP4Serializer.ResizeBuffer(m_BP4Serializer.m_DeferredVariablesDataSize,
-                                 "in call to PerformPuts");
-
-    for (const std::string &variableName : m_BP4Serializer.m_DeferredVariables)
-    {
-        const std::string type = m_IO.InquireVariableType(variableName);
-        if (type == "compound")
-        {
-            // not supported
-        }
-#define declare_template_instantiation(T)                                      \
-    else if (type == helper::GetType<T>())                                     \
-    {                                                                          \
-        Variable<T> &variable = FindVariable<T>(                               \
-            variableName, "in call to PerformPuts, EndStep or Close");         \
-                                                                               \
-        for (const auto &blockInfo : variable.m_BlocksInfo)                    \
-        {                                                                      \
-            PutSyncCommon(variable, blockInfo);                                \
-        }                                                                      \
-        variable.m_BlocksInfo.clear();                                         \
-    }
-
-        ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
-#undef declare_template_instantiation
-    }
-    m_BP4Serializer.m_DeferredVariables.clear();
+    PerformDeferredPuts(false);
 }
 
 void BP4Writer::EndStep()
 {
     TAU_SCOPED_TIMER("BP4Writer::EndStep");
+    const size_t flushStepsCount = m_BP4Serializer.m_FlushStepsCount;
+
     if (m_BP4Serializer.m_DeferredVariables.size() > 0)
     {
-        PerformPuts();
+        // payloads can stay in application memory only if this EndStep
+        // writes them synchronously
+        const bool referenceData =
+            m_BP4Serializer.m_ZeroCopyThreshold > 0 &&
+            !m_BP4Serializer.m_AsyncWrite &&
+            !m_BP4Serializer.m_Aggregator->m_IsActive &&
+            (CurrentStep() + 1) % flushStepsCount == 0;
+
+        PerformDeferredPuts(referenceData);
     }
 
     // true: advances step
     m_BP4Serializer.SerializeData(m_IO, true);
 
     const size_t currentStep = CurrentStep();
-    const size_t flushStepsCount = m_BP4Serializer.m_FlushStepsCount;
 
     if (currentStep % flushStepsCount == 0)
     {
@@ -124,19 +107,156 @@ void BP4Writer::Flush(const int transportIndex)
     }
 }
 
+void BP4Writer::NotifyRemoveVariable(const VariableBase &variable) noexcept
+{
+    m_BP4Serializer.RemoveDeferredVariable(variable);
+}
+
+void BP4Writer::NotifyRemoveAllVariables() noexcept
+{
+    m_BP4Serializer.ClearDeferredVariables();
+}
+
 // PRIVATE
+void BP4Writer::PerformDeferredPuts(const bool referenceData)
+{
+    if (m_BP4Serializer.m_DeferredVariables.empty())
+    {
+        return;
+    }
+
+    // referenced or chunked payloads don't need room in the buffer,
+    // PutSyncCommon resizes for the rest
+    if (!referenceData && !UseBufferChunks())
+    {
+        m_BP4Serializer.ResizeBuffer(
+            m_BP4Serializer.m_DeferredVariablesDataSize,
+            "in call to PerformPuts");
+    }
+
+    // multithreaded: statistics of all blocks are computed concurrently,
+    // then blocks are serialized in order, which keeps the variable index
+    // deterministic, while their payload copies are only reserved and run
+    // concurrently at the end
+    // span blocks are already in the buffer and can't be flushed before
+    // their min/max are set
+    for (VariableBase *variableBase : m_BP4Serializer.m_DeferredVariables)
+    {
+        switch (variableBase->m_DataType)
+        {
+#define declare_type(T)                                                        \
+    case helper::GetDataType<T>():                                             \
+    {                                                                          \
+        PutSpansMetadata(*static_cast<Variable<T> *>(variableBase));           \
+        break;                                                                 \
+    }
+
+            ADIOS2_FOREACH_PRIMITIVE_STDTYPE_1ARG(declare_type)
+#undef declare_type
+        default:
+            // strings and compound don't have spans
+            break;
+        }
+    }
+
+    const unsigned int threads = m_BP4Serializer.GetThreads();
+    std::vector<std::function<void(const unsigned int)>> statsTasks;
+    std::vector<std::function<void()>> putTasks;
+
+    for (VariableBase *variableBase : m_BP4Serializer.m_DeferredVariables)
+    {
+        switch (variableBase->m_DataType)
+        {
+#define declare_template_instantiation(T)                                      \
+    case helper::GetDataType<T>():                                             \
+    {                                                                          \
+        Variable<T> &variable = *static_cast<Variable<T> *>(variableBase);     \
+                                                                               \
+        if (threads > 1)                                                       \
+        {                                                                      \
+            StageDeferredPuts(variable, referenceData, statsTasks, putTasks);  \
+            break;                                                             \
+        }                                                                      \
+                                                                               \
+        for (const auto &blockInfo : variable.m_BlocksInfo)                    \
+        {                                                                      \
+            PutSyncCommon(variable, blockInfo, referenceData);                 \
+        }                                                                      \
+        variable.m_BlocksInfo.clear();                                         \
+        break;                                                                 \
+    }
+
+            ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
+#undef declare_template_instantiation
+        default:
+            // compound not supported
+            break;
+        }
+    }
+
+    if (!putTasks.empty())
+    {
+        // threads go to the blocks if there are enough of them, otherwise
+        // to the min/max of each block
+        if (statsTasks.size() >= threads)
+        {
+            helper::GetThreadPool().ParallelFor(
+                statsTasks.size(), threads,
+                [&](const size_t i) { statsTasks[i](1); });
+        }
+        else
+        {
+            for (auto &statsTask : statsTasks)
+            {
+                statsTask(threads);
+            }
+        }
+
+        m_BP4Serializer.m_DeferPayloadCopies = true;
+        for (auto &putTask : putTasks)
+        {
+            putTask();
+        }
+        m_BP4Serializer.m_DeferPayloadCopies = false;
+        m_BP4Serializer.PerformPayloadCopies();
+    }
+
+    m_BP4Serializer.ClearDeferredVariables();
+}
+
+bool BP4Writer::UseBufferChunks() const noexcept
+{
+    return m_BP4Serializer.m_BufferChunkSize > 0 &&
+           !m_BP4Serializer.m_AsyncWrite &&
+           !m_BP4Serializer.m_Aggregator->m_IsActive;
+}
+
 void BP4Writer::Init()
 {
     InitParameters();
     InitTransports();
     InitBPBuffer();
+    InitAsyncWrite();
 }
 
+#define declare_type(T)                                                        \
+    void BP4Writer::DoPut(Variable<T> &variable,                               \
+                          typename Variable<T>::Span &span,                    \
+                          const size_t bufferID, const T &value)               \
+    {                                                                          \
+        TAU_SCOPED_TIMER("BP4Writer::Put");                                    \
+        PutCommon(variable, span, bufferID, value);                            \
+    }
+
+ADIOS2_FOREACH_PRIMITIVE_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
 #define declare_type(T)                                                        \
     void BP4Writer::DoPutSync(Variable<T> &variable, const T *data)            \
     {                                                                          \
         PutSyncCommon(variable, variable.SetBlockInfo(data, CurrentStep()));   \
-        variable.m_BlocksInfo.clear();                                         \
+        /* keeps deferred and span blocks */                                   \
+        variable.m_BlocksInfo.pop_back();                                      \
     }                                                                          \
     void BP4Writer::DoPutDeferred(Variable<T> &variable, const T *data)        \
     {                                                                          \
@@ -164,7 +284,7 @@ void BP4Writer::InitTransports()
     // only consumers will interact with transport managers
     std::vector<std::string> bpSubStreamNames;
 
-    if (m_BP4Serializer.m_Aggregator.m_IsConsumer)
+    if (m_BP4Serializer.m_Aggregator->m_IsConsumer)
     {
         // Names passed to IO AddTransport option with key "Name"
         const std::vector<std::string> transportsNames =
@@ -180,7 +300,7 @@ void BP4Writer::InitTransports()
                                     m_BP4Serializer.m_NodeLocal);
     m_BP4Serializer.ProfilerStop("mkdir");
 
-    if (m_BP4Serializer.m_Aggregator.m_IsConsumer)
+    if (m_BP4Serializer.m_Aggregator->m_IsConsumer)
     {
         m_FileDataManager.OpenFiles(bpSubStreamNames, m_OpenMode,
                                     m_IO.m_TransportsParameters,
@@ -227,7 +347,7 @@ void BP4Writer::InitBPBuffer()
 
 void BP4Writer::DoFlush(const bool isFinal, const int transportIndex)
 {
-    if (m_BP4Serializer.m_Aggregator.m_IsActive)
+    if (m_BP4Serializer.m_Aggregator->m_IsActive)
     {
         AggregateWriteData(isFinal, transportIndex);
     }
@@ -254,8 +374,10 @@ void BP4Writer::DoClose(const int transportIndex)
     }
 
     DoFlush(true, transportIndex);
+    // queued data must reach the files before they are closed
+    AsyncWait();
 
-    if (m_BP4Serializer.m_Aggregator.m_IsConsumer)
+    if (m_BP4Serializer.m_Aggregator->m_IsConsumer)
     {
         m_FileDataManager.CloseFiles(transportIndex);
     }
@@ -265,6 +387,7 @@ void BP4Writer::DoClose(const int transportIndex)
     {
         WriteCollectiveMetadataFile(true);
     }
+    AsyncWait();
 
     if (m_BP4Serializer.m_Profiler.IsActive &&
         m_FileDataManager.AllTransportsClosed())
@@ -272,19 +395,30 @@ void BP4Writer::DoClose(const int transportIndex)
         // std::cout << "write profiling file!" << std::endl;
         WriteProfilingJSONFile();
     }
-    if (m_BP4Serializer.m_Aggregator.m_IsActive)
+    if (m_BP4Serializer.m_Aggregator->m_IsActive)
     {
-        m_BP4Serializer.m_Aggregator.Close();
+        m_BP4Serializer.m_Aggregator->Close();
     }
 
     if (m_BP4Serializer.m_RankMPI == 0)
     {
+        if (m_BP4Serializer.m_MetadataSet.metadataFileLength > 0)
+        {
+            // the md.idx header exists, tell stream readers no more steps
+            // are coming
+            const char activeFlag = 0;
+            m_FileMetadataIndexManager.WriteFileAt(
+                &activeFlag, 1, m_BP4Serializer.m_ActiveFlagPosition);
+        }
+
         // close metadata file
         m_FileMetadataManager.CloseFiles();
 
         // close metadata index file
         m_FileMetadataIndexManager.CloseFiles();
     }
+
+    AsyncStop();
 }
 
 void BP4Writer::WriteProfilingJSONFile()
@@ -372,6 +506,10 @@ void BP4Writer::PopulateMetadataIndexFileHeader(std::vector<char> &buffer,
         helper::CopyToBuffer(buffer, position, &zeros2);
     }
     helper::CopyToBuffer(buffer, position, &version);
+
+    // readers following the file keep polling while this flag is set, it is
+    // cleared at Close
+    buffer[m_BP4Serializer.m_ActiveFlagPosition] = 1;
     position += 16;
 }
 
@@ -424,10 +562,9 @@ void BP4Writer::WriteCollectiveMetadataFile(const bool isFinal)
         //     m_IO.m_TransportsParameters,
         //     m_BP4Serializer.m_Profiler.IsActive);
 
-        m_FileMetadataManager.WriteFiles(
-            m_BP4Serializer.m_Metadata.m_Buffer.data(),
-            m_BP4Serializer.m_Metadata.m_Position);
-        m_FileMetadataManager.FlushFiles();
+        WriteFiles(m_FileMetadataManager,
+                   m_BP4Serializer.m_Metadata.m_Buffer.data(),
+                   m_BP4Serializer.m_Metadata.m_Position);
 
         /*record the starting position of indices in metadata file*/
         const uint64_t pgIndexStartMetadataFile =
@@ -479,8 +616,8 @@ void BP4Writer::WriteCollectiveMetadataFile(const bool isFinal)
         {
             PopulateMetadataIndexFileHeader(metadataIndex.m_Buffer,
                                             metadataIndex.m_Position, 4, true);
-            m_FileMetadataIndexManager.WriteFiles(metadataIndex.m_Buffer.data(),
-                                                  metadataIndex.m_Position);
+            WriteFiles(m_FileMetadataIndexManager,
+                       metadataIndex.m_Buffer.data(), metadataIndex.m_Position);
 
             metadataIndex.m_Buffer.resize(48);
             metadataIndex.m_Buffer.assign(metadataIndex.m_Buffer.size(), '\0');
@@ -493,9 +630,8 @@ void BP4Writer::WriteCollectiveMetadataFile(const bool isFinal)
             currentStepEndPos, metadataIndex.m_Buffer,
             metadataIndex.m_Position);
 
-        m_FileMetadataIndexManager.WriteFiles(metadataIndex.m_Buffer.data(),
-                                              metadataIndex.m_Position);
-        m_FileMetadataIndexManager.FlushFiles();
+        WriteFiles(m_FileMetadataIndexManager, metadataIndex.m_Buffer.data(),
+                   metadataIndex.m_Position);
 
         m_BP4Serializer.m_MetadataSet.metadataFileLength +=
             m_BP4Serializer.m_Metadata.m_Position;
@@ -528,8 +664,45 @@ void BP4Writer::WriteData(const bool isFinal, const int transportIndex)
         m_BP4Serializer.CloseStream(m_IO);
     }
 
-    m_FileDataManager.WriteFiles(m_BP4Serializer.m_Data.m_Buffer.data(),
-                                 dataSize, transportIndex);
+    if (m_BP4Serializer.m_AsyncWrite)
+    {
+        // hand the filled buffer to the drain thread and keep serializing
+        // into a recycled one
+        AsyncWriteTask task;
+        task.Manager = &m_FileDataManager;
+        task.Size = dataSize;
+        task.TransportIndex = transportIndex;
+        task.Recycle = true;
+        task.Used = m_BP4Serializer.m_Data.m_Position;
+        {
+            std::lock_guard<std::mutex> lock(m_AsyncMutex);
+            if (!m_AsyncFreeBuffers.empty())
+            {
+                task.Buffer = std::move(m_AsyncFreeBuffers.back());
+                m_AsyncFreeBuffers.pop_back();
+            }
+        }
+
+        std::vector<char> &data = m_BP4Serializer.m_Data.m_Buffer;
+        task.Buffer.resize(data.size());
+        task.Buffer.swap(data);
+        AsyncEnqueue(std::move(task));
+        return;
+    }
+
+    if (!m_BP4Serializer.m_Data.m_References.empty())
+    {
+        // payloads in chunks or application memory go in place
+        const std::vector<core::iovec> dataV =
+            m_BP4Serializer.m_Data.GetDataV(dataSize);
+        m_FileDataManager.WriteFiles(dataV.data(), dataV.size(),
+                                     transportIndex);
+    }
+    else
+    {
+        m_FileDataManager.WriteFiles(m_BP4Serializer.m_Data.m_Buffer.data(),
+                                     dataSize, transportIndex);
+    }
 
     m_FileDataManager.FlushFiles(transportIndex);
 }
@@ -539,20 +712,22 @@ void BP4Writer::AggregateWriteData(const bool isFinal, const int transportIndex)
     TAU_SCOPED_TIMER("BP4Writer::AggregateWriteData");
     m_BP4Serializer.CloseStream(m_IO, false);
 
-    // async?
-    for (int r = 0; r < m_BP4Serializer.m_Aggregator.m_Size; ++r)
+    // each round the consumer writes one buffer while the aggregator keeps
+    // moving data for the next rounds
+    const int rounds = m_BP4Serializer.m_Aggregator->GetRounds();
+    for (int r = 0; r < rounds; ++r)
     {
         std::vector<std::vector<MPI_Request>> dataRequests =
-            m_BP4Serializer.m_Aggregator.IExchange(m_BP4Serializer.m_Data, r);
+            m_BP4Serializer.m_Aggregator->IExchange(m_BP4Serializer.m_Data, r);
 
         std::vector<std::vector<MPI_Request>> absolutePositionRequests =
-            m_BP4Serializer.m_Aggregator.IExchangeAbsolutePosition(
+            m_BP4Serializer.m_Aggregator->IExchangeAbsolutePosition(
                 m_BP4Serializer.m_Data, r);
 
-        if (m_BP4Serializer.m_Aggregator.m_IsConsumer)
+        if (m_BP4Serializer.m_Aggregator->m_IsConsumer)
         {
             const BufferSTL &bufferSTL =
-                m_BP4Serializer.m_Aggregator.GetConsumerBuffer(
+                m_BP4Serializer.m_Aggregator->GetConsumerBuffer(
                     m_BP4Serializer.m_Data);
 
             m_FileDataManager.WriteFiles(bufferSTL.m_Buffer.data(),
@@ -561,11 +736,11 @@ void BP4Writer::AggregateWriteData(const bool isFinal, const int transportIndex)
             m_FileDataManager.FlushFiles(transportIndex);
         }
 
-        m_BP4Serializer.m_Aggregator.WaitAbsolutePosition(
+        m_BP4Serializer.m_Aggregator->WaitAbsolutePosition(
             absolutePositionRequests, r);
 
-        m_BP4Serializer.m_Aggregator.Wait(dataRequests, r);
-        m_BP4Serializer.m_Aggregator.SwapBuffers(r);
+        m_BP4Serializer.m_Aggregator->Wait(dataRequests, r);
+        m_BP4Serializer.m_Aggregator->SwapBuffers(r);
     }
 
     m_BP4Serializer.UpdateOffsetsInMetadata();
@@ -576,21 +751,171 @@ void BP4Writer::AggregateWriteData(const bool isFinal, const int transportIndex)
         m_BP4Serializer.ResetBuffer(bufferSTL, false, false);
 
         m_BP4Serializer.AggregateCollectiveMetadata(
-            m_BP4Serializer.m_Aggregator.m_Comm, bufferSTL, false);
+            m_BP4Serializer.m_Aggregator->m_Comm, bufferSTL, false);
 
-        if (m_BP4Serializer.m_Aggregator.m_IsConsumer)
+        if (m_BP4Serializer.m_Aggregator->m_IsConsumer)
         {
             m_FileDataManager.WriteFiles(bufferSTL.m_Buffer.data(),
                                          bufferSTL.m_Position, transportIndex);
 
             m_FileDataManager.FlushFiles(transportIndex);
         }
-        m_BP4Serializer.m_Aggregator.Close();
+        m_BP4Serializer.m_Aggregator->Close();
+    }
+
+    m_BP4Serializer.m_Aggregator->ResetBuffers();
+}
+
+void BP4Writer::WriteFiles(transportman::TransportMan &manager,
+                           const char *buffer, const size_t size,
+                           const int transportIndex)
+{
+    if (!m_BP4Serializer.m_AsyncWrite)
+    {
+        manager.WriteFiles(buffer, size, transportIndex);
+        manager.FlushFiles(transportIndex);
+        return;
     }
 
-    m_BP4Serializer.m_Aggregator.ResetBuffers();
+    AsyncWriteTask task;
+    task.Manager = &manager;
+    task.Buffer.assign(buffer, buffer + size);
+    task.Size = size;
+    task.TransportIndex = transportIndex;
+    AsyncEnqueue(std::move(task));
+}
+
+void BP4Writer::InitAsyncWrite()
+{
+    if (m_BP4Serializer.m_AsyncWrite)
+    {
+        m_AsyncThread = std::thread(&BP4Writer::AsyncDrain, this);
+    }
 }
 
+void BP4Writer::AsyncEnqueue(AsyncWriteTask &&task)
+{
+    TAU_SCOPED_TIMER("BP4Writer::AsyncEnqueue");
+    std::unique_lock<std::mutex> lock(m_AsyncMutex);
+    // back-pressure: wait for the drain to catch up
+    m_AsyncCV.wait(lock, [&] {
+        const size_t inFlight = m_AsyncQueue.size() + (m_AsyncBusy ? 1 : 0);
+        return inFlight < m_BP4Serializer.m_AsyncQueueLimit ||
+               m_AsyncException;
+    });
+
+    if (m_AsyncException)
+    {
+        std::exception_ptr exception = m_AsyncException;
+        m_AsyncException = nullptr;
+        std::rethrow_exception(exception);
+    }
+
+    m_AsyncQueue.push_back(std::move(task));
+    lock.unlock();
+    m_AsyncCV.notify_all();
+}
+
+void BP4Writer::AsyncWait()
+{
+    if (!m_AsyncThread.joinable())
+    {
+        return;
+    }
+
+    TAU_SCOPED_TIMER("BP4Writer::AsyncWait");
+    std::unique_lock<std::mutex> lock(m_AsyncMutex);
+    m_AsyncCV.wait(lock, [&] {
+        return (m_AsyncQueue.empty() && !m_AsyncBusy) || m_AsyncException;
+    });
+
+    if (m_AsyncException)
+    {
+        std::exception_ptr exception = m_AsyncException;
+        m_AsyncException = nullptr;
+        std::rethrow_exception(exception);
+    }
+}
+
+void BP4Writer::AsyncStop() noexcept
+{
+    if (!m_AsyncThread.joinable())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_AsyncMutex);
+        m_AsyncStop = true;
+    }
+    m_AsyncCV.notify_all();
+    m_AsyncThread.join();
+    m_AsyncFreeBuffers.clear();
+}
+
+void BP4Writer::AsyncDrain()
+{
+    while (true)
+    {
+        AsyncWriteTask task;
+        {
+            std::unique_lock<std::mutex> lock(m_AsyncMutex);
+            m_AsyncCV.wait(lock,
+                           [&] { return !m_AsyncQueue.empty() || m_AsyncStop; });
+
+            // stop is only honored once everything queued is written
+            if (m_AsyncQueue.empty())
+            {
+                return;
+            }
+
+            task = std::move(m_AsyncQueue.front());
+            m_AsyncQueue.pop_front();
+            m_AsyncBusy = true;
+        }
+
+        try
+        {
+            task.Manager->WriteFiles(task.Buffer.data(), task.Size,
+                                     task.TransportIndex);
+            task.Manager->FlushFiles(task.TransportIndex);
+
+            if (task.Recycle)
+            {
+                std::fill(task.Buffer.begin(),
+                          task.Buffer.begin() +
+                              std::min(task.Used, task.Buffer.size()),
+                          '\0');
+            }
+
+            std::lock_guard<std::mutex> lock(m_AsyncMutex);
+            if (task.Recycle)
+            {
+                m_AsyncFreeBuffers.push_back(std::move(task.Buffer));
+            }
+            m_AsyncBusy = false;
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(m_AsyncMutex);
+            m_AsyncException = std::current_exception();
+            m_AsyncQueue.clear();
+            m_AsyncBusy = false;
+        }
+        m_AsyncCV.notify_all();
+    }
+}
+
+#define declare_type(T, L)                                                     \
+    T *BP4Writer::DoBufferData_##L(const size_t payloadPosition,               \
+                                   const size_t bufferID) noexcept             \
+    {                                                                          \
+        return BufferDataCommon<T>(payloadPosition, bufferID);                 \
+    }
+
+ADIOS2_FOREACH_PRIMITVE_STDTYPE_2ARGS(declare_type)
+#undef declare_type
+
 } // end namespace engine
 } // end namespace core
 } // end namespace adios2
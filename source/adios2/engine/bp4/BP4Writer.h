@@ -11,6 +11,16 @@
 #ifndef ADIOS2_ENGINE_BP4_BP4WRITER_H_
 #define ADIOS2_ENGINE_BP4_BP4WRITER_H_
 
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <condition_variable>
+#include <deque>
+#include <exception>  //std::exception_ptr
+#include <functional> //std::function
+#include <mutex>
+#include <thread>
+#include <vector>
+/// \endcond
+
 #include "adios2/ADIOSConfig.h"
 #include "adios2/core/Engine.h"
 #include "adios2/toolkit/format/bp4/BP4.h"
@@ -44,6 +54,8 @@ public:
     void PerformPuts() final;
     void EndStep() final;
     void Flush(const int transportIndex = -1) final;
+    void NotifyRemoveVariable(const VariableBase &variable) noexcept final;
+    void NotifyRemoveAllVariables() noexcept final;
 
 private:
     /** Single object controlling BP buffering */
@@ -58,6 +70,34 @@ private:
     /* transport manager for managing the metadata index file */
     transportman::TransportMan m_FileMetadataIndexManager;
 
+    /** Buffer waiting to be written by the background drain thread */
+    struct AsyncWriteTask
+    {
+        transportman::TransportMan *Manager = nullptr;
+        std::vector<char> Buffer;
+        size_t Size = 0;
+        int TransportIndex = -1;
+        /** true: Buffer goes back to m_AsyncFreeBuffers once written */
+        bool Recycle = false;
+        /** bytes cleared before recycling, serialization expects a zeroed
+         * buffer past its position */
+        size_t Used = 0;
+    };
+
+    /** AsyncWrite=On: drains m_AsyncQueue to transports */
+    std::thread m_AsyncThread;
+    std::mutex m_AsyncMutex;
+    std::condition_variable m_AsyncCV;
+    /** FIFO, keeps data and metadata writes in the same order as sync mode */
+    std::deque<AsyncWriteTask> m_AsyncQueue;
+    /** written data buffers reused by the next flush (buffer rotation) */
+    std::vector<std::vector<char>> m_AsyncFreeBuffers;
+    /** true: drain thread is writing a task already popped from the queue */
+    bool m_AsyncBusy = false;
+    bool m_AsyncStop = false;
+    /** first exception thrown in the drain thread, rethrown in this thread */
+    std::exception_ptr m_AsyncException;
+
     void Init() final;
 
     /** Parses parameters from IO SetParameters */
@@ -67,6 +107,13 @@ private:
     /** Allocates memory and starts a PG group */
     void InitBPBuffer();
 
+#define declare_type(T)                                                        \
+    void DoPut(Variable<T> &variable, typename Variable<T>::Span &span,        \
+               const size_t bufferID, const T &value) final;
+
+    ADIOS2_FOREACH_PRIMITIVE_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
 #define declare_type(T)                                                        \
     void DoPutSync(Variable<T> &, const T *) final;                            \
     void DoPutDeferred(Variable<T> &, const T *) final;
@@ -74,14 +121,59 @@ private:
     ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
 #undef declare_type
 
+    /**
+     * Reserves the payload of a block populated by the application in the
+     * data buffer, its min/max are computed in PutSpansMetadata
+     */
+    template <class T>
+    void PutCommon(Variable<T> &variable, typename Variable<T>::Span &span,
+                   const size_t bufferID, const T &value);
+
     /**
      * Common function for primitive PutSync, puts variables in buffer
      * @param variable
      * @param values
      */
     template <class T>
-    void PutSyncCommon(Variable<T> &variable,
-                       const typename Variable<T>::Info &blockInfo);
+    void PutSyncCommon(
+        Variable<T> &variable, const typename Variable<T>::Info &blockInfo,
+        const bool referenceData = false,
+        const format::BP4Serializer::Stats<T> *blockStats = nullptr);
+
+    /**
+     * Serializes deferred variables
+     * @param referenceData true: large contiguous payloads are referenced
+     * in the data buffer instead of copied, only valid if the buffer is
+     * written before returning to the application
+     */
+    void PerformDeferredPuts(const bool referenceData);
+
+    /**
+     * Threads > 1: adds the tasks for the deferred blocks of a variable,
+     * statsTasks are independent and can run concurrently, putTasks serialize
+     * in order and must run after all statsTasks, a stats task is called
+     * with the threads for the min/max of its block
+     */
+    template <class T>
+    void StageDeferredPuts(
+        Variable<T> &variable, const bool referenceData,
+        std::vector<std::function<void(const unsigned int)>> &statsTasks,
+        std::vector<std::function<void()>> &putTasks);
+
+    /**
+     * Puts min/max of the populated span blocks of a variable and removes
+     * them from its deferred blocks, runs before any deferred block can
+     * flush the buffer holding them
+     */
+    template <class T>
+    void PutSpansMetadata(Variable<T> &variable);
+
+    /** smaller payloads are always copied to the buffer */
+    static constexpr size_t MinChunkPayloadSize = 4096;
+
+    /** true: payloads that don't fit in the data buffer can go to chunks,
+     * requires the buffer to be written by WriteData */
+    bool UseBufferChunks() const noexcept;
 
     template <class T>
     void PutDeferredCommon(Variable<T> &variable, const T *data);
@@ -117,6 +209,47 @@ private:
      * @param transportIndex
      */
     void AggregateWriteData(const bool isFinal, const int transportIndex = -1);
+
+    /**
+     * Writes and flushes buffer to manager files, with AsyncWrite=On buffer
+     * is copied and queued for the background drain thread
+     * @param manager target files
+     * @param buffer
+     * @param size
+     * @param transportIndex
+     */
+    void WriteFiles(transportman::TransportMan &manager, const char *buffer,
+                    const size_t size, const int transportIndex = -1);
+
+    /** Starts the background drain thread if AsyncWrite=On */
+    void InitAsyncWrite();
+
+    /**
+     * Queues a task for the drain thread, blocks while the queue holds
+     * AsyncQueueLimit tasks
+     * @param task
+     */
+    void AsyncEnqueue(AsyncWriteTask &&task);
+
+    /** Blocks until all queued tasks are written, rethrows drain errors */
+    void AsyncWait();
+
+    /** Drains remaining tasks and joins the drain thread */
+    void AsyncStop() noexcept;
+
+    /** Drain thread loop */
+    void AsyncDrain();
+
+#define declare_type(T, L)                                                     \
+    T *DoBufferData_##L(const size_t payloadPosition,                          \
+                        const size_t bufferID = 0) noexcept final;
+
+    ADIOS2_FOREACH_PRIMITVE_STDTYPE_2ARGS(declare_type)
+#undef declare_type
+
+    template <class T>
+    T *BufferDataCommon(const size_t payloadOffset,
+                        const size_t bufferID) noexcept;
 };
 
 } // end namespace engine
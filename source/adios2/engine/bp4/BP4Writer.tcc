@@ -12,6 +12,10 @@
 
 #include "BP4Writer.h"
 
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <memory> //std::make_shared
+/// \endcond
+
 namespace adios2
 {
 namespace core
@@ -20,8 +24,9 @@ namespace engine
 {
 
 template <class T>
-void BP4Writer::PutSyncCommon(Variable<T> &variable,
-                              const typename Variable<T>::Info &blockInfo)
+void BP4Writer::PutCommon(Variable<T> &variable,
+                          typename Variable<T>::Span &span,
+                          const size_t /*bufferID*/, const T &value)
 {
     // if first timestep Write create a new pg index
     if (!m_BP4Serializer.m_MetadataSet.DataPGIsOpen)
@@ -30,6 +35,17 @@ void BP4Writer::PutSyncCommon(Variable<T> &variable,
             m_IO.m_Name, m_IO.m_HostLanguage,
             m_FileDataManager.GetTransportsTypes());
     }
+    const typename Variable<T>::Info blockInfo =
+        variable.SetBlockInfo(nullptr, CurrentStep());
+    m_BP4Serializer.AddDeferredVariable(variable);
+
+    if (m_DebugMode && !blockInfo.Operations.empty())
+    {
+        throw std::invalid_argument(
+            "ERROR: returning a Span of variable " + variable.m_Name +
+            " with operations is not supported in BP4 engine, in call to "
+            "Put\n");
+    }
 
     const size_t dataSize =
         helper::PayloadSize(blockInfo.Data, blockInfo.Count) +
@@ -39,8 +55,87 @@ void BP4Writer::PutSyncCommon(Variable<T> &variable,
         m_BP4Serializer.ResizeBuffer(dataSize, "in call to variable " +
                                                    variable.m_Name + " Put");
 
+    if (m_DebugMode && resizeResult == format::BP4Base::ResizeResult::Flush)
+    {
+        throw std::invalid_argument(
+            "ERROR: returning a Span can't trigger "
+            "buffer reallocation in BP4 engine, remove "
+            "MaxBufferSize parameter, in call to Put\n");
+    }
+
+    // WRITE INDEX to data buffer and metadata structure (in memory)//
+    const bool sourceRowMajor = helper::IsRowMajor(m_IO.m_HostLanguage);
+    m_BP4Serializer.PutVariableMetadata<T>(variable, blockInfo, sourceRowMajor,
+                                           nullptr, &span);
+    span.m_Value = value;
+    m_BP4Serializer.PutVariablePayload(variable, blockInfo, sourceRowMajor,
+                                       format::BP4Serializer::PayloadMode::Copy,
+                                       &span);
+}
+
+template <class T>
+void BP4Writer::PutSyncCommon(
+    Variable<T> &variable, const typename Variable<T>::Info &blockInfo,
+    const bool referenceData,
+    const format::BP4Serializer::Stats<T> *blockStats)
+{
+    // if first timestep Write create a new pg index
+    if (!m_BP4Serializer.m_MetadataSet.DataPGIsOpen)
+    {
+        m_BP4Serializer.PutProcessGroupIndex(
+            m_IO.m_Name, m_IO.m_HostLanguage,
+            m_FileDataManager.GetTransportsTypes());
+    }
+
+    using PayloadMode = format::BP4Serializer::PayloadMode;
+    const BufferSTL &data = m_BP4Serializer.m_Data;
+
+    const size_t payloadSize =
+        helper::PayloadSize(blockInfo.Data, blockInfo.Count);
+    const size_t indexSize =
+        m_BP4Serializer.GetBPIndexSizeInData(variable.m_Name, blockInfo.Count);
+
+    // only contiguous payloads written as they are can be out of m_Data
+    const bool isContiguous = !std::is_same<T, std::string>::value &&
+                              blockInfo.Data != nullptr &&
+                              blockInfo.Operations.empty() &&
+                              blockInfo.MemoryStart.empty();
+
+    PayloadMode payloadMode = PayloadMode::Copy;
+    if (isContiguous && referenceData &&
+        payloadSize >= m_BP4Serializer.m_ZeroCopyThreshold)
+    {
+        payloadMode = PayloadMode::Reference;
+    }
+    else if (isContiguous && UseBufferChunks() &&
+             payloadSize >= MinChunkPayloadSize &&
+             data.m_Position + indexSize + payloadSize > data.m_Buffer.size() &&
+             data.m_Position + data.GetChunksSize() + indexSize +
+                     payloadSize <=
+                 m_BP4Serializer.m_MaxBufferSize)
+    {
+        // a chunk instead of growing m_Data, which copies all its contents
+        payloadMode = PayloadMode::Chunk;
+    }
+
+    const size_t copySize =
+        blockInfo.Operations.empty()
+            ? payloadSize
+            : m_BP4Serializer.GetOperationsPayloadSize(
+                  blockInfo.Operations, payloadSize,
+                  "in call to variable " + variable.m_Name + " Put");
+
+    const size_t dataSize =
+        (payloadMode == PayloadMode::Copy ? copySize : 0) + indexSize;
+
+    const format::BP4Base::ResizeResult resizeResult =
+        m_BP4Serializer.ResizeBuffer(dataSize, "in call to variable " +
+                                                   variable.m_Name + " Put");
+
     if (resizeResult == format::BP4Base::ResizeResult::Flush)
     {
+        // reserved payloads must be in the buffer before it's written
+        m_BP4Serializer.PerformPayloadCopies();
         DoFlush(false);
         m_BP4Serializer.ResetBuffer(m_BP4Serializer.m_Data);
 
@@ -52,8 +147,55 @@ void BP4Writer::PutSyncCommon(Variable<T> &variable,
 
     // WRITE INDEX to data buffer and metadata structure (in memory)//
     const bool sourceRowMajor = helper::IsRowMajor(m_IO.m_HostLanguage);
-    m_BP4Serializer.PutVariableMetadata(variable, blockInfo, sourceRowMajor);
-    m_BP4Serializer.PutVariablePayload(variable, blockInfo, sourceRowMajor);
+    m_BP4Serializer.PutVariableMetadata(variable, blockInfo, sourceRowMajor,
+                                        blockStats);
+    m_BP4Serializer.PutVariablePayload(variable, blockInfo, sourceRowMajor,
+                                       payloadMode);
+}
+
+template <>
+inline void BP4Writer::StageDeferredPuts(
+    Variable<std::string> &variable, const bool referenceData,
+    std::vector<std::function<void(const unsigned int)>> & /*statsTasks*/,
+    std::vector<std::function<void()>> &putTasks)
+{
+    putTasks.push_back([this, &variable, referenceData]() {
+        for (const auto &blockInfo : variable.m_BlocksInfo)
+        {
+            PutSyncCommon(variable, blockInfo, referenceData);
+        }
+        variable.m_BlocksInfo.clear();
+    });
+}
+
+template <class T>
+void BP4Writer::StageDeferredPuts(
+    Variable<T> &variable, const bool referenceData,
+    std::vector<std::function<void(const unsigned int)>> &statsTasks,
+    std::vector<std::function<void()>> &putTasks)
+{
+    const bool sourceRowMajor = helper::IsRowMajor(m_IO.m_HostLanguage);
+
+    for (const auto &blockInfo : variable.m_BlocksInfo)
+    {
+        auto stats = std::make_shared<format::BP4Serializer::Stats<T>>();
+
+        statsTasks.push_back(
+            [this, &variable, &blockInfo, stats,
+             sourceRowMajor](const unsigned int threads) {
+                *stats = m_BP4Serializer.GetBlockStats<T>(
+                    variable.m_SingleValue, blockInfo, sourceRowMajor,
+                    threads);
+            });
+
+        putTasks.push_back([this, &variable, &blockInfo, stats,
+                            referenceData]() {
+            PutSyncCommon(variable, blockInfo, referenceData, stats.get());
+        });
+    }
+
+    // blocks are referenced by the tasks above until they run
+    putTasks.push_back([&variable]() { variable.m_BlocksInfo.clear(); });
 }
 
 template <class T>
@@ -67,13 +209,46 @@ void BP4Writer::PutDeferredCommon(Variable<T> &variable, const T *data)
 
     const typename Variable<T>::Info blockInfo =
         variable.SetBlockInfo(data, CurrentStep());
-    m_BP4Serializer.m_DeferredVariables.insert(variable.m_Name);
+    m_BP4Serializer.AddDeferredVariable(variable);
     m_BP4Serializer.m_DeferredVariablesDataSize += static_cast<size_t>(
         1.05 * helper::PayloadSize(blockInfo.Data, blockInfo.Count) +
         4 * m_BP4Serializer.GetBPIndexSizeInData(variable.m_Name,
                                                  blockInfo.Count));
 }
 
+template <class T>
+void BP4Writer::PutSpansMetadata(Variable<T> &variable)
+{
+    if (variable.m_BlocksSpan.empty())
+    {
+        return;
+    }
+
+    for (const auto &spanPair : variable.m_BlocksSpan)
+    {
+        m_BP4Serializer.PutSpanMetadata(variable, spanPair.second);
+    }
+
+    // span blocks are already serialized, erase from the back to keep the
+    // block ids of the remaining span blocks valid
+    for (auto itSpan = variable.m_BlocksSpan.rbegin();
+         itSpan != variable.m_BlocksSpan.rend(); ++itSpan)
+    {
+        variable.m_BlocksInfo.erase(variable.m_BlocksInfo.begin() +
+                                    itSpan->first);
+    }
+    variable.m_BlocksSpan.clear();
+}
+
+template <class T>
+T *BP4Writer::BufferDataCommon(const size_t payloadPosition,
+                               const size_t /*bufferID*/) noexcept
+{
+    T *data = reinterpret_cast<T *>(m_BP4Serializer.m_Data.m_Buffer.data() +
+                                    payloadPosition);
+    return data;
+}
+
 } // end namespace engine
 } // end namespace core
 } // end namespace adios2
@@ -35,6 +35,8 @@ DataManCommon::DataManCommon(const std::string engineType, IO &io,
         throw(std::invalid_argument(
             "WorkflowMode parameter for DataMan must be File or Stream"));
     }
+    GetStringParameter(m_IO.m_Parameters, "MetadataSerialization",
+                       m_MetadataSerialization);
     m_Channels = m_IO.m_TransportsParameters.size();
     if (m_Channels == 0)
     {
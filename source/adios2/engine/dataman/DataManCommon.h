@@ -41,6 +41,8 @@ protected:
     int m_MpiSize;
     int m_Channels;
     std::string m_WorkflowMode = "stream";
+    // string, msgpack, cbor, ubjson or binary, must match on both ends
+    std::string m_MetadataSerialization = "string";
     size_t m_BufferSize = 1024 * 1024 * 1024;
     bool m_DoMonitor = false;
     int64_t m_CurrentStep = -1;
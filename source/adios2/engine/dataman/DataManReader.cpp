@@ -26,7 +26,7 @@ DataManReader::DataManReader(IO &io, const std::string &name, const Mode mode,
                              MPI_Comm mpiComm)
 : DataManCommon("DataManReader", io, name, mode, mpiComm),
   m_DataManSerializer(m_IsRowMajor, m_ContiguousMajor, m_IsLittleEndian,
-                      mpiComm)
+                      mpiComm, m_MetadataSerialization)
 {
     m_EndMessage = " in call to IO Open DataManReader " + m_Name + "\n";
     Init();
@@ -116,7 +116,8 @@ void DataManWriter::Init()
     {
         m_DataManSerializer.push_back(
             std::make_shared<format::DataManSerializer>(
-                m_IsRowMajor, m_ContiguousMajor, m_IsLittleEndian, m_MPIComm));
+                m_IsRowMajor, m_ContiguousMajor, m_IsLittleEndian, m_MPIComm,
+                m_MetadataSerialization));
     }
 }
 
@@ -59,8 +59,8 @@ void HDF5ReaderP::Init()
             ", in call to Open\n");
     }
 
-    m_H5File.Init(m_Name, m_MPIComm, false);
     m_H5File.ParseParameters(m_IO);
+    m_H5File.Init(m_Name, m_MPIComm, false);
 
     /*
     int ts = m_H5File.GetNumAdiosSteps();
@@ -59,6 +59,9 @@ void HDF5WriterP::Init()
 #ifdef NEVER
     m_H5File.Init(m_Name, m_MPIComm, true);
 #else
+    // file access parameters are applied when the file is created
+    m_H5File.ParseParameters(m_IO);
+
     // enforce .h5 ending
     std::string suffix = ".h5";
     std::string wrongSuffix = ".bp";
@@ -76,7 +79,6 @@ void HDF5WriterP::Init()
     {
         m_H5File.Init(m_Name, m_MPIComm, true);
     }
-    m_H5File.ParseParameters(m_IO);
 #endif
 }
 
@@ -14,6 +14,7 @@
 #include "InSituMPIFunctions.h"
 
 #include <chrono>
+#include <climits>
 #include <fstream>
 #include <iostream>
 #include <thread> // sleep_for
@@ -248,6 +249,92 @@ int ConnectDirectPeers(const MPI_Comm commWorld, const bool IAmSender,
     return retval;
 }
 
+bool FitsSubarrayDatatype(const Box<Dims> &box) noexcept
+{
+    for (size_t d = 0; d < box.first.size(); ++d)
+    {
+        if (box.second[d] - box.first[d] + 1 > static_cast<size_t>(INT_MAX))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+MPI_Request StartPersistentRequest(PersistentRequest &request,
+                                   const void *buffer,
+                                   const Box<Dims> &outerBox,
+                                   const Box<Dims> &innerBox,
+                                   const size_t elementSize,
+                                   const bool isRowMajor, const bool isSend,
+                                   const int peerRank, MPI_Comm comm)
+{
+    if (request.Datatype == MPI_DATATYPE_NULL)
+    {
+        const int ndims = static_cast<int>(outerBox.first.size());
+        std::vector<int> sizes(ndims), subsizes(ndims), starts(ndims);
+        for (int d = 0; d < ndims; ++d)
+        {
+            sizes[d] =
+                static_cast<int>(outerBox.second[d] - outerBox.first[d] + 1);
+            subsizes[d] =
+                static_cast<int>(innerBox.second[d] - innerBox.first[d] + 1);
+            starts[d] = static_cast<int>(innerBox.first[d] - outerBox.first[d]);
+        }
+
+        MPI_Datatype element;
+        MPI_Type_contiguous(static_cast<int>(elementSize), MPI_BYTE, &element);
+        MPI_Type_create_subarray(ndims, sizes.data(), subsizes.data(),
+                                 starts.data(),
+                                 isRowMajor ? MPI_ORDER_C : MPI_ORDER_FORTRAN,
+                                 element, &request.Datatype);
+        MPI_Type_commit(&request.Datatype);
+        MPI_Type_free(&element);
+    }
+
+    if (request.Request == MPI_REQUEST_NULL || request.Buffer != buffer)
+    {
+        if (request.Request != MPI_REQUEST_NULL)
+        {
+            MPI_Request_free(&request.Request);
+        }
+        if (isSend)
+        {
+            MPI_Send_init(buffer, 1, request.Datatype, peerRank, MpiTags::Data,
+                          comm, &request.Request);
+        }
+        else
+        {
+            MPI_Recv_init(const_cast<void *>(buffer), 1, request.Datatype,
+                          peerRank, MpiTags::Data, comm, &request.Request);
+        }
+        request.Buffer = buffer;
+    }
+
+    MPI_Start(&request.Request);
+    return request.Request;
+}
+
+void FreePersistentRequests(PersistentRequestMap &requests)
+{
+    for (auto &variablePair : requests)
+    {
+        for (auto &requestPair : variablePair.second)
+        {
+            PersistentRequest &request = requestPair.second;
+            if (request.Request != MPI_REQUEST_NULL)
+            {
+                MPI_Request_free(&request.Request);
+            }
+            if (request.Datatype != MPI_DATATYPE_NULL)
+            {
+                MPI_Type_free(&request.Datatype);
+            }
+        }
+    }
+    requests.clear();
+}
+
 std::vector<MPI_Status> CompleteRequests(std::vector<MPI_Request> &requests,
                                          const bool IAmWriter,
                                          const int localRank)
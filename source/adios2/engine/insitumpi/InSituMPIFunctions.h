@@ -15,9 +15,13 @@
 
 #include <mpi.h>
 
+#include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "adios2/ADIOSTypes.h"
+
 namespace adios2
 {
 
@@ -43,6 +47,30 @@ enum MpiTags
     LastTag
 };
 
+// Values of the FixedRemoteSchedule message. The reader answers
+// FixedPersistent if both sides have fixed schedules and every transfer can
+// use persistent requests with subarray datatypes.
+enum FixedSchedule
+{
+    NotFixed = 0,
+    Fixed,
+    FixedPersistent
+};
+
+// A persistent send or receive of one read schedule entry, and the subarray
+// datatype it uses. Re-initialized only when the user buffer moves.
+struct PersistentRequest
+{
+    const void *Buffer = nullptr;
+    MPI_Datatype Datatype = MPI_DATATYPE_NULL;
+    MPI_Request Request = MPI_REQUEST_NULL;
+};
+
+// Variable name -> (peer ID, index in the peer's schedule) -> request
+using PersistentRequestMap =
+    std::map<std::string,
+             std::map<std::pair<size_t, size_t>, PersistentRequest>>;
+
 // Generate the list of the other processes in MPI_COMM_WORLD who are
 // the partner in Write--Read. comm is 'our' communicator.
 // name is the output/input name the Open() was called with.
@@ -69,6 +97,24 @@ int ConnectDirectPeers(const MPI_Comm commWorld, const bool IAmSender,
                        const bool IAmWriterRoot, const int globalRank,
                        const std::vector<int> &peers);
 
+// True if the box extents fit the int arguments of MPI_Type_create_subarray
+bool FitsSubarrayDatatype(const Box<Dims> &box) noexcept;
+
+// Start the persistent transfer of the innerBox part of a buffer holding
+// outerBox (boxes have inclusive ends). The request and its datatype are
+// created at first use and re-created only if the buffer changed.
+// Returns the started request to be waited upon.
+MPI_Request StartPersistentRequest(PersistentRequest &request,
+                                   const void *buffer,
+                                   const Box<Dims> &outerBox,
+                                   const Box<Dims> &innerBox,
+                                   const size_t elementSize,
+                                   const bool isRowMajor, const bool isSend,
+                                   const int peerRank, MPI_Comm comm);
+
+// Free all (completed) persistent requests and their datatypes
+void FreePersistentRequests(PersistentRequestMap &requests);
+
 // Wait for multiple MPI requests to complete and check errors
 std::vector<MPI_Status> CompleteRequests(std::vector<MPI_Request> &requests,
                                          const bool IAmWriter,
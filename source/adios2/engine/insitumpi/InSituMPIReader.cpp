@@ -312,17 +312,6 @@ void InSituMPIReader::PerformGets()
     }
     m_NCallsPerformGets++;
 
-    // send flag about this receiver's fixed schedule
-    if (m_CurrentStep == 0)
-    {
-        if (m_ReaderRootRank == m_ReaderRank)
-        {
-            int fixed = (int)m_IO.m_DefinitionsLocked;
-            MPI_Send(&fixed, 1, MPI_INT, m_WriteRootGlobalRank,
-                     insitumpi::MpiTags::FixedRemoteSchedule, m_CommWorld);
-        }
-    }
-
     // Create read schedule per writer
     // const std::map<std::string, SubFileInfoMap> variablesSubFileInfo =
     if (m_CurrentStep == 0 || !m_IO.m_DefinitionsLocked)
@@ -337,6 +326,32 @@ void InSituMPIReader::PerformGets()
     int nRequests = insitumpi::FixSeeksToZeroOffset(
         m_ReadScheduleMap, helper::IsRowMajor(m_IO.m_HostLanguage));
 
+    // send flag about this receiver's fixed schedule, and whether all
+    // readers can receive every transfer with persistent requests
+    if (m_CurrentStep == 0)
+    {
+        int persistent =
+            (m_IO.m_DefinitionsLocked && m_RemoteDefinitionsLocked &&
+             m_BP3Deserializer.m_IsRowMajor ==
+                 helper::IsRowMajor(m_IO.m_HostLanguage) &&
+             CanUsePersistentTransfers());
+        MPI_Allreduce(MPI_IN_PLACE, &persistent, 1, MPI_INT, MPI_MIN,
+                      m_MPIComm);
+        m_PersistentTransfers = (persistent != 0);
+
+        if (m_ReaderRootRank == m_ReaderRank)
+        {
+            int fixed = insitumpi::NotFixed;
+            if (m_IO.m_DefinitionsLocked)
+            {
+                fixed = (m_PersistentTransfers ? insitumpi::FixedPersistent
+                                               : insitumpi::Fixed);
+            }
+            MPI_Send(&fixed, 1, MPI_INT, m_WriteRootGlobalRank,
+                     insitumpi::MpiTags::FixedRemoteSchedule, m_CommWorld);
+        }
+    }
+
     if (m_CurrentStep == 0 || !m_IO.m_DefinitionsLocked)
     {
         // Send schedule to writers
@@ -468,6 +483,55 @@ void InSituMPIReader::SendReadSchedule(
     TAU_STOP("InSituMPIReader::CompleteRequests");
 }
 
+bool InSituMPIReader::CanUsePersistentTransfers()
+{
+    for (const auto &variablePair : m_ReadScheduleMap)
+    {
+        const std::string type(m_IO.InquireVariableType(variablePair.first));
+        Box<Dims> selectionBox;
+
+        if (type == "compound")
+        {
+            return false;
+        }
+#define declare_template_instantiation(T)                                      \
+    else if (type == helper::GetType<T>())                                     \
+    {                                                                          \
+        core::Variable<T> *variable =                                          \
+            m_IO.InquireVariable<T>(variablePair.first);                       \
+        if (variable == nullptr)                                               \
+        {                                                                      \
+            return false;                                                      \
+        }                                                                      \
+        selectionBox =                                                         \
+            helper::StartEndBox(variable->m_Start, variable->m_Count);         \
+    }
+
+        ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
+#undef declare_template_instantiation
+
+        if (selectionBox.first.empty() ||
+            !insitumpi::FitsSubarrayDatatype(selectionBox))
+        {
+            return false;
+        }
+        for (const auto &subFileIndexPair : variablePair.second)
+        {
+            for (const auto &stepPair : subFileIndexPair.second)
+            {
+                for (const auto &sfi : stepPair.second)
+                {
+                    if (!insitumpi::FitsSubarrayDatatype(sfi.BlockBox))
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
 void InSituMPIReader::AsyncRecvAllVariables()
 {
     TAU_SCOPED_TIMER("InSituMPIReader::AsyncRecvAllVariables");
@@ -600,6 +664,7 @@ void InSituMPIReader::DoClose(const int transportIndex)
                       << "% of data in place (zero-copy)" << std::endl;
         }
     }
+    insitumpi::FreePersistentRequests(m_PersistentReceives);
 }
 
 #define declare_type(T)                                                        \
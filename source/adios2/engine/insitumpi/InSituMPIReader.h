@@ -14,6 +14,7 @@
 #ifndef ADIOS2_ENGINE_INSITUMPIREADER_H_
 #define ADIOS2_ENGINE_INSITUMPIREADER_H_
 
+#include "InSituMPIFunctions.h"
 #include "adios2/ADIOSConfig.h"
 #include "adios2/core/ADIOS.h"
 #include "adios2/core/Engine.h"
@@ -83,6 +84,13 @@ private:
      */
     bool m_RemoteDefinitionsLocked = false;
 
+    /** true: both schedules are fixed and every transfer is received with
+     * a persistent request and a subarray datatype straight into the user
+     * buffer. Decided by the readers in the first step.
+     */
+    bool m_PersistentTransfers = false;
+    insitumpi::PersistentRequestMap m_PersistentReceives;
+
     void Init() final;
     void InitParameters() final;
     void InitTransports() final;
@@ -116,6 +124,10 @@ private:
     void SendReadSchedule(const std::map<std::string, helper::SubFileInfoMap>
                               &variablesSubFileInfo);
 
+    // true if all selections and blocks in the read schedule can be
+    // described by subarray datatypes
+    bool CanUsePersistentTransfers();
+
     uint64_t m_BytesReceivedInPlace = 0; // bytes that were arriving in place
     uint64_t m_BytesReceivedInTemporary = 0; // bytes that needed copy
     int Statistics(uint64_t bytesInPlace, uint64_t bytesCopied);
@@ -111,8 +111,9 @@ void InSituMPIReader::AsyncRecvVariable(
         for (const auto &stepPair : subFileIndexPair.second)
         {
             const std::vector<helper::SubFileInfo> &sfis = stepPair.second;
-            for (const auto &sfi : sfis)
+            for (size_t i = 0; i < sfis.size(); ++i)
             {
+                const helper::SubFileInfo &sfi = sfis[i];
                 if (m_Verbosity == 5)
                 {
                     std::cout << "InSituMPI Reader " << m_ReaderRank
@@ -127,6 +128,31 @@ void InSituMPIReader::AsyncRecvVariable(
                     std::cout << std::endl;
                 }
 
+                if (m_PersistentTransfers)
+                {
+                    // receive the intersection in place through a subarray
+                    // datatype, with a request kept across steps
+                    char *ptr = reinterpret_cast<char *>(variable.GetData());
+                    insitumpi::PersistentRequest &request =
+                        m_PersistentReceives[variable.m_Name]
+                                            [{writerRank, i}];
+                    m_OngoingReceives.emplace_back(sfi, &variable.m_Name, ptr);
+                    m_MPIRequests.push_back(insitumpi::StartPersistentRequest(
+                        request, ptr,
+                        helper::StartEndBox(variable.m_Start,
+                                            variable.m_Count),
+                        sfi.IntersectionBox, sizeof(T),
+                        m_BP3Deserializer.m_IsRowMajor, false,
+                        m_RankAllPeers[writerRank], m_CommWorld));
+                    m_BytesReceivedInPlace +=
+                        helper::GetTotalSize(
+                            helper::StartCountBox(sfi.IntersectionBox.first,
+                                                  sfi.IntersectionBox.second)
+                                .second) *
+                        sizeof(T);
+                    continue;
+                }
+
                 const auto &seek = sfi.Seeks;
                 const size_t blockSize = seek.second - seek.first;
                 m_MPIRequests.emplace_back();
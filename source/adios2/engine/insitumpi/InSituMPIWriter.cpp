@@ -220,7 +220,8 @@ void InSituMPIWriter::PerformPuts()
             }
             // broadcast fixed schedule flag to every reader
             MPI_Bcast(&fixed, 1, MPI_INT, 0, m_MPIComm);
-            m_RemoteDefinitionsLocked = (fixed ? true : false);
+            m_RemoteDefinitionsLocked = (fixed != insitumpi::NotFixed);
+            m_PersistentTransfers = (fixed == insitumpi::FixedPersistent);
             if (m_BP3Serializer.m_RankMPI == 0)
             {
                 if (m_Verbosity == 5)
@@ -229,7 +230,9 @@ void InSituMPIWriter::PerformPuts()
                               << " fixed Writer schedule = "
                               << m_IO.m_DefinitionsLocked
                               << " fixed Reader schedule = "
-                              << m_RemoteDefinitionsLocked << std::endl;
+                              << m_RemoteDefinitionsLocked
+                              << " persistent transfers = "
+                              << m_PersistentTransfers << std::endl;
                 }
             }
         }
@@ -417,6 +420,7 @@ void InSituMPIWriter::DoClose(const int transportIndex)
         insitumpi::CompleteRequests(m_MPIRequests, true, m_WriterRank);
         m_MPIRequests.clear();
     }
+    insitumpi::FreePersistentRequests(m_PersistentSends);
 }
 
 void InSituMPIWriter::ReceiveReadSchedule(
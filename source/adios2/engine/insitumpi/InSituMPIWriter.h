@@ -14,6 +14,7 @@
 #ifndef ADIOS2_ENGINE_INSITUMPIMPIWRITER_H_
 #define ADIOS2_ENGINE_INSITUMPIMPIWRITER_H_
 
+#include "InSituMPIFunctions.h"
 #include "InSituMPISchedules.h"
 #include "adios2/ADIOSConfig.h"
 #include "adios2/core/Engine.h"
@@ -83,6 +84,13 @@ private:
      */
     bool m_RemoteDefinitionsLocked = false;
 
+    /** true: both schedules are fixed and the readers agreed to receive
+     * with subarray datatypes, so data is sent with persistent requests
+     * straight from the user buffers
+     */
+    bool m_PersistentTransfers = false;
+    insitumpi::PersistentRequestMap m_PersistentSends;
+
     std::vector<MPI_Request> m_MPIRequests; // for MPI_Waitall in EndStep()
 
     void Init() final;
@@ -113,8 +113,9 @@ void InSituMPIWriter::AsyncSendVariable(
             helper::StartEndBox(variable.m_Start, variable.m_Count);
         for (const auto &readerPair : requests)
         {
-            for (const auto &sfi : readerPair.second)
+            for (size_t i = 0; i < readerPair.second.size(); ++i)
             {
+                const helper::SubFileInfo &sfi = readerPair.second[i];
                 if (helper::IdenticalBoxes(mybox, sfi.BlockBox))
                 {
                     if (m_Verbosity == 5)
@@ -129,6 +130,23 @@ void InSituMPIWriter::AsyncSendVariable(
                         std::cout << std::endl;
                     }
 
+                    if (m_PersistentTransfers)
+                    {
+                        // send only the intersection, straight from the
+                        // user buffer, with a request kept across steps
+                        insitumpi::PersistentRequest &request =
+                            m_PersistentSends[variable.m_Name]
+                                             [{readerPair.first, i}];
+                        m_MPIRequests.push_back(
+                            insitumpi::StartPersistentRequest(
+                                request, blockInfo.Data, sfi.BlockBox,
+                                sfi.IntersectionBox, sizeof(T),
+                                helper::IsRowMajor(m_IO.m_HostLanguage), true,
+                                m_RankAllPeers[readerPair.first],
+                                m_CommWorld));
+                        continue;
+                    }
+
                     m_MPIRequests.emplace_back();
 
                     const auto &seek = sfi.Seeks;
@@ -14,6 +14,7 @@
 #include "adios2/helper/adiosFunctions.h"
 #include "adios2/toolkit/transport/file/FileFStream.h"
 
+#include <cstring>
 #include <iostream>
 
 #include <zmq.h>
@@ -137,6 +138,11 @@ StepStatus SscReader::BeginStep(const StepMode stepMode,
 
     ++m_CurrentStep;
 
+    if (m_Locked)
+    {
+        return BeginStepLocked(timeoutSeconds);
+    }
+
     format::DmvVecPtr vars = nullptr;
 
     auto startTime = std::chrono::system_clock::now();
@@ -200,13 +206,195 @@ StepStatus SscReader::BeginStep(const StepMode stepMode,
     return StepStatus::OK;
 }
 
+StepStatus SscReader::BeginStepLocked(const float timeoutSeconds)
+{
+    TAU_SCOPED_TIMER_FUNC();
+
+    // only the number of the latest step is requested, the metadata of a
+    // locked step is the one of the step the plan was made from, the reply
+    // also holds the state and nonce of the stream window of the writers
+    int64_t step = -1;
+    // 1 to connect the stream window with the tag, 2 to free it
+    int64_t stream[2] = {0, 0};
+    auto startTime = std::chrono::system_clock::now();
+    do
+    {
+        step = -1;
+        stream[0] = 0;
+        if (m_MpiRank == 0)
+        {
+            std::vector<char> request(2 * sizeof(int64_t));
+            reinterpret_cast<int64_t *>(request.data())[0] = m_AppID;
+            reinterpret_cast<int64_t *>(request.data())[1] = -6;
+            while (step < m_CurrentStep)
+            {
+                std::string address =
+                    m_FullAddresses[rand() % m_FullAddresses.size()];
+#ifdef ADIOS2_HAVE_MPI
+                if (m_StreamPending)
+                {
+                    // only the writer leader knows about a pending connection
+                    address = m_FullAddresses.front();
+                }
+#endif
+                auto reply = m_MetadataTransport->Request(request, address);
+                if (reply->size() == 3 * sizeof(int64_t))
+                {
+                    const int64_t *latest =
+                        reinterpret_cast<const int64_t *>(reply->data());
+                    step = latest[0];
+#ifdef ADIOS2_HAVE_MPI
+                    // writer states: 1 pending, 2 connected, 3 closed
+                    if (m_StreamPending &&
+                        (latest[1] != 1 || latest[2] != m_StreamNonce))
+                    {
+                        m_StreamPending = false;
+                        if (latest[1] == 2 && latest[2] == m_StreamNonce)
+                        {
+                            MPI_Wait(&m_StreamRequest, MPI_STATUS_IGNORE);
+                            stream[0] = 1;
+                            stream[1] = m_StreamTag;
+                            break;
+                        }
+                        // never received, the writers gave up
+                        MPI_Request_free(&m_StreamRequest);
+                    }
+                    if (m_StreamComm != MPI_COMM_NULL && latest[1] == 3)
+                    {
+                        stream[0] = 2;
+                        break;
+                    }
+#endif
+                }
+                auto nowTime = std::chrono::system_clock::now();
+                auto duration =
+                    std::chrono::duration_cast<std::chrono::seconds>(
+                        nowTime - startTime);
+                if (step < m_CurrentStep && timeoutSeconds >= 0 &&
+                    duration.count() > timeoutSeconds)
+                {
+                    step = -1;
+                    break;
+                }
+            }
+        }
+        MPI_Bcast(&step, 1, MPI_INT64_T, 0, m_MPIComm);
+#ifdef ADIOS2_HAVE_MPI
+        MPI_Bcast(stream, 2, MPI_INT64_T, 0, m_MPIComm);
+        if (stream[0] == 1)
+        {
+            ConnectStream(static_cast<int>(stream[1]));
+            RegisterLockedPlan();
+        }
+        else if (stream[0] == 2)
+        {
+            // the writers are closing and wait for it
+            DisconnectStream();
+        }
+#endif
+    } while (stream[0] != 0);
+
+    if (step < 0)
+    {
+        Log(5,
+            "SscReader::BeginStepLocked() returned NotReady because of "
+            "timeout.",
+            true, true);
+        --m_CurrentStep;
+        return StepStatus::NotReady;
+    }
+    m_CurrentStep = step;
+
+    for (const auto &i : m_LockedPlan)
+    {
+        format::VecPtr reply = nullptr;
+#ifdef ADIOS2_HAVE_MPI
+        auto writerIt = m_LockedWriters.find(i.first);
+        if (writerIt != m_LockedWriters.end())
+        {
+            reply = GetLockedReply(writerIt->second);
+        }
+#endif
+        if (reply == nullptr)
+        {
+            reinterpret_cast<int64_t *>(i.second->data())[1] = m_CurrentStep;
+            reply = m_DataTransport->Request(*i.second, i.first);
+        }
+        if (reply->empty())
+        {
+            Log(1,
+                "Lost connection to writer. Data for the final step is "
+                "corrupted!",
+                true, true);
+            m_ConnectionLost = true;
+            break;
+        }
+        if (reply->size() <= 16)
+        {
+            std::string msg = "Step " + std::to_string(m_CurrentStep) +
+                              " received empty data package from writer " +
+                              i.first +
+                              ". This may be caused by a network failure.";
+            if (m_Tolerance)
+            {
+                Log(1, msg, true, true);
+            }
+            else
+            {
+                throw(std::runtime_error(msg));
+            }
+        }
+        else
+        {
+            m_DataManSerializer.PutPack(reply);
+        }
+    }
+
+    m_MetaDataMap.clear();
+    m_MetaDataMap[m_CurrentStep] = m_LockedVars;
+
+    Log(5,
+        "SscReader::BeginStepLocked() end. Step " +
+            std::to_string(m_CurrentStep),
+        true, true);
+
+    return StepStatus::OK;
+}
+
 void SscReader::PerformGets()
 {
 
     TAU_SCOPED_TIMER_FUNC();
     Log(5, "SscReader::PerformGets() begin", true, true);
 
-    auto requests = m_DataManSerializer.GetDeferredRequest();
+    format::DeferredRequestMapPtr requests;
+    if (m_Locked)
+    {
+        // data of the whole plan was already fetched in BeginStep
+        for (const auto &req : m_DeferredRequests)
+        {
+            if (not IsInLockedPlan(req))
+            {
+                throw(std::invalid_argument(
+                    "SscReader::PerformGets() variable " + req.variable +
+                    " is read with a selection that is not in the plan made "
+                    "when IO definitions were locked"));
+            }
+        }
+        requests = std::make_shared<format::DeferredRequestMap>();
+    }
+    else
+    {
+        requests = m_DataManSerializer.GetDeferredRequest();
+        m_StepRequests += m_DeferredRequests.size();
+        if (m_IO.m_DefinitionsLocked)
+        {
+            m_DataManSerializer.MergeDeferredRequests(m_LockedPlan, *requests);
+            m_LockedRequests.insert(m_LockedRequests.end(),
+                                    m_DeferredRequests.begin(),
+                                    m_DeferredRequests.end());
+        }
+    }
 
     if (m_Verbosity >= 10)
     {
@@ -305,6 +493,11 @@ void SscReader::EndStep()
         true, true);
 
     PerformGets();
+    if (not m_Locked && m_IO.m_DefinitionsLocked)
+    {
+        LockPlan();
+    }
+    m_StepRequests = 0;
     m_DataManSerializer.Erase(CurrentStep(), true);
 
     Log(5, "SscReader::EndStep() end. Step " + std::to_string(m_CurrentStep),
@@ -341,6 +534,17 @@ void SscReader::Init()
     srand(time(NULL));
     InitParameters();
     helper::HandshakeReader(m_MPIComm, m_AppID, m_FullAddresses, m_Name, "ssc");
+#ifdef ADIOS2_HAVE_MPI
+    // sent by the leader for the writers to check that they share a world
+    int worldRank;
+    int mpiSize;
+    MPI_Comm_rank(MPI_COMM_WORLD, &worldRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &m_WorldSize);
+    MPI_Comm_size(m_MPIComm, &mpiSize);
+    m_WorldRanks.resize(mpiSize);
+    MPI_Gather(&worldRank, 1, MPI_INT, m_WorldRanks.data(), 1, MPI_INT, 0,
+               m_MPIComm);
+#endif
 
     format::VecPtr reply = std::make_shared<std::vector<char>>();
     if (m_MpiRank == 0)
@@ -401,9 +605,224 @@ void SscReader::RequestMetadata(const int64_t step)
     m_DataManSerializer.PutAggregatedMetadata(reply, m_MPIComm);
 }
 
+void SscReader::LockPlan()
+{
+    TAU_SCOPED_TIMER_FUNC();
+
+    // a plan is only made from a step that was read entirely with locked
+    // definitions, otherwise try again with the next step
+    auto varsIt = m_MetaDataMap.find(m_CurrentStep);
+    if (m_StepRequests == 0 || m_LockedRequests.size() != m_StepRequests ||
+        varsIt == m_MetaDataMap.end() || varsIt->second == nullptr)
+    {
+        m_LockedPlan.clear();
+        m_LockedRequests.clear();
+        return;
+    }
+
+    // requests are sent with a header of the locked request tag and the step
+    // the writer replaces the step in the plan with
+    for (auto &i : m_LockedPlan)
+    {
+        auto request = std::make_shared<std::vector<char>>(
+            2 * sizeof(int64_t) + i.second->size());
+        reinterpret_cast<int64_t *>(request->data())[0] = -6;
+        std::memcpy(request->data() + 2 * sizeof(int64_t), i.second->data(),
+                    i.second->size());
+        i.second = request;
+    }
+#ifdef ADIOS2_HAVE_MPI
+    RequestStream();
+#endif
+
+    // keep only the metadata received from writers, not the replied data
+    m_LockedVars = std::make_shared<std::vector<format::DataManVar>>();
+    for (const auto &var : *varsIt->second)
+    {
+        if (var.buffer == nullptr)
+        {
+            m_LockedVars->push_back(var);
+        }
+    }
+
+    m_Locked = true;
+    Log(5,
+        "SscReader::LockPlan() locked communication plan with " +
+            std::to_string(m_LockedPlan.size()) + " writers at Step " +
+            std::to_string(m_CurrentStep),
+        true, true);
+}
+
+bool SscReader::IsInLockedPlan(const Request &req) const
+{
+    for (const auto &planned : m_LockedRequests)
+    {
+        if (planned.variable == req.variable && planned.type == req.type &&
+            planned.start == req.start && planned.count == req.count)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+#ifdef ADIOS2_HAVE_MPI
+void SscReader::RequestStream()
+{
+    TAU_SCOPED_TIMER_FUNC();
+    if (m_MpiRank != 0)
+    {
+        return;
+    }
+    m_StreamNonce = (static_cast<int64_t>(rand()) << 32) ^ rand();
+    std::vector<char> request((3 + m_WorldRanks.size()) * sizeof(int64_t));
+    int64_t *header = reinterpret_cast<int64_t *>(request.data());
+    header[0] = -8;
+    header[1] = m_StreamNonce;
+    header[2] = m_WorldSize;
+    std::copy(m_WorldRanks.begin(), m_WorldRanks.end(), header + 3);
+    auto reply = m_MetadataTransport->Request(request, m_FullAddresses.front());
+    if (reply->size() != 3 * sizeof(int64_t) ||
+        reinterpret_cast<const int64_t *>(reply->data())[0] != 1)
+    {
+        // in another world, or the writers already serve another reader
+        return;
+    }
+    m_StreamPeer =
+        static_cast<int>(reinterpret_cast<const int64_t *>(reply->data())[1]);
+    m_StreamTag =
+        static_cast<int>(reinterpret_cast<const int64_t *>(reply->data())[2]);
+    if (m_StreamPeer < 0 || m_StreamPeer >= m_WorldSize)
+    {
+        return;
+    }
+    // received by the writer leader only if it is in this world, it then
+    // waits for this app to connect
+    MPI_Isend(&m_StreamNonce, 1, MPI_INT64_T, m_StreamPeer, m_StreamTag,
+              MPI_COMM_WORLD, &m_StreamRequest);
+    m_StreamPending = true;
+}
+
+void SscReader::ConnectStream(const int tag)
+{
+    TAU_SCOPED_TIMER_FUNC();
+    MPI_Comm intercomm;
+    MPI_Intercomm_create(m_MPIComm, 0, MPI_COMM_WORLD, m_StreamPeer,
+                         tag + 0x4000, &intercomm);
+    MPI_Intercomm_merge(intercomm, 1, &m_StreamComm);
+    MPI_Comm_free(&intercomm);
+    MPI_Comm_rank(m_StreamComm, &m_StreamRank);
+    MPI_Win_create_dynamic(MPI_INFO_NULL, m_StreamComm, &m_Window);
+    // the writers attach their directories before
+    MPI_Barrier(m_StreamComm);
+}
+
+void SscReader::DisconnectStream()
+{
+    TAU_SCOPED_TIMER_FUNC();
+    m_LockedWriters.clear();
+    MPI_Win_free(&m_Window);
+    MPI_Comm_free(&m_StreamComm);
+}
+
+void SscReader::RegisterLockedPlan()
+{
+    TAU_SCOPED_TIMER_FUNC();
+    m_LockedWriters.clear();
+    for (const auto &i : m_LockedPlan)
+    {
+        std::vector<char> request(*i.second);
+        reinterpret_cast<int64_t *>(request.data())[0] = -7;
+        reinterpret_cast<int64_t *>(request.data())[1] = m_StreamRank;
+        auto reply = m_DataTransport->Request(request, i.first);
+        if (reply->size() != 2 * sizeof(int64_t))
+        {
+            // keep requesting the data of this writer over ZeroMQ
+            continue;
+        }
+        LockedWriter &writer = m_LockedWriters[i.first];
+        writer.rank = static_cast<int>(
+            reinterpret_cast<const int64_t *>(reply->data())[0]);
+        writer.directory = reinterpret_cast<const int64_t *>(reply->data())[1];
+    }
+}
+
+format::VecPtr SscReader::GetLockedReply(LockedWriter &writer)
+{
+    TAU_SCOPED_TIMER_FUNC();
+    format::VecPtr reply = nullptr;
+    MPI_Win_lock(MPI_LOCK_SHARED, writer.rank, 0, m_Window);
+    if (writer.slots == 0)
+    {
+        // published by the writer at its first step after the registration
+        int64_t entry[3];
+        MPI_Get(entry, 3, MPI_INT64_T, writer.rank,
+                writer.directory + 3 * m_StreamRank * sizeof(int64_t), 3,
+                MPI_INT64_T, m_Window);
+        MPI_Win_flush(writer.rank, m_Window);
+        writer.slots = entry[0];
+        writer.capacity = entry[1];
+        writer.slotCount = entry[2];
+    }
+    if (writer.slots != 0)
+    {
+        const MPI_Aint slot =
+            writer.slots + (m_CurrentStep % writer.slotCount) * writer.capacity;
+        int64_t header[2];
+        MPI_Get(header, 2, MPI_INT64_T, writer.rank, slot, 2, MPI_INT64_T,
+                m_Window);
+        MPI_Win_flush(writer.rank, m_Window);
+        // otherwise the slot is already reused or the reply did not fit
+        if (header[0] == m_CurrentStep)
+        {
+            const int size = static_cast<int>(header[1]);
+            reply = std::make_shared<std::vector<char>>(size);
+            MPI_Get(reply->data(), size, MPI_CHAR, writer.rank,
+                    slot + 2 * sizeof(int64_t), size, MPI_CHAR, m_Window);
+        }
+    }
+    MPI_Win_unlock(writer.rank, m_Window);
+    return reply;
+}
+#endif
+
 void SscReader::DoClose(const int transportIndex)
 {
     TAU_SCOPED_TIMER_FUNC();
+#ifdef ADIOS2_HAVE_MPI
+    int64_t stream[2] = {0, m_StreamTag};
+    if (m_StreamPending)
+    {
+        // the writers may have received the confirmation meanwhile, then
+        // they wait for this app to connect
+        std::vector<char> request(2 * sizeof(int64_t));
+        reinterpret_cast<int64_t *>(request.data())[0] = m_StreamNonce;
+        reinterpret_cast<int64_t *>(request.data())[1] = -9;
+        auto reply =
+            m_MetadataTransport->Request(request, m_FullAddresses.front());
+        if (reply->size() == sizeof(int64_t) &&
+            reinterpret_cast<const int64_t *>(reply->data())[0] == 1)
+        {
+            MPI_Wait(&m_StreamRequest, MPI_STATUS_IGNORE);
+            stream[0] = 1;
+        }
+        else
+        {
+            MPI_Request_free(&m_StreamRequest);
+        }
+        m_StreamPending = false;
+    }
+    MPI_Bcast(stream, 2, MPI_INT64_T, 0, m_MPIComm);
+    if (stream[0] == 1)
+    {
+        ConnectStream(static_cast<int>(stream[1]));
+    }
+    if (m_StreamComm != MPI_COMM_NULL)
+    {
+        // waits for the writers to close, they keep serving until then
+        DisconnectStream();
+    }
+#endif
     if (m_Verbosity >= 5)
     {
         std::cout << "Staging Reader " << m_MpiRank << " Close(" << m_Name
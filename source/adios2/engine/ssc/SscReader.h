@@ -40,6 +40,7 @@ public:
         StepMode stepMode = StepMode::NextAvailable,
         const float timeoutSeconds = std::numeric_limits<float>::max()) final;
     StepStatus BeginStepIterator(StepMode stepMode, format::DmvVecPtr &vars);
+    StepStatus BeginStepLocked(const float timeoutSeconds);
     void PerformGets() final;
     size_t CurrentStep() const final;
     void EndStep() final;
@@ -69,6 +70,51 @@ private:
     };
     std::vector<Request> m_DeferredRequests;
 
+    // Once a whole step has been read with locked IO definitions, its
+    // requests are kept as a plan and replayed for every following step
+    // without requesting metadata or computing overlaps again
+    bool m_Locked = false;
+    format::DeferredRequestMap m_LockedPlan;
+    std::vector<Request> m_LockedRequests;
+    format::DmvVecPtr m_LockedVars;
+    size_t m_StepRequests = 0;
+
+    void LockPlan();
+    bool IsInLockedPlan(const Request &req) const;
+
+#ifdef ADIOS2_HAVE_MPI
+    // writers keep the replies of a registered plan for their latest steps
+    // in buffers of a dynamic window over the writer and reader ranks of
+    // this stream, read with MPI_Get, see SscWriter
+    struct LockedWriter
+    {
+        int rank = -1;
+        int64_t directory = 0;
+        int64_t slots = 0;
+        int64_t capacity = 0;
+        int64_t slotCount = 0;
+    };
+    MPI_Comm m_StreamComm = MPI_COMM_NULL;
+    MPI_Win m_Window = MPI_WIN_NULL;
+    int m_StreamRank = -1;
+    int m_WorldSize = 0;
+    std::vector<int> m_WorldRanks;
+    // leader only, waiting for the writers to receive the confirmation sent
+    // to their leader and to connect
+    bool m_StreamPending = false;
+    int m_StreamPeer = -1;
+    int m_StreamTag = 0;
+    int64_t m_StreamNonce = 0;
+    MPI_Request m_StreamRequest = MPI_REQUEST_NULL;
+    std::unordered_map<std::string, LockedWriter> m_LockedWriters;
+
+    void RequestStream();
+    void ConnectStream(const int tag);
+    void DisconnectStream();
+    void RegisterLockedPlan();
+    format::VecPtr GetLockedReply(LockedWriter &writer);
+#endif
+
     format::VecPtr m_RepliedMetadata;
     std::mutex m_RepliedMetadataMutex;
 
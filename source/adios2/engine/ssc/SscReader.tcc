@@ -55,9 +55,12 @@ void SscReader::GetDeferredCommon(Variable<T> &variable, T *data)
         variable.m_Start = Dims(1, 0);
         variable.m_Count = Dims(1, 1);
     }
-    m_DataManSerializer.PutDeferredRequest(variable.m_Name, CurrentStep(),
-                                           variable.m_Start, variable.m_Count,
-                                           data);
+    if (not m_Locked)
+    {
+        m_DataManSerializer.PutDeferredRequest(
+            variable.m_Name, CurrentStep(), variable.m_Start, variable.m_Count,
+            data);
+    }
 
     m_DeferredRequests.emplace_back();
     auto &req = m_DeferredRequests.back();
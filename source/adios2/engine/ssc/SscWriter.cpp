@@ -14,6 +14,7 @@
 #include "adios2/helper/adiosFunctions.h"
 #include "adios2/toolkit/transport/file/FileFStream.h"
 
+#include <cstring>
 #include <iostream>
 
 #include <zmq.h>
@@ -79,9 +80,24 @@ void SscWriter::EndStep()
     if (m_CurrentStepActive)
     {
         m_DataManSerializer.PutPack(m_DataManSerializer.GetLocalPack());
+#ifdef ADIOS2_HAVE_MPI
+        if (m_StreamComm != MPI_COMM_NULL)
+        {
+            PutLockedPlans();
+        }
+#endif
         m_DataManSerializer.AggregateMetadata();
+        m_LatestAggregatedStep = m_CurrentStep;
     }
 
+#ifdef ADIOS2_HAVE_MPI
+    // after the step is served, as the reader joins from its next step
+    if (m_StreamState == StreamIdle || m_StreamState == StreamPending)
+    {
+        ConnectStream();
+    }
+#endif
+
     if (m_CurrentStep > 5)
     {
         m_DataManSerializer.Erase(m_CurrentStep - 5, true);
@@ -117,6 +133,15 @@ void SscWriter::Init()
     helper::HandshakeWriter(m_MPIComm, m_AppID, m_FullAddresses, m_Name, "ssc",
                             m_Port, m_Channels, m_MaxRanksPerNode,
                             m_MaxAppsPerNode);
+#ifdef ADIOS2_HAVE_MPI
+    // for the leader to check that a reader claims the same world
+    int worldRank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &worldRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &m_WorldSize);
+    m_WorldRanks.resize(m_MpiSize);
+    MPI_Gather(&worldRank, 1, MPI_INT, m_WorldRanks.data(), 1, MPI_INT, 0,
+               m_MPIComm);
+#endif
     InitTransports();
 }
 
@@ -171,6 +196,30 @@ void SscWriter::ReplyThread(const std::string &address)
             int64_t reader_id = reinterpret_cast<int64_t *>(request->data())[0];
             int64_t stepRequested =
                 reinterpret_cast<int64_t *>(request->data())[1];
+            if (stepRequested == -6) // locked reader asking for latest step
+            {
+                auto reply =
+                    std::make_shared<std::vector<char>>(3 * sizeof(int64_t));
+                int64_t *latest = reinterpret_cast<int64_t *>(reply->data());
+                latest[0] = m_LatestAggregatedStep;
+#ifdef ADIOS2_HAVE_MPI
+                latest[1] = m_StreamState;
+                latest[2] = m_StreamNonce;
+#endif
+                tpm.SendReply(reply);
+                continue;
+            }
+#ifdef ADIOS2_HAVE_MPI
+            if (stepRequested == -9) // reader leader closing while pending
+            {
+                auto reply =
+                    std::make_shared<std::vector<char>>(sizeof(int64_t));
+                reinterpret_cast<int64_t *>(reply->data())[0] =
+                    WithdrawStream(reader_id);
+                tpm.SendReply(reply);
+                continue;
+            }
+#endif
             std::shared_ptr<std::vector<char>> aggMetadata = nullptr;
             int64_t stepProvided = -1;
             while (aggMetadata == nullptr)
@@ -201,11 +250,57 @@ void SscWriter::ReplyThread(const std::string &address)
         }
         else if (request->size() > 16)
         {
+#ifdef ADIOS2_HAVE_MPI
+            const int64_t *plan =
+                reinterpret_cast<const int64_t *>(request->data());
+            if (plan[0] == -8) // reader leader asking for a stream window
+            {
+                tpm.SendReply(AcceptStream(*request));
+                continue;
+            }
+            if (plan[0] == -7) // locked reader registering its request plan
+            {
+                if (m_StreamState != StreamConnected)
+                {
+                    auto reply =
+                        std::make_shared<std::vector<char>>(sizeof(int64_t));
+                    reinterpret_cast<int64_t *>(reply->data())[0] = -1;
+                    tpm.SendReply(reply);
+                    continue;
+                }
+                {
+                    std::lock_guard<std::mutex> l(m_PendingPlansMutex);
+                    m_PendingPlans.emplace_back(
+                        static_cast<int>(plan[1]),
+                        std::vector<char>(request->begin() +
+                                              2 * sizeof(int64_t),
+                                          request->end()));
+                }
+                auto reply =
+                    std::make_shared<std::vector<char>>(2 * sizeof(int64_t));
+                reinterpret_cast<int64_t *>(reply->data())[0] = m_StreamRank;
+                reinterpret_cast<int64_t *>(reply->data())[1] =
+                    m_RmaDirectoryAddress;
+                tpm.SendReply(reply);
+                continue;
+            }
+#endif
             size_t step;
             m_CompressionParamsMutex.lock();
             std::unordered_map<std::string, Params> p = m_CompressionParams;
             m_CompressionParamsMutex.unlock();
-            auto reply = m_DataManSerializer.GenerateReply(*request, step, p);
+            format::VecPtr reply;
+            const int64_t *header =
+                reinterpret_cast<const int64_t *>(request->data());
+            if (header[0] == -6) // locked reader replaying its request plan
+            {
+                reply = m_DataManSerializer.GenerateReply(
+                    *request, step, p, 2 * sizeof(int64_t), header[1]);
+            }
+            else
+            {
+                reply = m_DataManSerializer.GenerateReply(*request, step, p);
+            }
             tpm.SendReply(reply);
             if (reply->size() <= 16)
             {
@@ -230,9 +325,248 @@ void SscWriter::ReplyThread(const std::string &address)
     }
 }
 
+#ifdef ADIOS2_HAVE_MPI
+format::VecPtr SscWriter::AcceptStream(const std::vector<char> &request)
+{
+    // the request holds the nonce, world size and world ranks of the reader
+    // app, the reader leader first
+    const int64_t *header = reinterpret_cast<const int64_t *>(request.data());
+    const size_t readers = request.size() / sizeof(int64_t) - 3;
+    auto reply = std::make_shared<std::vector<char>>(3 * sizeof(int64_t));
+    int64_t *accepted = reinterpret_cast<int64_t *>(reply->data());
+    accepted[0] = 0;
+
+    // a reader launched separately has its own MPI_COMM_WORLD, where the
+    // same ranks are other processes, only claims that can hold in this
+    // world are confirmed with a message
+    bool sameWorld = m_MpiRank == 0 && request.size() % sizeof(int64_t) == 0 &&
+                     readers > 0 && header[2] == m_WorldSize;
+    for (size_t i = 0; sameWorld && i < readers; ++i)
+    {
+        const int64_t rank = header[3 + i];
+        sameWorld = rank >= 0 && rank < m_WorldSize &&
+                    std::find(m_WorldRanks.begin(), m_WorldRanks.end(),
+                              rank) == m_WorldRanks.end();
+    }
+    if (!sameWorld)
+    {
+        return reply;
+    }
+
+    std::lock_guard<std::mutex> l(m_StreamMutex);
+    if (m_StreamState != StreamIdle)
+    {
+        return reply;
+    }
+    m_StreamPeer = static_cast<int>(header[3]);
+    m_StreamNonce = header[1];
+    m_StreamTag = static_cast<int>(m_StreamNonce & 0x3fff);
+    m_StreamWait = 0;
+    m_StreamStart = std::chrono::system_clock::now();
+    m_StreamState = StreamPending;
+    accepted[0] = 1;
+    accepted[1] = m_WorldRanks[0];
+    accepted[2] = m_StreamTag;
+    return reply;
+}
+
+int64_t SscWriter::WithdrawStream(const int64_t nonce)
+{
+    std::lock_guard<std::mutex> l(m_StreamMutex);
+    if (nonce != m_StreamNonce)
+    {
+        return 0;
+    }
+    if (m_StreamState == StreamPending)
+    {
+        m_StreamState = StreamIdle;
+        return 0;
+    }
+    // the writers already wait for the reader to join
+    return m_StreamState == StreamConnected ? 1 : 0;
+}
+
+void SscWriter::ConnectStream()
+{
+    TAU_SCOPED_TIMER_FUNC();
+    // decided by the leader, which receives the confirmation of the reader
+    // leader, sent to this world rank and tag after AcceptStream
+    int decision[2] = {0, 0};
+    if (m_MpiRank == 0)
+    {
+        std::lock_guard<std::mutex> l(m_StreamMutex);
+        if (m_StreamState == StreamPending)
+        {
+            int found;
+            MPI_Message message;
+            MPI_Improbe(m_StreamPeer, m_StreamTag, MPI_COMM_WORLD, &found,
+                        &message, MPI_STATUS_IGNORE);
+            if (found)
+            {
+                int64_t nonce;
+                MPI_Mrecv(&nonce, 1, MPI_INT64_T, &message, MPI_STATUS_IGNORE);
+                // otherwise it was sent by another stream
+                if (nonce == m_StreamNonce)
+                {
+                    decision[0] = 1;
+                    decision[1] = m_StreamTag;
+                    m_StreamState = StreamConnected;
+                }
+            }
+            else if (++m_StreamWait > m_StreamWaitSteps &&
+                     std::chrono::system_clock::now() - m_StreamStart >
+                         std::chrono::seconds(m_Timeout))
+            {
+                m_StreamState = StreamIdle;
+            }
+        }
+    }
+    MPI_Bcast(decision, 2, MPI_INT, 0, m_MPIComm);
+    if (decision[0] == 0)
+    {
+        return;
+    }
+
+    // the reader leader sees the state with its next step request
+    m_StreamState = StreamConnected;
+    MPI_Comm intercomm;
+    MPI_Intercomm_create(m_MPIComm, 0, MPI_COMM_WORLD, m_StreamPeer,
+                         decision[1] + 0x4000, &intercomm);
+    MPI_Intercomm_merge(intercomm, 0, &m_StreamComm);
+    MPI_Comm_free(&intercomm);
+
+    int streamRank;
+    int streamSize;
+    MPI_Comm_rank(m_StreamComm, &streamRank);
+    MPI_Comm_size(m_StreamComm, &streamSize);
+    m_RmaDirectory.assign(3 * streamSize, 0);
+    MPI_Win_create_dynamic(MPI_INFO_NULL, m_StreamComm, &m_Window);
+    MPI_Win_attach(m_Window, m_RmaDirectory.data(),
+                   m_RmaDirectory.size() * sizeof(int64_t));
+    MPI_Aint address;
+    MPI_Get_address(m_RmaDirectory.data(), &address);
+    m_RmaDirectoryAddress = address;
+    m_StreamRank = streamRank;
+    // readers register their plans once the directories are attached
+    MPI_Barrier(m_StreamComm);
+}
+
+void SscWriter::DisconnectStream()
+{
+    TAU_SCOPED_TIMER_FUNC();
+    for (auto &i : m_LockedPlans)
+    {
+        MPI_Win_detach(m_Window, i.second.slots.data());
+    }
+    m_LockedPlans.clear();
+    MPI_Win_detach(m_Window, m_RmaDirectory.data());
+    MPI_Win_free(&m_Window);
+    MPI_Comm_free(&m_StreamComm);
+}
+
+void SscWriter::PutLockedPlans()
+{
+    TAU_SCOPED_TIMER_FUNC();
+    std::vector<std::pair<int, std::vector<char>>> pending;
+    {
+        std::lock_guard<std::mutex> l(m_PendingPlansMutex);
+        pending.swap(m_PendingPlans);
+    }
+    // indexed by the rank of the reader in the stream communicator
+    const int streamSize = static_cast<int>(m_RmaDirectory.size() / 3);
+    for (auto it = pending.begin(); it != pending.end();)
+    {
+        if (it->first < 0 || it->first >= streamSize)
+        {
+            it = pending.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    if (pending.empty() && m_LockedPlans.empty())
+    {
+        return;
+    }
+
+    m_CompressionParamsMutex.lock();
+    std::unordered_map<std::string, Params> p = m_CompressionParams;
+    m_CompressionParamsMutex.unlock();
+    size_t step;
+
+    // slots are sized from the first reply, with room for the replies of
+    // later steps to grow, and attached before they are published
+    for (auto &i : pending)
+    {
+        auto it = m_LockedPlans.find(i.first);
+        if (it != m_LockedPlans.end())
+        {
+            MPI_Win_detach(m_Window, it->second.slots.data());
+            m_LockedPlans.erase(it);
+        }
+        LockedPlan &plan = m_LockedPlans[i.first];
+        plan.request = std::move(i.second);
+        auto reply = m_DataManSerializer.GenerateReply(plan.request, step, p,
+                                                       0, m_CurrentStep);
+        plan.capacity = 2 * (reply->size() + 2 * sizeof(int64_t));
+        plan.slots.resize(m_LockedSlots * plan.capacity);
+        for (int64_t s = 0; s < m_LockedSlots; ++s)
+        {
+            reinterpret_cast<int64_t *>(plan.slots.data() +
+                                        s * plan.capacity)[0] = -1;
+        }
+        MPI_Win_attach(m_Window, plan.slots.data(), plan.slots.size());
+    }
+
+    MPI_Win_lock(MPI_LOCK_EXCLUSIVE, m_StreamRank, 0, m_Window);
+    for (const auto &i : pending)
+    {
+        const LockedPlan &plan = m_LockedPlans[i.first];
+        MPI_Aint address;
+        MPI_Get_address(plan.slots.data(), &address);
+        m_RmaDirectory[3 * i.first] = address;
+        m_RmaDirectory[3 * i.first + 1] = plan.capacity;
+        m_RmaDirectory[3 * i.first + 2] = m_LockedSlots;
+    }
+    for (auto &i : m_LockedPlans)
+    {
+        LockedPlan &plan = i.second;
+        auto reply = m_DataManSerializer.GenerateReply(plan.request, step, p,
+                                                       0, m_CurrentStep);
+        char *slot =
+            plan.slots.data() + (m_CurrentStep % m_LockedSlots) * plan.capacity;
+        int64_t *header = reinterpret_cast<int64_t *>(slot);
+        if (reply->size() + 2 * sizeof(int64_t) > plan.capacity)
+        {
+            // the reader requests this step through the reply threads
+            header[0] = -1;
+            continue;
+        }
+        std::memcpy(slot + 2 * sizeof(int64_t), reply->data(), reply->size());
+        header[0] = m_CurrentStep;
+        header[1] = reply->size();
+    }
+    MPI_Win_unlock(m_StreamRank, m_Window);
+}
+#endif
+
 void SscWriter::DoClose(const int transportIndex)
 {
     MPI_Barrier(m_MPIComm);
+#ifdef ADIOS2_HAVE_MPI
+    {
+        // also drops a pending reader
+        std::lock_guard<std::mutex> l(m_StreamMutex);
+        m_StreamState = StreamClosed;
+    }
+    if (m_StreamComm != MPI_COMM_NULL)
+    {
+        // waits for the readers to free the window too, at their next step
+        // or Close, the reply threads keep serving them until then
+        DisconnectStream();
+    }
+#endif
     m_Listening = false;
     for (auto &i : m_ReplyThreads)
     {
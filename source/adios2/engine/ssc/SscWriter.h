@@ -11,8 +11,11 @@
 #ifndef ADIOS2_ENGINE_SSCWRITER_H_
 #define ADIOS2_ENGINE_SSCWRITER_H_
 
+#include <atomic>
+#include <chrono>
 #include <queue>
 
+#include "adios2/ADIOSConfig.h"
 #include "adios2/core/Engine.h"
 #include "adios2/toolkit/format/dataman/DataManSerializer.h"
 #include "adios2/toolkit/format/dataman/DataManSerializer.tcc"
@@ -62,9 +65,65 @@ private:
     bool m_AttributesSet = false;
     bool m_CurrentStepActive = true;
     size_t m_AppID = 0;
+    // latest step aggregated across all writer ranks, served to readers with
+    // locked definitions instead of the aggregated metadata
+    std::atomic<int64_t> m_LatestAggregatedStep{-1};
     std::unordered_map<std::string, Params> m_CompressionParams;
     std::mutex m_CompressionParamsMutex;
 
+#ifdef ADIOS2_HAVE_MPI
+    // Readers with locked definitions register their request plan once and
+    // then MPI_Get the replies from these buffers. The window is dynamic and
+    // spans only the writer and reader ranks of this stream, through a
+    // communicator merged from an intercommunicator over MPI_COMM_WORLD. It
+    // is only created when both apps are in the same world, confirmed by a
+    // message between the app leaders, otherwise readers keep using the
+    // reply threads. m_RmaDirectory holds the slot address, capacity and
+    // count per reader rank of the stream, each slot is a step and size
+    // header followed by the reply.
+    struct LockedPlan
+    {
+        std::vector<char> request;
+        std::vector<char> slots;
+        size_t capacity = 0;
+    };
+    enum StreamState : int
+    {
+        StreamIdle,
+        StreamPending,
+        StreamConnected,
+        StreamClosed
+    };
+    static constexpr int64_t m_LockedSlots = 4;
+    // a pending reader not confirmed after this many steps and seconds is
+    // in another world or gave up
+    static constexpr int m_StreamWaitSteps = 16;
+    std::atomic<int> m_StreamState{StreamIdle};
+    MPI_Comm m_StreamComm = MPI_COMM_NULL;
+    MPI_Win m_Window = MPI_WIN_NULL;
+    std::atomic<int> m_StreamRank{-1};
+    int m_WorldSize = 0;
+    std::vector<int> m_WorldRanks;
+    // reader leader of the pending connection, set by the reply threads
+    int m_StreamPeer = -1;
+    int m_StreamTag = 0;
+    std::atomic<int64_t> m_StreamNonce{0};
+    int m_StreamWait = 0;
+    std::chrono::system_clock::time_point m_StreamStart;
+    std::mutex m_StreamMutex;
+    std::vector<int64_t> m_RmaDirectory;
+    std::atomic<int64_t> m_RmaDirectoryAddress{0};
+    std::unordered_map<int, LockedPlan> m_LockedPlans;
+    std::vector<std::pair<int, std::vector<char>>> m_PendingPlans;
+    std::mutex m_PendingPlansMutex;
+
+    format::VecPtr AcceptStream(const std::vector<char> &request);
+    int64_t WithdrawStream(const int64_t nonce);
+    void ConnectStream();
+    void DisconnectStream();
+    void PutLockedPlans();
+#endif
+
     void Init() final;
     void InitParameters() final;
     void InitTransports() final;
@@ -182,10 +182,14 @@ void SstParamParser::ParseParams(IO &io, struct _SstParams &Params)
             {
                 parameter = SstQueueFullDiscard;
             }
+            else if (method == "adaptive")
+            {
+                parameter = SstQueueFullAdaptive;
+            }
             else
             {
                 throw std::invalid_argument(
-                    "ERROR: Unknown Sst MarshalMethod parameter \"" + method +
+                    "ERROR: Unknown Sst QueueFullPolicy parameter \"" + method +
                     "\"");
             }
             return true;
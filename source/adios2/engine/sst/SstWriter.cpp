@@ -178,6 +178,13 @@ void SstWriter::PerformPuts() {}
 
 void SstWriter::Flush(const int transportIndex) {}
 
+struct _SstStats SstWriter::GetStats() const
+{
+    struct _SstStats stats = {};
+    SstWriterGetStats(m_Output, &stats);
+    return stats;
+}
+
 // PRIVATE functions below
 void SstWriter::Init()
 {
@@ -41,6 +41,12 @@ public:
     void EndStep() final;
     void Flush(const int transportIndex = -1) final;
 
+    /**
+     * Writer queue statistics since Open, discards, stall time and reader
+     * rates are only complete on rank 0
+     */
+    struct _SstStats GetStats() const;
+
 private:
     void Init(); ///< calls InitCapsules and InitTransports based on Method,
                  /// called from constructor
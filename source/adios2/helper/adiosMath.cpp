@@ -30,6 +30,41 @@ size_t GetTotalSize(const Dims &dimensions) noexcept
                            static_cast<size_t>(1), std::multiplies<size_t>());
 }
 
+// GCC on x86-64 glibc (ifunc) can build each kernel for several instruction
+// sets and pick the best one at load time
+#if defined(__GNUC__) && !defined(__clang__) && !defined(__INTEL_COMPILER) && \
+    (__GNUC__ >= 6) && defined(__x86_64__) && defined(__ELF__) &&            \
+    defined(__GLIBC__)
+#define ADIOS2_MINMAX_TARGETS                                                  \
+    __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define ADIOS2_MINMAX_TARGETS
+#endif
+
+#define declare_type(T)                                                        \
+    ADIOS2_MINMAX_TARGETS void GetMinMaxVectorized(                            \
+        const T *values, const size_t size, T &min, T &max) noexcept           \
+    {                                                                          \
+        GetMinMaxLanes(values, size, min, max);                                \
+    }
+ADIOS2_FOREACH_ATTRIBUTE_PRIMITIVE_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
+ADIOS2_MINMAX_TARGETS void
+GetMinMaxVectorized(const std::complex<float> *values, const size_t size,
+                    std::complex<float> &min, std::complex<float> &max) noexcept
+{
+    GetMinMaxComplexLanes(values, size, min, max);
+}
+
+ADIOS2_MINMAX_TARGETS void
+GetMinMaxVectorized(const std::complex<double> *values, const size_t size,
+                    std::complex<double> &min,
+                    std::complex<double> &max) noexcept
+{
+    GetMinMaxComplexLanes(values, size, min, max);
+}
+
 bool CheckIndexRange(const int index, const int upperLimit,
                      const int lowerLimit) noexcept
 {
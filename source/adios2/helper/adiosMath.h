@@ -15,6 +15,7 @@
 #include <vector>
 /// \endcond
 
+#include "adios2/ADIOSMacros.h"
 #include "adios2/ADIOSTypes.h"
 
 namespace adios2
@@ -79,7 +80,7 @@ void GetMinMaxComplex(const std::complex<T> *values, const size_t size,
  */
 template <class T>
 void GetMinMaxThreads(const T *values, const size_t size, T &min, T &max,
-                      const unsigned int threads = 1) noexcept;
+                      const unsigned int threads = 1);
 
 /**
  * Overloaded version of GetMinMaxThreads for complex types
@@ -91,7 +92,43 @@ void GetMinMaxThreads(const T *values, const size_t size, T &min, T &max,
  */
 template <class T>
 void GetMinMaxThreads(const std::complex<T> *values, const size_t size, T &min,
-                      T &max, const unsigned int threads = 1) noexcept;
+                      T &max, const unsigned int threads = 1);
+
+/**
+ * Gets the min and max from values spaced by stride elements, used for
+ * non-contiguous memory selections
+ * @param values input array
+ * @param size number of values to check
+ * @param stride distance between values, in elements
+ * @param min of values
+ * @param max of values
+ */
+template <class T>
+void GetMinMaxStrided(const T *values, const size_t size, const size_t stride,
+                      T &min, T &max) noexcept;
+
+/**
+ * Compiled kernels behind GetMinMax for primitive and complex types, built
+ * for several instruction sets selected at runtime where the compiler
+ * supports it
+ * @param values input array
+ * @param size of values array, must be > 0
+ * @param min of values
+ * @param max of values
+ */
+#define declare_type(T)                                                        \
+    void GetMinMaxVectorized(const T *values, const size_t size, T &min,       \
+                             T &max) noexcept;
+ADIOS2_FOREACH_ATTRIBUTE_PRIMITIVE_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
+void GetMinMaxVectorized(const std::complex<float> *values, const size_t size,
+                         std::complex<float> &min,
+                         std::complex<float> &max) noexcept;
+
+void GetMinMaxVectorized(const std::complex<double> *values, const size_t size,
+                         std::complex<double> &min,
+                         std::complex<double> &max) noexcept;
 
 /**
  * Check if index is within (inclusive) limits
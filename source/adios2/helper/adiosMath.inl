@@ -17,9 +17,9 @@
 #include <algorithm> // std::minmax_element, std::min_element, std::max_element
                      // std::transform
 #include <limits>    //std::numeri_limits
-#include <thread>
 
 #include "adios2/ADIOSMacros.h"
+#include "adios2/helper/adiosThreadPool.h" //GetThreadPool
 
 namespace adios2
 {
@@ -31,164 +31,278 @@ void GetMinMaxSelection(const T *values, const Dims &shape, const Dims &start,
                         const Dims &count, const bool isRowMajor, T &min,
                         T &max) noexcept
 {
-    auto lf_MinMaxRowMajor = [](const T *values, const Dims &shape,
-                                const Dims &start, const Dims &count, T &min,
-                                T &max) {
-        // loop through selection box contiguous part
-        const size_t dimensions = shape.size();
-        const size_t stride = count.back();
-        const size_t startCoord = dimensions - 2;
-
-        Dims currentPoint(start); // current point for contiguous memory
-        bool run = true;
-        bool firstStep = true;
-
-        while (run)
-        {
-            // here copy current linear memory between currentPoint and end
-            const size_t startOffset = helper::LinearIndex(
-                Dims(shape.size(), 0), shape, currentPoint, true);
+    const size_t dimensions = shape.size();
+    if (GetTotalSize(count) == 0)
+    {
+        return;
+    }
 
-            T minStride, maxStride;
-            GetMinMax(values + startOffset, stride, minStride, maxStride);
+    if (dimensions == 1)
+    {
+        const size_t startOffset =
+            helper::LinearIndex(Dims(1, 0), shape, start, isRowMajor);
+        const size_t totalSize = helper::GetTotalSize(count);
+        GetMinMax(values + startOffset, totalSize, min, max);
+        return;
+    }
 
-            if (firstStep)
-            {
-                min = minStride;
-                max = maxStride;
-                firstStep = false;
-            }
-            else
-            {
-                if (LessThan(minStride, min))
-                {
-                    min = minStride;
-                }
-
-                if (GreaterThan(maxStride, max))
-                {
-                    max = maxStride;
-                }
-            }
+    // loop in row-major order, column-major is the reverse
+    Dims rShape(shape);
+    Dims rStart(start);
+    Dims rCount(count);
+    if (!isRowMajor)
+    {
+        std::reverse(rShape.begin(), rShape.end());
+        std::reverse(rStart.begin(), rStart.end());
+        std::reverse(rCount.begin(), rCount.end());
+    }
 
-            size_t p = startCoord;
-            while (true)
-            {
-                ++currentPoint[p];
-                if (currentPoint[p] > start[p] + count[p] - 1)
-                {
-                    if (p == 0)
-                    {
-                        run = false; // we are done
-                        break;
-                    }
-                    else
-                    {
-                        currentPoint[p] = start[p];
-                        --p;
-                    }
-                }
-                else
-                {
-                    break; // break inner p loop
-                }
-            } // dimension index update
-        }     // end while stride loop
-    };
+    // element strides per dimension
+    Dims strides(dimensions, 1);
+    for (size_t d = dimensions - 1; d > 0; --d)
+    {
+        strides[d - 1] = strides[d] * rShape[d];
+    }
+
+    // runs go along the fastest dimension with more than one element, they
+    // are contiguous unless the selection is a single column
+    size_t runDimension = dimensions - 1;
+    while (runDimension > 0 && rCount[runDimension] == 1)
+    {
+        --runDimension;
+    }
+    const size_t runSize = rCount[runDimension];
+    const size_t runStride = strides[runDimension];
+
+    size_t offset = 0;
+    for (size_t d = 0; d < dimensions; ++d)
+    {
+        offset += rStart[d] * strides[d];
+    }
 
-    auto lf_MinMaxColumnMajor = [](const T *values, const Dims &shape,
-                                   const Dims &start, const Dims &count, T &min,
-                                   T &max) {
-        // loop through selection box contiguous part
-        const size_t dimensions = shape.size();
-        const size_t stride = count.front();
-        const size_t startCoord = 1;
+    // offsets are updated incrementally, dimensions [0, runDimension)
+    Dims point(dimensions, 0);
+    bool run = true;
+    bool firstRun = true;
 
-        Dims currentPoint(start); // current point for contiguous memory
-        bool run = true;
-        bool firstStep = true;
+    while (run)
+    {
+        T minRun, maxRun;
+        GetMinMaxStrided(values + offset, runSize, runStride, minRun, maxRun);
 
-        while (run)
+        if (firstRun)
+        {
+            min = minRun;
+            max = maxRun;
+            firstRun = false;
+        }
+        else
         {
-            // here copy current linear memory between currentPoint and end
-            const size_t startOffset = helper::LinearIndex(
-                Dims(shape.size(), 0), shape, currentPoint, false);
+            if (LessThan(minRun, min))
+            {
+                min = minRun;
+            }
 
-            T minStride, maxStride;
-            GetMinMax(values + startOffset, stride, minStride, maxStride);
+            if (GreaterThan(maxRun, max))
+            {
+                max = maxRun;
+            }
+        }
 
-            if (firstStep)
+        size_t d = runDimension;
+        while (true)
+        {
+            if (d == 0)
             {
-                min = minStride;
-                max = maxStride;
-                firstStep = false;
+                run = false; // we are done
+                break;
             }
-            else
+            --d;
+
+            if (++point[d] < rCount[d])
             {
-                if (LessThan(minStride, min))
-                {
-                    min = minStride;
-                }
-
-                if (GreaterThan(maxStride, max))
-                {
-                    max = maxStride;
-                }
+                offset += strides[d];
+                break;
             }
 
-            size_t p = startCoord;
+            offset -= (rCount[d] - 1) * strides[d];
+            point[d] = 0;
+        }
+    }
+}
+
+template <class T>
+inline void GetMinMaxLanes(const T *values, const size_t size, T &min,
+                           T &max) noexcept
+{
+    // independent lanes updated without branches are turned into packed
+    // min/max instructions by the compiler, min and max come from one pass
+    constexpr size_t lanes = (sizeof(T) < 64) ? 64 / sizeof(T) : 1;
+
+    min = values[0];
+    max = values[0];
+    size_t i = 0;
+
+    if (size >= 2 * lanes)
+    {
+        T mins[lanes];
+        T maxs[lanes];
+        for (size_t l = 0; l < lanes; ++l)
+        {
+            mins[l] = values[0];
+            maxs[l] = values[0];
+        }
 
-            while (true)
+        const size_t end = size - size % lanes;
+        for (; i < end; i += lanes)
+        {
+            for (size_t l = 0; l < lanes; ++l)
             {
-                ++currentPoint[p];
-                if (currentPoint[p] > start[p] + count[p] - 1)
-                {
-                    if (p == dimensions - 1)
-                    {
-                        run = false; // we are done
-                        break;
-                    }
-                    else
-                    {
-                        currentPoint[p] = start[p];
-                        ++p;
-                    }
-                }
-                else
-                {
-                    break; // break inner p loop
-                }
-            } // dimension index update
-
-        } // end while stride loop
-    };
+                const T value = values[i + l];
+                mins[l] = (value < mins[l]) ? value : mins[l];
+                maxs[l] = (maxs[l] < value) ? value : maxs[l];
+            }
+        }
 
-    if (shape.size() == 1)
+        for (size_t l = 0; l < lanes; ++l)
+        {
+            min = (mins[l] < min) ? mins[l] : min;
+            max = (max < maxs[l]) ? maxs[l] : max;
+        }
+    }
+
+    for (; i < size; ++i)
     {
-        const size_t startOffset =
-            helper::LinearIndex(Dims(1, 0), shape, start, isRowMajor);
-        const size_t totalSize = helper::GetTotalSize(count);
-        GetMinMax(values + startOffset, totalSize, min, max);
-        return;
+        const T value = values[i];
+        min = (value < min) ? value : min;
+        max = (max < value) ? value : max;
     }
+}
 
-    if (isRowMajor)
+template <class T>
+inline void GetMinMaxComplexLanes(const std::complex<T> *values,
+                                  const size_t size, std::complex<T> &min,
+                                  std::complex<T> &max) noexcept
+{
+    // same as GetMinMaxLanes on the modulus, keeping the index of the first
+    // minimum and maximum per lane
+    constexpr size_t lanes = 8;
+
+    auto lf_Norm = [](const std::complex<T> &value) -> T {
+        return value.real() * value.real() + value.imag() * value.imag();
+    };
+
+    T minNorm = lf_Norm(values[0]);
+    T maxNorm = minNorm;
+    size_t minIndex = 0;
+    size_t maxIndex = 0;
+    size_t i = 1;
+
+    if (size >= 2 * lanes)
     {
-        lf_MinMaxRowMajor(values, shape, start, count, min, max);
+        T minNorms[lanes];
+        T maxNorms[lanes];
+        size_t minIndices[lanes];
+        size_t maxIndices[lanes];
+        for (size_t l = 0; l < lanes; ++l)
+        {
+            minNorms[l] = minNorm;
+            maxNorms[l] = maxNorm;
+            minIndices[l] = 0;
+            maxIndices[l] = 0;
+        }
+
+        const size_t end = size - size % lanes;
+        for (i = 0; i < end; i += lanes)
+        {
+            for (size_t l = 0; l < lanes; ++l)
+            {
+                const T norm = lf_Norm(values[i + l]);
+                const bool isMin = norm < minNorms[l];
+                const bool isMax = norm > maxNorms[l];
+                minIndices[l] = isMin ? i + l : minIndices[l];
+                minNorms[l] = isMin ? norm : minNorms[l];
+                maxIndices[l] = isMax ? i + l : maxIndices[l];
+                maxNorms[l] = isMax ? norm : maxNorms[l];
+            }
+        }
+
+        // ties go to the first index, as in a sequential search
+        for (size_t l = 0; l < lanes; ++l)
+        {
+            if (minNorms[l] < minNorm ||
+                (minNorms[l] == minNorm && minIndices[l] < minIndex))
+            {
+                minNorm = minNorms[l];
+                minIndex = minIndices[l];
+            }
+
+            if (maxNorms[l] > maxNorm ||
+                (maxNorms[l] == maxNorm && maxIndices[l] < maxIndex))
+            {
+                maxNorm = maxNorms[l];
+                maxIndex = maxIndices[l];
+            }
+        }
     }
-    else
+
+    for (; i < size; ++i)
     {
-        lf_MinMaxColumnMajor(values, shape, start, count, min, max);
+        const T norm = lf_Norm(values[i]);
+        if (norm < minNorm)
+        {
+            minNorm = norm;
+            minIndex = i;
+        }
+        else if (norm > maxNorm)
+        {
+            maxNorm = norm;
+            maxIndex = i;
+        }
     }
+
+    min = values[minIndex];
+    max = values[maxIndex];
 }
 
 template <class T>
 inline void GetMinMax(const T *values, const size_t size, T &min,
                       T &max) noexcept
 {
-    auto bounds = std::minmax_element(values, values + size);
-    min = *bounds.first;
-    max = *bounds.second;
+    GetMinMaxLanes(values, size, min, max);
+}
+
+#define declare_type(T)                                                        \
+    template <>                                                                \
+    inline void GetMinMax<T>(const T *values, const size_t size, T &min,       \
+                             T &max) noexcept                                  \
+    {                                                                          \
+        GetMinMaxVectorized(values, size, min, max);                           \
+    }
+ADIOS2_FOREACH_ATTRIBUTE_PRIMITIVE_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
+template <class T>
+void GetMinMaxComplex(const std::complex<T> *values, const size_t size,
+                      std::complex<T> &min, std::complex<T> &max) noexcept
+{
+    GetMinMaxComplexLanes(values, size, min, max);
+}
+
+template <>
+inline void GetMinMaxComplex(const std::complex<float> *values,
+                             const size_t size, std::complex<float> &min,
+                             std::complex<float> &max) noexcept
+{
+    GetMinMaxVectorized(values, size, min, max);
+}
+
+template <>
+inline void GetMinMaxComplex(const std::complex<double> *values,
+                             const size_t size, std::complex<double> &min,
+                             std::complex<double> &max) noexcept
+{
+    GetMinMaxVectorized(values, size, min, max);
 }
 
 template <>
@@ -208,81 +322,65 @@ inline void GetMinMax(const std::complex<double> *values, const size_t size,
 }
 
 template <class T>
-void GetMinMaxComplex(const std::complex<T> *values, const size_t size,
-                      std::complex<T> &min, std::complex<T> &max) noexcept
+void GetMinMaxStrided(const T *values, const size_t size, const size_t stride,
+                      T &min, T &max) noexcept
 {
+    if (stride == 1)
+    {
+        GetMinMax(values, size, min, max);
+        return;
+    }
+
     min = values[0];
     max = values[0];
-
-    T minNorm = std::norm(values[0]);
-    T maxNorm = minNorm;
-
-    for (auto i = 1; i < size; ++i)
+    for (size_t i = 1; i < size; ++i)
     {
-        T norm = std::norm(values[i]);
-
-        if (norm < minNorm)
+        const T value = values[i * stride];
+        if (LessThan(value, min))
         {
-            minNorm = norm;
-            min = values[i];
-            continue;
+            min = value;
         }
-
-        if (norm > maxNorm)
+        else if (GreaterThan(value, max))
         {
-            maxNorm = norm;
-            max = values[i];
+            max = value;
         }
     }
 }
 
 template <class T>
 void GetMinMaxThreads(const T *values, const size_t size, T &min, T &max,
-                      const unsigned int threads) noexcept
+                      const unsigned int threads)
 {
     if (size == 0)
     {
         return;
     }
 
-    if (threads == 1 || threads > size)
+    // below this many elements per thread the single pass kernel is faster
+    // than waking up workers
+    const size_t minStride = 65536;
+    const unsigned int usedThreads = static_cast<unsigned int>(
+        std::min(static_cast<size_t>(threads), size / minStride));
+
+    if (usedThreads <= 1)
     {
         GetMinMax(values, size, min, max);
         return;
     }
 
-    const size_t stride = size / threads;    // elements per thread
-    const size_t remainder = size % threads; // remainder if not aligned
+    const size_t stride = size / usedThreads;    // elements per thread
+    const size_t remainder = size % usedThreads; // remainder if not aligned
     const size_t last = stride + remainder;
 
-    std::vector<T> mins(threads); // zero init
-    std::vector<T> maxs(threads); // zero init
-
-    std::vector<std::thread> getMinMaxThreads;
-    getMinMaxThreads.reserve(threads);
+    std::vector<T> mins(usedThreads); // zero init
+    std::vector<T> maxs(usedThreads); // zero init
 
-    for (unsigned int t = 0; t < threads; ++t)
-    {
-        const size_t position = stride * t;
-
-        if (t == threads - 1)
-        {
-            getMinMaxThreads.push_back(
-                std::thread(GetMinMax<T>, &values[position], last,
-                            std::ref(mins[t]), std::ref(maxs[t])));
-        }
-        else
-        {
-            getMinMaxThreads.push_back(
-                std::thread(GetMinMax<T>, &values[position], stride,
-                            std::ref(mins[t]), std::ref(maxs[t])));
-        }
-    }
-
-    for (auto &getMinMaxThread : getMinMaxThreads)
-    {
-        getMinMaxThread.join();
-    }
+    GetThreadPool().ParallelFor(
+        usedThreads, usedThreads, [&](const size_t t) {
+            const size_t position = stride * t;
+            GetMinMax(&values[position], (t == usedThreads - 1) ? last : stride,
+                      mins[t], maxs[t]);
+        });
 
     auto itMin = std::min_element(mins.begin(), mins.end());
     min = *itMin;
@@ -294,51 +392,37 @@ void GetMinMaxThreads(const T *values, const size_t size, T &min, T &max,
 template <class T>
 void GetMinMaxThreads(const std::complex<T> *values, const size_t size,
                       std::complex<T> &min, std::complex<T> &max,
-                      const unsigned int threads) noexcept
+                      const unsigned int threads)
 {
     if (size == 0)
     {
         return;
     }
 
-    if (threads == 1)
+    const size_t minStride = 65536;
+    const unsigned int usedThreads = static_cast<unsigned int>(
+        std::min(static_cast<size_t>(threads), size / minStride));
+
+    if (usedThreads <= 1)
     {
         GetMinMaxComplex(values, size, min, max);
         return;
     }
 
-    const size_t stride = size / threads;    // elements per thread
-    const size_t remainder = size % threads; // remainder if not aligned
+    const size_t stride = size / usedThreads;    // elements per thread
+    const size_t remainder = size % usedThreads; // remainder if not aligned
     const size_t last = stride + remainder;
 
-    std::vector<std::complex<T>> mins(threads); // zero init
-    std::vector<std::complex<T>> maxs(threads); // zero init
-
-    std::vector<std::thread> getMinMaxThreads;
-    getMinMaxThreads.reserve(threads);
-
-    for (unsigned int t = 0; t < threads; ++t)
-    {
-        const size_t position = stride * t;
+    std::vector<std::complex<T>> mins(usedThreads); // zero init
+    std::vector<std::complex<T>> maxs(usedThreads); // zero init
 
-        if (t == threads - 1)
-        {
-            getMinMaxThreads.push_back(
-                std::thread(GetMinMaxComplex<T>, &values[position], last,
-                            std::ref(mins[t]), std::ref(maxs[t])));
-        }
-        else
-        {
-            getMinMaxThreads.push_back(
-                std::thread(GetMinMaxComplex<T>, &values[position], stride,
-                            std::ref(mins[t]), std::ref(maxs[t])));
-        }
-    }
-
-    for (auto &getMinMaxThread : getMinMaxThreads)
-    {
-        getMinMaxThread.join();
-    }
+    GetThreadPool().ParallelFor(
+        usedThreads, usedThreads, [&](const size_t t) {
+            const size_t position = stride * t;
+            GetMinMaxComplex(&values[position],
+                             (t == usedThreads - 1) ? last : stride, mins[t],
+                             maxs[t]);
+        });
 
     std::complex<T> minTemp;
     std::complex<T> maxTemp;
@@ -0,0 +1,163 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * adiosThreadPool.cpp
+ */
+
+#include "adiosThreadPool.h"
+
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <algorithm> //std::min
+#include <atomic>
+#include <exception> //std::exception_ptr
+/// \endcond
+
+namespace adios2
+{
+namespace helper
+{
+
+/** a ParallelFor call, shared by the caller and the workers helping it */
+struct ThreadPool::Job
+{
+    const std::function<void(const size_t)> *Task = nullptr;
+    size_t Tasks = 0;
+    std::atomic<size_t> Next{0};
+    std::atomic<size_t> Done{0};
+
+    std::mutex Mutex;
+    std::condition_variable CV;
+    std::exception_ptr Exception;
+};
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stop = true;
+    }
+    m_CV.notify_all();
+
+    for (auto &worker : m_Workers)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::ParallelFor(const size_t tasks, const unsigned int threads,
+                             const std::function<void(const size_t)> &task)
+{
+    if (tasks == 0)
+    {
+        return;
+    }
+
+    const size_t helpers =
+        std::min(static_cast<size_t>(threads > 0 ? threads - 1 : 0),
+                 tasks - 1);
+    if (helpers == 0)
+    {
+        for (size_t i = 0; i < tasks; ++i)
+        {
+            task(i);
+        }
+        return;
+    }
+
+    auto job = std::make_shared<Job>();
+    job->Task = &task;
+    job->Tasks = tasks;
+
+    Reserve(helpers);
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        for (size_t h = 0; h < helpers; ++h)
+        {
+            m_Queue.push_back(job);
+        }
+    }
+    m_CV.notify_all();
+
+    RunJob(*job);
+
+    std::unique_lock<std::mutex> lock(job->Mutex);
+    job->CV.wait(lock, [&]() { return job->Done == job->Tasks; });
+
+    if (job->Exception)
+    {
+        std::rethrow_exception(job->Exception);
+    }
+}
+
+size_t ThreadPool::Size() const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Workers.size();
+}
+
+// PRIVATE
+void ThreadPool::Reserve(const size_t workers)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    while (m_Workers.size() < workers)
+    {
+        m_Workers.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+}
+
+void ThreadPool::WorkerLoop()
+{
+    while (true)
+    {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_CV.wait(lock, [&]() { return m_Stop || !m_Queue.empty(); });
+            if (m_Stop && m_Queue.empty())
+            {
+                return;
+            }
+            job = std::move(m_Queue.front());
+            m_Queue.pop_front();
+        }
+
+        // the job might be finished by others already, then this is a no-op
+        RunJob(*job);
+    }
+}
+
+void ThreadPool::RunJob(Job &job)
+{
+    size_t i;
+    while ((i = job.Next++) < job.Tasks)
+    {
+        try
+        {
+            (*job.Task)(i);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(job.Mutex);
+            if (!job.Exception)
+            {
+                job.Exception = std::current_exception();
+            }
+        }
+
+        if (++job.Done == job.Tasks)
+        {
+            std::lock_guard<std::mutex> lock(job.Mutex);
+            job.CV.notify_all();
+        }
+    }
+}
+
+ThreadPool &GetThreadPool()
+{
+    static ThreadPool threadPool;
+    return threadPool;
+}
+
+} // end namespace helper
+} // end namespace adios2
@@ -0,0 +1,78 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * adiosThreadPool.h persistent worker threads shared by helper functions
+ */
+
+#ifndef ADIOS2_HELPER_ADIOSTHREADPOOL_H_
+#define ADIOS2_HELPER_ADIOSTHREADPOOL_H_
+
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+/// \endcond
+
+namespace adios2
+{
+namespace helper
+{
+
+/**
+ * Workers are created on demand and live until the pool is destroyed, so
+ * repeated parallel loops (e.g. min/max per Put) don't pay for thread
+ * creation. The calling thread always takes part in its own loop, nested
+ * loops from inside a task can't deadlock.
+ */
+class ThreadPool
+{
+
+public:
+    ThreadPool() = default;
+
+    /** joins all workers */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * Runs task(i) for i in [0, tasks) and returns when all are done
+     * @param tasks number of task calls
+     * @param threads max number of threads working on the loop, including
+     * the caller, workers are added to the pool if needed
+     * @param task called with the task index, the first exception thrown by
+     * a task is rethrown to the caller
+     */
+    void ParallelFor(const size_t tasks, const unsigned int threads,
+                     const std::function<void(const size_t)> &task);
+
+    /** current number of workers */
+    size_t Size() const;
+
+private:
+    struct Job;
+
+    std::vector<std::thread> m_Workers;
+    std::deque<std::shared_ptr<Job>> m_Queue;
+    mutable std::mutex m_Mutex;
+    std::condition_variable m_CV;
+    bool m_Stop = false;
+
+    void Reserve(const size_t workers);
+    void WorkerLoop();
+    static void RunJob(Job &job);
+};
+
+/** process-wide pool used by helper functions */
+ThreadPool &GetThreadPool();
+
+} // end namespace helper
+} // end namespace adios2
+
+#endif /* ADIOS2_HELPER_ADIOSTHREADPOOL_H_ */
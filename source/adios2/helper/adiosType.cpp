@@ -213,5 +213,22 @@ std::string OpenModeToString(const Mode openMode, const bool oneLetter) noexcept
     return openModeString;
 }
 
+DataType GetDataTypeFromString(const std::string &type) noexcept
+{
+    if (type == "compound")
+    {
+        return DataType::Compound;
+    }
+#define declare_type(T)                                                        \
+    else if (type == GetType<T>())                                             \
+    {                                                                          \
+        return GetDataType<T>();                                               \
+    }
+    ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
+    return DataType::None;
+}
+
 } // end namespace helper
 } // end namespace adios2
@@ -103,6 +103,21 @@ struct SubStreamBoxInfo
 template <class T>
 std::string GetType() noexcept;
 
+/**
+ * Gets the DataType enum from template parameter T, usable as a case label
+ * to dispatch on VariableBase::m_DataType without string comparisons
+ * @return DataType matching GetType<T>()
+ */
+template <class T>
+constexpr DataType GetDataType() noexcept;
+
+/**
+ * Maps a type string from GetType<T>() (or "compound") to its DataType
+ * @param type input type string
+ * @return matching DataType, DataType::None if unknown
+ */
+DataType GetDataTypeFromString(const std::string &type) noexcept;
+
 /**
  * Check in types set if "type" is one of the aliases for a certain type,
  * (e.g. if type = integer is an accepted alias for "int", returning true)
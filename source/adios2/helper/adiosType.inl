@@ -96,6 +96,77 @@ inline std::string GetType<std::complex<double>>() noexcept
     return "double complex";
 }
 
+template <>
+constexpr DataType GetDataType<std::string>() noexcept
+{
+    return DataType::String;
+}
+template <>
+constexpr DataType GetDataType<int8_t>() noexcept
+{
+    return DataType::Int8;
+}
+template <>
+constexpr DataType GetDataType<uint8_t>() noexcept
+{
+    return DataType::UInt8;
+}
+template <>
+constexpr DataType GetDataType<int16_t>() noexcept
+{
+    return DataType::Int16;
+}
+template <>
+constexpr DataType GetDataType<uint16_t>() noexcept
+{
+    return DataType::UInt16;
+}
+template <>
+constexpr DataType GetDataType<int32_t>() noexcept
+{
+    return DataType::Int32;
+}
+template <>
+constexpr DataType GetDataType<uint32_t>() noexcept
+{
+    return DataType::UInt32;
+}
+template <>
+constexpr DataType GetDataType<int64_t>() noexcept
+{
+    return DataType::Int64;
+}
+template <>
+constexpr DataType GetDataType<uint64_t>() noexcept
+{
+    return DataType::UInt64;
+}
+template <>
+constexpr DataType GetDataType<float>() noexcept
+{
+    return DataType::Float;
+}
+template <>
+constexpr DataType GetDataType<double>() noexcept
+{
+    return DataType::Double;
+}
+template <>
+constexpr DataType GetDataType<long double>() noexcept
+{
+    return DataType::LongDouble;
+}
+template <>
+constexpr DataType GetDataType<std::complex<float>>() noexcept
+{
+    return DataType::FloatComplex;
+}
+template <>
+constexpr DataType GetDataType<std::complex<double>>() noexcept
+{
+    return DataType::DoubleComplex;
+}
+
 template <class T>
 bool IsTypeAlias(
     const std::string type,
@@ -0,0 +1,393 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * CompressShuffleLZ.cpp
+ */
+
+#include "CompressShuffleLZ.h"
+
+#include <cstdint>
+#include <cstring>   //std::memcpy
+#include <stdexcept> //std::invalid_argument
+#include <vector>
+
+#include "adios2/helper/adiosFunctions.h"
+
+namespace adios2
+{
+namespace core
+{
+namespace compress
+{
+
+namespace
+{
+
+/*
+ * LZ77 stream of sequences, each one:
+ *   token: 4 bits literals length, 4 bits match length - MinMatch
+ *   [literals length - 15 in 255-byte steps, if token nibble is 15]
+ *   literals
+ *   2 bytes little-endian match offset (absent in the last sequence)
+ *   [match length - MinMatch - 15 in 255-byte steps, if token nibble is 15]
+ */
+constexpr size_t MinMatch = 4;
+constexpr size_t MaxOffset = 65535;
+constexpr size_t HashLog = 14;
+
+inline uint32_t Read32(const uint8_t *source) noexcept
+{
+    uint32_t value;
+    std::memcpy(&value, source, sizeof(uint32_t));
+    return value;
+}
+
+inline size_t Hash(const uint32_t sequence) noexcept
+{
+    return static_cast<size_t>((sequence * 2654435761U) >> (32 - HashLog));
+}
+
+/** byte b of every element goes to plane b, trailing bytes as they are */
+void Shuffle(const uint8_t *source, const size_t size,
+             const size_t elementSize, uint8_t *destination) noexcept
+{
+    const size_t elements = size / elementSize;
+    for (size_t b = 0; b < elementSize; ++b)
+    {
+        uint8_t *plane = destination + b * elements;
+        for (size_t e = 0; e < elements; ++e)
+        {
+            plane[e] = source[e * elementSize + b];
+        }
+    }
+    const size_t tail = elements * elementSize;
+    std::memcpy(destination + tail, source + tail, size - tail);
+}
+
+void Unshuffle(const uint8_t *source, const size_t size,
+               const size_t elementSize, uint8_t *destination) noexcept
+{
+    const size_t elements = size / elementSize;
+    for (size_t b = 0; b < elementSize; ++b)
+    {
+        const uint8_t *plane = source + b * elements;
+        for (size_t e = 0; e < elements; ++e)
+        {
+            destination[e * elementSize + b] = plane[e];
+        }
+    }
+    const size_t tail = elements * elementSize;
+    std::memcpy(destination + tail, source + tail, size - tail);
+}
+
+bool PutLength(size_t length, uint8_t *&out, const uint8_t *outEnd) noexcept
+{
+    for (; length >= 255; length -= 255)
+    {
+        if (out == outEnd)
+        {
+            return false;
+        }
+        *out++ = 255;
+    }
+    if (out == outEnd)
+    {
+        return false;
+    }
+    *out++ = static_cast<uint8_t>(length);
+    return true;
+}
+
+/** matchLength == 0 for the last sequence, false if out of room */
+bool PutSequence(const uint8_t *literals, const size_t literalsLength,
+                 const size_t offset, const size_t matchLength, uint8_t *&out,
+                 const uint8_t *outEnd) noexcept
+{
+    if (out == outEnd)
+    {
+        return false;
+    }
+    uint8_t *token = out++;
+    const size_t matchCode = (matchLength == 0) ? 0 : matchLength - MinMatch;
+    *token = static_cast<uint8_t>(
+        ((literalsLength < 15 ? literalsLength : 15) << 4) |
+        (matchCode < 15 ? matchCode : 15));
+
+    if (literalsLength >= 15 && !PutLength(literalsLength - 15, out, outEnd))
+    {
+        return false;
+    }
+    if (static_cast<size_t>(outEnd - out) < literalsLength)
+    {
+        return false;
+    }
+    std::memcpy(out, literals, literalsLength);
+    out += literalsLength;
+
+    if (matchLength == 0)
+    {
+        return true;
+    }
+
+    if (outEnd - out < 2)
+    {
+        return false;
+    }
+    *out++ = static_cast<uint8_t>(offset & 0xff);
+    *out++ = static_cast<uint8_t>(offset >> 8);
+
+    return matchCode < 15 || PutLength(matchCode - 15, out, outEnd);
+}
+
+/** @return compressed size, 0 if it doesn't fit in capacity */
+size_t LZCompress(const uint8_t *source, const size_t size,
+                  uint8_t *destination, const size_t capacity)
+{
+    uint8_t *out = destination;
+    const uint8_t *outEnd = destination + capacity;
+
+    // positions + 1, 0 is empty
+    std::vector<size_t> table(size_t(1) << HashLog, 0);
+    size_t anchor = 0;
+    size_t position = 0;
+
+    while (position + MinMatch <= size)
+    {
+        const uint32_t sequence = Read32(source + position);
+        size_t &entry = table[Hash(sequence)];
+        const size_t candidate = entry;
+        entry = position + 1;
+
+        if (candidate == 0 || position - (candidate - 1) > MaxOffset ||
+            Read32(source + candidate - 1) != sequence)
+        {
+            // skip faster over data that doesn't match
+            position += 1 + ((position - anchor) >> 6);
+            continue;
+        }
+
+        const size_t match = candidate - 1;
+        size_t length = MinMatch;
+        while (position + length < size &&
+               source[match + length] == source[position + length])
+        {
+            ++length;
+        }
+
+        if (!PutSequence(source + anchor, position - anchor, position - match,
+                         length, out, outEnd))
+        {
+            return 0;
+        }
+        position += length;
+        anchor = position;
+    }
+
+    if (!PutSequence(source + anchor, size - anchor, 0, 0, out, outEnd))
+    {
+        return 0;
+    }
+    return static_cast<size_t>(out - destination);
+}
+
+size_t GetLength(const uint8_t *&in, const uint8_t *inEnd)
+{
+    size_t length = 0;
+    uint8_t byte = 255;
+    while (byte == 255)
+    {
+        if (in == inEnd)
+        {
+            throw std::invalid_argument(
+                "ERROR: truncated length in compressed data, in call to "
+                "CompressShuffleLZ Decompress\n");
+        }
+        byte = *in++;
+        length += byte;
+    }
+    return length;
+}
+
+void LZDecompress(const uint8_t *source, const size_t size,
+                  uint8_t *destination, const size_t sizeOut)
+{
+    const uint8_t *in = source;
+    const uint8_t *inEnd = source + size;
+    uint8_t *out = destination;
+    const uint8_t *outEnd = destination + sizeOut;
+    const std::string hint(", in call to CompressShuffleLZ Decompress\n");
+
+    while (in < inEnd)
+    {
+        const uint8_t token = *in++;
+
+        size_t literalsLength = token >> 4;
+        if (literalsLength == 15)
+        {
+            literalsLength += GetLength(in, inEnd);
+        }
+        if (static_cast<size_t>(inEnd - in) < literalsLength ||
+            static_cast<size_t>(outEnd - out) < literalsLength)
+        {
+            throw std::invalid_argument(
+                "ERROR: literals out of bounds in compressed data" + hint);
+        }
+        std::memcpy(out, in, literalsLength);
+        in += literalsLength;
+        out += literalsLength;
+
+        if (in == inEnd)
+        {
+            break;
+        }
+
+        if (inEnd - in < 2)
+        {
+            throw std::invalid_argument(
+                "ERROR: truncated offset in compressed data" + hint);
+        }
+        const size_t offset =
+            static_cast<size_t>(in[0]) | (static_cast<size_t>(in[1]) << 8);
+        in += 2;
+
+        size_t matchLength = token & 15;
+        if (matchLength == 15)
+        {
+            matchLength += GetLength(in, inEnd);
+        }
+        matchLength += MinMatch;
+
+        if (offset == 0 || offset > static_cast<size_t>(out - destination) ||
+            static_cast<size_t>(outEnd - out) < matchLength)
+        {
+            throw std::invalid_argument(
+                "ERROR: match out of bounds in compressed data" + hint);
+        }
+
+        const uint8_t *match = out - offset;
+        if (offset >= matchLength)
+        {
+            std::memcpy(out, match, matchLength);
+            out += matchLength;
+        }
+        else
+        {
+            // overlapping match repeats the last offset bytes
+            for (size_t i = 0; i < matchLength; ++i)
+            {
+                *out++ = *match++;
+            }
+        }
+    }
+
+    if (out != outEnd)
+    {
+        throw std::invalid_argument(
+            "ERROR: decompressed size " +
+            std::to_string(out - destination) + " doesn't match expected " +
+            std::to_string(sizeOut) + hint);
+    }
+}
+
+} // end empty namespace
+
+CompressShuffleLZ::CompressShuffleLZ(const Params &parameters,
+                                     const bool debugMode)
+: Operator("compress", parameters, debugMode)
+{
+}
+
+size_t CompressShuffleLZ::BufferMaxSize(const size_t sizeIn) const
+{
+    return sizeIn;
+}
+
+size_t CompressShuffleLZ::Compress(const void *dataIn, const Dims &dimensions,
+                                   const size_t elementSize,
+                                   const std::string type, void *bufferOut,
+                                   const Params &parameters) const
+{
+    std::string shuffle("byte");
+    helper::SetParameterValue("Shuffle", m_Parameters, shuffle);
+    helper::SetParameterValue("Shuffle", parameters, shuffle);
+
+    if (m_DebugMode && shuffle != "byte" && shuffle != "none")
+    {
+        throw std::invalid_argument(
+            "ERROR: Shuffle must be byte or none, in call to "
+            "CompressShuffleLZ Compress " +
+            type + "\n");
+    }
+
+    const size_t sizeIn =
+        static_cast<size_t>(helper::GetTotalSize(dimensions) * elementSize);
+    const uint8_t *source = reinterpret_cast<const uint8_t *>(dataIn);
+    uint8_t *dest = reinterpret_cast<uint8_t *>(bufferOut);
+
+    const size_t shuffleSize =
+        (shuffle == "byte" && elementSize > 1 && elementSize <= 255)
+            ? elementSize
+            : 1;
+
+    std::vector<uint8_t> shuffled;
+    if (shuffleSize > 1)
+    {
+        shuffled.resize(sizeIn);
+        Shuffle(source, sizeIn, shuffleSize, shuffled.data());
+        source = shuffled.data();
+    }
+
+    // compressed is header + LZ stream, always smaller than sizeIn so that
+    // Decompress tells it apart from data stored as is
+    if (sizeIn > 2)
+    {
+        dest[0] = static_cast<uint8_t>(shuffleSize);
+        const size_t lzSize =
+            LZCompress(source, sizeIn, dest + 1, sizeIn - 2);
+        if (lzSize > 0)
+        {
+            return lzSize + 1;
+        }
+    }
+
+    std::memcpy(dest, dataIn, sizeIn);
+    return sizeIn;
+}
+
+size_t CompressShuffleLZ::Decompress(const void *bufferIn, const size_t sizeIn,
+                                     void *dataOut, const size_t sizeOut) const
+{
+    const uint8_t *source = reinterpret_cast<const uint8_t *>(bufferIn);
+    uint8_t *dest = reinterpret_cast<uint8_t *>(dataOut);
+
+    if (sizeIn == sizeOut)
+    {
+        std::memcpy(dest, source, sizeOut);
+        return sizeOut;
+    }
+
+    if (sizeIn == 0 || sizeIn > sizeOut)
+    {
+        throw std::invalid_argument(
+            "ERROR: compressed size " + std::to_string(sizeIn) +
+            " is invalid for " + std::to_string(sizeOut) +
+            " bytes, in call to CompressShuffleLZ Decompress\n");
+    }
+
+    const size_t shuffleSize = source[0];
+    if (shuffleSize <= 1)
+    {
+        LZDecompress(source + 1, sizeIn - 1, dest, sizeOut);
+        return sizeOut;
+    }
+
+    std::vector<uint8_t> shuffled(sizeOut);
+    LZDecompress(source + 1, sizeIn - 1, shuffled.data(), sizeOut);
+    Unshuffle(shuffled.data(), sizeOut, shuffleSize, dest);
+    return sizeOut;
+}
+
+} // end namespace compress
+} // end namespace core
+} // end namespace adios2
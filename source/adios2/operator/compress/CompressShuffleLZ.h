@@ -0,0 +1,70 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * CompressShuffleLZ.h : built-in lossless compression, byte shuffle followed
+ * by a fast LZ77 codec, type "compress"
+ */
+
+#ifndef ADIOS2_OPERATOR_COMPRESS_COMPRESSSHUFFLELZ_H_
+#define ADIOS2_OPERATOR_COMPRESS_COMPRESSSHUFFLELZ_H_
+
+#include "adios2/core/Operator.h"
+
+namespace adios2
+{
+namespace core
+{
+namespace compress
+{
+
+class CompressShuffleLZ : public Operator
+{
+
+public:
+    /**
+     * Unique constructor
+     * @param parameters default parameters, Shuffle: byte (default) or none
+     * @param debugMode
+     */
+    CompressShuffleLZ(const Params &parameters, const bool debugMode);
+
+    ~CompressShuffleLZ() = default;
+
+    /** Output never exceeds the input, incompressible data is stored as is */
+    size_t BufferMaxSize(const size_t sizeIn) const final;
+
+    /**
+     * Shuffles the bytes of each element of dataIn into planes, then
+     * compresses them. If the result doesn't shrink, dataIn is copied.
+     * @param dataIn
+     * @param dimensions
+     * @param elementSize
+     * @param type
+     * @param bufferOut at least BufferMaxSize bytes
+     * @param parameters override the ones passed at construction
+     * @return size of compressed buffer in bytes
+     */
+    size_t Compress(const void *dataIn, const Dims &dimensions,
+                    const size_t elementSize, const std::string type,
+                    void *bufferOut,
+                    const Params &parameters = Params()) const final;
+
+    using Operator::Decompress;
+    /**
+     * Reverses Compress
+     * @param bufferIn
+     * @param sizeIn
+     * @param dataOut
+     * @param sizeOut original size in bytes
+     * @return size of decompressed buffer in bytes
+     */
+    size_t Decompress(const void *bufferIn, const size_t sizeIn, void *dataOut,
+                      const size_t sizeOut) const override;
+};
+
+} // end namespace compress
+} // end namespace core
+} // end namespace adios2
+
+#endif /* ADIOS2_OPERATOR_COMPRESS_COMPRESSSHUFFLELZ_H_ */
@@ -57,6 +57,10 @@ public:
 
     virtual void Init(const size_t subStreams, MPI_Comm parentComm);
 
+    /** number of exchange rounds (IExchange...SwapBuffers) per flush, each
+     * round the consumer writes one buffer, default: m_Size */
+    virtual int GetRounds() const noexcept;
+
     virtual std::vector<std::vector<MPI_Request>>
     IExchange(BufferSTL &bufferSTL, const int step) = 0;
 
@@ -77,7 +81,7 @@ public:
     virtual BufferSTL &GetConsumerBuffer(BufferSTL &bufferSTL);
 
     /** closes current aggregator, frees m_Comm */
-    void Close();
+    virtual void Close();
 
 protected:
     /** Init m_Comm splitting assigning ranks to subStreams (balanced except for
@@ -9,6 +9,10 @@
  */
 #include "MPIChain.h"
 
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <numeric> //std::accumulate
+/// \endcond
+
 #include "adios2/ADIOSMPI.h"
 #include "adios2/helper/adiosFunctions.h" //helper::CheckMPIReturn
 
@@ -17,19 +21,17 @@ namespace adios2
 namespace aggregator
 {
 
-MPIChain::MPIChain() : MPIAggregator() {}
+MPIChain::MPIChain() : MPIAggregator()
+{
+    m_Buffers.resize(2);
+    m_RingRequests.resize(m_Buffers.size());
+}
 
 void MPIChain::Init(const size_t subStreams, MPI_Comm parentComm)
 {
     InitComm(subStreams, parentComm);
     HandshakeRank(0);
     HandshakeLinks();
-
-    // add a receiving buffer except for the last rank (only sends)
-    if (m_Rank < m_Size)
-    {
-        m_Buffers.emplace_back(); // just one for now
-    }
 }
 
 std::vector<std::vector<MPI_Request>> MPIChain::IExchange(BufferSTL &bufferSTL,
@@ -40,69 +42,35 @@ std::vector<std::vector<MPI_Request>> MPIChain::IExchange(BufferSTL &bufferSTL,
         return std::vector<std::vector<MPI_Request>>();
     }
 
-    BufferSTL &sendBuffer = GetSender(bufferSTL);
-    const int endRank = m_Size - 1 - step;
-    const bool sender = (m_Rank >= 1 && m_Rank <= endRank) ? true : false;
-    const bool receiver = (m_Rank < endRank) ? true : false;
-
-    std::vector<std::vector<MPI_Request>> requests(2);
-
-    if (sender) // sender
+    if (step == 0)
     {
-        requests[0].resize(1);
+        // one collective gives the sizes of all rounds and absolute positions
+        const size_t size = (m_Rank == 0) ? bufferSTL.m_AbsolutePosition
+                                          : bufferSTL.m_Position;
+        m_Sizes = helper::AllGatherValues(size, m_Comm);
 
-        helper::CheckMPIReturn(MPI_Isend(&sendBuffer.m_Position, 1,
-                                         ADIOS2_MPI_SIZE_T, m_Rank - 1, 0,
-                                         m_Comm, &requests[0][0]),
-                               ", aggregation Isend size at iteration " +
-                                   std::to_string(step) + "\n");
+        const int end = (m_Rank == 0) ? m_Size : m_Rank;
+        m_ExchangeAbsolutePosition = std::accumulate(
+            m_Sizes.begin(), m_Sizes.begin() + end, static_cast<size_t>(0));
 
-        // only send data if buffer larger than 0
-        if (sendBuffer.m_Position > 0)
+        if (IsReceiver(step))
         {
-
-            const std::vector<MPI_Request> requestsISend64 =
-                helper::Isend64(sendBuffer.m_Buffer.data(),
-                                sendBuffer.m_Position, m_Rank - 1, 1, m_Comm,
-                                ", aggregation Isend64 data at iteration " +
-                                    std::to_string(step));
-
-            requests[0].insert(requests[0].end(), requestsISend64.begin(),
-                               requestsISend64.end());
+            IReceive(step);
         }
     }
-    // receive size, resize receiving buffer and receive data
-    if (receiver)
-    {
-        size_t bufferSize = 0;
-        MPI_Request receiveSizeRequest;
-        helper::CheckMPIReturn(MPI_Irecv(&bufferSize, 1, ADIOS2_MPI_SIZE_T,
-                                         m_Rank + 1, 0, m_Comm,
-                                         &receiveSizeRequest),
-                               ", aggregation Irecv size at iteration " +
-                                   std::to_string(step) + "\n");
 
-        MPI_Status receiveStatus;
-        helper::CheckMPIReturn(
-            MPI_Wait(&receiveSizeRequest, &receiveStatus),
-            ", aggregation waiting for receiver size at iteration " +
-                std::to_string(step) + "\n");
-
-        BufferSTL &receiveBuffer = GetReceiver(bufferSTL);
-        ResizeUpdateBufferSTL(
-            bufferSize, receiveBuffer,
-            "in aggregation, when resizing receiving buffer to size " +
-                std::to_string(bufferSize));
-
-        // only receive data if buffer is larger than 0
-        if (bufferSize > 0)
-        {
-            requests[1] =
-                helper::Irecv64(receiveBuffer.m_Buffer.data(),
-                                receiveBuffer.m_Position, m_Rank + 1, 1, m_Comm,
-                                ", aggregation Irecv64 data at iteration " +
-                                    std::to_string(step));
-        }
+    std::vector<std::vector<MPI_Request>> requests(2);
+
+    // data of rank m_Rank + step
+    const size_t size = m_Sizes[m_Rank + step];
+    if (IsSender(step) && size > 0)
+    {
+        BufferSTL &sendBuffer = GetSender(bufferSTL, step);
+        requests[0] = helper::Isend64(sendBuffer.m_Buffer.data(), size,
+                                      m_Rank - 1, 1, m_Comm,
+                                      ", aggregation Isend64 data at "
+                                      "iteration " +
+                                          std::to_string(step));
     }
 
     return requests;
@@ -111,50 +79,12 @@ std::vector<std::vector<MPI_Request>> MPIChain::IExchange(BufferSTL &bufferSTL,
 std::vector<std::vector<MPI_Request>>
 MPIChain::IExchangeAbsolutePosition(BufferSTL &bufferSTL, const int step)
 {
-    if (m_Size == 1)
-    {
-        return std::vector<std::vector<MPI_Request>>();
-    }
-
-    if (m_IsInExchangeAbsolutePosition)
-    {
-        throw std::runtime_error("ERROR: MPIChain::IExchangeAbsolutePosition: "
-                                 "An existing exchange is still active.");
-    }
-
-    const int destination = (step != m_Size - 1) ? step + 1 : 0;
-    std::vector<std::vector<MPI_Request>> requests(2,
-                                                   std::vector<MPI_Request>(1));
-
-    if (step == 0)
+    // positions come from the sizes gathered in IExchange
+    if (m_Size > 1 && step == 0)
     {
-        m_SizeSend =
-            (m_Rank == 0) ? bufferSTL.m_AbsolutePosition : bufferSTL.m_Position;
+        bufferSTL.m_AbsolutePosition = m_ExchangeAbsolutePosition;
     }
-
-    if (m_Rank == step)
-    {
-        m_ExchangeAbsolutePosition =
-            (m_Rank == 0) ? m_SizeSend
-                          : m_SizeSend + bufferSTL.m_AbsolutePosition;
-
-        helper::CheckMPIReturn(
-            MPI_Isend(&m_ExchangeAbsolutePosition, 1, ADIOS2_MPI_SIZE_T,
-                      destination, 0, m_Comm, &requests[0][0]),
-            ", aggregation Isend absolute position at iteration " +
-                std::to_string(step) + "\n");
-    }
-    else if (m_Rank == destination)
-    {
-        helper::CheckMPIReturn(
-            MPI_Irecv(&bufferSTL.m_AbsolutePosition, 1, ADIOS2_MPI_SIZE_T, step,
-                      0, m_Comm, &requests[1][0]),
-            ", aggregation Irecv absolute position at iteration " +
-                std::to_string(step) + "\n");
-    }
-
-    m_IsInExchangeAbsolutePosition = true;
-    return requests;
+    return std::vector<std::vector<MPI_Request>>();
 }
 
 void MPIChain::Wait(std::vector<std::vector<MPI_Request>> &requests,
@@ -165,79 +95,44 @@ void MPIChain::Wait(std::vector<std::vector<MPI_Request>> &requests,
         return;
     }
 
-    const int endRank = m_Size - 1 - step;
-    const bool sender = (m_Rank >= 1 && m_Rank <= endRank) ? true : false;
-    const bool receiver = (m_Rank < endRank) ? true : false;
+    if (IsReceiver(step))
+    {
+        WaitRequests(m_RingRequests[static_cast<size_t>(step) %
+                                    m_Buffers.size()],
+                     ", aggregation waiting for receiver request at "
+                     "iteration " +
+                         std::to_string(step) + "\n");
+    }
 
-    MPI_Status status;
-    if (receiver)
+    if (IsSender(step))
     {
-        for (auto &req : requests[1])
-        {
-            helper::CheckMPIReturn(
-                MPI_Wait(&req, &status),
-                ", aggregation waiting for receiver request at iteration " +
-                    std::to_string(step) + "\n");
-        }
+        WaitRequests(requests[0],
+                     ", aggregation waiting for sender request at iteration " +
+                         std::to_string(step) + "\n");
     }
 
-    if (sender)
+    // the ring entry of the next round was sent, or written, this round
+    if (IsReceiver(step + 1))
     {
-        for (auto &req : requests[0])
-        {
-            helper::CheckMPIReturn(
-                MPI_Wait(&req, &status),
-                ", aggregation waiting for sender request at iteration " +
-                    std::to_string(step) + "\n");
-        }
+        IReceive(step + 1);
     }
 }
 
 void MPIChain::WaitAbsolutePosition(
-    std::vector<std::vector<MPI_Request>> &requests, const int step)
+    std::vector<std::vector<MPI_Request>> & /*requests*/, const int /*step*/)
 {
-    if (m_Size == 1)
-    {
-        return;
-    }
-
-    if (!m_IsInExchangeAbsolutePosition)
-    {
-        throw std::runtime_error("ERROR: MPIChain::WaitAbsolutePosition: An "
-                                 "existing exchange is not active.");
-    }
-
-    MPI_Status status;
-    const int destination = (step != m_Size - 1) ? step + 1 : 0;
-
-    if (m_Rank == destination)
-    {
-        helper::CheckMPIReturn(
-            MPI_Wait(&requests[1][0], &status),
-            ", aggregation Irecv Wait absolute position at iteration " +
-                std::to_string(step) + "\n");
-    }
-
-    if (m_Rank == step)
-    {
-        helper::CheckMPIReturn(
-            MPI_Wait(&requests[0][0], &status),
-            ", aggregation Isend Wait absolute position at iteration " +
-                std::to_string(step) + "\n");
-    }
-    m_IsInExchangeAbsolutePosition = false;
 }
 
-void MPIChain::SwapBuffers(const int /*step*/) noexcept
+void MPIChain::SwapBuffers(const int step) noexcept
 {
-    m_CurrentBufferOrder = (m_CurrentBufferOrder == 0) ? 1 : 0;
+    m_CurrentRound = step + 1;
 }
 
-void MPIChain::ResetBuffers() noexcept { m_CurrentBufferOrder = 0; }
+void MPIChain::ResetBuffers() noexcept { m_CurrentRound = 0; }
 
 BufferSTL &MPIChain::GetConsumerBuffer(BufferSTL &bufferSTL)
 {
-    return GetSender(bufferSTL);
+    return GetSender(bufferSTL, m_CurrentRound);
 }
 
 // PRIVATE
@@ -276,35 +171,61 @@ void MPIChain::HandshakeLinks()
     }
 }
 
-BufferSTL &MPIChain::GetSender(BufferSTL &bufferSTL)
+BufferSTL &MPIChain::GetSender(BufferSTL &bufferSTL, const int step) noexcept
 {
-    if (m_CurrentBufferOrder == 0)
+    if (step == 0)
     {
         return bufferSTL;
     }
-    else
-    {
-        return m_Buffers.front();
-    }
+    return m_Buffers[static_cast<size_t>(step - 1) % m_Buffers.size()];
+}
+
+bool MPIChain::IsSender(const int step) const noexcept
+{
+    return m_Rank >= 1 && m_Rank <= m_Size - 1 - step;
 }
 
-BufferSTL &MPIChain::GetReceiver(BufferSTL &bufferSTL)
+bool MPIChain::IsReceiver(const int step) const noexcept
 {
-    if (m_CurrentBufferOrder == 0)
+    return m_Rank < m_Size - 1 - step;
+}
+
+void MPIChain::IReceive(const int step)
+{
+    // data of rank m_Rank + 1 + step
+    const size_t size = m_Sizes[m_Rank + 1 + step];
+    const size_t index = static_cast<size_t>(step) % m_Buffers.size();
+    BufferSTL &receiveBuffer = m_Buffers[index];
+
+    if (receiveBuffer.m_Buffer.size() < size)
     {
-        return m_Buffers.front();
+        receiveBuffer.Resize(
+            size, "in aggregation, when resizing receiving buffer to size " +
+                      std::to_string(size));
     }
-    else
+    receiveBuffer.m_Position = size;
+
+    std::vector<MPI_Request> &requests = m_RingRequests[index];
+    requests.clear();
+
+    if (size > 0)
     {
-        return bufferSTL;
+        requests = helper::Irecv64(receiveBuffer.m_Buffer.data(), size,
+                                   m_Rank + 1, 1, m_Comm,
+                                   ", aggregation Irecv64 data at iteration " +
+                                       std::to_string(step));
     }
 }
 
-void MPIChain::ResizeUpdateBufferSTL(const size_t newSize, BufferSTL &bufferSTL,
-                                     const std::string hint)
+void MPIChain::WaitRequests(std::vector<MPI_Request> &requests,
+                            const std::string hint)
 {
-    bufferSTL.Resize(newSize, hint);
-    bufferSTL.m_Position = bufferSTL.m_Buffer.size();
+    MPI_Status status;
+    for (auto &request : requests)
+    {
+        helper::CheckMPIReturn(MPI_Wait(&request, &status), hint);
+    }
+    requests.clear();
 }
 
 } // end namespace aggregator
@@ -18,6 +18,13 @@ namespace adios2
 namespace aggregator
 {
 
+/**
+ * Ranks of a substream form a chain towards the consumer (rank 0): each round
+ * every rank sends what it holds to the previous rank and receives the data
+ * of the next one, while the consumer writes. Sizes are gathered once per
+ * flush, so receives are posted without waiting for a size message, into a
+ * ring of m_Buffers as soon as the ring entry was sent.
+ */
 class MPIChain : public MPIAggregator
 {
 
@@ -47,43 +54,42 @@ public:
     BufferSTL &GetConsumerBuffer(BufferSTL &bufferSTL) final;
 
 private:
-    bool m_IsInExchangeAbsolutePosition = false;
-    size_t m_SizeSend = 0;
+    /** m_Position of every m_Comm rank at the current flush, except the
+     * consumer entry which holds its m_AbsolutePosition */
+    std::vector<size_t> m_Sizes;
+
+    /** absolute position of this rank's data in the substream file */
     size_t m_ExchangeAbsolutePosition = 0;
 
-    /** current sender/receiver pair order (0: sender is original buffer and
-    receiver is extra buffer, 1: sender is extra buffer and receiver is the
-    original buffer)*/
-    unsigned int m_CurrentBufferOrder = 0;
+    /** round currently sent, and written by the consumer */
+    int m_CurrentRound = 0;
+
+    /** receives in flight for each m_Buffers entry */
+    std::vector<std::vector<MPI_Request>> m_RingRequests;
 
     void HandshakeLinks();
 
     /**
-     * Returns a reference to the sender buffer depending on
-     * m_CurrentBufferOrder
-     * flag
+     * Returns the buffer sent (or written by the consumer) at a round, the
+     * serializer buffer at round 0, then the ring entry received the round
+     * before
      * @param bufferSTL original buffer from serializer
+     * @param step round
      * @return reference to sender buffer
      */
-    BufferSTL &GetSender(BufferSTL &bufferSTL);
+    BufferSTL &GetSender(BufferSTL &bufferSTL, const int step) noexcept;
 
-    /**
-     * Returns a reference to the receiver buffer depending on
-     * m_CurrentBufferOrder
-     * flag
-     * @param bufferSTL original buffer from serializer
-     * @return reference to receiver buffer
-     */
-    BufferSTL &GetReceiver(BufferSTL &bufferSTL);
+    /** true: this rank sends to the previous one at round step */
+    bool IsSender(const int step) const noexcept;
 
-    /**
-     * Resizes and updates m_Position in a bufferSTL, used for receiving buffers
-     * @param newSize new size for receiving buffer
-     * @param bufferSTL to be resized
-     * @param hint used in exception error message
-     */
-    void ResizeUpdateBufferSTL(const size_t newSize, BufferSTL &bufferSTL,
-                               const std::string hint);
+    /** true: this rank receives from the next one at round step */
+    bool IsReceiver(const int step) const noexcept;
+
+    /** posts the receive of the data of round step into its ring entry */
+    void IReceive(const int step);
+
+    void WaitRequests(std::vector<MPI_Request> &requests,
+                      const std::string hint);
 };
 
 } // end namespace aggregator
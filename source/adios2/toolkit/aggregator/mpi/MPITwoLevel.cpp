@@ -0,0 +1,331 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * MPITwoLevel.cpp
+ */
+#include "MPITwoLevel.h"
+
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <algorithm> //std::min
+#include <cstring>   //std::strncmp
+#include <numeric>   //std::accumulate
+/// \endcond
+
+#include "adios2/ADIOSMPI.h"
+#include "adios2/helper/adiosFunctions.h" //helper::CheckMPIReturn
+
+namespace adios2
+{
+namespace aggregator
+{
+
+MPITwoLevel::MPITwoLevel(const size_t nodeGroupSize, const size_t ringSize)
+: MPIAggregator(), m_NodeGroupSize(nodeGroupSize)
+{
+    m_Buffers.resize(std::max(ringSize, static_cast<size_t>(2)));
+    m_RingRequests.resize(m_Buffers.size());
+}
+
+MPITwoLevel::~MPITwoLevel()
+{
+    if (m_GroupComm != MPI_COMM_NULL)
+    {
+        helper::CheckMPIReturn(MPI_Comm_free(&m_GroupComm),
+                               "freeing node group comm in MPITwoLevel "
+                               "destructor, not recommended");
+    }
+}
+
+void MPITwoLevel::Init(const size_t subStreams, MPI_Comm parentComm)
+{
+    InitComm(subStreams, parentComm);
+    HandshakeRank(0);
+    InitGroups();
+}
+
+int MPITwoLevel::GetRounds() const noexcept
+{
+    return static_cast<int>(m_GroupBegins.size()) - 1;
+}
+
+std::vector<std::vector<MPI_Request>>
+MPITwoLevel::IExchange(BufferSTL &bufferSTL, const int step)
+{
+    if (m_Size == 1)
+    {
+        return std::vector<std::vector<MPI_Request>>();
+    }
+
+    if (step == 0)
+    {
+        // one collective gives group sizes and absolute positions
+        const size_t size = (m_Rank == 0) ? bufferSTL.m_AbsolutePosition
+                                          : bufferSTL.m_Position;
+        m_Sizes = helper::AllGatherValues(size, m_Comm);
+
+        const int end = (m_Rank == 0) ? m_Size : m_Rank;
+        m_ExchangeAbsolutePosition = std::accumulate(
+            m_Sizes.begin(), m_Sizes.begin() + end, static_cast<size_t>(0));
+
+        GatherGroup(bufferSTL, step);
+
+        if (m_GroupRank == 0 && !m_IsConsumer && bufferSTL.m_Position > 0)
+        {
+            m_SendRequests = helper::Isend64(
+                bufferSTL.m_Buffer.data(), bufferSTL.m_Position, 0, 1, m_Comm,
+                ", aggregation Isend64 group data at iteration " +
+                    std::to_string(step));
+        }
+    }
+
+    if (m_IsConsumer)
+    {
+        // keep every ring buffer except the one being written receiving
+        const int ringSize = static_cast<int>(m_Buffers.size());
+        const int first = (step == 0) ? 1 : step + ringSize - 1;
+        const int last = std::min(step + ringSize - 1, GetRounds() - 1);
+        for (int group = first; group <= last; ++group)
+        {
+            IReceiveGroup(group, step);
+        }
+    }
+
+    return std::vector<std::vector<MPI_Request>>();
+}
+
+std::vector<std::vector<MPI_Request>>
+MPITwoLevel::IExchangeAbsolutePosition(BufferSTL &bufferSTL, const int step)
+{
+    // positions come from the sizes gathered in IExchange
+    if (m_Size > 1 && step == 0)
+    {
+        bufferSTL.m_AbsolutePosition = m_ExchangeAbsolutePosition;
+    }
+    return std::vector<std::vector<MPI_Request>>();
+}
+
+void MPITwoLevel::Wait(std::vector<std::vector<MPI_Request>> & /*requests*/,
+                       const int step)
+{
+    if (m_Size == 1)
+    {
+        return;
+    }
+
+    // the consumer needs the next group before the next round
+    if (m_IsConsumer && step + 1 < GetRounds())
+    {
+        const size_t index = static_cast<size_t>(step) % m_Buffers.size();
+        WaitRequests(m_RingRequests[index],
+                     ", aggregation waiting for group data at iteration " +
+                         std::to_string(step) + "\n");
+    }
+
+    // leaders' data is in flight until the consumer gets to it
+    if (!m_IsConsumer && step == GetRounds() - 1)
+    {
+        WaitRequests(m_SendRequests,
+                     ", aggregation waiting for sender request at iteration " +
+                         std::to_string(step) + "\n");
+    }
+}
+
+void MPITwoLevel::WaitAbsolutePosition(
+    std::vector<std::vector<MPI_Request>> & /*requests*/, const int /*step*/)
+{
+}
+
+void MPITwoLevel::SwapBuffers(const int step) noexcept
+{
+    m_CurrentRound = step + 1;
+}
+
+void MPITwoLevel::ResetBuffers() noexcept { m_CurrentRound = 0; }
+
+BufferSTL &MPITwoLevel::GetConsumerBuffer(BufferSTL &bufferSTL)
+{
+    if (m_CurrentRound == 0)
+    {
+        return bufferSTL;
+    }
+    return GetRingBuffer(m_CurrentRound);
+}
+
+void MPITwoLevel::Close()
+{
+    if (m_GroupComm != MPI_COMM_NULL)
+    {
+        helper::CheckMPIReturn(MPI_Comm_free(&m_GroupComm),
+                               "freeing node group comm at Close\n");
+        m_GroupComm = MPI_COMM_NULL;
+    }
+    MPIAggregator::Close();
+}
+
+// PRIVATE
+void MPITwoLevel::InitGroups()
+{
+    std::vector<char> names(static_cast<size_t>(m_Size) *
+                            MPI_MAX_PROCESSOR_NAME);
+    {
+        char name[MPI_MAX_PROCESSOR_NAME] = {};
+        int length = 0;
+        helper::CheckMPIReturn(MPI_Get_processor_name(name, &length),
+                               "getting node name, MPITwoLevel aggregator, "
+                               "at Open");
+
+        helper::CheckMPIReturn(
+            MPI_Allgather(name, MPI_MAX_PROCESSOR_NAME, MPI_CHAR, names.data(),
+                          MPI_MAX_PROCESSOR_NAME, MPI_CHAR, m_Comm),
+            "gathering node names, MPITwoLevel aggregator, at Open");
+    }
+
+    auto lf_SameNode = [&](const int rank1, const int rank2) -> bool {
+        return std::strncmp(&names[rank1 * MPI_MAX_PROCESSOR_NAME],
+                            &names[rank2 * MPI_MAX_PROCESSOR_NAME],
+                            MPI_MAX_PROCESSOR_NAME) == 0;
+    };
+
+    // groups are runs of consecutive ranks in the same node
+    m_GroupBegins.clear();
+    for (int rank = 0; rank < m_Size; ++rank)
+    {
+        if (rank == 0 || !lf_SameNode(rank - 1, rank) ||
+            (m_NodeGroupSize > 0 &&
+             static_cast<size_t>(rank - m_GroupBegins.back()) >=
+                 m_NodeGroupSize))
+        {
+            m_GroupBegins.push_back(rank);
+        }
+
+        if (rank == m_Rank)
+        {
+            m_Group = m_GroupBegins.size() - 1;
+        }
+    }
+    m_GroupBegins.push_back(m_Size);
+
+    helper::CheckMPIReturn(MPI_Comm_split(m_Comm, m_GroupBegins[m_Group],
+                                          m_Rank, &m_GroupComm),
+                           "creating node group comm with split at Open");
+    MPI_Comm_rank(m_GroupComm, &m_GroupRank);
+}
+
+void MPITwoLevel::GatherGroup(BufferSTL &bufferSTL, const int step)
+{
+    const int groupBegin = m_GroupBegins[m_Group];
+    const int groupSize = m_GroupBegins[m_Group + 1] - groupBegin;
+    if (groupSize == 1)
+    {
+        return;
+    }
+
+    if (m_GroupRank > 0)
+    {
+        if (bufferSTL.m_Position > 0)
+        {
+            std::vector<MPI_Request> requests = helper::Isend64(
+                bufferSTL.m_Buffer.data(), bufferSTL.m_Position, 0, 0,
+                m_GroupComm, ", aggregation Isend64 node data at iteration " +
+                                 std::to_string(step));
+            WaitRequests(requests,
+                         ", aggregation waiting for node sender request at "
+                         "iteration " +
+                             std::to_string(step) + "\n");
+        }
+        return;
+    }
+
+    // leader: members' data goes right after its own
+    size_t position = bufferSTL.m_Position;
+    const size_t groupDataSize =
+        position + std::accumulate(m_Sizes.begin() + groupBegin + 1,
+                                   m_Sizes.begin() + groupBegin + groupSize,
+                                   static_cast<size_t>(0));
+
+    if (bufferSTL.m_Buffer.size() < groupDataSize)
+    {
+        bufferSTL.Resize(groupDataSize,
+                         "in aggregation, when resizing node group buffer to "
+                         "size " +
+                             std::to_string(groupDataSize));
+    }
+
+    std::vector<MPI_Request> requests;
+    for (int member = 1; member < groupSize; ++member)
+    {
+        const size_t size = m_Sizes[groupBegin + member];
+        if (size == 0)
+        {
+            continue;
+        }
+
+        const std::vector<MPI_Request> memberRequests = helper::Irecv64(
+            bufferSTL.m_Buffer.data() + position, size, member, 0, m_GroupComm,
+            ", aggregation Irecv64 node data at iteration " +
+                std::to_string(step));
+        requests.insert(requests.end(), memberRequests.begin(),
+                        memberRequests.end());
+        position += size;
+    }
+
+    WaitRequests(requests,
+                 ", aggregation waiting for node receiver request at "
+                 "iteration " +
+                     std::to_string(step) + "\n");
+    bufferSTL.m_Position = groupDataSize;
+}
+
+void MPITwoLevel::IReceiveGroup(const int group, const int step)
+{
+    const size_t size = GetGroupDataSize(group);
+    BufferSTL &receiveBuffer = GetRingBuffer(group);
+
+    if (receiveBuffer.m_Buffer.size() < size)
+    {
+        receiveBuffer.Resize(
+            size, "in aggregation, when resizing receiving buffer to size " +
+                      std::to_string(size));
+    }
+    receiveBuffer.m_Position = size;
+
+    std::vector<MPI_Request> &requests =
+        m_RingRequests[static_cast<size_t>(group - 1) % m_Buffers.size()];
+    requests.clear();
+
+    if (size > 0)
+    {
+        requests = helper::Irecv64(receiveBuffer.m_Buffer.data(), size,
+                                   m_GroupBegins[group], 1, m_Comm,
+                                   ", aggregation Irecv64 group data at "
+                                   "iteration " +
+                                       std::to_string(step));
+    }
+}
+
+size_t MPITwoLevel::GetGroupDataSize(const int group) const noexcept
+{
+    return std::accumulate(m_Sizes.begin() + m_GroupBegins[group],
+                           m_Sizes.begin() + m_GroupBegins[group + 1],
+                           static_cast<size_t>(0));
+}
+
+BufferSTL &MPITwoLevel::GetRingBuffer(const int group) noexcept
+{
+    return m_Buffers[static_cast<size_t>(group - 1) % m_Buffers.size()];
+}
+
+void MPITwoLevel::WaitRequests(std::vector<MPI_Request> &requests,
+                               const std::string hint)
+{
+    MPI_Status status;
+    for (auto &request : requests)
+    {
+        helper::CheckMPIReturn(MPI_Wait(&request, &status), hint);
+    }
+    requests.clear();
+}
+
+} // end namespace aggregator
+} // end namespace adios2
@@ -0,0 +1,119 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * MPITwoLevel.h two-level aggregation: node-local gather to a group leader,
+ * then group leaders to the consumer in a pipelined star
+ */
+
+#ifndef ADIOS2_TOOLKIT_AGGREGATOR_MPI_MPITWOLEVEL_H_
+#define ADIOS2_TOOLKIT_AGGREGATOR_MPI_MPITWOLEVEL_H_
+
+#include "adios2/toolkit/aggregator/mpi/MPIAggregator.h"
+
+namespace adios2
+{
+namespace aggregator
+{
+
+/**
+ * Ranks of a substream running on the same node (and contiguous in rank
+ * order, so data keeps the file order) are gathered into their first rank,
+ * the group leader. Leaders then send their group data straight to the
+ * consumer, which writes group r while receiving the next groups into a ring
+ * of m_Buffers. Each byte crosses the network once, unlike MPIChain where
+ * data from rank r is forwarded r times.
+ */
+class MPITwoLevel : public MPIAggregator
+{
+
+public:
+    /**
+     * @param nodeGroupSize max number of ranks in a node group, 0: all ranks
+     * of a node
+     * @param ringSize number of receiving buffers in the consumer, >= 2
+     */
+    MPITwoLevel(const size_t nodeGroupSize = 0, const size_t ringSize = 2);
+
+    ~MPITwoLevel();
+
+    void Init(const size_t subStreams, MPI_Comm parentComm) final;
+
+    /** one round per node group */
+    int GetRounds() const noexcept final;
+
+    std::vector<std::vector<MPI_Request>> IExchange(BufferSTL &bufferSTL,
+                                                    const int step) final;
+
+    std::vector<std::vector<MPI_Request>>
+    IExchangeAbsolutePosition(BufferSTL &bufferSTL, const int step) final;
+
+    void Wait(std::vector<std::vector<MPI_Request>> &requests,
+              const int step) final;
+
+    void WaitAbsolutePosition(std::vector<std::vector<MPI_Request>> &requests,
+                              const int step) final;
+
+    /** advances the round written by the consumer */
+    void SwapBuffers(const int step) noexcept final;
+
+    void ResetBuffers() noexcept final;
+
+    BufferSTL &GetConsumerBuffer(BufferSTL &bufferSTL) final;
+
+    /** also frees the node group comm */
+    void Close() final;
+
+private:
+    const size_t m_NodeGroupSize;
+
+    /** ranks of m_Comm in this rank's node group, leader is rank 0 */
+    MPI_Comm m_GroupComm = MPI_COMM_NULL;
+
+    /** rank from m_GroupComm */
+    int m_GroupRank = 0;
+
+    /** first m_Comm rank of each node group, m_GroupBegins[0] = 0 is the
+     * consumer, followed by m_Size */
+    std::vector<int> m_GroupBegins;
+
+    /** index of this rank's node group in m_GroupBegins */
+    size_t m_Group = 0;
+
+    /** m_Position of every m_Comm rank at the current step, except the
+     * consumer entry which holds its m_AbsolutePosition */
+    std::vector<size_t> m_Sizes;
+
+    /** absolute position of this rank's data in the substream file */
+    size_t m_ExchangeAbsolutePosition = 0;
+
+    /** group currently written by the consumer */
+    int m_CurrentRound = 0;
+
+    /** consumer only: receives in flight for each m_Buffers entry */
+    std::vector<std::vector<MPI_Request>> m_RingRequests;
+
+    /** group leaders only: sends of the group data to the consumer */
+    std::vector<MPI_Request> m_SendRequests;
+
+    void InitGroups();
+
+    /** first level: gathers the group data at the end of the leader's
+     * bufferSTL, blocking */
+    void GatherGroup(BufferSTL &bufferSTL, const int step);
+
+    /** consumer: posts receives for node group into its ring buffer */
+    void IReceiveGroup(const int group, const int step);
+
+    size_t GetGroupDataSize(const int group) const noexcept;
+
+    BufferSTL &GetRingBuffer(const int group) noexcept;
+
+    void WaitRequests(std::vector<MPI_Request> &requests,
+                      const std::string hint);
+};
+
+} // end namespace aggregator
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_AGGREGATOR_MPI_MPITWOLEVEL_H_ */
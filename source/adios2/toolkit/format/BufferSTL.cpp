@@ -10,9 +10,26 @@
 
 #include "BufferSTL.h"
 
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <algorithm> //std::max
+#include <cstdlib>   //std::malloc, std::free
+#include <stdexcept> //std::runtime_error
+/// \endcond
+
+#ifdef __linux__
+#include <sys/mman.h> //madvise
+#endif
+
 namespace adios2
 {
 
+namespace
+{
+/** chunks of at least this size are aligned to and advised for transparent
+ * huge pages where available */
+constexpr size_t HugePageSize = 2 * 1024 * 1024;
+}
+
 void BufferSTL::Resize(const size_t size, const std::string hint)
 {
     try
@@ -36,4 +53,115 @@ size_t BufferSTL::GetAvailableSize() const
     return m_Buffer.size() - m_Position;
 }
 
+size_t BufferSTL::GetReferencesSize(const size_t begin, const size_t end) const
+    noexcept
+{
+    size_t size = 0;
+    for (const Reference &reference : m_References)
+    {
+        if (reference.Position > begin && reference.Position <= end)
+        {
+            size += reference.Size;
+        }
+    }
+    return size;
+}
+
+std::vector<core::iovec> BufferSTL::GetDataV(const size_t size) const
+{
+    std::vector<core::iovec> dataV;
+    dataV.reserve(2 * m_References.size() + 1);
+
+    size_t position = 0;
+    for (const Reference &reference : m_References)
+    {
+        if (reference.Position > size)
+        {
+            break;
+        }
+
+        if (reference.Position > position)
+        {
+            dataV.push_back({m_Buffer.data() + position,
+                             reference.Position - position});
+            position = reference.Position;
+        }
+        dataV.push_back({reference.Data, reference.Size});
+    }
+
+    if (size > position)
+    {
+        dataV.push_back({m_Buffer.data() + position, size - position});
+    }
+    return dataV;
+}
+
+char *BufferSTL::GetChunkSpace(const size_t size, const size_t chunkSize,
+                               const std::string hint)
+{
+    // chunks too small for size are skipped until the next reset
+    while (m_ChunkIndex < m_Chunks.size() &&
+           m_Chunks[m_ChunkIndex].Size - m_ChunkPosition < size)
+    {
+        ++m_ChunkIndex;
+        m_ChunkPosition = 0;
+    }
+
+    if (m_ChunkIndex == m_Chunks.size())
+    {
+        const size_t newSize = std::max(size, chunkSize);
+        void *data = nullptr;
+#ifdef __linux__
+        if (newSize >= HugePageSize)
+        {
+            if (posix_memalign(&data, HugePageSize, newSize) == 0)
+            {
+                madvise(data, newSize, MADV_HUGEPAGE);
+            }
+            else
+            {
+                data = nullptr;
+            }
+        }
+        else
+        {
+            data = std::malloc(newSize);
+        }
+#else
+        data = std::malloc(newSize);
+#endif
+        if (data == nullptr)
+        {
+            throw std::runtime_error(
+                "ERROR: buffer overflow when allocating chunk of " +
+                std::to_string(newSize) + " bytes, " + hint + "\n");
+        }
+
+        Chunk chunk;
+        chunk.Data.reset(static_cast<char *>(data));
+        chunk.Size = newSize;
+        m_Chunks.push_back(std::move(chunk));
+    }
+
+    char *space = m_Chunks[m_ChunkIndex].Data.get() + m_ChunkPosition;
+    m_ChunkPosition += size;
+    m_ChunksSize += size;
+    return space;
+}
+
+size_t BufferSTL::GetChunksSize() const noexcept { return m_ChunksSize; }
+
+void BufferSTL::ResetChunks() noexcept
+{
+    m_ChunkIndex = 0;
+    m_ChunkPosition = 0;
+    m_ChunksSize = 0;
+}
+
+// PRIVATE
+void BufferSTL::ChunkDeleter::operator()(char *data) const noexcept
+{
+    std::free(data);
+}
+
 } // end namespace adios2
@@ -11,6 +11,7 @@
 #ifndef ADIOS2_TOOLKIT_FORMAT_BUFFERSTL_H_
 #define ADIOS2_TOOLKIT_FORMAT_BUFFERSTL_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -26,15 +27,83 @@ public:
     size_t m_Position = 0;
     size_t m_AbsolutePosition = 0;
 
+    /** payload referenced in place instead of copied into m_Buffer */
+    struct Reference
+    {
+        /** the payload goes right before m_Buffer[Position] */
+        size_t Position;
+        const char *Data;
+        size_t Size;
+    };
+
+    /** in m_Buffer order, cleared with m_Position */
+    std::vector<Reference> m_References;
+
     BufferSTL() = default;
     ~BufferSTL() = default;
+    BufferSTL(BufferSTL &&) = default;
 
     void Resize(const size_t size, const std::string hint);
 
     size_t GetAvailableSize() const;
 
+    /**
+     * Size of the references between two m_Buffer positions, so lengths
+     * computed from positions can account for them
+     * @param begin references at begin are not counted
+     * @param end references at end are counted
+     * @return bytes referenced in (begin, end]
+     */
+    size_t GetReferencesSize(const size_t begin, const size_t end) const
+        noexcept;
+
+    /**
+     * Contents with the references in place, for vectored writes
+     * @param size of m_Buffer contents, references past it are excluded
+     * @return buffers in file order
+     */
+    std::vector<core::iovec> GetDataV(const size_t size) const;
+
+    /**
+     * Contiguous space taken from a pool of chunks, for payloads that would
+     * otherwise grow m_Buffer and copy all its contents. Chunk memory is not
+     * initialized, callers must write all of it, and is reused after
+     * ResetChunks.
+     * @param size bytes requested
+     * @param chunkSize size of new chunks, larger if size doesn't fit
+     * @param hint for the exception if allocation fails
+     * @return space valid until ResetChunks
+     */
+    char *GetChunkSpace(const size_t size, const size_t chunkSize,
+                        const std::string hint);
+
+    /** bytes taken from chunks since the last ResetChunks */
+    size_t GetChunksSize() const noexcept;
+
+    /** all chunks become available again, their memory is kept */
+    void ResetChunks() noexcept;
+
 private:
     const bool m_DebugMode = false;
+
+    struct ChunkDeleter
+    {
+        void operator()(char *data) const noexcept;
+    };
+
+    struct Chunk
+    {
+        std::unique_ptr<char[], ChunkDeleter> Data;
+        size_t Size;
+    };
+
+    /** pool kept across resets */
+    std::vector<Chunk> m_Chunks;
+    /** chunk currently handing out space */
+    size_t m_ChunkIndex = 0;
+    /** used bytes in m_Chunks[m_ChunkIndex] */
+    size_t m_ChunkPosition = 0;
+    size_t m_ChunksSize = 0;
 };
 
 } // end namespace adios2
@@ -1500,7 +1500,7 @@ void BP3Serializer::SetDataOffset(uint64_t &offset) noexcept
 #define declare_template_instantiation(T)                                      \
     template void BP3Serializer::PutVariableMetadata(                          \
         const core::Variable<T> &, const typename core::Variable<T>::Info &,   \
-        const bool, typename core::Variable<T>::Span *) noexcept;              \
+        const bool, typename core::Variable<T>::Span *);                       \
                                                                                \
     template void BP3Serializer::PutVariablePayload(                           \
         const core::Variable<T> &, const typename core::Variable<T>::Info &,   \
@@ -1512,7 +1512,7 @@ ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
 #define declare_template_instantiation(T)                                      \
     template void BP3Serializer::PutSpanMetadata(                              \
         const core::Variable<T> &,                                             \
-        const typename core::Variable<T>::Span &) noexcept;
+        const typename core::Variable<T>::Span &);
 
 ADIOS2_FOREACH_PRIMITIVE_STDTYPE_1ARG(declare_template_instantiation)
 #undef declare_template_instantiation
@@ -54,7 +54,7 @@ public:
         const core::Variable<T> &variable,
         const typename core::Variable<T>::Info &blockInfo,
         const bool sourceRowMajor = true,
-        typename core::Variable<T>::Span *span = nullptr) noexcept;
+        typename core::Variable<T>::Span *span = nullptr);
 
     /**
      * Put in buffer variable payload. Expensive part.
@@ -69,7 +69,7 @@ public:
 
     template <class T>
     void PutSpanMetadata(const core::Variable<T> &variable,
-                         const typename core::Variable<T>::Span &span) noexcept;
+                         const typename core::Variable<T>::Span &span);
 
     /**
      *  Serializes data buffer and close current process group
@@ -233,7 +233,7 @@ private:
     template <class T>
     Stats<T> GetBPStats(const bool singleValue,
                         const typename core::Variable<T>::Info &blockInfo,
-                        const bool isRowMajor) noexcept;
+                        const bool isRowMajor);
 
     template <class T>
     void
@@ -432,7 +432,7 @@ private:
 #define declare_template_instantiation(T)                                      \
     extern template void BP3Serializer::PutVariableMetadata(                   \
         const core::Variable<T> &, const typename core::Variable<T>::Info &,   \
-        const bool, typename core::Variable<T>::Span *) noexcept;              \
+        const bool, typename core::Variable<T>::Span *);                       \
                                                                                \
     extern template void BP3Serializer::PutVariablePayload(                    \
         const core::Variable<T> &, const typename core::Variable<T>::Info &,   \
@@ -444,7 +444,7 @@ ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
 #define declare_template_instantiation(T)                                      \
     extern template void BP3Serializer::PutSpanMetadata(                       \
         const core::Variable<T> &,                                             \
-        const typename core::Variable<T>::Span &) noexcept;
+        const typename core::Variable<T>::Span &);
 
 ADIOS2_FOREACH_PRIMITIVE_STDTYPE_1ARG(declare_template_instantiation)
 #undef declare_template_instantiation
@@ -26,7 +26,7 @@ template <class T>
 void BP3Serializer::PutVariableMetadata(
     const core::Variable<T> &variable,
     const typename core::Variable<T>::Info &blockInfo,
-    const bool sourceRowMajor, typename core::Variable<T>::Span *span) noexcept
+    const bool sourceRowMajor, typename core::Variable<T>::Span *span)
 {
     ProfilerStart("buffering");
 
@@ -103,7 +103,7 @@ inline void BP3Serializer::PutVariablePayload(
 template <class T>
 void BP3Serializer::PutSpanMetadata(
     const core::Variable<T> &variable,
-    const typename core::Variable<T>::Span &span) noexcept
+    const typename core::Variable<T>::Span &span)
 {
     if (m_StatsLevel == 0)
     {
@@ -390,7 +390,7 @@ template <>
 inline BP3Serializer::Stats<std::string> BP3Serializer::GetBPStats(
     const bool /*singleValue*/,
     const typename core::Variable<std::string>::Info & /*blockInfo*/,
-    const bool /*isRowMajor*/) noexcept
+    const bool /*isRowMajor*/)
 {
     Stats<std::string> stats;
     stats.Step = m_MetadataSet.TimeStep;
@@ -402,7 +402,7 @@ template <class T>
 BP3Serializer::Stats<T>
 BP3Serializer::GetBPStats(const bool singleValue,
                           const typename core::Variable<T>::Info &blockInfo,
-                          const bool isRowMajor) noexcept
+                          const bool isRowMajor)
 {
     Stats<T> stats;
     stats.Step = m_MetadataSet.TimeStep;
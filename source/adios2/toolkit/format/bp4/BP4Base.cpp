@@ -10,14 +10,16 @@
 #include "BP4Base.h"
 #include "BP4Base.tcc"
 
-#include <algorithm> // std::transform
+#include <algorithm> // std::transform, std::find
 #include <iostream>  //std::cout Warnings
 
 #include "adios2/ADIOSTypes.h"            //PathSeparator
 #include "adios2/helper/adiosFunctions.h" //CreateDirectory, StringToTimeUnit,
 
+#include "adios2/toolkit/format/bp4/operation/BP4BZip2.h"
 #include "adios2/toolkit/format/bp4/operation/BP4MGARD.h"
 #include "adios2/toolkit/format/bp4/operation/BP4SZ.h"
+#include "adios2/toolkit/format/bp4/operation/BP4ShuffleLZ.h"
 #include "adios2/toolkit/format/bp4/operation/BP4Zfp.h"
 
 namespace adios2
@@ -26,7 +28,11 @@ namespace format
 {
 
 const std::set<std::string> BP4Base::m_TransformTypes = {
-    {"unknown", "none", "identity", "sz", "zfp", "mgard"}};
+    {"unknown", "none", "identity", "sz", "zfp", "mgard", "compress",
+     "bzip2"}};
+
+const std::set<std::string> BP4Base::m_LosslessTransformTypes = {"compress",
+                                                                  "bzip2"};
 
 const std::map<int, std::string> BP4Base::m_TransformTypesToNames = {
     {transform_unknown, "unknown"},   {transform_none, "none"},
@@ -45,6 +51,8 @@ const std::map<int, std::string> BP4Base::m_TransformTypesToNames = {
     //    {transform_blosc, "blosc"},
 };
 
+constexpr size_t BP4Base::m_ActiveFlagPosition;
+
 BP4Base::BP4Base(MPI_Comm mpiComm, const bool debugMode)
 : m_MPIComm(mpiComm), m_DebugMode(debugMode)
 {
@@ -91,6 +99,10 @@ void BP4Base::InitParameters(const Params &parameters)
         {
             InitParameterMaxBufferSize(value);
         }
+        else if (key == "bufferchunksize")
+        {
+            InitParameterBufferChunkSize(value);
+        }
         else if (key == "threads")
         {
             InitParameterThreads(value);
@@ -115,6 +127,65 @@ void BP4Base::InitParameters(const Params &parameters)
         {
             InitParameterNodeLocal(value);
         }
+        else if (key == "aggregatortype")
+        {
+            InitParameterAggregatorType(value);
+        }
+        else if (key == "nodegroupsize")
+        {
+            InitParameterNodeGroupSize(value);
+        }
+        else if (key == "asyncwrite")
+        {
+            InitParameterAsyncWrite(value);
+        }
+        else if (key == "asyncqueuelimit")
+        {
+            InitParameterAsyncQueueLimit(value);
+        }
+        else if (key == "zerocopythreshold")
+        {
+            InitParameterZeroCopyThreshold(value);
+        }
+        else if (key == "readcoalescegap")
+        {
+            InitParameterReadCoalesceGap(value);
+        }
+        else if (key == "maxopensubfiles")
+        {
+            InitParameterMaxOpenSubFiles(value);
+        }
+        else if (key == "metadatamergeradix")
+        {
+            InitParameterMetadataMergeRadix(value);
+        }
+        else if (key == "prefetch")
+        {
+            InitParameterPrefetch(value);
+        }
+        else if (key == "streamreader")
+        {
+            InitParameterStreamReader(value);
+        }
+        else if (key == "beginsteppollingfrequencysecs")
+        {
+            InitParameterBeginStepPollingFrequencySecs(value);
+        }
+        else if (key == "opentimeoutsecs")
+        {
+            InitParameterOpenTimeoutSecs(value);
+        }
+    }
+
+    // aggregator type and substreams can come in any order
+    if (m_SubStreams > 0)
+    {
+        if (m_AggregatorType == "twolevel")
+        {
+            m_Aggregator =
+                std::make_shared<aggregator::MPITwoLevel>(m_NodeGroupSize);
+        }
+        m_Aggregator->Init(m_SubStreams, m_MPIComm);
     }
 
     // default timer for buffering
@@ -195,7 +266,7 @@ std::string BP4Base::GetBPMetadataFileName(const std::string &name) const
     }
 
     // const size_t index =
-    //    m_Aggregator.m_IsActive ? m_Aggregator.m_SubStreamIndex : rank;
+    //    m_Aggregator->m_IsActive ? m_Aggregator->m_SubStreamIndex : rank;
 
     const size_t index = 0; // global metadata file is generated by rank 0
 
@@ -236,7 +307,7 @@ std::string BP4Base::GetBPMetadataIndexFileName(const std::string &name) const
     }
 
     // const size_t index =
-    //    m_Aggregator.m_IsActive ? m_Aggregator.m_SubStreamIndex : rank;
+    //    m_Aggregator->m_IsActive ? m_Aggregator->m_SubStreamIndex : rank;
 
     // const size_t index = 0; // global metadata index file is generated by
     // rank 0
@@ -310,16 +381,46 @@ void BP4Base::ResetBuffer(BufferSTL &bufferSTL,
                           const bool zeroInitialize)
 {
     ProfilerStart("buffering");
+    if (zeroInitialize)
+    {
+        // bytes past m_Position are still zero, serialization skips fields
+        // counting on it
+        std::fill(bufferSTL.m_Buffer.begin(),
+                  bufferSTL.m_Buffer.begin() + bufferSTL.m_Position, '\0');
+    }
     bufferSTL.m_Position = 0;
+    bufferSTL.m_References.clear();
+    bufferSTL.ResetChunks();
     if (resetAbsolutePosition)
     {
         bufferSTL.m_AbsolutePosition = 0;
     }
-    if (zeroInitialize)
+    ProfilerStop("buffering");
+}
+
+void BP4Base::AddDeferredVariable(core::VariableBase &variable)
+{
+    if (m_DeferredVariablesSet.insert(&variable).second)
     {
-        bufferSTL.m_Buffer.assign(bufferSTL.m_Buffer.size(), '\0');
+        m_DeferredVariables.push_back(&variable);
     }
-    ProfilerStop("buffering");
+}
+
+void BP4Base::RemoveDeferredVariable(
+    const core::VariableBase &variable) noexcept
+{
+    if (m_DeferredVariablesSet.erase(&variable) > 0)
+    {
+        m_DeferredVariables.erase(std::find(m_DeferredVariables.begin(),
+                                            m_DeferredVariables.end(),
+                                            &variable));
+    }
+}
+
+void BP4Base::ClearDeferredVariables() noexcept
+{
+    m_DeferredVariables.clear();
+    m_DeferredVariablesSet.clear();
 }
 
 BP4Base::ResizeResult BP4Base::ResizeBuffer(const size_t dataIn,
@@ -328,6 +429,8 @@ BP4Base::ResizeResult BP4Base::ResizeBuffer(const size_t dataIn,
     ProfilerStart("buffering");
     const size_t currentCapacity = m_Data.m_Buffer.capacity();
     const size_t requiredCapacity = dataIn + m_Data.m_Position;
+    // payloads in chunks count towards MaxBufferSize
+    const size_t requiredSize = requiredCapacity + m_Data.GetChunksSize();
 
     ResizeResult result = ResizeResult::Unchanged;
 
@@ -343,13 +446,15 @@ BP4Base::ResizeResult BP4Base::ResizeBuffer(const size_t dataIn,
             hint + "\n");
     }
 
-    if (requiredCapacity <= currentCapacity)
+    if (requiredCapacity <= currentCapacity &&
+        requiredSize <= m_MaxBufferSize)
     {
         // do nothing, unchanged is default
     }
-    else if (requiredCapacity > m_MaxBufferSize)
+    else if (requiredSize > m_MaxBufferSize)
     {
-        if (currentCapacity < m_MaxBufferSize)
+        if (requiredCapacity > currentCapacity &&
+            currentCapacity < m_MaxBufferSize)
         {
             m_Data.Resize(m_MaxBufferSize, " when resizing buffer to " +
                                                std::to_string(m_MaxBufferSize) +
@@ -402,6 +507,78 @@ void BP4Base::InitOnOffParameter(const std::string value, bool &parameter,
     }
 }
 
+void BP4Base::InitSizeTParameter(const std::string value, size_t &parameter,
+                                 const size_t minimum, const std::string hint)
+{
+    long long int number = -1;
+
+    if (m_DebugMode)
+    {
+        bool success = true;
+        std::string description;
+
+        try
+        {
+            number = std::stoll(value);
+        }
+        catch (std::exception &e)
+        {
+            success = false;
+            description = std::string(e.what());
+        }
+
+        if (!success || number < static_cast<long long int>(minimum))
+        {
+            throw std::invalid_argument(
+                "ERROR: IO SetParameters invalid value " + value + ", " +
+                hint + "\nadditional description: " + description +
+                "\n, in call to Open\n");
+        }
+    }
+    else
+    {
+        number = std::stoll(value);
+    }
+
+    parameter = static_cast<size_t>(number);
+}
+
+void BP4Base::InitFloatParameter(const std::string value, float &parameter,
+                                 const std::string hint)
+{
+    float number = -1.f;
+
+    if (m_DebugMode)
+    {
+        bool success = true;
+        std::string description;
+
+        try
+        {
+            number = std::stof(value);
+        }
+        catch (std::exception &e)
+        {
+            success = false;
+            description = std::string(e.what());
+        }
+
+        if (!success || number < 0.f)
+        {
+            throw std::invalid_argument(
+                "ERROR: IO SetParameters invalid value " + value + ", " +
+                hint + "\nadditional description: " + description +
+                "\n, in call to Open\n");
+        }
+    }
+    else
+    {
+        number = std::stof(value);
+    }
+
+    parameter = number;
+}
+
 void BP4Base::InitParameterProfile(const std::string value)
 {
     InitOnOffParameter(value, m_Profiler.IsActive, "valid: Profile On or Off");
@@ -566,6 +743,49 @@ void BP4Base::InitParameterMaxBufferSize(const std::string value)
     }
 }
 
+void BP4Base::InitParameterBufferChunkSize(const std::string value)
+{
+    if (value == "0")
+    {
+        m_BufferChunkSize = 0;
+        return;
+    }
+
+    const std::string hint("valid syntax: BufferChunkSize=16Mb (default), "
+                           "BufferChunkSize=1Gb, BufferChunkSize=0 (off)");
+    if (value.size() < 2)
+    {
+        if (m_DebugMode)
+        {
+            throw std::invalid_argument(
+                "ERROR: couldn't convert value of BufferChunkSize IO "
+                "SetParameter, " +
+                hint + ", in call to Open\n");
+        }
+        return;
+    }
+
+    const std::string number(value.substr(0, value.size() - 2));
+    const std::string units(value.substr(value.size() - 2));
+    const size_t factor = helper::BytesFactor(units, m_DebugMode);
+
+    try
+    {
+        m_BufferChunkSize = static_cast<size_t>(std::stoul(number) * factor);
+    }
+    catch (std::exception &e)
+    {
+        if (m_DebugMode)
+        {
+            throw std::invalid_argument(
+                "ERROR: couldn't convert value of BufferChunkSize IO "
+                "SetParameter, " +
+                hint + "\nadditional description: " + e.what() +
+                " in call to Open\n");
+        }
+    }
+}
+
 void BP4Base::InitParameterThreads(const std::string value)
 {
     int threads = -1;
@@ -684,6 +904,90 @@ void BP4Base::InitParameterNodeLocal(const std::string value)
     InitOnOffParameter(value, m_NodeLocal, "valid: node-local On or Off");
 }
 
+void BP4Base::InitParameterAsyncWrite(const std::string value)
+{
+    InitOnOffParameter(value, m_AsyncWrite, "valid: AsyncWrite On or Off");
+}
+
+void BP4Base::InitParameterAsyncQueueLimit(const std::string value)
+{
+    InitSizeTParameter(value, m_AsyncQueueLimit, 1,
+                       "valid: AsyncQueueLimit integer >= 1 (default 2)");
+}
+
+void BP4Base::InitParameterReadCoalesceGap(const std::string value)
+{
+    InitSizeTParameter(value, m_ReadCoalesceGap, 0,
+                       "valid: ReadCoalesceGap bytes >= 0 (default 65536)");
+}
+
+void BP4Base::InitParameterMaxOpenSubFiles(const std::string value)
+{
+    InitSizeTParameter(value, m_MaxOpenSubFiles, 0,
+                       "valid: MaxOpenSubFiles integer >= 0, 0: no limit "
+                       "(default 512)");
+}
+
+void BP4Base::InitParameterMetadataMergeRadix(const std::string value)
+{
+    InitSizeTParameter(value, m_MetadataMergeRadix, 0,
+                       "valid: MetadataMergeRadix integer >= 0, 0 or 1: "
+                       "merge in rank 0 (default 0)");
+}
+
+void BP4Base::InitParameterPrefetch(const std::string value)
+{
+    InitOnOffParameter(value, m_Prefetch, "valid: Prefetch On or Off");
+}
+
+void BP4Base::InitParameterStreamReader(const std::string value)
+{
+    InitOnOffParameter(value, m_StreamReader, "valid: StreamReader On or Off");
+}
+
+void BP4Base::InitParameterBeginStepPollingFrequencySecs(
+    const std::string value)
+{
+    InitFloatParameter(
+        value, m_BeginStepPollingFrequencySecs,
+        "valid: BeginStepPollingFrequencySecs seconds >= 0 (default 1)");
+}
+
+void BP4Base::InitParameterOpenTimeoutSecs(const std::string value)
+{
+    InitFloatParameter(value, m_OpenTimeoutSecs,
+                       "valid: OpenTimeoutSecs seconds >= 0 (default 0)");
+}
+
+void BP4Base::InitParameterAggregatorType(const std::string value)
+{
+    if (value != "chain" && value != "twolevel")
+    {
+        if (m_DebugMode)
+        {
+            throw std::invalid_argument(
+                "ERROR: IO SetParameters AggregatorType invalid value " +
+                value + ", valid: Chain (default) or TwoLevel, in call to "
+                        "Open\n");
+        }
+        return;
+    }
+    m_AggregatorType = value;
+}
+
+void BP4Base::InitParameterZeroCopyThreshold(const std::string value)
+{
+    InitSizeTParameter(value, m_ZeroCopyThreshold, 0,
+                       "valid: ZeroCopyThreshold bytes >= 0, 0: off (default)");
+}
+
+void BP4Base::InitParameterNodeGroupSize(const std::string value)
+{
+    InitSizeTParameter(value, m_NodeGroupSize, 0,
+                       "valid: NodeGroupSize ranks >= 0, 0: all ranks in a "
+                       "node (default)");
+}
+
 std::vector<uint8_t>
 BP4Base::GetTransportIDs(const std::vector<std::string> &transportsTypes) const
     noexcept
@@ -811,6 +1115,8 @@ void BP4Base::ProfilerStop(const std::string process) noexcept
     }
 }
 
+unsigned int BP4Base::GetThreads() const noexcept { return m_Threads; }
+
 BP4Base::TransformTypes
 BP4Base::TransformTypeEnum(const std::string transformType) const noexcept
 {
@@ -880,7 +1186,7 @@ void BP4Base::InitParameterSubStreams(const std::string value)
 
     if (subStreams < m_SizeMPI)
     {
-        m_Aggregator.Init(subStreams, m_MPIComm);
+        m_SubStreams = static_cast<size_t>(subStreams);
     }
 }
 
@@ -900,9 +1206,13 @@ BP4Base::SetBP4Operation(const std::string type) const noexcept
     {
         bp4Op = std::make_shared<BP4MGARD>();
     }
+    else if (type == "compress")
+    {
+        bp4Op = std::make_shared<BP4ShuffleLZ>(m_Threads, m_IsRowMajor);
+    }
     else if (type == "bzip2")
     {
-        // TODO
+        bp4Op = std::make_shared<BP4BZip2>();
     }
     return bp4Op;
 }
@@ -929,7 +1239,7 @@ std::string BP4Base::GetBPSubStreamName(const std::string &name,
     // }
 
     const size_t index =
-        m_Aggregator.m_IsActive ? m_Aggregator.m_SubStreamIndex : rank;
+        m_Aggregator->m_IsActive ? m_Aggregator->m_SubStreamIndex : rank;
 
     // const std::string bpRankName(bpName + ".dir" + PathSeparator + bpRoot +
     //                             "." + std::to_string(index));
@@ -29,6 +29,7 @@
 #include "adios2/core/Engine.h"
 #include "adios2/core/VariableBase.h"
 #include "adios2/toolkit/aggregator/mpi/MPIChain.h"
+#include "adios2/toolkit/aggregator/mpi/MPITwoLevel.h"
 #include "adios2/toolkit/format/BufferSTL.h"
 #include "adios2/toolkit/format/bp4/operation/BP4Operation.h"
 #include "adios2/toolkit/profiling/iochrono/IOChrono.h"
@@ -166,6 +167,10 @@ public:
     /** max buffer size, set by the user */
     size_t m_MaxBufferSize = DefaultMaxBufferSize;
 
+    /** size of m_Data chunks taking payloads that would grow m_Data, 0: off,
+     * m_Data always grows */
+    size_t m_BufferChunkSize = DefaultBufferChunkSize;
+
     /** contains bp1 format metadata indices*/
     MetadataSet m_MetadataSet;
 
@@ -183,17 +188,33 @@ public:
      * EndStep */
     size_t m_FlushStepsCount = 1;
 
-    /** from host language in data information at read */
+    /** from host language in data information at read, of the application
+     * at write */
     bool m_IsRowMajor = true;
 
     /** if reader and writer have different ordering (column vs row major) */
     bool m_ReverseDimensions = false;
 
-    /** manages all communication tasks in aggregation */
-    aggregator::MPIChain m_Aggregator;
+    /** manages all communication tasks in aggregation, MPIChain unless
+     * AggregatorType=TwoLevel */
+    std::shared_ptr<aggregator::MPIAggregator> m_Aggregator =
+        std::make_shared<aggregator::MPIChain>();
+
+    /** from SubStreams, 0: no aggregation */
+    size_t m_SubStreams = 0;
+
+    /** chain or twolevel, from AggregatorType */
+    std::string m_AggregatorType = "chain";
+
+    /** max ranks gathered in a node group by the TwoLevel aggregator, 0: all
+     * ranks in a node */
+    size_t m_NodeGroupSize = 0;
 
-    /** tracks Put and Get variables in deferred mode */
-    std::set<std::string> m_DeferredVariables;
+    /** tracks Put and Get variables in deferred mode, each variable once in
+     * order of first call, engines dispatch on VariableBase::m_DataType */
+    std::vector<core::VariableBase *> m_DeferredVariables;
+    /** fast membership test for m_DeferredVariables */
+    std::unordered_set<const core::VariableBase *> m_DeferredVariablesSet;
     /** tracks the overall size of deferred variables */
     size_t m_DeferredVariablesDataSize = 0;
 
@@ -214,6 +235,51 @@ public:
     /** true: NVMex each rank creates its own directory */
     bool m_NodeLocal = false;
 
+    /** true: data buffers are handed to a background thread that drains
+     * them to transports, so EndStep doesn't block on file I/O */
+    bool m_AsyncWrite = false;
+
+    /** max number of filled buffers waiting in the background drain queue,
+     * Put/EndStep block (back-pressure) when the queue is full */
+    size_t m_AsyncQueueLimit = 2;
+
+    /** deferred payloads of at least this many bytes are written from the
+     * application memory at a flushing EndStep instead of being copied to
+     * m_Data, 0: always copy (default) */
+    size_t m_ZeroCopyThreshold = 0;
+
+    /** reads in the same subfile separated by at most this many bytes are
+     * merged into a single read */
+    size_t m_ReadCoalesceGap = 64 * 1024;
+
+    /** reader: max number of data subfiles kept open, the least recently
+     * used are closed beyond it, 0: no limit */
+    size_t m_MaxOpenSubFiles = 512;
+
+    /** reader: true: EndStep starts reading in the background the payloads
+     * the next step would read with the same selections */
+    bool m_Prefetch = false;
+
+    /** writer: collective metadata indices are merged up a tree where each
+     * rank merges those of up to radix - 1 neighbor subtrees, 0 or 1: all
+     * indices are gathered and merged in rank 0 (default) */
+    size_t m_MetadataMergeRadix = 0;
+
+    /** true: reader follows a file still being written, BeginStep waits for
+     * new steps until the writer closes the file */
+    bool m_StreamReader = false;
+
+    /** seconds between polls of md.idx for new steps in BeginStep */
+    float m_BeginStepPollingFrequencySecs = 1.f;
+
+    /** seconds a reader waits for md.idx to show up at Open, 0: fail right
+     * away if it doesn't exist */
+    float m_OpenTimeoutSecs = 0.f;
+
+    /** byte in the md.idx header zero padding set to 1 while a writer still
+     * has the file open */
+    static constexpr size_t m_ActiveFlagPosition = 38;
+
     /**
      * Unique constructor
      * @param mpiComm for m_BP1Aggregator
@@ -282,6 +348,22 @@ public:
                      const bool resetAbsolutePosition = false,
                      const bool zeroInitialize = true);
 
+    /**
+     * Adds variable to m_DeferredVariables if not already there
+     * @param variable handle kept until ClearDeferredVariables
+     */
+    void AddDeferredVariable(core::VariableBase &variable);
+
+    /**
+     * Drops variable from m_DeferredVariables, called before it is removed
+     * from its IO
+     * @param variable handle, if deferred
+     */
+    void RemoveDeferredVariable(const core::VariableBase &variable) noexcept;
+
+    /** Empties m_DeferredVariables */
+    void ClearDeferredVariables() noexcept;
+
     /** Return type of the CheckAllocation function. */
     enum class ResizeResult
     {
@@ -307,8 +389,12 @@ public:
 
     void ProfilerStop(const std::string process) noexcept;
 
+    /** from the Threads parameter */
+    unsigned int GetThreads() const noexcept;
+
 protected:
-    /** might be used in large payload copies to buffer */
+    /** might be used in large payload copies to buffer, or to read subfiles
+     * in parallel */
     unsigned int m_Threads = 1;
     const bool m_DebugMode = false;
 
@@ -444,6 +530,9 @@ protected:
     static const std::set<std::string> m_TransformTypes;
     static const std::map<int, std::string> m_TransformTypesToNames;
 
+    /** byte codecs that can follow another operation in a pipeline */
+    static const std::set<std::string> m_LosslessTransformTypes;
+
     /** Returns the proper derived class for BP4Operation based on type
      * @param type input, must be a supported type under bp4/operation
      * @return derived class if supported, false pointer if type not supported
@@ -451,6 +540,11 @@ protected:
     std::shared_ptr<BP4Operation> SetBP4Operation(const std::string type) const
         noexcept;
 
+    /** Supported operations of a block in the order they are applied,
+     * after the first one only m_LosslessTransformTypes
+     * @param operations of the block
+     * @return operations index to derived class
+     */
     template <class T>
     std::map<size_t, std::shared_ptr<BP4Operation>> SetBP4Operations(
         const std::vector<core::VariableBase::Operation> &operations) const;
@@ -498,6 +592,8 @@ protected:
         uint8_t BitFinite = 0;
         bool IsValue = false;
         BP4OpInfo Op;
+        /** lossless operations applied after Op, in order */
+        std::vector<BP4OpInfo> PipelineOps;
 
         Stats() : Min(), Max(), Value() {}
     };
@@ -534,6 +630,25 @@ protected:
     void InitOnOffParameter(const std::string value, bool &parameter,
                             const std::string hint);
 
+    /**
+     * Functions used for setting unsigned integer parameters
+     * @param value
+     * @param parameter
+     * @param minimum smallest valid value
+     * @param hint
+     */
+    void InitSizeTParameter(const std::string value, size_t &parameter,
+                            const size_t minimum, const std::string hint);
+
+    /**
+     * Functions used for setting non-negative float parameters (e.g. seconds)
+     * @param value
+     * @param parameter
+     * @param hint
+     */
+    void InitFloatParameter(const std::string value, float &parameter,
+                            const std::string hint);
+
     /** profile=on (default) generate profiling.log
      *  profile=off */
     void InitParameterProfile(const std::string value);
@@ -547,6 +662,9 @@ protected:
     /** set initial buffer size */
     void InitParameterInitBufferSize(const std::string value);
 
+    /** default = DefaultBufferChunkSize in ADIOSTypes.h, 0: off */
+    void InitParameterBufferChunkSize(const std::string value);
+
     /** default = DefaultMaxBufferSize in ADIOSTypes.h, set max buffer size in
      * Gb or Mb
      *  max_buffer_size=100Mb or  max_buffer_size=1Gb */
@@ -571,6 +689,42 @@ protected:
      * stream */
     void InitParameterNodeLocal(const std::string value);
 
+    /** AggregatorType=Chain (default) or TwoLevel */
+    void InitParameterAggregatorType(const std::string value);
+
+    /** max ranks per node group with AggregatorType=TwoLevel */
+    void InitParameterNodeGroupSize(const std::string value);
+
+    /** AsyncWrite=On drains data buffers in a background thread */
+    void InitParameterAsyncWrite(const std::string value);
+
+    /** number of buffers that can be queued for the background drain */
+    void InitParameterAsyncQueueLimit(const std::string value);
+
+    /** min payload size in bytes referenced instead of copied */
+    void InitParameterZeroCopyThreshold(const std::string value);
+
+    /** max gap in bytes between merged reads */
+    void InitParameterReadCoalesceGap(const std::string value);
+
+    /** max number of subfiles open at once in the reader */
+    void InitParameterMaxOpenSubFiles(const std::string value);
+
+    /** radix of the tree merging collective metadata */
+    void InitParameterMetadataMergeRadix(const std::string value);
+
+    /** Prefetch=On reads the next step payloads in the background */
+    void InitParameterPrefetch(const std::string value);
+
+    /** StreamReader=On reads steps while the file is being written */
+    void InitParameterStreamReader(const std::string value);
+
+    /** seconds between md.idx polls in StreamReader mode */
+    void InitParameterBeginStepPollingFrequencySecs(const std::string value);
+
+    /** seconds to wait for the file to be created at Open */
+    void InitParameterOpenTimeoutSecs(const std::string value);
+
     std::vector<uint8_t>
     GetTransportIDs(const std::vector<std::string> &transportsTypes) const
         noexcept;
@@ -440,34 +440,35 @@ inline void BP4Base::ParseCharacteristics(const std::vector<char> &buffer,
         }
         case (characteristic_transform_type):
         {
+            // operations after the first one are a pipeline
+            BP4OpInfo op;
             const size_t typeLength = static_cast<size_t>(
                 helper::ReadValue<uint8_t>(buffer, position, isLittleEndian));
-            characteristics.Statistics.Op.Type =
-                std::string(&buffer[position], typeLength);
+            op.Type = std::string(&buffer[position], typeLength);
             position += typeLength;
 
-            characteristics.Statistics.Op.PreDataType =
+            op.PreDataType =
                 helper::ReadValue<uint8_t>(buffer, position, isLittleEndian);
 
             const size_t dimensionsSize = static_cast<size_t>(
                 helper::ReadValue<uint8_t>(buffer, position, isLittleEndian));
 
-            characteristics.Statistics.Op.PreShape.reserve(dimensionsSize);
-            characteristics.Statistics.Op.PreStart.reserve(dimensionsSize);
-            characteristics.Statistics.Op.PreCount.reserve(dimensionsSize);
+            op.PreShape.reserve(dimensionsSize);
+            op.PreStart.reserve(dimensionsSize);
+            op.PreCount.reserve(dimensionsSize);
             position += 2; // skip length (not required)
 
             for (size_t d = 0; d < dimensionsSize; ++d)
             {
-                characteristics.Statistics.Op.PreCount.push_back(
+                op.PreCount.push_back(
                     static_cast<size_t>(helper::ReadValue<uint64_t>(
                         buffer, position, isLittleEndian)));
 
-                characteristics.Statistics.Op.PreShape.push_back(
+                op.PreShape.push_back(
                     static_cast<size_t>(helper::ReadValue<uint64_t>(
                         buffer, position, isLittleEndian)));
 
-                characteristics.Statistics.Op.PreStart.push_back(
+                op.PreStart.push_back(
                     static_cast<size_t>(helper::ReadValue<uint64_t>(
                         buffer, position, isLittleEndian)));
             }
@@ -475,12 +476,21 @@ inline void BP4Base::ParseCharacteristics(const std::vector<char> &buffer,
             const size_t metadataLength = static_cast<size_t>(
                 helper::ReadValue<uint16_t>(buffer, position, isLittleEndian));
 
-            characteristics.Statistics.Op.Metadata =
-                std::vector<char>(buffer.begin() + position,
-                                  buffer.begin() + position + metadataLength);
+            op.Metadata = std::vector<char>(buffer.begin() + position,
+                                            buffer.begin() + position +
+                                                metadataLength);
             position += metadataLength;
 
-            characteristics.Statistics.Op.IsActive = true;
+            op.IsActive = true;
+            if (characteristics.Statistics.Op.IsActive)
+            {
+                characteristics.Statistics.PipelineOps.push_back(
+                    std::move(op));
+            }
+            else
+            {
+                characteristics.Statistics.Op = std::move(op);
+            }
             break;
         }
         default:
@@ -513,7 +523,13 @@ std::map<size_t, std::shared_ptr<BP4Operation>> BP4Base::SetBP4Operations(
         const std::string type = operations[i].Op->m_Type;
         std::shared_ptr<BP4Operation> bp4Operation = SetBP4Operation(type);
 
-        if (bp4Operation) // if the result is a supported type
+        if (!bp4Operation) // if the result is not a supported type
+        {
+            continue;
+        }
+
+        // only byte codecs can take the output of a previous operation
+        if (bp4Operations.empty() || m_LosslessTransformTypes.count(type) == 1)
         {
             bp4Operations.emplace(i, bp4Operation);
         }
@@ -36,7 +36,8 @@ BP4Deserializer::BP4Deserializer(MPI_Comm mpiComm, const bool debugMode)
 }
 
 void BP4Deserializer::ParseMetadata(const BufferSTL &bufferSTL,
-                                    core::Engine &engine)
+                                    core::Engine &engine,
+                                    const size_t firstStep)
 {
     // ParseMinifooter(bufferSTL);
     // ParsePGIndex(bufferSTL, io);
@@ -48,7 +49,7 @@ void BP4Deserializer::ParseMetadata(const BufferSTL &bufferSTL,
     m_MetadataSet.CurrentStep = steps - 1;
     /* parse the metadata step by step using the pointers saved in the metadata
     index table */
-    for (int i = 0; i < steps; i++)
+    for (size_t i = firstStep; i < steps; i++)
     {
         ParsePGIndexPerStep(bufferSTL, engine.m_IO.m_HostLanguage, 0, i + 1);
         ParseVariablesIndexPerStep(bufferSTL, engine, 0, i + 1);
@@ -56,55 +57,61 @@ void BP4Deserializer::ParseMetadata(const BufferSTL &bufferSTL,
     }
 }
 
-void BP4Deserializer::ParseMetadataIndex(const BufferSTL &bufferSTL)
+void BP4Deserializer::ParseMetadataIndex(const BufferSTL &bufferSTL,
+                                         const bool hasHeader)
 {
     const auto &buffer = bufferSTL.m_Buffer;
     const size_t bufferSize = buffer.size();
     size_t position = 0;
-    position += 28;
-    const uint8_t endianness = helper::ReadValue<uint8_t>(buffer, position);
-    m_Minifooter.IsLittleEndian = (endianness == 0) ? true : false;
-#ifndef ADIOS2_HAVE_ENDIAN_REVERSE
-    if (m_DebugMode)
+
+    if (hasHeader)
     {
-        if (helper::IsLittleEndian() != m_Minifooter.IsLittleEndian)
+        position += 28;
+        const uint8_t endianness = helper::ReadValue<uint8_t>(buffer, position);
+        m_Minifooter.IsLittleEndian = (endianness == 0) ? true : false;
+#ifndef ADIOS2_HAVE_ENDIAN_REVERSE
+        if (m_DebugMode)
         {
-            throw std::runtime_error(
-                "ERROR: reader found BigEndian bp file, "
-                "this version of ADIOS2 wasn't compiled "
-                "with the cmake flag -DADIOS2_USE_ENDIAN_REVERSE=ON "
-                "explicitly, in call to Open\n");
+            if (helper::IsLittleEndian() != m_Minifooter.IsLittleEndian)
+            {
+                throw std::runtime_error(
+                    "ERROR: reader found BigEndian bp file, "
+                    "this version of ADIOS2 wasn't compiled "
+                    "with the cmake flag -DADIOS2_USE_ENDIAN_REVERSE=ON "
+                    "explicitly, in call to Open\n");
+            }
         }
-    }
 #endif
 
-    position += 1;
+        position += 1;
 
-    const int8_t fileType = helper::ReadValue<int8_t>(
-        buffer, position, m_Minifooter.IsLittleEndian);
-    if (fileType >= 3)
-    {
-        m_Minifooter.HasSubFiles = true;
-    }
-    else if (fileType == 0 || fileType == 2)
-    {
-        m_Minifooter.HasSubFiles = false;
-    }
+        const int8_t fileType = helper::ReadValue<int8_t>(
+            buffer, position, m_Minifooter.IsLittleEndian);
+        if (fileType >= 3)
+        {
+            m_Minifooter.HasSubFiles = true;
+        }
+        else if (fileType == 0 || fileType == 2)
+        {
+            m_Minifooter.HasSubFiles = false;
+        }
 
-    m_Minifooter.Version = helper::ReadValue<uint8_t>(
-        buffer, position, m_Minifooter.IsLittleEndian);
-    if (m_Minifooter.Version < 3)
-    {
-        throw std::runtime_error("ERROR: ADIOS2 only supports bp format "
-                                 "version 3 and above, found " +
-                                 std::to_string(m_Minifooter.Version) +
-                                 " version \n");
-    }
+        m_Minifooter.Version = helper::ReadValue<uint8_t>(
+            buffer, position, m_Minifooter.IsLittleEndian);
+        if (m_Minifooter.Version < 3)
+        {
+            throw std::runtime_error("ERROR: ADIOS2 only supports bp format "
+                                     "version 3 and above, found " +
+                                     std::to_string(m_Minifooter.Version) +
+                                     " version \n");
+        }
 
-    position = 0;
-    m_Minifooter.VersionTag.assign(&buffer[position], 28);
+        position = 0;
+        m_Minifooter.VersionTag.assign(&buffer[position], 28);
+
+        position += 48;
+    }
 
-    position += 48;
     while (position < bufferSize)
     {
         std::vector<uint64_t> ptrs;
@@ -145,6 +152,29 @@ const helper::BlockOperationInfo &BP4Deserializer::InitPostOperatorBlockData(
     return blockOperationsInfo.at(index);
 }
 
+std::pair<size_t, size_t> BP4Deserializer::GetOperationRows(
+    const helper::SubStreamBoxInfo &subStreamBoxInfo,
+    const helper::BlockOperationInfo &blockOperationInfo) const noexcept
+{
+    const Dims &count = blockOperationInfo.PreCount;
+    if (count.empty())
+    {
+        return std::make_pair(size_t(0), size_t(0));
+    }
+
+    const Box<Dims> &blockBox = subStreamBoxInfo.BlockBox;
+    const Box<Dims> &intersectionBox = subStreamBoxInfo.IntersectionBox;
+    if (!m_IsRowMajor || m_ReverseDimensions || blockBox.first.empty() ||
+        intersectionBox.first.empty())
+    {
+        return std::make_pair(size_t(0), count[0]);
+    }
+
+    // boxes end is inclusive
+    return std::make_pair(intersectionBox.first[0] - blockBox.first[0],
+                          intersectionBox.second[0] - blockBox.first[0] + 1);
+}
+
 /* void BP4Deserializer::GetPreOperatorBlockData(
     const std::vector<char> &postOpData,
     const helper::BlockOperationInfo &blockOperationInfo,
@@ -630,6 +660,10 @@ void BP4Deserializer::ClipMemory(const std::string &variableName, core::IO &io,
         typename core::Variable<T>::Info &, const std::vector<char> &,         \
         const Box<Dims> &, const Box<Dims> &) const;                           \
                                                                                \
+    template void BP4Deserializer::ClipRawPayload<T>(                          \
+        T *, const Dims &, const Dims &, const char *, const Box<Dims> &,      \
+        const Box<Dims> &) const;                                              \
+                                                                               \
     template void BP4Deserializer::GetValueFromMetadata(                       \
         core::Variable<T> &variable, T *) const;
 
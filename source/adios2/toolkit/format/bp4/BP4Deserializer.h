@@ -49,9 +49,25 @@ public:
 
     ~BP4Deserializer() = default;
 
-    void ParseMetadataIndex(const BufferSTL &bufferSTL);
+    /**
+     * Fills m_MetadataIndexTable from md.idx contents
+     * @param bufferSTL md.idx contents, or only entries appended since the
+     * last call if hasHeader is false
+     * @param hasHeader true: bufferSTL starts with the 48 bytes md.idx header
+     */
+    void ParseMetadataIndex(const BufferSTL &bufferSTL,
+                            const bool hasHeader = true);
 
-    void ParseMetadata(const BufferSTL &bufferSTL, core::Engine &engine);
+    /**
+     * Fills engine IO with Variables and Attributes of steps in
+     * m_MetadataIndexTable
+     * @param bufferSTL md.0 contents, positions in the index are absolute
+     * @param engine
+     * @param firstStep number of steps already parsed, only later steps are
+     * parsed (used when new steps are appended to a file being read)
+     */
+    void ParseMetadata(const BufferSTL &bufferSTL, core::Engine &engine,
+                       const size_t firstStep = 0);
 
     /**
      * Used to get the variable payload data for the current selection (dims and
@@ -114,6 +130,21 @@ public:
                       const bool isRowMajorDestination,
                       const size_t threadID = 0);
 
+    /**
+     * Clips a raw payload (no operations) read from a subfile into the
+     * destination of a Get request. Thread-safe, doesn't use m_ThreadBuffers.
+     * @param data destination for the current step
+     * @param blockStart Get selection start
+     * @param blockCount Get selection count
+     * @param payload raw block payload as stored in the subfile
+     * @param blockBox box of the stored block
+     * @param intersectionBox selection intersection with blockBox
+     */
+    template <class T>
+    void ClipRawPayload(T *data, const Dims &blockStart, const Dims &blockCount,
+                        const char *payload, const Box<Dims> &blockBox,
+                        const Box<Dims> &intersectionBox) const;
+
     /**
      * Clips and assigns memory to blockInfo.Data from a contiguous memory
      * input
@@ -227,6 +258,15 @@ private:
     const helper::BlockOperationInfo &InitPostOperatorBlockData(
         const std::vector<helper::BlockOperationInfo> &blockOperationsInfo)
         const;
+
+    /**
+     * Rows [first, second) of the slowest dimension of an operated block
+     * intersecting the selection, all rows if dimensions are reversed
+     */
+    std::pair<size_t, size_t>
+    GetOperationRows(const helper::SubStreamBoxInfo &subStreamBoxInfo,
+                     const helper::BlockOperationInfo &blockOperationInfo) const
+        noexcept;
 };
 
 // TODO: deprecate this
@@ -244,6 +284,10 @@ private:
         typename core::Variable<T>::Info &, const std::vector<char> &,         \
         const Box<Dims> &, const Box<Dims> &intersectionBox) const;            \
                                                                                \
+    extern template void BP4Deserializer::ClipRawPayload<T>(                   \
+        T *, const Dims &, const Dims &, const char *, const Box<Dims> &,      \
+        const Box<Dims> &) const;                                              \
+                                                                               \
     extern template void BP4Deserializer::GetValueFromMetadata(                \
         core::Variable<T> &variable, T *) const;
 
@@ -130,8 +130,10 @@ void BP4Deserializer::SetVariableBlockInfo(
     typename core::Variable<T>::Info &blockInfo) const
 {
     auto lf_SetSubStreamInfoOperations =
-        [&](const BP4OpInfo &bp4OpInfo, const size_t payloadOffset,
-            helper::SubStreamBoxInfo &subStreamInfo, const bool isRowMajor)
+        [&](const BP4OpInfo &bp4OpInfo,
+            const std::vector<BP4OpInfo> &pipelineOpsInfo,
+            const size_t payloadOffset, helper::SubStreamBoxInfo &subStreamInfo,
+            const bool isRowMajor)
 
     {
         helper::BlockOperationInfo blockOperation;
@@ -152,6 +154,26 @@ void BP4Deserializer::SetVariableBlockInfo(
             std::stoull(blockOperation.Info.at("OutputSize")));
 
         subStreamInfo.OperationsInfo.push_back(std::move(blockOperation));
+
+        // pipeline operations take the bytes of the previous one
+        for (const BP4OpInfo &pipelineOpInfo : pipelineOpsInfo)
+        {
+            helper::BlockOperationInfo pipelineOperation;
+            pipelineOperation.PayloadOffset = payloadOffset;
+            pipelineOperation.Info["PreDataType"] = helper::GetType<uint8_t>();
+            pipelineOperation.Info["Type"] = pipelineOpInfo.Type;
+            pipelineOperation.PreSizeOf = 1;
+
+            SetBP4Operation(pipelineOpInfo.Type)
+                ->GetMetadata(pipelineOpInfo.Metadata, pipelineOperation.Info);
+            pipelineOperation.PreCount = {static_cast<size_t>(
+                std::stoull(pipelineOperation.Info.at("InputSize")))};
+            pipelineOperation.PayloadSize = static_cast<size_t>(
+                std::stoull(pipelineOperation.Info.at("OutputSize")));
+
+            subStreamInfo.OperationsInfo.push_back(
+                std::move(pipelineOperation));
+        }
     };
 
     auto lf_SetSubStreamInfoLocalArray =
@@ -256,8 +278,9 @@ void BP4Deserializer::SetVariableBlockInfo(
         // count) depending on operation info
         if (bp4Op.IsActive)
         {
-            lf_SetSubStreamInfoOperations(bp4Op, payloadOffset, subStreamInfo,
-                                          m_IsRowMajor);
+            lf_SetSubStreamInfoOperations(
+                bp4Op, blockCharacteristics.Statistics.PipelineOps,
+                payloadOffset, subStreamInfo, m_IsRowMajor);
         }
         else
         {
@@ -362,8 +385,9 @@ void BP4Deserializer::SetVariableBlockInfo(
         // count) depending on operation info
         if (bp4Op.IsActive)
         {
-            lf_SetSubStreamInfoOperations(bp4Op, payloadOffset, subStreamInfo,
-                                          m_IsRowMajor);
+            lf_SetSubStreamInfoOperations(
+                bp4Op, blockCharacteristics.Statistics.PipelineOps,
+                payloadOffset, subStreamInfo, m_IsRowMajor);
         }
         else
         {
@@ -488,17 +512,32 @@ void BP4Deserializer::PreDataRead(
         const helper::BlockOperationInfo &blockOperationInfo =
             InitPostOperatorBlockData(subStreamBoxInfo.OperationsInfo);
 
-        if (!identity)
+        payloadSize = blockOperationInfo.PayloadSize;
+        payloadOffset = blockOperationInfo.PayloadOffset;
+
+        if (!identity && subStreamBoxInfo.OperationsInfo.size() > 1)
+        {
+            // a pipeline output is read whole
+            payloadSize = subStreamBoxInfo.OperationsInfo.back().PayloadSize;
+            m_ThreadBuffers[threadID][1].resize(payloadSize, '\0');
+        }
+        else if (!identity)
         {
-            m_ThreadBuffers[threadID][1].resize(blockOperationInfo.PayloadSize,
-                                                '\0');
+            // chunked payloads are read only where selected
+            std::shared_ptr<BP4Operation> bp4Op =
+                SetBP4Operation(blockOperationInfo.Info.at("Type"));
+            const std::pair<size_t, size_t> rows =
+                GetOperationRows(subStreamBoxInfo, blockOperationInfo);
+            const std::pair<size_t, size_t> range = bp4Op->GetPayloadRange(
+                blockOperationInfo, rows.first, rows.second);
+
+            payloadOffset += range.first;
+            payloadSize = range.second;
+            m_ThreadBuffers[threadID][1].resize(payloadSize, '\0');
         }
 
         buffer = identity ? reinterpret_cast<char *>(blockInfo.Data)
                           : m_ThreadBuffers[threadID][1].data();
-
-        payloadSize = blockOperationInfo.PayloadSize;
-        payloadOffset = blockOperationInfo.PayloadOffset;
     }
     else
     {
@@ -531,10 +570,39 @@ void BP4Deserializer::PostDataRead(
         std::shared_ptr<BP4Operation> bp4Op =
             SetBP4Operation(blockOperationInfo.Info.at("Type"));
 
+        const std::pair<size_t, size_t> rows =
+            GetOperationRows(subStreamBoxInfo, blockOperationInfo);
+
+        // undo pipeline operations from the last one, the output of
+        // operation i - 1 goes in thread buffer 2 + i % 2
+        const char *postOpData = m_ThreadBuffers[threadID][1].data();
+        const auto &operationsInfo = subStreamBoxInfo.OperationsInfo;
+        for (size_t i = operationsInfo.size() - 1; i > 0; --i)
+        {
+            const helper::BlockOperationInfo &pipelineOperationInfo =
+                operationsInfo[i];
+            std::vector<char> &pipelineData =
+                m_ThreadBuffers[threadID][2 + i % 2];
+            pipelineData.resize(
+                helper::GetTotalSize(pipelineOperationInfo.PreCount));
+
+            SetBP4Operation(pipelineOperationInfo.Info.at("Type"))
+                ->GetData(postOpData, pipelineOperationInfo,
+                          pipelineData.data());
+            postOpData = pipelineData.data();
+            if (i == 1)
+            {
+                // chunked payloads start at the first selected chunk
+                const std::pair<size_t, size_t> range = bp4Op->GetPayloadRange(
+                    blockOperationInfo, rows.first, rows.second);
+                postOpData += range.first;
+            }
+        }
+
         // get original block back
         char *preOpData = m_ThreadBuffers[threadID][0].data();
-        const char *postOpData = m_ThreadBuffers[threadID][1].data();
-        bp4Op->GetData(postOpData, blockOperationInfo, preOpData);
+        bp4Op->GetRowsData(postOpData, blockOperationInfo, rows.first,
+                           rows.second, preOpData);
 
         // clip block to match selection
         helper::ClipVector(m_ThreadBuffers[threadID][0],
@@ -542,6 +610,23 @@ void BP4Deserializer::PostDataRead(
                            subStreamBoxInfo.Seeks.second);
     }
 
+    const Dims blockInfoStart =
+        (variable.m_ShapeID == ShapeID::LocalArray && blockInfo.Start.empty())
+            ? Dims(blockInfo.Count.size(), 0)
+            : blockInfo.Start;
+
+    ClipRawPayload(blockInfo.Data, blockInfoStart, blockInfo.Count,
+                   m_ThreadBuffers[threadID][0].data(),
+                   subStreamBoxInfo.BlockBox, subStreamBoxInfo.IntersectionBox);
+}
+
+template <class T>
+void BP4Deserializer::ClipRawPayload(T *data, const Dims &blockStart,
+                                     const Dims &blockCount,
+                                     const char *payload,
+                                     const Box<Dims> &blockBox,
+                                     const Box<Dims> &intersectionBox) const
+{
 #ifdef ADIOS2_HAVE_ENDIAN_REVERSE
     const bool endianReverse =
         (helper::IsLittleEndian() != m_Minifooter.IsLittleEndian) ? true
@@ -550,16 +635,9 @@ void BP4Deserializer::PostDataRead(
     constexpr bool endianReverse = false;
 #endif
 
-    const Dims blockInfoStart =
-        (variable.m_ShapeID == ShapeID::LocalArray && blockInfo.Start.empty())
-            ? Dims(blockInfo.Count.size(), 0)
-            : blockInfo.Start;
-
-    helper::ClipContiguousMemory(
-        blockInfo.Data, blockInfoStart, blockInfo.Count,
-        m_ThreadBuffers[threadID][0].data(), subStreamBoxInfo.BlockBox,
-        subStreamBoxInfo.IntersectionBox, m_IsRowMajor, m_ReverseDimensions,
-        endianReverse);
+    helper::ClipContiguousMemory(data, blockStart, blockCount, payload,
+                                 blockBox, intersectionBox, m_IsRowMajor,
+                                 m_ReverseDimensions, endianReverse);
 }
 
 template <class T>
@@ -11,13 +11,17 @@
 #include "BP4Serializer.h"
 #include "BP4Serializer.tcc"
 
+#include <algorithm> //std::fill, std::max, std::min
 #include <chrono>
+#include <cstring> //std::memcpy
 #include <future>
+#include <stdexcept> //std::invalid_argument
 #include <string>
 #include <vector>
 
 #include "adios2/helper/adiosFunctions.h" //helper::GetType<T>, helper::ReadValue<T>,
                                           // ReduceValue<T>
+#include "adios2/helper/adiosThreadPool.h" //helper::GetThreadPool
 
 #ifdef _WIN32
 #pragma warning(disable : 4503) // Windows complains about SubFileInfoMap levels
@@ -55,8 +59,8 @@ void BP4Serializer::PutProcessGroupIndex(
     PutNameRecord(ioName, metadataBuffer);
 
     // write if data is column major in metadata and data
-    const char columnMajor =
-        (helper::IsRowMajor(hostLanguage) == false) ? 'y' : 'n';
+    m_IsRowMajor = helper::IsRowMajor(hostLanguage);
+    const char columnMajor = (m_IsRowMajor == false) ? 'y' : 'n';
     helper::InsertToBuffer(metadataBuffer, &columnMajor);
     helper::CopyToBuffer(dataBuffer, dataPosition, &columnMajor);
 
@@ -150,7 +154,7 @@ void BP4Serializer::CloseData(core::IO &io)
             m_Profiler.Bytes.at("buffering") = m_Data.m_AbsolutePosition;
         }
 
-        m_Aggregator.Close();
+        m_Aggregator->Close();
         m_IsClosed = true;
     }
 
@@ -421,7 +425,7 @@ void BP4Serializer::UpdateOffsetsInMetadata()
     };
 
     // BODY OF FUNCTION STARTS HERE
-    if (m_Aggregator.m_IsConsumer)
+    if (m_Aggregator->m_IsConsumer)
     {
         return;
     }
@@ -437,6 +441,89 @@ void BP4Serializer::UpdateOffsetsInMetadata()
     }
 }
 
+void BP4Serializer::PerformPayloadCopies()
+{
+    if (m_PayloadCopies.empty())
+    {
+        return;
+    }
+
+    ProfilerStart("memcpy");
+
+    // large payloads are split so all threads get a share of the copies
+    size_t totalSize = 0;
+    for (const PayloadCopy &copy : m_PayloadCopies)
+    {
+        totalSize += copy.Size;
+    }
+    const size_t pieceSize = std::max(static_cast<size_t>(1024 * 1024),
+                                      (totalSize + m_Threads - 1) / m_Threads);
+
+    std::vector<PayloadCopy> pieces;
+    pieces.reserve(m_PayloadCopies.size());
+    for (const PayloadCopy &copy : m_PayloadCopies)
+    {
+        char *destination = (copy.Destination != nullptr)
+                                ? copy.Destination
+                                : m_Data.m_Buffer.data() + copy.Position;
+
+        for (size_t offset = 0; offset < copy.Size; offset += pieceSize)
+        {
+            pieces.push_back({0, destination + offset, copy.Source + offset,
+                              std::min(pieceSize, copy.Size - offset)});
+        }
+    }
+
+    helper::GetThreadPool().ParallelFor(
+        pieces.size(), m_Threads, [&](const size_t i) {
+            std::memcpy(pieces[i].Destination, pieces[i].Source,
+                        pieces[i].Size);
+        });
+
+    m_PayloadCopies.clear();
+    ProfilerStop("memcpy");
+}
+
+size_t BP4Serializer::GetOperationsPayloadSize(
+    const std::vector<core::VariableBase::Operation> &operations,
+    const size_t payloadSize, const std::string hint) const
+{
+    size_t size = payloadSize;
+    bool isFirst = true;
+
+    for (const auto &operation : operations)
+    {
+        const std::string type = operation.Op->m_Type;
+        if (!SetBP4Operation(type))
+        {
+            continue;
+        }
+
+        const bool isLossless = m_LosslessTransformTypes.count(type) == 1;
+        if (!isFirst && !isLossless)
+        {
+            if (m_DebugMode)
+            {
+                throw std::invalid_argument(
+                    "ERROR: operation " + type +
+                    " can't follow another operation, only compress or bzip2 "
+                    "can, " +
+                    hint + "\n");
+            }
+            continue;
+        }
+        isFirst = false;
+
+        // a byte codec can grow its input, also as first operation
+        if (isLossless)
+        {
+            size = std::max(size, operation.Op->BufferMaxSize(size));
+        }
+    }
+
+    return size;
+}
+
 // PRIVATE FUNCTIONS
 void BP4Serializer::PutAttributes(core::IO &io)
 {
@@ -612,6 +699,15 @@ BP4Serializer::SerialElementIndex &BP4Serializer::GetSerialElementIndex(
     return itName->second;
 }
 
+void BP4Serializer::DeferPayloadCopy(const size_t position, char *destination,
+                                     const char *source, const size_t size)
+{
+    if (size > 0)
+    {
+        m_PayloadCopies.push_back({position, destination, source, size});
+    }
+}
+
 void BP4Serializer::SerializeDataBuffer(core::IO &io) noexcept
 {
     auto &buffer = m_Data.m_Buffer;
@@ -621,9 +717,12 @@ void BP4Serializer::SerializeDataBuffer(core::IO &io) noexcept
     // vars count and Length (only for PG)
     helper::CopyToBuffer(buffer, m_MetadataSet.DataPGVarsCountPosition,
                          &m_MetadataSet.DataPGVarsCount);
-    // without record itself and vars count
+    // without record itself and vars count, referenced payloads are not in
+    // buffer
     const uint64_t varsLength =
-        position - m_MetadataSet.DataPGVarsCountPosition - 8 - 4;
+        position - m_MetadataSet.DataPGVarsCountPosition - 8 - 4 +
+        m_Data.GetReferencesSize(m_MetadataSet.DataPGVarsCountPosition,
+                                 position);
     helper::CopyToBuffer(buffer, m_MetadataSet.DataPGVarsCountPosition,
                          &varsLength);
 
@@ -641,14 +740,18 @@ void BP4Serializer::SerializeDataBuffer(core::IO &io) noexcept
     {
         m_Data.Resize(position + 12, "for empty Attributes\n");
         // Attribute index header for zero attributes: 0, 0LL
-        // Resize() already takes care of this
+        // Resize() doesn't clear bytes left by a previous use of the buffer
+        std::fill(buffer.begin() + position, buffer.begin() + position + 12,
+                  '\0');
         position += 12;
         absolutePosition += 12;
     }
 
     // Finish writing pg group length without record itself
     const uint64_t dataPGLength =
-        position - m_MetadataSet.DataPGLengthPosition - 8;
+        position - m_MetadataSet.DataPGLengthPosition - 8 +
+        m_Data.GetReferencesSize(m_MetadataSet.DataPGLengthPosition,
+                                 position);
     helper::CopyToBuffer(buffer, m_MetadataSet.DataPGLengthPosition,
                          &dataPGLength);
 
@@ -853,6 +956,17 @@ void BP4Serializer::AggregateMergeIndex(
 {
     // first serialize index
     std::vector<char> serializedIndices = SerializeIndices(indices, comm);
+
+    int size;
+    MPI_Comm_size(comm, &size);
+    if (m_MetadataMergeRadix > 1 &&
+        static_cast<size_t>(size) > m_MetadataMergeRadix)
+    {
+        AggregateMergeIndexTree(serializedIndices, comm, bufferSTL,
+                                isRankConstant);
+        return;
+    }
+
     // gather in rank 0
     std::vector<char> gatheredSerialIndices;
     size_t gatheredSerialIndicesPosition = 0;
@@ -901,6 +1015,193 @@ void BP4Serializer::AggregateMergeIndex(
     }
 }
 
+void BP4Serializer::AggregateMergeIndexTree(
+    std::vector<char> &serializedIndices, MPI_Comm comm, BufferSTL &bufferSTL,
+    const bool isRankConstant)
+{
+    int rank, size;
+    MPI_Comm_rank(comm, &rank);
+    MPI_Comm_size(comm, &size);
+
+    std::unordered_map<std::string, MergedIndex> mergedIndices;
+
+    // adds records [rank (4 bytes)][index] from SerializeIndices, the
+    // characteristics sets of an existing name go after the current ones
+    auto lf_Merge = [&](const std::vector<char> &serialized) {
+        size_t position = 0;
+        while (position < serialized.size())
+        {
+            position += 4; // skip rank
+            const size_t start = position;
+            const ElementIndexHeader header =
+                ReadElementIndexHeader(serialized, position);
+            const size_t end = start + static_cast<size_t>(header.Length) + 4;
+
+            auto itIndex = mergedIndices.find(header.Name);
+            if (itIndex != mergedIndices.end() && isRankConstant)
+            {
+                position = end;
+                continue;
+            }
+
+            // set: count (1 byte), length (4 bytes), characteristics
+            uint64_t setsCount = 0;
+            size_t setPosition = position;
+            while (setPosition < end)
+            {
+                setPosition += 1;
+                const uint32_t length =
+                    helper::ReadValue<uint32_t>(serialized, setPosition);
+                setPosition += length;
+                ++setsCount;
+            }
+
+            if (itIndex == mergedIndices.end())
+            {
+                MergedIndex &index = mergedIndices[header.Name];
+                index.Buffer.assign(serialized.begin() + start,
+                                    serialized.begin() + end);
+                index.SetsCountPosition = position - start - 8;
+                index.SetsCount = setsCount;
+            }
+            else
+            {
+                MergedIndex &index = itIndex->second;
+                index.Buffer.insert(index.Buffer.end(),
+                                    serialized.begin() + position,
+                                    serialized.begin() + end);
+                index.SetsCount += setsCount;
+            }
+            position = end;
+        }
+    };
+
+    // writes the final length and sets count in each merged header
+    auto lf_UpdateHeaders = [&]() {
+        for (auto &indexPair : mergedIndices)
+        {
+            MergedIndex &index = indexPair.second;
+            const uint32_t length =
+                static_cast<uint32_t>(index.Buffer.size() - 4);
+            size_t position = 0;
+            helper::CopyToBuffer(index.Buffer, position, &length);
+            position = index.SetsCountPosition;
+            helper::CopyToBuffer(index.Buffer, position, &index.SetsCount);
+        }
+    };
+
+    const int sizeTag = 0;
+    const int indicesTag = 1;
+    const std::string hint(", in call to AggregateMergeIndexTree BP4 metadata");
+
+    lf_Merge(serializedIndices);
+    std::vector<char>().swap(serializedIndices);
+
+    // at level stride, rank r holds the indices of ranks [r, r + stride)
+    const size_t radix = m_MetadataMergeRadix;
+    const size_t r = static_cast<size_t>(rank);
+    std::vector<char> received;
+    for (size_t stride = 1; stride < static_cast<size_t>(size);
+         stride *= radix)
+    {
+        if (r % (stride * radix) != 0)
+        {
+            const int parent = static_cast<int>(r - r % (stride * radix));
+
+            lf_UpdateHeaders();
+            std::vector<char> serialized;
+            const uint32_t rankSource = static_cast<uint32_t>(rank);
+            for (const auto &indexPair : mergedIndices)
+            {
+                helper::InsertToBuffer(serialized, &rankSource);
+                helper::InsertToBuffer(serialized,
+                                       indexPair.second.Buffer.data(),
+                                       indexPair.second.Buffer.size());
+            }
+            mergedIndices.clear();
+
+            unsigned long long serializedSize = serialized.size();
+            helper::CheckMPIReturn(MPI_Send(&serializedSize, 1,
+                                            MPI_UNSIGNED_LONG_LONG, parent,
+                                            sizeTag, comm),
+                                   hint);
+            if (serializedSize > 0)
+            {
+                std::vector<MPI_Request> requests =
+                    helper::Isend64(serialized.data(), serialized.size(),
+                                    parent, indicesTag, comm, hint);
+                MPI_Status status;
+                for (auto &request : requests)
+                {
+                    helper::CheckMPIReturn(MPI_Wait(&request, &status), hint);
+                }
+            }
+            return;
+        }
+
+        // children subtrees in rank order
+        for (size_t c = 1; c < radix; ++c)
+        {
+            const size_t child = r + c * stride;
+            if (child >= static_cast<size_t>(size))
+            {
+                break;
+            }
+
+            unsigned long long receivedSize = 0;
+            MPI_Status status;
+            helper::CheckMPIReturn(MPI_Recv(&receivedSize, 1,
+                                            MPI_UNSIGNED_LONG_LONG,
+                                            static_cast<int>(child), sizeTag,
+                                            comm, &status),
+                                   hint);
+            received.resize(static_cast<size_t>(receivedSize));
+            if (receivedSize > 0)
+            {
+                std::vector<MPI_Request> requests = helper::Irecv64(
+                    received.data(), received.size(), static_cast<int>(child),
+                    indicesTag, comm, hint);
+                for (auto &request : requests)
+                {
+                    helper::CheckMPIReturn(MPI_Wait(&request, &status), hint);
+                }
+            }
+            lf_Merge(received);
+        }
+    }
+
+    // rank 0, same layout as AggregateMergeIndex
+    lf_UpdateHeaders();
+    size_t mergedSize = 0;
+    for (const auto &indexPair : mergedIndices)
+    {
+        mergedSize += indexPair.second.Buffer.size();
+    }
+
+    auto &buffer = bufferSTL.m_Buffer;
+    auto &position = bufferSTL.m_Position;
+    size_t countPosition = position;
+
+    // Write count
+    position += 12;
+    bufferSTL.Resize(position + mergedSize + m_MetadataSet.MiniFooterSize,
+                     hint);
+    const uint32_t totalCountU32 =
+        static_cast<uint32_t>(mergedIndices.size());
+    helper::CopyToBuffer(buffer, countPosition, &totalCountU32);
+
+    for (const auto &indexPair : mergedIndices)
+    {
+        helper::CopyToBuffer(buffer, position, indexPair.second.Buffer.data(),
+                             indexPair.second.Buffer.size());
+    }
+
+    // Write length
+    const uint64_t totalLengthU64 =
+        static_cast<uint64_t>(position - countPosition - 8);
+    helper::CopyToBuffer(buffer, countPosition, &totalLengthU64);
+}
+
 std::vector<char> BP4Serializer::SerializeIndices(
     const std::unordered_map<std::string, SerialElementIndex> &indices,
     MPI_Comm comm) const noexcept
@@ -1295,116 +1596,6 @@ void BP4Serializer::MergeSerializeIndicesPerStep(
             helper::CopyToBuffer(bufferOut, backPosition, &setsCount);
         };
 
-    auto lf_MergeRank = [&](const std::vector<SerialElementIndex> &indices,
-                            BufferSTL &bufferSTL) {
-        ElementIndexHeader header;
-        size_t firstRank = 0;
-        // index positions per rank
-        std::vector<size_t> positions(indices.size(), 0);
-        // merge index length
-        size_t headerSize = 0;
-
-        for (size_t r = 0; r < indices.size(); ++r)
-        {
-            const auto &buffer = indices[r].Buffer;
-            if (buffer.empty())
-            {
-                continue;
-            }
-            size_t &position = positions[r];
-
-            header = ReadElementIndexHeader(buffer, position);
-            firstRank = r;
-
-            headerSize = position;
-            break;
-        }
-
-        if (m_DebugMode)
-        {
-            if (header.DataType == std::numeric_limits<uint8_t>::max() - 1)
-            {
-                throw std::runtime_error(
-                    "ERROR: invalid data type for variable " + header.Name +
-                    "when writing collective metadata\n");
-            }
-        }
-
-        // move all positions to headerSize
-        for (size_t r = 0; r < indices.size(); ++r)
-        {
-            const auto &buffer = indices[r].Buffer;
-            if (buffer.empty())
-            {
-                continue;
-            }
-            positions[r] = headerSize;
-        }
-
-        uint64_t setsCount = 0;
-        unsigned int currentTimeStep = 1;
-        std::vector<char> sorted;
-
-        for (size_t r = firstRank; r < indices.size(); ++r)
-        {
-            const auto &buffer = indices[r].Buffer;
-            if (buffer.empty())
-            {
-                continue;
-            }
-
-            auto &position = positions[r];
-            if (position >= buffer.size())
-            {
-                continue;
-            }
-
-            uint8_t count = 0;
-            uint32_t length = 0;
-            uint32_t timeStep = static_cast<uint32_t>(currentTimeStep);
-
-            size_t localPosition = position;
-            lf_GetCharacteristics(buffer, localPosition, header.DataType, count,
-                                  length, timeStep);
-            ++setsCount;
-
-            // here copy to sorted buffer
-            helper::InsertToBuffer(sorted, &buffer[position], length + 5);
-            position += length + 5;
-        }
-
-        const uint32_t entryLength =
-            static_cast<uint32_t>(headerSize + sorted.size() - 4);
-        // Copy header to metadata buffer, need mutex here
-        {
-            std::lock_guard<std::mutex> lock(m_Mutex);
-            auto &buffer = bufferSTL.m_Buffer;
-            auto &position = bufferSTL.m_Position;
-
-            helper::CopyToBuffer(buffer, position, &entryLength);
-            helper::CopyToBuffer(buffer, position,
-                                 &indices[firstRank].Buffer[4],
-                                 headerSize - 8 - 4);
-            helper::CopyToBuffer(buffer, position, &setsCount);
-            helper::CopyToBuffer(buffer, position, sorted.data(),
-                                 sorted.size());
-        }
-    };
-
-    auto lf_MergeRankRange =
-        [&](const std::unordered_map<
-                std::string, std::vector<SerialElementIndex>> &nameRankIndices,
-            const std::vector<std::string> &names, const size_t start,
-            const size_t end, BufferSTL &bufferSTL)
-
-    {
-        for (auto i = start; i < end; ++i)
-        {
-            auto itIndex = nameRankIndices.find(names[i]);
-            lf_MergeRank(itIndex->second, bufferSTL);
-        }
-    };
-
     // BODY OF FUNCTION STARTS HERE
     if (m_Threads == 1) // enforcing serial version for now
     {
@@ -1415,41 +1606,33 @@ void BP4Serializer::MergeSerializeIndicesPerStep(
         return;
     }
 
-    // TODO need to debug this part, if threaded per variable
-    const size_t elements = nameRankIndices.size();
-    const size_t stride = elements / m_Threads;        // elements per thread
-    const size_t last = stride + elements % m_Threads; // remainder to last
-
-    std::vector<std::thread> threads;
-    threads.reserve(m_Threads);
-
-    // copy names in order to use threads
-    std::vector<std::string> names;
-    names.reserve(nameRankIndices.size());
-
+    // variables are merged concurrently into their own buffers, then copied
+    // in the same order as the serial version
+    std::vector<const std::vector<SerialElementIndex> *> rankIndices;
+    rankIndices.reserve(nameRankIndices.size());
     for (const auto &nameRankIndexPair : nameRankIndices)
     {
-        names.push_back(nameRankIndexPair.first);
+        rankIndices.push_back(&nameRankIndexPair.second);
     }
 
-    for (unsigned int t = 0; t < m_Threads; ++t)
-    {
-        const size_t start = stride * t;
-        size_t end = start + stride;
-
-        if (t == m_Threads - 1)
-        {
-            end = start + last;
-        }
-
-        threads.push_back(
-            std::thread(lf_MergeRankRange, std::ref(nameRankIndices),
-                        std::ref(names), start, end, std::ref(bufferSTL)));
-    }
+    std::vector<BufferSTL> merged(rankIndices.size());
+    helper::GetThreadPool().ParallelFor(
+        rankIndices.size(), m_Threads, [&](const size_t i) {
+            // merged index is at most the sum of the rank indices
+            size_t size = 0;
+            for (const auto &index : *rankIndices[i])
+            {
+                size += index.Buffer.size();
+            }
+            merged[i].Resize(size, "when merging metadata indices");
+            lf_MergeRankSerial(*rankIndices[i], merged[i]);
+        });
 
-    for (auto &thread : threads)
+    for (const auto &variableBuffer : merged)
     {
-        thread.join();
+        helper::CopyToBuffer(bufferSTL.m_Buffer, bufferSTL.m_Position,
+                             variableBuffer.m_Buffer.data(),
+                             variableBuffer.m_Position);
     }
 }
 
@@ -1853,9 +2036,9 @@ BP4Serializer::SetCollectiveProfilingJSON(const std::string &rankLog) const
 
 uint32_t BP4Serializer::GetFileIndex() const noexcept
 {
-    if (m_Aggregator.m_IsActive)
+    if (m_Aggregator->m_IsActive)
     {
-        return static_cast<uint32_t>(m_Aggregator.m_SubStreamIndex);
+        return static_cast<uint32_t>(m_Aggregator->m_SubStreamIndex);
     }
 
     return static_cast<uint32_t>(m_RankMPI);
@@ -1902,15 +2085,27 @@ size_t BP4Serializer::GetAttributesSizeInData(core::IO &io) const noexcept
 #define declare_template_instantiation(T)                                      \
     template void BP4Serializer::PutVariablePayload(                           \
         const core::Variable<T> &, const typename core::Variable<T>::Info &,   \
-        const bool) noexcept;                                                  \
+        const bool, const PayloadMode, typename core::Variable<T>::Span *);    \
                                                                                \
     template void BP4Serializer::PutVariableMetadata(                          \
         const core::Variable<T> &, const typename core::Variable<T>::Info &,   \
-        const bool) noexcept;
+        const bool, const Stats<T> *, typename core::Variable<T>::Span *);
 
 ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
 #undef declare_template_instantiation
 
+#define declare_template_instantiation(T)                                      \
+    template BP4Serializer::Stats<T> BP4Serializer::GetBlockStats(             \
+        const bool, const typename core::Variable<T>::Info &, const bool,      \
+        const unsigned int) const;                                             \
+                                                                               \
+    template void BP4Serializer::PutSpanMetadata(                              \
+        const core::Variable<T> &,                                             \
+        const typename core::Variable<T>::Span &);
+
+ADIOS2_FOREACH_PRIMITIVE_STDTYPE_1ARG(declare_template_instantiation)
+#undef declare_template_instantiation
+
 //------------------------------------------------------------------------------
 
 } // end namespace format
@@ -11,6 +11,7 @@
 #ifndef ADIOS2_TOOLKIT_FORMAT_BP4_BP4SERIALIZER_H_
 #define ADIOS2_TOOLKIT_FORMAT_BP4_BP4SERIALIZER_H_
 
+#include <array>
 #include <mutex>
 
 #include "adios2/core/Attribute.h"
@@ -46,23 +47,91 @@ public:
         const std::string &ioName, const std::string hostLanguage,
         const std::vector<std::string> &transportsTypes) noexcept;
 
+    /** block statistics written with the variable metadata */
+    using BP4Base::Stats;
+
     /**
      * Put in buffer metadata for a given variable
      * @param variable
+     * @param blockStats precomputed with GetBlockStats, nullptr: computed
+     * here
+     * @param span not nullptr: records payload and min/max positions for a
+     * block populated by the application in the buffer
+     */
+    template <class T>
+    void PutVariableMetadata(
+        const core::Variable<T> &variable,
+        const typename core::Variable<T>::Info &blockInfo,
+        const bool sourceRowMajor = true,
+        const Stats<T> *blockStats = nullptr,
+        typename core::Variable<T>::Span *span = nullptr);
+
+    /**
+     * Writes min/max of a populated span in the variable index and in the
+     * data buffer characteristics, call before the buffer is serialized
+     * @param variable
+     * @param span from PutVariableMetadata
      */
     template <class T>
-    void PutVariableMetadata(const core::Variable<T> &variable,
-                             const typename core::Variable<T>::Info &blockInfo,
-                             const bool sourceRowMajor = true) noexcept;
+    void PutSpanMetadata(const core::Variable<T> &variable,
+                         const typename core::Variable<T>::Span &span);
+
+    /**
+     * Statistics of a block at the current step, doesn't modify the
+     * serializer so it can run concurrently for different blocks
+     * @param threads used for the min/max of this block
+     */
+    template <class T>
+    Stats<T>
+    GetBlockStats(const bool singleValue,
+                  const typename core::Variable<T>::Info &blockInfo,
+                  const bool isRowMajor, const unsigned int threads) const;
+
+    /** true: contiguous payload copies are only recorded by
+     * PutVariablePayload, the space is reserved and the copies run in
+     * PerformPayloadCopies */
+    bool m_DeferPayloadCopies = false;
+
+    /** runs the recorded payload copies over m_Threads and clears them, must
+     * be called before m_Data is written or reset */
+    void PerformPayloadCopies();
+
+    /** where PutVariablePayload places a block payload */
+    enum class PayloadMode
+    {
+        Copy,     //!< COPY, into m_Data.m_Buffer
+        Chunk,    //!< CHUNK, copied into a m_Data chunk and referenced
+        Reference //!< REFERENCE, blockInfo.Data itself is referenced
+    };
 
     /**
      * Put in buffer variable payload. Expensive part.
      * @param variable payload input from m_PutValues
+     * @param mode Chunk and Reference are only for contiguous blocks without
+     * operations, with Reference blockInfo.Data must stay valid until m_Data
+     * is written
+     * @param span not nullptr: only reserves the payload in m_Data, filled
+     * with span->m_Value if not zero
      */
     template <class T>
     void PutVariablePayload(const core::Variable<T> &variable,
                             const typename core::Variable<T>::Info &blockInfo,
-                            const bool sourceRowMajor = true) noexcept;
+                            const bool sourceRowMajor = true,
+                            const PayloadMode mode = PayloadMode::Copy,
+                            typename core::Variable<T>::Span *span = nullptr);
+
+    /**
+     * Bytes a block with operations takes in m_Data, operations after the
+     * first one run in order on the output of the previous one and must be
+     * lossless byte codecs
+     * @param operations of the block
+     * @param payloadSize of the block before operations
+     * @param hint for exceptions
+     * @return at least payloadSize
+     */
+    size_t GetOperationsPayloadSize(
+        const std::vector<core::VariableBase::Operation> &operations,
+        const size_t payloadSize, const std::string hint) const;
 
     /**
      *  Serializes data buffer and close current process group
@@ -217,33 +286,35 @@ private:
     template <class T>
     Stats<T> GetBPStats(const bool singleValue,
                         const typename core::Variable<T>::Info &blockInfo,
-                        const bool isRowMajor) noexcept;
+                        const bool isRowMajor);
 
     template <class T>
-    void
-    PutVariableMetadataInData(const core::Variable<T> &variable,
-                              const typename core::Variable<T>::Info &blockInfo,
-                              const Stats<T> &stats) noexcept;
+    void PutVariableMetadataInData(
+        const core::Variable<T> &variable,
+        const typename core::Variable<T>::Info &blockInfo,
+        const Stats<T> &stats,
+        typename core::Variable<T>::Span *span = nullptr) noexcept;
 
     template <class T>
     void PutVariableMetadataInIndex(
         const core::Variable<T> &variable,
         const typename core::Variable<T>::Info &blockInfo,
-        const Stats<T> &stats, const bool isNew,
-        SerialElementIndex &index) noexcept;
+        const Stats<T> &stats, const bool isNew, SerialElementIndex &index,
+        typename core::Variable<T>::Span *span = nullptr) noexcept;
 
     template <class T>
     void PutVariableCharacteristics(
         const core::Variable<T> &variable,
         const typename core::Variable<T>::Info &blockInfo,
-        const Stats<T> &stats, std::vector<char> &buffer) noexcept;
+        const Stats<T> &stats, std::vector<char> &buffer,
+        typename core::Variable<T>::Span *span) noexcept;
 
     template <class T>
     void PutVariableCharacteristics(
         const core::Variable<T> &variable,
         const typename core::Variable<T>::Info &blockInfo,
-        const Stats<T> &stats, std::vector<char> &buffer,
-        size_t &position) noexcept;
+        const Stats<T> &stats, std::vector<char> &buffer, size_t &position,
+        typename core::Variable<T>::Span *span) noexcept;
 
     /**
      * Writes from &buffer[position]:  [2
@@ -378,6 +449,30 @@ private:
         const std::unordered_map<std::string, SerialElementIndex> &indices,
         MPI_Comm comm, BufferSTL &bufferSTL, const bool isRankConstant = false);
 
+    /** index of one variable/attribute merged from several ranks */
+    struct MergedIndex
+    {
+        /** header of the first rank followed by all characteristics sets */
+        std::vector<char> Buffer;
+        size_t SetsCountPosition = 0;
+        uint64_t SetsCount = 0;
+    };
+
+    /**
+     * AggregateMergeIndex over a tree of m_MetadataMergeRadix. Ranks
+     * receive the indices merged by their children subtrees, append them
+     * to their own in rank order and send the result to their parent, so
+     * rank 0 merges radix - 1 inputs per level only. The metadata is the
+     * same as the one merged by MergeSerializeIndicesPerStep.
+     * @param serializedIndices from SerializeIndices, released here
+     * @param comm communicator domain
+     * @param bufferSTL buffer where rank 0 places merged indices
+     * @param isRankConstant true: keep the index of the first rank only
+     */
+    void AggregateMergeIndexTree(std::vector<char> &serializedIndices,
+                                 MPI_Comm comm, BufferSTL &bufferSTL,
+                                 const bool isRankConstant);
+
     /**
      * Returns a serialized buffer with all indices with format:
      * Rank (4 bytes), Buffer
@@ -433,6 +528,21 @@ private:
                             const typename core::Variable<T>::Info &blockInfo,
                             const bool sourceRowMajor = true) noexcept;
 
+    /** payload copy recorded while m_DeferPayloadCopies is true */
+    struct PayloadCopy
+    {
+        size_t Position;   ///< in m_Data.m_Buffer, used if !Destination
+        char *Destination; ///< chunk space, nullptr: m_Data.m_Buffer
+        const char *Source;
+        size_t Size;
+    };
+
+    std::vector<PayloadCopy> m_PayloadCopies;
+
+    /** adds a copy to m_PayloadCopies */
+    void DeferPayloadCopy(const size_t position, char *destination,
+                          const char *source, const size_t size);
+
     template <class T>
     void UpdateIndexOffsetsCharacteristics(size_t &currentPosition,
                                            const DataTypes dataType,
@@ -447,11 +557,16 @@ private:
         noexcept;
 
     // Operations related functions
+
+    /** intermediate outputs of operation pipelines, ping-pong */
+    std::array<BufferSTL, 2> m_OperationBuffers;
+
+    /** puts a transform characteristic for each supported operation */
     template <class T>
     void PutCharacteristicOperation(
         const core::Variable<T> &variable,
         const typename core::Variable<T>::Info &blockInfo,
-        std::vector<char> &buffer) noexcept;
+        uint8_t &characteristicsCounter, std::vector<char> &buffer) noexcept;
 
     template <class T>
     void PutOperationPayloadInBuffer(
@@ -462,15 +577,28 @@ private:
 #define declare_template_instantiation(T)                                      \
     extern template void BP4Serializer::PutVariablePayload(                    \
         const core::Variable<T> &, const typename core::Variable<T>::Info &,   \
-        const bool) noexcept;                                                  \
+        const bool, const PayloadMode, typename core::Variable<T>::Span *);    \
                                                                                \
     extern template void BP4Serializer::PutVariableMetadata(                   \
         const core::Variable<T> &, const typename core::Variable<T>::Info &,   \
-        const bool) noexcept;
+        const bool, const Stats<T> *, typename core::Variable<T>::Span *);
 
 ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
 #undef declare_template_instantiation
 
+#define declare_template_instantiation(T)                                      \
+    extern template BP4Serializer::Stats<T>                                    \
+    BP4Serializer::GetBlockStats(                                              \
+        const bool, const typename core::Variable<T>::Info &, const bool,      \
+        const unsigned int) const;                                             \
+                                                                               \
+    extern template void BP4Serializer::PutSpanMetadata(                       \
+        const core::Variable<T> &,                                             \
+        const typename core::Variable<T>::Span &);
+
+ADIOS2_FOREACH_PRIMITIVE_STDTYPE_1ARG(declare_template_instantiation)
+#undef declare_template_instantiation
+
 } // end namespace format
 } // end namespace adios2
 
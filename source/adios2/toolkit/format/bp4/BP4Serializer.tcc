@@ -14,6 +14,8 @@
 #include "BP4Serializer.h"
 
 #include <algorithm> // std::all_of
+#include <cstring>   // std::memcpy
+#include <iterator>  // std::next
 
 #include "adios2/helper/adiosFunctions.h"
 
@@ -26,10 +28,11 @@ template <class T>
 inline void BP4Serializer::PutVariableMetadata(
     const core::Variable<T> &variable,
     const typename core::Variable<T>::Info &blockInfo,
-    const bool sourceRowMajor) noexcept
+    const bool sourceRowMajor, const Stats<T> *blockStats,
+    typename core::Variable<T>::Span *span)
 {
     auto lf_SetOffset = [&](uint64_t &offset) {
-        if (m_Aggregator.m_IsActive && !m_Aggregator.m_IsConsumer)
+        if (m_Aggregator->m_IsActive && !m_Aggregator->m_IsConsumer)
         {
             offset = static_cast<uint64_t>(m_Data.m_Position);
         }
@@ -42,7 +45,9 @@ inline void BP4Serializer::PutVariableMetadata(
     ProfilerStart("buffering");
 
     Stats<T> stats =
-        GetBPStats<T>(variable.m_SingleValue, blockInfo, sourceRowMajor);
+        (blockStats != nullptr)
+            ? *blockStats
+            : GetBPStats<T>(variable.m_SingleValue, blockInfo, sourceRowMajor);
 
     // Get new Index or point to existing index
     bool isNew = true; // flag to check if variable is new
@@ -53,12 +58,16 @@ inline void BP4Serializer::PutVariableMetadata(
     stats.MemberID = variableIndex.MemberID;
 
     lf_SetOffset(stats.Offset);
-    PutVariableMetadataInData(variable, blockInfo, stats);
+    PutVariableMetadataInData(variable, blockInfo, stats, span);
     lf_SetOffset(stats.PayloadOffset);
+    if (span != nullptr)
+    {
+        span->m_PayloadPosition = m_Data.m_Position;
+    }
 
     // write to metadata  index
     PutVariableMetadataInIndex(variable, blockInfo, stats, isNew,
-                               variableIndex);
+                               variableIndex, span);
     ++m_MetadataSet.DataPGVarsCount;
 
     ProfilerStop("buffering");
@@ -68,10 +77,52 @@ template <class T>
 inline void BP4Serializer::PutVariablePayload(
     const core::Variable<T> &variable,
     const typename core::Variable<T>::Info &blockInfo,
-    const bool sourceRowMajor) noexcept
+    const bool sourceRowMajor, const PayloadMode mode,
+    typename core::Variable<T>::Span *span)
 {
     ProfilerStart("buffering");
-    if (blockInfo.Operations.empty())
+    if (span != nullptr)
+    {
+        // the application populates the payload in place
+        const size_t blockSize = helper::GetTotalSize(blockInfo.Count);
+        if (span->m_Value != T{})
+        {
+            T *itBegin = reinterpret_cast<T *>(m_Data.m_Buffer.data() +
+                                               m_Data.m_Position);
+            std::fill_n(itBegin, blockSize, span->m_Value);
+        }
+
+        m_Data.m_Position += blockSize * sizeof(T);
+        m_Data.m_AbsolutePosition += blockSize * sizeof(T);
+    }
+    else if (mode != PayloadMode::Copy)
+    {
+        const size_t payloadSize =
+            helper::PayloadSize(blockInfo.Data, blockInfo.Count);
+        const char *data = reinterpret_cast<const char *>(blockInfo.Data);
+
+        if (mode == PayloadMode::Chunk)
+        {
+            char *chunk = m_Data.GetChunkSpace(
+                payloadSize, m_BufferChunkSize,
+                "in call to variable " + variable.m_Name + " Put");
+            if (m_DeferPayloadCopies)
+            {
+                DeferPayloadCopy(0, chunk, data, payloadSize);
+            }
+            else
+            {
+                ProfilerStart("memcpy");
+                std::memcpy(chunk, data, payloadSize);
+                ProfilerStop("memcpy");
+            }
+            data = chunk;
+        }
+
+        m_Data.m_References.push_back({m_Data.m_Position, data, payloadSize});
+        m_Data.m_AbsolutePosition += payloadSize;
+    }
+    else if (blockInfo.Operations.empty())
     {
         PutPayloadInBuffer(variable, blockInfo, sourceRowMajor);
     }
@@ -83,6 +134,35 @@ inline void BP4Serializer::PutVariablePayload(
     ProfilerStop("buffering");
 }
 
+template <class T>
+void BP4Serializer::PutSpanMetadata(
+    const core::Variable<T> &variable,
+    const typename core::Variable<T>::Span &span)
+{
+    if (m_StatsLevel == 0)
+    {
+        // Get Min/Max from populated data
+        ProfilerStart("minmax");
+        T min, max;
+        helper::GetMinMaxThreads(span.Data(), span.Size(), min, max, m_Threads);
+        ProfilerStop("minmax");
+
+        // Put min/max in variable index
+        SerialElementIndex &variableIndex =
+            m_MetadataSet.VarsIndices.at(variable.m_Name);
+        size_t position = span.m_MinMaxMetadataPositions.first;
+        helper::CopyToBuffer(variableIndex.Buffer, position, &min);
+        position = span.m_MinMaxMetadataPositions.second;
+        helper::CopyToBuffer(variableIndex.Buffer, position, &max);
+
+        // and in the variable characteristics in data
+        position = span.m_MinMaxDataPositions.first;
+        helper::CopyToBuffer(m_Data.m_Buffer, position, &min);
+        position = span.m_MinMaxDataPositions.second;
+        helper::CopyToBuffer(m_Data.m_Buffer, position, &max);
+    }
+}
+
 // PRIVATE
 template <class T>
 size_t
@@ -349,7 +429,7 @@ template <>
 inline BP4Serializer::Stats<std::string> BP4Serializer::GetBPStats(
     const bool /*singleValue*/,
     const typename core::Variable<std::string>::Info & /*blockInfo*/,
-    const bool /*isRowMajor*/) noexcept
+    const bool /*isRowMajor*/)
 {
     Stats<std::string> stats;
     stats.Step = m_MetadataSet.TimeStep;
@@ -361,7 +441,26 @@ template <class T>
 BP4Serializer::Stats<T>
 BP4Serializer::GetBPStats(const bool singleValue,
                           const typename core::Variable<T>::Info &blockInfo,
-                          const bool isRowMajor) noexcept
+                          const bool isRowMajor)
+{
+    if (singleValue || m_StatsLevel != 0)
+    {
+        return GetBlockStats<T>(singleValue, blockInfo, isRowMajor, m_Threads);
+    }
+
+    ProfilerStart("minmax");
+    Stats<T> stats =
+        GetBlockStats<T>(singleValue, blockInfo, isRowMajor, m_Threads);
+    ProfilerStop("minmax");
+    return stats;
+}
+
+template <class T>
+BP4Serializer::Stats<T>
+BP4Serializer::GetBlockStats(const bool singleValue,
+                             const typename core::Variable<T>::Info &blockInfo,
+                             const bool isRowMajor,
+                             const unsigned int threads) const
 {
     Stats<T> stats;
     stats.Step = m_MetadataSet.TimeStep;
@@ -375,15 +474,15 @@ BP4Serializer::GetBPStats(const bool singleValue,
         return stats;
     }
 
-    if (m_StatsLevel == 0)
+    // a Span block is populated later, see PutSpanMetadata
+    if (m_StatsLevel == 0 && blockInfo.Data != nullptr)
     {
-        ProfilerStart("minmax");
         if (blockInfo.MemoryStart.empty())
         {
             const std::size_t valuesSize =
                 helper::GetTotalSize(blockInfo.Count);
             helper::GetMinMaxThreads(blockInfo.Data, valuesSize, stats.Min,
-                                     stats.Max, m_Threads);
+                                     stats.Max, threads);
         }
         else // non-contiguous memory min/max
         {
@@ -391,7 +490,6 @@ BP4Serializer::GetBPStats(const bool singleValue,
                                        blockInfo.MemoryStart, blockInfo.Count,
                                        isRowMajor, stats.Min, stats.Max);
         }
-        ProfilerStop("minmax");
     }
 
     return stats;
@@ -400,8 +498,8 @@ BP4Serializer::GetBPStats(const bool singleValue,
 template <class T>
 void BP4Serializer::PutVariableMetadataInData(
     const core::Variable<T> &variable,
-    const typename core::Variable<T>::Info &blockInfo,
-    const Stats<T> &stats) noexcept
+    const typename core::Variable<T>::Info &blockInfo, const Stats<T> &stats,
+    typename core::Variable<T>::Span *span) noexcept
 {
     auto &buffer = m_Data.m_Buffer;
     auto &position = m_Data.m_Position;
@@ -434,7 +532,8 @@ void BP4Serializer::PutVariableMetadataInData(
                         buffer, position);
 
     // CHARACTERISTICS
-    PutVariableCharacteristics(variable, blockInfo, stats, buffer, position);
+    PutVariableCharacteristics(variable, blockInfo, stats, buffer, position,
+                               span);
 
     // Back to varLength including payload size
     // not need to remove its own size (8) from length from bpdump
@@ -452,7 +551,8 @@ template <>
 inline void BP4Serializer::PutVariableMetadataInData(
     const core::Variable<std::string> &variable,
     const typename core::Variable<std::string>::Info &blockInfo,
-    const Stats<std::string> &stats) noexcept
+    const Stats<std::string> &stats,
+    typename core::Variable<std::string>::Span * /*span*/) noexcept
 {
     auto &buffer = m_Data.m_Buffer;
     auto &position = m_Data.m_Position;
@@ -500,7 +600,8 @@ template <class T>
 void BP4Serializer::PutVariableMetadataInIndex(
     const core::Variable<T> &variable,
     const typename core::Variable<T>::Info &blockInfo, const Stats<T> &stats,
-    const bool isNew, SerialElementIndex &index) noexcept
+    const bool isNew, SerialElementIndex &index,
+    typename core::Variable<T>::Span *span) noexcept
 {
     auto &buffer = index.Buffer;
 
@@ -533,7 +634,7 @@ void BP4Serializer::PutVariableMetadataInIndex(
         }
     }
 
-    PutVariableCharacteristics(variable, blockInfo, stats, buffer);
+    PutVariableCharacteristics(variable, blockInfo, stats, buffer, span);
 }
 
 template <class T>
@@ -619,7 +720,8 @@ template <>
 inline void BP4Serializer::PutVariableCharacteristics(
     const core::Variable<std::string> &variable,
     const core::Variable<std::string>::Info &blockInfo,
-    const Stats<std::string> &stats, std::vector<char> &buffer) noexcept
+    const Stats<std::string> &stats, std::vector<char> &buffer,
+    typename core::Variable<std::string>::Span * /*span*/) noexcept
 {
     const size_t characteristicsCountPosition = buffer.size();
     // skip characteristics count(1) + length (4)
@@ -673,7 +775,7 @@ template <class T>
 void BP4Serializer::PutVariableCharacteristics(
     const core::Variable<T> &variable,
     const typename core::Variable<T>::Info &blockInfo, const Stats<T> &stats,
-    std::vector<char> &buffer) noexcept
+    std::vector<char> &buffer, typename core::Variable<T>::Span *span) noexcept
 {
     // going back at the end
     const size_t characteristicsCountPosition = buffer.size();
@@ -688,8 +790,16 @@ void BP4Serializer::PutVariableCharacteristics(
     PutCharacteristicRecord(characteristic_file_index, characteristicsCounter,
                             stats.FileIndex, buffer);
 
-    if (blockInfo.Data != nullptr)
+    if (blockInfo.Data != nullptr || span != nullptr)
     {
+        if (m_StatsLevel == 0 && span != nullptr)
+        {
+            // id (1) + min, id (1) + max, patched in PutSpanMetadata
+            span->m_MinMaxMetadataPositions.first = buffer.size() + 1;
+            span->m_MinMaxMetadataPositions.second =
+                buffer.size() + 2 + sizeof(T);
+        }
+
         PutBoundsRecord(variable.m_SingleValue, stats, characteristicsCounter,
                         buffer);
     }
@@ -720,10 +830,8 @@ void BP4Serializer::PutVariableCharacteristics(
         // do not compress if count dimensions are all zero
         if (!isZeroCount)
         {
-            characteristicID = characteristic_transform_type;
-            helper::InsertToBuffer(buffer, &characteristicID);
-            PutCharacteristicOperation(variable, blockInfo, buffer);
-            ++characteristicsCounter;
+            PutCharacteristicOperation(variable, blockInfo,
+                                       characteristicsCounter, buffer);
         }
     }
 
@@ -746,7 +854,8 @@ template <class T>
 void BP4Serializer::PutVariableCharacteristics(
     const core::Variable<T> &variable,
     const typename core::Variable<T>::Info &blockInfo, const Stats<T> &stats,
-    std::vector<char> &buffer, size_t &position) noexcept
+    std::vector<char> &buffer, size_t &position,
+    typename core::Variable<T>::Span *span) noexcept
 {
     // going back at the end
     const size_t characteristicsCountPosition = position;
@@ -767,8 +876,14 @@ void BP4Serializer::PutVariableCharacteristics(
     ++characteristicsCounter;
 
     // VALUE for SCALAR or STAT min, max for ARRAY
-    if (blockInfo.Data != nullptr)
+    if (blockInfo.Data != nullptr || span != nullptr)
     {
+        if (m_StatsLevel == 0 && span != nullptr)
+        {
+            span->m_MinMaxDataPositions.first = position + 1;
+            span->m_MinMaxDataPositions.second = position + 2 + sizeof(T);
+        }
+
         PutBoundsRecord(variable.m_SingleValue, stats, characteristicsCounter,
                         buffer, position);
     }
@@ -812,6 +927,13 @@ void BP4Serializer::PutPayloadInBuffer(
             Dims(), blockInfo.MemoryStart, blockInfo.MemoryCount);
         m_Data.m_Position += blockSize * sizeof(T);
     }
+    else if (m_DeferPayloadCopies)
+    {
+        DeferPayloadCopy(m_Data.m_Position, nullptr,
+                         reinterpret_cast<const char *>(blockInfo.Data),
+                         blockSize * sizeof(T));
+        m_Data.m_Position += blockSize * sizeof(T);
+    }
     else
     {
         helper::CopyToBufferThreads(m_Data.m_Buffer, m_Data.m_Position,
@@ -967,34 +1089,60 @@ template <class T>
 void BP4Serializer::PutCharacteristicOperation(
     const core::Variable<T> &variable,
     const typename core::Variable<T>::Info &blockInfo,
-    std::vector<char> &buffer) noexcept
+    uint8_t &characteristicsCounter, std::vector<char> &buffer) noexcept
 {
-    // TODO: we only take the first operation for now
     const std::map<size_t, std::shared_ptr<BP4Operation>> bp4Operations =
         SetBP4Operations<T>(blockInfo.Operations);
 
-    const size_t operationIndex = bp4Operations.begin()->first;
-    std::shared_ptr<BP4Operation> bp4Operation = bp4Operations.begin()->second;
+    for (const auto &bp4OperationPair : bp4Operations)
+    {
+        auto &operation = blockInfo.Operations[bp4OperationPair.first];
+
+        const uint8_t characteristicID = characteristic_transform_type;
+        helper::InsertToBuffer(buffer, &characteristicID);
 
-    auto &operation = blockInfo.Operations[operationIndex];
+        const std::string type = operation.Op->m_Type;
+        const uint8_t typeLength = static_cast<uint8_t>(type.size());
+        helper::InsertToBuffer(buffer, &typeLength);
+        helper::InsertToBuffer(buffer, type.c_str(), type.size());
+        ++characteristicsCounter;
 
-    const std::string type = operation.Op->m_Type;
-    const uint8_t typeLength = static_cast<uint8_t>(type.size());
-    helper::InsertToBuffer(buffer, &typeLength);
-    helper::InsertToBuffer(buffer, type.c_str(), type.size());
+        if (bp4OperationPair.first != bp4Operations.begin()->first)
+        {
+            // bytes of the previous operation, no dimensions, sizes are put
+            // by PutOperationPayloadInBuffer
+            const uint8_t dataType = TypeTraits<uint8_t>::type_enum;
+            helper::InsertToBuffer(buffer, &dataType);
+            const uint8_t dimensions = 0;
+            helper::InsertToBuffer(buffer, &dimensions);
+            const uint16_t dimensionsLength = 0;
+            helper::InsertToBuffer(buffer, &dimensionsLength);
+
+            constexpr uint16_t metadataSize = 16;
+            helper::InsertToBuffer(buffer, &metadataSize);
+            // being naughty here
+            Params &info = const_cast<Params &>(operation.Info);
+            info["SizesMetadataPosition"] = std::to_string(buffer.size());
+            const uint64_t sizes[2] = {0, 0};
+            helper::InsertToBuffer(buffer, sizes, 2);
+            continue;
+        }
 
-    // pre-transform type
-    const uint8_t dataType = TypeTraits<T>::type_enum;
-    helper::InsertToBuffer(buffer, &dataType);
-    // pre-transform dimensions
-    const uint8_t dimensions = static_cast<uint8_t>(blockInfo.Count.size());
-    helper::InsertToBuffer(buffer, &dimensions); // count
-    const uint16_t dimensionsLength = static_cast<uint16_t>(24 * dimensions);
-    helper::InsertToBuffer(buffer, &dimensionsLength); // length
-    PutDimensionsRecord(blockInfo.Count, blockInfo.Shape, blockInfo.Start,
-                        buffer);
-    // here put the metadata info depending on operation
-    bp4Operation->SetMetadata(variable, blockInfo, operation, buffer);
+        // pre-transform type
+        const uint8_t dataType = TypeTraits<T>::type_enum;
+        helper::InsertToBuffer(buffer, &dataType);
+        // pre-transform dimensions
+        const uint8_t dimensions = static_cast<uint8_t>(blockInfo.Count.size());
+        helper::InsertToBuffer(buffer, &dimensions); // count
+        const uint16_t dimensionsLength =
+            static_cast<uint16_t>(24 * dimensions);
+        helper::InsertToBuffer(buffer, &dimensionsLength); // length
+        PutDimensionsRecord(blockInfo.Count, blockInfo.Shape, blockInfo.Start,
+                            buffer);
+        // here put the metadata info depending on operation
+        bp4OperationPair.second->SetMetadata(variable, blockInfo, operation,
+                                             buffer);
+    }
 }
 
 template <class T>
@@ -1002,24 +1150,79 @@ void BP4Serializer::PutOperationPayloadInBuffer(
     const core::Variable<T> &variable,
     const typename core::Variable<T>::Info &blockInfo)
 {
-    // TODO: we only take the first operation for now
     const std::map<size_t, std::shared_ptr<BP4Operation>> bp4Operations =
         SetBP4Operations<T>(blockInfo.Operations);
 
-    const size_t operationIndex = bp4Operations.begin()->first;
-    const std::shared_ptr<BP4Operation> bp4Operation =
-        bp4Operations.begin()->second;
-
-    bp4Operation->SetData(variable, blockInfo,
-                          blockInfo.Operations[operationIndex], m_Data);
-
-    // update metadata
     bool isFound = false;
     SerialElementIndex &variableIndex = GetSerialElementIndex(
         variable.m_Name, m_MetadataSet.VarsIndices, isFound);
-    bp4Operation->UpdateMetadata(variable, blockInfo,
-                                 blockInfo.Operations[operationIndex],
+
+    auto itBP4Operation = bp4Operations.begin();
+    const std::shared_ptr<BP4Operation> bp4Operation = itBP4Operation->second;
+    const auto &firstOperation = blockInfo.Operations[itBP4Operation->first];
+
+    if (bp4Operations.size() == 1)
+    {
+        bp4Operation->SetData(variable, blockInfo, firstOperation, m_Data);
+        // update metadata
+        bp4Operation->UpdateMetadata(variable, blockInfo, firstOperation,
+                                     variableIndex.Buffer);
+        return;
+    }
+
+    // pipeline, the last output goes to m_Data
+    const size_t maxSize = GetOperationsPayloadSize(
+        blockInfo.Operations,
+        helper::PayloadSize(blockInfo.Data, blockInfo.Count),
+        "in call to variable " + variable.m_Name + " Put");
+    for (BufferSTL &operationBuffer : m_OperationBuffers)
+    {
+        if (operationBuffer.m_Buffer.size() < maxSize)
+        {
+            operationBuffer.m_Buffer.resize(maxSize);
+        }
+        operationBuffer.m_Position = 0;
+    }
+
+    bp4Operation->SetData(variable, blockInfo, firstOperation,
+                          m_OperationBuffers[0]);
+    bp4Operation->UpdateMetadata(variable, blockInfo, firstOperation,
                                  variableIndex.Buffer);
+
+    size_t input = 0;
+    uint64_t sizes[2] = {m_OperationBuffers[0].m_Position, 0};
+
+    for (++itBP4Operation; itBP4Operation != bp4Operations.end();
+         ++itBP4Operation)
+    {
+        const auto &operation = blockInfo.Operations[itBP4Operation->first];
+        const bool isLast = std::next(itBP4Operation) == bp4Operations.end();
+        BufferSTL &output = isLast ? m_Data : m_OperationBuffers[1 - input];
+
+        sizes[1] = operation.Op->Compress(
+            m_OperationBuffers[input].m_Buffer.data(),
+            {static_cast<size_t>(sizes[0])}, 1, helper::GetType<uint8_t>(),
+            output.m_Buffer.data() + output.m_Position, operation.Parameters);
+
+        // being naughty here
+        Params &info = const_cast<Params &>(operation.Info);
+        auto itPosition = info.find("SizesMetadataPosition");
+        if (itPosition != info.end())
+        {
+            size_t backPosition =
+                static_cast<size_t>(std::stoull(itPosition->second));
+            helper::CopyToBuffer(variableIndex.Buffer, backPosition, sizes, 2);
+            info.erase(itPosition);
+        }
+
+        if (isLast)
+        {
+            m_Data.m_Position += sizes[1];
+            m_Data.m_AbsolutePosition += sizes[1];
+        }
+        input = 1 - input;
+        sizes[0] = sizes[1];
+    }
 }
 
 } // end namespace format
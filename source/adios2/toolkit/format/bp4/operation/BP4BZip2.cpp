@@ -0,0 +1,80 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * BP4BZip2.cpp
+ */
+
+#include "BP4BZip2.h"
+#include "BP4BZip2.tcc"
+
+#include "adios2/helper/adiosFunctions.h"
+
+#ifdef ADIOS2_HAVE_BZIP2
+#include "adios2/operator/compress/CompressBZip2.h"
+#endif
+
+namespace adios2
+{
+namespace format
+{
+
+#define declare_type(T)                                                        \
+    void BP4BZip2::SetData(                                                    \
+        const core::Variable<T> &variable,                                     \
+        const typename core::Variable<T>::Info &blockInfo,                     \
+        const typename core::Variable<T>::Operation &operation,                \
+        BufferSTL &bufferSTL) const noexcept                                   \
+    {                                                                          \
+        SetDataCommon(variable, blockInfo, operation, bufferSTL);              \
+    }                                                                          \
+                                                                               \
+    void BP4BZip2::SetMetadata(                                                \
+        const core::Variable<T> &variable,                                     \
+        const typename core::Variable<T>::Info &blockInfo,                     \
+        const typename core::Variable<T>::Operation &operation,                \
+        std::vector<char> &buffer) const noexcept                              \
+    {                                                                          \
+        SetMetadataCommon(variable, blockInfo, operation, buffer);             \
+    }                                                                          \
+                                                                               \
+    void BP4BZip2::UpdateMetadata(                                             \
+        const core::Variable<T> &variable,                                     \
+        const typename core::Variable<T>::Info &blockInfo,                     \
+        const typename core::Variable<T>::Operation &operation,                \
+        std::vector<char> &buffer) const noexcept                              \
+    {                                                                          \
+        UpdateMetadataCommon(variable, blockInfo, operation, buffer);          \
+    }
+
+ADIOS2_FOREACH_PRIMITIVE_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
+void BP4BZip2::GetMetadata(const std::vector<char> &buffer, Params &info) const
+    noexcept
+{
+    size_t position = 0;
+    info["InputSize"] =
+        std::to_string(helper::ReadValue<uint64_t>(buffer, position));
+    info["OutputSize"] =
+        std::to_string(helper::ReadValue<uint64_t>(buffer, position));
+}
+
+void BP4BZip2::GetData(const char *input,
+                       const helper::BlockOperationInfo &blockOperationInfo,
+                       char *dataOutput) const
+{
+#ifdef ADIOS2_HAVE_BZIP2
+    core::compress::CompressBZip2 op(Params(), true);
+    op.Decompress(input, blockOperationInfo.PayloadSize, dataOutput,
+                  helper::GetTotalSize(blockOperationInfo.PreCount) *
+                      blockOperationInfo.PreSizeOf);
+#else
+    throw std::runtime_error("ERROR: current ADIOS2 library didn't compile "
+                             "with BZip2, can't read BZip2 compressed data, "
+                             "in call to Get\n");
+#endif
+}
+
+} // end namespace format
+} // end namespace adios2
@@ -43,5 +43,19 @@ namespace format
 ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
 #undef declare_type
 
+std::pair<size_t, size_t> BP4Operation::GetPayloadRange(
+    const helper::BlockOperationInfo &blockOperationInfo,
+    const size_t /*rowStart*/, const size_t /*rowEnd*/) const
+{
+    return std::make_pair(size_t(0), blockOperationInfo.PayloadSize);
+}
+
+void BP4Operation::GetRowsData(
+    const char *input, const helper::BlockOperationInfo &blockOperationInfo,
+    const size_t /*rowStart*/, const size_t /*rowEnd*/, char *dataOutput) const
+{
+    GetData(input, blockOperationInfo, dataOutput);
+}
+
 } // end namespace format
 } // end namespace adios2
@@ -12,6 +12,7 @@
 #define ADIOS2_TOOLKIT_FORMAT_BP4_OPERATION_BP4OPERATION_H_
 
 #include <string>
+#include <utility> //std::pair
 #include <vector>
 
 #include "adios2/ADIOSMacros.h"
@@ -63,6 +64,33 @@ public:
     virtual void GetData(const char *input,
                          const helper::BlockOperationInfo &blockOperationInfo,
                          char *dataOutput) const = 0;
+
+    /**
+     * Part of the payload needed to get rows [rowStart, rowEnd) of the
+     * slowest dimension back, the entire payload unless it's chunked
+     * @param blockOperationInfo from GetMetadata
+     * @param rowStart
+     * @param rowEnd
+     * @return first: offset from payload start, second: size
+     */
+    virtual std::pair<size_t, size_t>
+    GetPayloadRange(const helper::BlockOperationInfo &blockOperationInfo,
+                    const size_t rowStart, const size_t rowEnd) const;
+
+    /**
+     * Gets rows [rowStart, rowEnd) back in their place in dataOutput, the
+     * entire block unless it's chunked
+     * @param input payload from GetPayloadRange
+     * @param blockOperationInfo
+     * @param rowStart
+     * @param rowEnd
+     * @param dataOutput sized for the entire block
+     */
+    virtual void
+    GetRowsData(const char *input,
+                const helper::BlockOperationInfo &blockOperationInfo,
+                const size_t rowStart, const size_t rowEnd,
+                char *dataOutput) const;
 };
 
 } // end namespace format
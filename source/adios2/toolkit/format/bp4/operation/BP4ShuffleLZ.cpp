@@ -0,0 +1,228 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * BP4ShuffleLZ.cpp
+ */
+
+#include "BP4ShuffleLZ.h"
+#include "BP4ShuffleLZ.tcc"
+
+#include <algorithm> //std::min, std::max
+#include <numeric>   //std::accumulate
+
+#include "adios2/helper/adiosFunctions.h"
+#include "adios2/helper/adiosThreadPool.h"
+#include "adios2/operator/compress/CompressShuffleLZ.h"
+
+namespace adios2
+{
+namespace format
+{
+
+BP4ShuffleLZ::BP4ShuffleLZ(const unsigned int threads, const bool isRowMajor)
+: m_Threads(threads), m_IsRowMajor(isRowMajor)
+{
+}
+
+#define declare_type(T)                                                        \
+    void BP4ShuffleLZ::SetData(                                                \
+        const core::Variable<T> &variable,                                     \
+        const typename core::Variable<T>::Info &blockInfo,                     \
+        const typename core::Variable<T>::Operation &operation,                \
+        BufferSTL &bufferSTL) const noexcept                                   \
+    {                                                                          \
+        SetDataCommon(variable, blockInfo, operation, bufferSTL);              \
+    }                                                                          \
+                                                                               \
+    void BP4ShuffleLZ::SetMetadata(                                            \
+        const core::Variable<T> &variable,                                     \
+        const typename core::Variable<T>::Info &blockInfo,                     \
+        const typename core::Variable<T>::Operation &operation,                \
+        std::vector<char> &buffer) const noexcept                              \
+    {                                                                          \
+        SetMetadataCommon(variable, blockInfo, operation, buffer);             \
+    }                                                                          \
+                                                                               \
+    void BP4ShuffleLZ::UpdateMetadata(                                         \
+        const core::Variable<T> &variable,                                     \
+        const typename core::Variable<T>::Info &blockInfo,                     \
+        const typename core::Variable<T>::Operation &operation,                \
+        std::vector<char> &buffer) const noexcept                              \
+    {                                                                          \
+        UpdateMetadataCommon(variable, blockInfo, operation, buffer);          \
+    }
+
+ADIOS2_FOREACH_PRIMITIVE_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
+void BP4ShuffleLZ::GetMetadata(const std::vector<char> &buffer,
+                               Params &info) const noexcept
+{
+    size_t position = 0;
+    info["InputSize"] =
+        std::to_string(helper::ReadValue<uint64_t>(buffer, position));
+    info["OutputSize"] =
+        std::to_string(helper::ReadValue<uint64_t>(buffer, position));
+
+    if (buffer.size() == position)
+    {
+        return;
+    }
+
+    info["ChunkRows"] =
+        std::to_string(helper::ReadValue<uint64_t>(buffer, position));
+    const size_t chunks =
+        static_cast<size_t>(helper::ReadValue<uint64_t>(buffer, position));
+    std::string sizes;
+    for (size_t c = 0; c < chunks; ++c)
+    {
+        sizes +=
+            std::to_string(helper::ReadValue<uint64_t>(buffer, position)) + ",";
+    }
+    info["ChunkSizes"] = sizes;
+}
+
+void BP4ShuffleLZ::GetData(const char *input,
+                           const helper::BlockOperationInfo &blockOperationInfo,
+                           char *dataOutput) const
+{
+    core::compress::CompressShuffleLZ op(Params(), true);
+    op.Decompress(input, blockOperationInfo.PayloadSize, dataOutput,
+                  helper::GetTotalSize(blockOperationInfo.PreCount) *
+                      blockOperationInfo.PreSizeOf);
+}
+
+std::pair<size_t, size_t> BP4ShuffleLZ::GetPayloadRange(
+    const helper::BlockOperationInfo &blockOperationInfo,
+    const size_t rowStart, const size_t rowEnd) const
+{
+    size_t chunkRows = 0;
+    const std::vector<size_t> chunkSizes =
+        GetChunkSizes(blockOperationInfo, chunkRows);
+    if (chunkSizes.empty() || rowStart >= rowEnd)
+    {
+        return std::make_pair(size_t(0), blockOperationInfo.PayloadSize);
+    }
+
+    const size_t firstChunk = rowStart / chunkRows;
+    const size_t lastChunk =
+        std::min((rowEnd - 1) / chunkRows, chunkSizes.size() - 1);
+
+    const auto itFirst = chunkSizes.begin() + firstChunk;
+    const auto itEnd = chunkSizes.begin() + lastChunk + 1;
+    return std::make_pair(
+        std::accumulate(chunkSizes.begin(), itFirst, size_t(0)),
+        std::accumulate(itFirst, itEnd, size_t(0)));
+}
+
+void BP4ShuffleLZ::GetRowsData(
+    const char *input, const helper::BlockOperationInfo &blockOperationInfo,
+    const size_t rowStart, const size_t rowEnd, char *dataOutput) const
+{
+    size_t chunkRows = 0;
+    const std::vector<size_t> chunkSizes =
+        GetChunkSizes(blockOperationInfo, chunkRows);
+    if (chunkSizes.empty() || rowStart >= rowEnd)
+    {
+        GetData(input, blockOperationInfo, dataOutput);
+        return;
+    }
+
+    const Dims &count = blockOperationInfo.PreCount;
+    const size_t rows = count[0];
+    const size_t rowSize =
+        helper::GetTotalSize(count) / rows * blockOperationInfo.PreSizeOf;
+
+    const size_t firstChunk = rowStart / chunkRows;
+    const size_t lastChunk =
+        std::min((rowEnd - 1) / chunkRows, chunkSizes.size() - 1);
+
+    // input starts at firstChunk
+    std::vector<size_t> inputOffsets(lastChunk - firstChunk + 1, 0);
+    for (size_t c = firstChunk + 1; c <= lastChunk; ++c)
+    {
+        inputOffsets[c - firstChunk] =
+            inputOffsets[c - firstChunk - 1] + chunkSizes[c - 1];
+    }
+
+    core::compress::CompressShuffleLZ op(Params(), true);
+    helper::GetThreadPool().ParallelFor(
+        inputOffsets.size(), m_Threads, [&](const size_t i) {
+            const size_t c = firstChunk + i;
+            const size_t chunkSize =
+                std::min(chunkRows, rows - c * chunkRows) * rowSize;
+            op.Decompress(input + inputOffsets[i], chunkSizes[c],
+                          dataOutput + c * chunkRows * rowSize, chunkSize);
+        });
+}
+
+// PRIVATE
+size_t BP4ShuffleLZ::GetChunkRows(const Dims &count, const size_t elementSize,
+                                  const core::Operator &op,
+                                  const Params &parameters) const noexcept
+{
+    std::string value;
+    // being naughty here
+    helper::SetParameterValue(
+        "ChunkSize", const_cast<core::Operator &>(op).GetParameters(), value);
+    helper::SetParameterValue("ChunkSize", parameters, value);
+
+    long long int chunkSize = 0;
+    try
+    {
+        chunkSize = value.empty() ? 0 : std::stoll(value);
+    }
+    catch (std::exception &)
+    {
+        // not a number, blocks are not chunked
+    }
+
+    if (!m_IsRowMajor || chunkSize <= 0 || count.empty() || count[0] < 2)
+    {
+        return 0;
+    }
+
+    const size_t rowSize = helper::GetTotalSize(count) / count[0] * elementSize;
+    if (rowSize == 0)
+    {
+        // a trailing dimension is 0, the empty block is a single chunk
+        return 0;
+    }
+    const size_t minRows = (count[0] + MaxChunks - 1) / MaxChunks;
+    const size_t chunkRows = std::max(
+        std::max(static_cast<size_t>(chunkSize) / rowSize, size_t(1)),
+        minRows);
+
+    return (chunkRows < count[0]) ? chunkRows : 0;
+}
+
+std::vector<size_t> BP4ShuffleLZ::GetChunkSizes(
+    const helper::BlockOperationInfo &blockOperationInfo,
+    size_t &chunkRows) const
+{
+    std::vector<size_t> chunkSizes;
+    chunkRows = 0;
+
+    auto itChunkSizes = blockOperationInfo.Info.find("ChunkSizes");
+    if (itChunkSizes == blockOperationInfo.Info.end())
+    {
+        return chunkSizes;
+    }
+
+    chunkRows = static_cast<size_t>(
+        std::stoull(blockOperationInfo.Info.at("ChunkRows")));
+
+    const std::string &sizes = itChunkSizes->second;
+    for (size_t start = 0; start < sizes.size();)
+    {
+        const size_t end = sizes.find(',', start);
+        chunkSizes.push_back(
+            static_cast<size_t>(std::stoull(sizes.substr(start, end - start))));
+        start = end + 1;
+    }
+    return chunkSizes;
+}
+
+} // end namespace format
+} // end namespace adios2
@@ -0,0 +1,119 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * BP4ShuffleLZ.h : BP4 metadata and payload of the built-in "compress"
+ * operator
+ */
+
+#ifndef ADIOS2_TOOLKIT_FORMAT_BP4_OPERATION_BP4SHUFFLELZ_H_
+#define ADIOS2_TOOLKIT_FORMAT_BP4_OPERATION_BP4SHUFFLELZ_H_
+
+#include "adios2/toolkit/format/bp4/operation/BP4Operation.h"
+
+namespace adios2
+{
+namespace format
+{
+
+class BP4ShuffleLZ : public BP4Operation
+{
+public:
+    /**
+     * Blocks larger than the ChunkSize (bytes) operation parameter are split
+     * in chunks of rows along the slowest dimension, compressed and
+     * decompressed in parallel and read only where selected
+     * @param threads working on the chunks of a block
+     * @param isRowMajor false: the first dimension is not the slowest, blocks
+     * are not chunked
+     */
+    BP4ShuffleLZ(const unsigned int threads = 1, const bool isRowMajor = true);
+
+    ~BP4ShuffleLZ() = default;
+
+#define declare_type(T)                                                        \
+    void SetData(const core::Variable<T> &variable,                            \
+                 const typename core::Variable<T>::Info &blockInfo,            \
+                 const typename core::Variable<T>::Operation &operation,       \
+                 BufferSTL &bufferSTL) const noexcept final;                   \
+                                                                               \
+    void SetMetadata(const core::Variable<T> &variable,                        \
+                     const typename core::Variable<T>::Info &blockInfo,        \
+                     const typename core::Variable<T>::Operation &operation,   \
+                     std::vector<char> &buffer) const noexcept final;          \
+                                                                               \
+    void UpdateMetadata(                                                       \
+        const core::Variable<T> &variable,                                     \
+        const typename core::Variable<T>::Info &blockInfo,                     \
+        const typename core::Variable<T>::Operation &operation,                \
+        std::vector<char> &buffer) const noexcept final;
+
+    ADIOS2_FOREACH_PRIMITIVE_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
+    void GetMetadata(const std::vector<char> &buffer, Params &info) const
+        noexcept final;
+
+    void GetData(const char *input,
+                 const helper::BlockOperationInfo &blockOperationInfo,
+                 char *dataOutput) const final;
+
+    std::pair<size_t, size_t>
+    GetPayloadRange(const helper::BlockOperationInfo &blockOperationInfo,
+                    const size_t rowStart,
+                    const size_t rowEnd) const final;
+
+    void GetRowsData(const char *input,
+                     const helper::BlockOperationInfo &blockOperationInfo,
+                     const size_t rowStart, const size_t rowEnd,
+                     char *dataOutput) const final;
+
+private:
+    /** chunks are limited by the 16-bit length of the operation metadata */
+    static constexpr size_t MaxChunks = 4096;
+
+    const unsigned int m_Threads;
+    const bool m_IsRowMajor;
+
+    /**
+     * Rows of the first dimension in each chunk
+     * @return 0 if the block is not chunked
+     */
+    size_t GetChunkRows(const Dims &count, const size_t elementSize,
+                        const core::Operator &op,
+                        const Params &parameters) const noexcept;
+
+    /**
+     * Chunks table from GetMetadata
+     * @param chunkRows set to rows in each chunk, 0 if not chunked
+     * @return compressed size of each chunk, empty if not chunked
+     */
+    std::vector<size_t>
+    GetChunkSizes(const helper::BlockOperationInfo &blockOperationInfo,
+                  size_t &chunkRows) const;
+
+    template <class T>
+    void SetDataCommon(const core::Variable<T> &variable,
+                       const typename core::Variable<T>::Info &blockInfo,
+                       const typename core::Variable<T>::Operation &operation,
+                       BufferSTL &bufferSTL) const noexcept;
+
+    template <class T>
+    void
+    SetMetadataCommon(const core::Variable<T> &variable,
+                      const typename core::Variable<T>::Info &blockInfo,
+                      const typename core::Variable<T>::Operation &operation,
+                      std::vector<char> &buffer) const noexcept;
+
+    template <class T>
+    void
+    UpdateMetadataCommon(const core::Variable<T> &variable,
+                         const typename core::Variable<T>::Info &blockInfo,
+                         const typename core::Variable<T>::Operation &operation,
+                         std::vector<char> &buffer) const noexcept;
+};
+
+} // end namespace format
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_FORMAT_BP4_OPERATION_BP4SHUFFLELZ_H_ */
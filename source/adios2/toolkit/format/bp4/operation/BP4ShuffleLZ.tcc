@@ -0,0 +1,163 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * BP4ShuffleLZ.tcc
+ */
+
+#ifndef ADIOS2_TOOLKIT_FORMAT_BP4_OPERATION_BP4SHUFFLELZ_TCC_
+#define ADIOS2_TOOLKIT_FORMAT_BP4_OPERATION_BP4SHUFFLELZ_TCC_
+
+#include "BP4ShuffleLZ.h"
+
+#include <algorithm> //std::min
+#include <cstring>   //std::memmove
+
+#include "adios2/helper/adiosFunctions.h"
+#include "adios2/helper/adiosThreadPool.h"
+
+namespace adios2
+{
+namespace format
+{
+
+template <class T>
+void BP4ShuffleLZ::SetDataCommon(
+    const core::Variable<T> &variable,
+    const typename core::Variable<T>::Info &blockInfo,
+    const typename core::Variable<T>::Operation &operation,
+    BufferSTL &bufferSTL) const noexcept
+{
+    const core::Operator &op = *operation.Op;
+    const Params &parameters = operation.Parameters;
+    char *output = bufferSTL.m_Buffer.data() + bufferSTL.m_Position;
+
+    // being naughty here
+    Params &info = const_cast<Params &>(operation.Info);
+
+    const size_t chunkRows =
+        GetChunkRows(blockInfo.Count, sizeof(T), op, parameters);
+    size_t outputSize = 0;
+
+    if (chunkRows == 0)
+    {
+        outputSize = op.Compress(blockInfo.Data, blockInfo.Count,
+                                 variable.m_ElementSize, variable.m_Type,
+                                 output, parameters);
+    }
+    else
+    {
+        const size_t rows = blockInfo.Count[0];
+        const size_t rowSize =
+            helper::GetTotalSize(blockInfo.Count) / rows * sizeof(T);
+        const size_t chunks = (rows + chunkRows - 1) / chunkRows;
+        const char *input = reinterpret_cast<const char *>(blockInfo.Data);
+        std::vector<size_t> chunkSizes(chunks);
+
+        // output never exceeds input, each chunk is compressed in place of
+        // its input bytes and moved next to the previous one below
+        helper::GetThreadPool().ParallelFor(
+            chunks, m_Threads, [&](const size_t c) {
+                Dims count(blockInfo.Count);
+                count[0] = std::min(chunkRows, rows - c * chunkRows);
+                const size_t offset = c * chunkRows * rowSize;
+                chunkSizes[c] = op.Compress(
+                    input + offset, count, variable.m_ElementSize,
+                    variable.m_Type, output + offset, parameters);
+            });
+
+        std::string sizes;
+        for (size_t c = 0; c < chunks; ++c)
+        {
+            std::memmove(output + outputSize, output + c * chunkRows * rowSize,
+                         chunkSizes[c]);
+            outputSize += chunkSizes[c];
+            sizes += std::to_string(chunkSizes[c]) + ",";
+        }
+        info["ChunkSizes"] = sizes;
+    }
+
+    info["OutputSize"] = std::to_string(outputSize);
+
+    bufferSTL.m_Position += outputSize;
+    bufferSTL.m_AbsolutePosition += outputSize;
+}
+
+template <class T>
+void BP4ShuffleLZ::SetMetadataCommon(
+    const core::Variable<T> &variable,
+    const typename core::Variable<T>::Info &blockInfo,
+    const typename core::Variable<T>::Operation &operation,
+    std::vector<char> &buffer) const noexcept
+{
+    const uint64_t inputSize = static_cast<uint64_t>(
+        helper::GetTotalSize(blockInfo.Count) * sizeof(T));
+    // being naughty here
+    Params &info = const_cast<Params &>(operation.Info);
+    info["InputSize"] = std::to_string(inputSize);
+
+    const uint64_t chunkRows = static_cast<uint64_t>(GetChunkRows(
+        blockInfo.Count, sizeof(T), *operation.Op, operation.Parameters));
+    const uint64_t chunks =
+        (chunkRows == 0) ? 0 : (blockInfo.Count[0] + chunkRows - 1) / chunkRows;
+
+    // input size, output size [, chunk rows, chunks, size of each chunk]
+    const uint16_t metadataSize = static_cast<uint16_t>(
+        (chunkRows == 0) ? 16 : 32 + 8 * chunks);
+    helper::InsertToBuffer(buffer, &metadataSize);
+    helper::InsertToBuffer(buffer, &inputSize);
+    info["OutputSizeMetadataPosition"] = std::to_string(buffer.size());
+    const uint64_t outputSize = 0;
+    helper::InsertToBuffer(buffer, &outputSize);
+
+    if (chunkRows > 0)
+    {
+        helper::InsertToBuffer(buffer, &chunkRows);
+        helper::InsertToBuffer(buffer, &chunks);
+        // sizes are known after SetData
+        buffer.insert(buffer.end(), 8 * chunks, '\0');
+    }
+}
+
+template <class T>
+void BP4ShuffleLZ::UpdateMetadataCommon(
+    const core::Variable<T> &variable,
+    const typename core::Variable<T>::Info &blockInfo,
+    const typename core::Variable<T>::Operation &operation,
+    std::vector<char> &buffer) const noexcept
+{
+    const uint64_t outputSize =
+        static_cast<uint64_t>(std::stoll(operation.Info.at("OutputSize")));
+
+    size_t backPosition = static_cast<size_t>(
+        std::stoll(operation.Info.at("OutputSizeMetadataPosition")));
+
+    helper::CopyToBuffer(buffer, backPosition, &outputSize);
+
+    // being naughty here
+    Params &info = const_cast<Params &>(operation.Info);
+    info.erase("OutputSizeMetadataPosition");
+
+    auto itChunkSizes = info.find("ChunkSizes");
+    if (itChunkSizes == info.end())
+    {
+        return;
+    }
+
+    backPosition += 16; // skip chunk rows, chunks
+    const std::string &sizes = itChunkSizes->second;
+    for (size_t start = 0; start < sizes.size();)
+    {
+        const size_t end = sizes.find(',', start);
+        const uint64_t chunkSize =
+            std::stoull(sizes.substr(start, end - start));
+        helper::CopyToBuffer(buffer, backPosition, &chunkSize);
+        start = end + 1;
+    }
+    info.erase(itChunkSizes);
+}
+
+} // end namespace format
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_FORMAT_BP4_OPERATION_BP4SHUFFLELZ_TCC_ */
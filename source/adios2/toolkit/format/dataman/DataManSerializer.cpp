@@ -21,13 +21,155 @@ namespace adios2
 namespace format
 {
 
+namespace
+{
+
+// first bytes of binary metadata, JSON in any of its encodings can't start
+// with them
+constexpr char BinaryMagic[4] = {'D', 'M', 'B', 1};
+
+enum BinaryFlags : uint8_t
+{
+    BinaryColumnMajor = 1,
+    BinaryBigEndian = 2,
+    BinaryMinMax = 4,
+    BinaryCompression = 8
+};
+
+void PutVarint(std::vector<char> &buffer, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        buffer.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<char>(value));
+}
+
+void PutBytes(std::vector<char> &buffer, const char *data, const size_t size)
+{
+    buffer.insert(buffer.end(), data, data + size);
+}
+
+// zigzag delta against previous if it has the same number of dimensions
+void PutDims(std::vector<char> &buffer, const Dims &dims, Dims &previous)
+{
+    PutVarint(buffer, dims.size());
+    const bool delta = (previous.size() == dims.size());
+    for (size_t i = 0; i < dims.size(); ++i)
+    {
+        const int64_t difference =
+            static_cast<int64_t>(dims[i] - (delta ? previous[i] : 0));
+        PutVarint(buffer, (static_cast<uint64_t>(difference) << 1) ^
+                              static_cast<uint64_t>(difference >> 63));
+    }
+    previous = dims;
+}
+
+class BinaryReader
+{
+public:
+    BinaryReader(const char *start, const size_t size)
+    : m_Position(start), m_End(start + size)
+    {
+    }
+
+    uint64_t GetVarint()
+    {
+        uint64_t value = 0;
+        for (unsigned int shift = 0; shift < 64; shift += 7)
+        {
+            CheckSize(1);
+            const uint8_t byte = static_cast<uint8_t>(*m_Position++);
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return value;
+            }
+        }
+        throw(std::runtime_error("DataManSerializer::BinaryToDataManVarMap "
+                                 "received invalid varint in binary "
+                                 "metadata"));
+    }
+
+    // number of records taking at least minSize bytes each, checked before
+    // it is used to size a container
+    size_t GetCount(const size_t minSize)
+    {
+        const uint64_t count = GetVarint();
+        if (count > Remaining() / minSize)
+        {
+            throw(std::runtime_error(
+                "DataManSerializer::BinaryToDataManVarMap received invalid "
+                "record count in binary metadata"));
+        }
+        return static_cast<size_t>(count);
+    }
+
+    const char *GetBytes(const size_t size)
+    {
+        CheckSize(size);
+        const char *bytes = m_Position;
+        m_Position += size;
+        return bytes;
+    }
+
+    void GetDims(Dims &dims, Dims &previous)
+    {
+        dims.resize(GetCount(1));
+        const bool delta = (previous.size() == dims.size());
+        for (size_t i = 0; i < dims.size(); ++i)
+        {
+            const uint64_t zigzag = GetVarint();
+            const uint64_t difference = (zigzag >> 1) ^ (~(zigzag & 1) + 1);
+            dims[i] = static_cast<size_t>((delta ? previous[i] : 0) +
+                                          difference);
+        }
+        previous = dims;
+    }
+
+    size_t Remaining() const noexcept
+    {
+        return static_cast<size_t>(m_End - m_Position);
+    }
+
+private:
+    const char *m_Position;
+    const char *m_End;
+
+    void CheckSize(const size_t size) const
+    {
+        if (Remaining() < size)
+        {
+            throw(std::runtime_error(
+                "DataManSerializer::BinaryToDataManVarMap received truncated "
+                "binary metadata"));
+        }
+    }
+};
+
+} // end empty namespace
+
 DataManSerializer::DataManSerializer(bool isRowMajor,
                                      const bool contiguousMajor,
-                                     bool isLittleEndian, MPI_Comm mpiComm)
+                                     bool isLittleEndian, MPI_Comm mpiComm,
+                                     const std::string &metadataSerialization)
 : m_IsRowMajor(isRowMajor), m_IsLittleEndian(isLittleEndian),
   m_ContiguousMajor(contiguousMajor), m_MpiComm(mpiComm),
-  m_DeferredRequestsToSend(std::make_shared<DeferredRequestMap>())
+  m_DeferredRequestsToSend(std::make_shared<DeferredRequestMap>()),
+  m_UseJsonSerialization(metadataSerialization)
 {
+    if (m_UseJsonSerialization != "string" &&
+        m_UseJsonSerialization != "msgpack" &&
+        m_UseJsonSerialization != "cbor" &&
+        m_UseJsonSerialization != "ubjson" &&
+        m_UseJsonSerialization != "binary")
+    {
+        throw(std::invalid_argument(m_UseJsonSerialization +
+                                    " is not a valid method. DataManSerializer "
+                                    "only uses string, msgpack, cbor, ubjson "
+                                    "or binary"));
+    }
     MPI_Comm_size(m_MpiComm, &m_MpiSize);
     MPI_Comm_rank(m_MpiComm, &m_MpiRank);
     New(1024);
@@ -41,6 +183,14 @@ void DataManSerializer::New(size_t size)
     // queue in transport manager. It will be automatically released when the
     // entire workflow finishes using it.
     m_MetadataJson = nullptr;
+    m_MetadataBinary.clear();
+    m_MetadataBinaryRecords = 0;
+    m_MetadataBinaryStrings.clear();
+    m_MetadataBinaryStringIndices.clear();
+    for (auto &dims : m_MetadataBinaryDims)
+    {
+        dims.clear();
+    }
     m_LocalBuffer = std::make_shared<std::vector<char>>();
     m_LocalBuffer->reserve(size);
     m_LocalBuffer->resize(sizeof(uint64_t) * 2);
@@ -49,7 +199,9 @@ void DataManSerializer::New(size_t size)
 VecPtr DataManSerializer::GetLocalPack()
 {
     TAU_SCOPED_TIMER_FUNC();
-    auto metapack = SerializeJson(m_MetadataJson);
+    auto metapack = (m_UseJsonSerialization == "binary")
+                        ? SerializeBinary()
+                        : SerializeJson(m_MetadataJson);
     size_t metasize = metapack->size();
     (reinterpret_cast<uint64_t *>(m_LocalBuffer->data()))[0] =
         m_LocalBuffer->size();
@@ -555,6 +707,196 @@ void DataManSerializer::JsonToDataManVarMap(nlohmann::json &metaJ, VecPtr pack)
     }
 }
 
+void DataManSerializer::PutBinaryVar(const DataManVar &var)
+{
+    TAU_SCOPED_TIMER("DataManSerializer::PutBinaryVar");
+    std::vector<char> &buffer = m_MetadataBinary;
+
+    uint8_t flags = 0;
+    if (not var.isRowMajor)
+    {
+        flags |= BinaryColumnMajor;
+    }
+    if (not var.isLittleEndian)
+    {
+        flags |= BinaryBigEndian;
+    }
+    if (not var.max.empty())
+    {
+        flags |= BinaryMinMax;
+    }
+    if (not var.compression.empty())
+    {
+        flags |= BinaryCompression;
+    }
+
+    PutVarint(buffer, var.step);
+    PutVarint(buffer, static_cast<uint64_t>(var.rank));
+    PutVarint(buffer, GetBinaryString(var.name));
+    PutVarint(buffer, GetBinaryString(var.type));
+    PutVarint(buffer, GetBinaryString(var.address));
+    buffer.push_back(static_cast<char>(flags));
+    PutVarint(buffer, var.position);
+    PutVarint(buffer, var.size);
+    PutDims(buffer, var.shape, m_MetadataBinaryDims[0]);
+    PutDims(buffer, var.start, m_MetadataBinaryDims[1]);
+    PutDims(buffer, var.count, m_MetadataBinaryDims[2]);
+
+    if (flags & BinaryMinMax)
+    {
+        PutVarint(buffer, var.max.size());
+        PutBytes(buffer, var.min.data(), var.min.size());
+        PutBytes(buffer, var.max.data(), var.max.size());
+    }
+
+    if (flags & BinaryCompression)
+    {
+        PutVarint(buffer, GetBinaryString(var.compression));
+        PutVarint(buffer, var.params.size());
+        for (const auto &param : var.params)
+        {
+            PutVarint(buffer, GetBinaryString(param.first));
+            PutVarint(buffer, GetBinaryString(param.second));
+        }
+    }
+
+    ++m_MetadataBinaryRecords;
+}
+
+size_t DataManSerializer::GetBinaryString(const std::string &str)
+{
+    auto it = m_MetadataBinaryStringIndices.find(str);
+    if (it != m_MetadataBinaryStringIndices.end())
+    {
+        return it->second;
+    }
+    const size_t index = m_MetadataBinaryStrings.size();
+    m_MetadataBinaryStrings.push_back(str);
+    m_MetadataBinaryStringIndices.emplace(str, index);
+    return index;
+}
+
+VecPtr DataManSerializer::SerializeBinary()
+{
+    TAU_SCOPED_TIMER_FUNC();
+    auto pack = std::make_shared<std::vector<char>>();
+    size_t stringsSize = 0;
+    for (const auto &str : m_MetadataBinaryStrings)
+    {
+        stringsSize += str.size() + 2;
+    }
+    pack->reserve(sizeof(BinaryMagic) + stringsSize +
+                  m_MetadataBinary.size() + 20);
+
+    PutBytes(*pack, BinaryMagic, sizeof(BinaryMagic));
+    PutVarint(*pack, m_MetadataBinaryStrings.size());
+    for (const auto &str : m_MetadataBinaryStrings)
+    {
+        PutVarint(*pack, str.size());
+        PutBytes(*pack, str.data(), str.size());
+    }
+    PutVarint(*pack, m_MetadataBinaryRecords);
+    PutBytes(*pack, m_MetadataBinary.data(), m_MetadataBinary.size());
+
+    // attributes
+    if (m_MetadataJson != nullptr)
+    {
+        auto jsonPack = SerializeJson(m_MetadataJson);
+        PutBytes(*pack, jsonPack->data(), jsonPack->size());
+    }
+    return pack;
+}
+
+void DataManSerializer::BinaryToDataManVarMap(const char *start, size_t size,
+                                              VecPtr pack)
+{
+    TAU_SCOPED_TIMER_FUNC();
+    BinaryReader reader(start, size);
+    reader.GetBytes(sizeof(BinaryMagic));
+
+    // a string is at least its length
+    std::vector<std::string> strings(reader.GetCount(1));
+    for (auto &str : strings)
+    {
+        const size_t length = static_cast<size_t>(reader.GetVarint());
+        str.assign(reader.GetBytes(length), length);
+    }
+    auto lf_GetString = [&]() -> const std::string & {
+        const size_t index = static_cast<size_t>(reader.GetVarint());
+        if (index >= strings.size())
+        {
+            throw(std::runtime_error(
+                "DataManSerializer::BinaryToDataManVarMap received invalid "
+                "string index in binary metadata"));
+        }
+        return strings[index];
+    };
+
+    // decoded without holding the mutex
+    // a variable is at least 7 varints, its flags and 3 dims counts
+    std::vector<DataManVar> vars(reader.GetCount(11));
+    Dims previous[3];
+    for (auto &var : vars)
+    {
+        var.step = static_cast<size_t>(reader.GetVarint());
+        var.rank = static_cast<int>(reader.GetVarint());
+        var.name = lf_GetString();
+        var.type = lf_GetString();
+        var.address = lf_GetString();
+        const uint8_t flags = static_cast<uint8_t>(*reader.GetBytes(1));
+        var.isRowMajor = !(flags & BinaryColumnMajor);
+        var.isLittleEndian = !(flags & BinaryBigEndian);
+        var.position = static_cast<size_t>(reader.GetVarint());
+        var.size = static_cast<size_t>(reader.GetVarint());
+        reader.GetDims(var.shape, previous[0]);
+        reader.GetDims(var.start, previous[1]);
+        reader.GetDims(var.count, previous[2]);
+
+        if (flags & BinaryMinMax)
+        {
+            const size_t length = static_cast<size_t>(reader.GetVarint());
+            const char *min = reader.GetBytes(length);
+            var.min.assign(min, min + length);
+            const char *max = reader.GetBytes(length);
+            var.max.assign(max, max + length);
+        }
+
+        if (flags & BinaryCompression)
+        {
+            var.compression = lf_GetString();
+            const size_t params = reader.GetCount(2);
+            for (size_t i = 0; i < params; ++i)
+            {
+                const std::string &key = lf_GetString();
+                var.params[key] = lf_GetString();
+            }
+        }
+        var.buffer = pack;
+    }
+
+    {
+        std::lock_guard<std::mutex> lDataManVarMapMutex(m_DataManVarMapMutex);
+        for (auto &var : vars)
+        {
+            auto &stepVars = m_DataManVarMap[var.step];
+            if (stepVars == nullptr)
+            {
+                stepVars = std::make_shared<std::vector<DataManVar>>();
+            }
+            stepVars->emplace_back(std::move(var));
+        }
+    }
+
+    // attributes
+    if (reader.Remaining() > 0)
+    {
+        const size_t remaining = reader.Remaining();
+        nlohmann::json metaJ =
+            DeserializeJson(reader.GetBytes(remaining), remaining);
+        JsonToDataManVarMap(metaJ, pack);
+    }
+}
+
 int DataManSerializer::PutPack(const VecPtr data)
 {
     TAU_SCOPED_TIMER_FUNC();
@@ -581,6 +923,14 @@ int DataManSerializer::PutPack(const VecPtr data)
     uint64_t metaPosition =
         (reinterpret_cast<const uint64_t *>(data->data()))[0];
     uint64_t metaSize = (reinterpret_cast<const uint64_t *>(data->data()))[1];
+    if (metaSize >= sizeof(BinaryMagic) &&
+        std::memcmp(data->data() + metaPosition, BinaryMagic,
+                    sizeof(BinaryMagic)) == 0)
+    {
+        BinaryToDataManVarMap(data->data() + metaPosition, metaSize, data);
+        return 0;
+    }
+
     nlohmann::json j = DeserializeJson(data->data() + metaPosition, metaSize);
 
     JsonToDataManVarMap(j, data);
@@ -778,9 +1128,34 @@ DeferredRequestMapPtr DataManSerializer::GetDeferredRequest()
     return t;
 }
 
+void DataManSerializer::MergeDeferredRequests(DeferredRequestMap &to,
+                                              const DeferredRequestMap &from)
+{
+    TAU_SCOPED_TIMER_FUNC();
+    for (const auto &i : from)
+    {
+        auto toIt = to.find(i.first);
+        if (toIt == to.end() || toIt->second == nullptr)
+        {
+            to[i.first] = i.second;
+            continue;
+        }
+        nlohmann::json jsonSer =
+            DeserializeJson(toIt->second->data(), toIt->second->size());
+        nlohmann::json jsonFrom =
+            DeserializeJson(i.second->data(), i.second->size());
+        for (auto j = jsonFrom.begin(); j != jsonFrom.end(); ++j)
+        {
+            jsonSer.push_back(*j);
+        }
+        toIt->second = SerializeJson(jsonSer);
+    }
+}
+
 VecPtr DataManSerializer::GenerateReply(
     const std::vector<char> &request, size_t &step,
-    const std::unordered_map<std::string, Params> &compressionParams)
+    const std::unordered_map<std::string, Params> &compressionParams,
+    const size_t offset, const int64_t stepOverride)
 {
     TAU_SCOPED_TIMER_FUNC();
     auto replyMetaJ = std::make_shared<nlohmann::json>();
@@ -790,7 +1165,8 @@ VecPtr DataManSerializer::GenerateReply(
     nlohmann::json metaj;
     try
     {
-        metaj = DeserializeJson(request.data(), request.size());
+        metaj = DeserializeJson(request.data() + offset,
+                                request.size() - offset);
     }
     catch (std::exception &e)
     {
@@ -808,7 +1184,8 @@ VecPtr DataManSerializer::GenerateReply(
         std::string variable = req["N"].get<std::string>();
         Dims start = req["O"].get<Dims>();
         Dims count = req["C"].get<Dims>();
-        step = req["T"].get<size_t>();
+        step = stepOverride < 0 ? req["T"].get<size_t>()
+                                : static_cast<size_t>(stepOverride);
 
         DmvVecPtr varVec;
 
@@ -994,7 +1371,8 @@ VecPtr DataManSerializer::SerializeJson(const nlohmann::json &message)
 {
     TAU_SCOPED_TIMER_FUNC();
     auto pack = std::make_shared<std::vector<char>>();
-    if (m_UseJsonSerialization == "msgpack")
+    if (m_UseJsonSerialization == "msgpack" ||
+        m_UseJsonSerialization == "binary")
     {
         nlohmann::json::to_msgpack(message, *pack);
     }
@@ -1044,7 +1422,8 @@ nlohmann::json DataManSerializer::DeserializeJson(const char *start,
                                  "uninitialized message"));
     }
     nlohmann::json message;
-    if (m_UseJsonSerialization == "msgpack")
+    if (m_UseJsonSerialization == "msgpack" ||
+        m_UseJsonSerialization == "binary")
     {
         message = nlohmann::json::from_msgpack(start, size);
     }
@@ -83,8 +83,13 @@ using DeferredRequestMapPtr = std::shared_ptr<DeferredRequestMap>;
 class DataManSerializer
 {
 public:
+    /**
+     * @param metadataSerialization string, msgpack, cbor, ubjson or binary,
+     * binary puts variables in flat records instead of JSON
+     */
     DataManSerializer(bool isRowMajor, const bool contiguousMajor,
-                      bool isLittleEndian, MPI_Comm mpiComm);
+                      bool isLittleEndian, MPI_Comm mpiComm,
+                      const std::string &metadataSerialization = "string");
 
     // clear and allocate new buffer for writer
     void New(size_t size);
@@ -127,9 +132,13 @@ public:
 
     static VecPtr EndSignal(size_t step);
 
+    // generate the data reply for a deferred request pack starting at offset
+    // in request, if stepOverride is not negative it replaces the step
+    // recorded in the pack
     VecPtr GenerateReply(
         const std::vector<char> &request, size_t &step,
-        const std::unordered_map<std::string, Params> &compressionParams);
+        const std::unordered_map<std::string, Params> &compressionParams,
+        const size_t offset = 0, const int64_t stepOverride = -1);
 
     int PutPack(const VecPtr data);
 
@@ -153,6 +162,10 @@ public:
                            const Dims &start, const Dims &count, void *data);
     DeferredRequestMapPtr GetDeferredRequest();
 
+    // append the request packs in from to the ones for the same address in to
+    void MergeDeferredRequests(DeferredRequestMap &to,
+                               const DeferredRequestMap &from);
+
     size_t MinStep();
     size_t Steps();
 
@@ -188,7 +201,15 @@ private:
 
     template <typename T>
     void CalculateMinMax(const T *data, const Dims &count,
-                         nlohmann::json &metaj);
+                         std::vector<char> &min, std::vector<char> &max);
+
+    // binary metadata: interned strings, then one flat record per variable
+    // block with shapes, starts and counts delta encoded against the
+    // previous record, then the rest of the metadata as JSON
+    void PutBinaryVar(const DataManVar &var);
+    size_t GetBinaryString(const std::string &str);
+    VecPtr SerializeBinary();
+    void BinaryToDataManVarMap(const char *start, size_t size, VecPtr pack);
 
     void Log(const int level, const std::string &message, const bool mpi,
              const bool endline);
@@ -201,6 +222,16 @@ private:
     // writer app API thread, do not need mutex
     nlohmann::json m_MetadataJson;
 
+    // local rank single step binary metadata records, used in writer
+    // instead of m_MetadataJson for variables when m_UseJsonSerialization is
+    // binary, only accessed from writer app API thread, do not need mutex
+    std::vector<char> m_MetadataBinary;
+    size_t m_MetadataBinaryRecords = 0;
+    std::vector<std::string> m_MetadataBinaryStrings;
+    std::unordered_map<std::string, size_t> m_MetadataBinaryStringIndices;
+    // shape, start and count of the last record
+    Dims m_MetadataBinaryDims[3];
+
     // temporary compression buffer, made class member only for saving costs for
     // memory allocation
     std::vector<char> m_CompressBuffer;
@@ -229,7 +260,8 @@ private:
 
     DeferredRequestMapPtr m_DeferredRequestsToSend;
 
-    // string, msgpack, cbor, ubjson
+    // string, msgpack, cbor, ubjson, binary (msgpack for what is left in
+    // JSON)
     std::string m_UseJsonSerialization = "string";
 
     bool m_IsRowMajor;
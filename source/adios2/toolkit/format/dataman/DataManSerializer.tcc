@@ -34,46 +34,47 @@ namespace format
 
 template <>
 inline void DataManSerializer::CalculateMinMax<std::complex<float>>(
-    const std::complex<float> *data, const Dims &count, nlohmann::json &metaj)
+    const std::complex<float> *data, const Dims &count, std::vector<char> &min,
+    std::vector<char> &max)
 {
 }
 
 template <>
 inline void DataManSerializer::CalculateMinMax<std::complex<double>>(
-    const std::complex<double> *data, const Dims &count, nlohmann::json &metaj)
+    const std::complex<double> *data, const Dims &count,
+    std::vector<char> &min, std::vector<char> &max)
 {
 }
 
 template <typename T>
 void DataManSerializer::CalculateMinMax(const T *data, const Dims &count,
-                                        nlohmann::json &metaj)
+                                        std::vector<char> &min,
+                                        std::vector<char> &max)
 {
-    TAU_SCOPED_TIMER_FUNC();
+    TAU_SCOPED_TIMER("DataManSerializer::CalculateMinMax");
     size_t size = std::accumulate(count.begin(), count.end(), 1,
                                   std::multiplies<size_t>());
-    T max = std::numeric_limits<T>::min();
-    T min = std::numeric_limits<T>::max();
+    T maxValue = std::numeric_limits<T>::min();
+    T minValue = std::numeric_limits<T>::max();
 
     for (size_t j = 0; j < size; ++j)
     {
         T value = data[j];
-        if (value > max)
+        if (value > maxValue)
         {
-            max = value;
+            maxValue = value;
         }
-        if (value < min)
+        if (value < minValue)
         {
-            min = value;
+            minValue = value;
         }
     }
 
-    std::vector<char> vectorValue(sizeof(T));
-
-    reinterpret_cast<T *>(vectorValue.data())[0] = max;
-    metaj["+"] = vectorValue;
+    max.resize(sizeof(T));
+    reinterpret_cast<T *>(max.data())[0] = maxValue;
 
-    reinterpret_cast<T *>(vectorValue.data())[0] = min;
-    metaj["-"] = vectorValue;
+    min.resize(sizeof(T));
+    reinterpret_cast<T *>(min.data())[0] = minValue;
 }
 
 template <class T>
@@ -83,7 +84,7 @@ void DataManSerializer::PutVar(const core::Variable<T> &variable,
                                const Params &params, VecPtr localBuffer,
                                JsonPtr metadataJson)
 {
-    TAU_SCOPED_TIMER_FUNC();
+    TAU_SCOPED_TIMER("DataManSerializer::PutVar");
     PutVar(variable.GetData(), variable.m_Name, variable.m_Shape,
            variable.m_Start, variable.m_Count, variable.m_MemoryStart,
            variable.m_MemoryCount, doid, step, rank, address, params,
@@ -99,39 +100,70 @@ void DataManSerializer::PutVar(const T *inputData, const std::string &varName,
                                const std::string &address, const Params &params,
                                VecPtr localBuffer, JsonPtr metadataJson)
 {
-    TAU_SCOPED_TIMER_FUNC();
-    Log(1,
-        "DataManSerializer::PutVar begin with Step " + std::to_string(step) +
-            " Var " + varName,
-        true, true);
+    // per variable, the timer name is not formatted
+    TAU_SCOPED_TIMER("DataManSerializer::PutVar");
+    if (m_Verbosity >= 1)
+    {
+        Log(1,
+            "DataManSerializer::PutVar begin with Step " +
+                std::to_string(step) + " Var " + varName,
+            true, true);
+    }
 
     if (localBuffer == nullptr)
     {
         localBuffer = m_LocalBuffer;
     }
 
-    nlohmann::json metaj;
+    // replies to deferred requests stay in JSON
+    const bool binary =
+        (m_UseJsonSerialization == "binary" && metadataJson == nullptr);
 
-    metaj["A"] = address;
-    metaj["N"] = varName;
-    metaj["O"] = varStart;
-    metaj["C"] = varCount;
-    metaj["S"] = varShape;
-    metaj["Y"] = helper::GetType<T>();
-    metaj["P"] = localBuffer->size();
+    nlohmann::json metaj;
+    DataManVar var;
 
-    if (m_EnableStat)
+    if (binary)
     {
-        CalculateMinMax(inputData, varCount, metaj);
+        var.address = address;
+        var.name = varName;
+        var.start = varStart;
+        var.count = varCount;
+        var.shape = varShape;
+        var.type = helper::GetType<T>();
+        var.position = localBuffer->size();
+        var.step = step;
+        var.rank = rank;
+        var.isRowMajor = m_IsRowMajor;
+        var.isLittleEndian = m_IsLittleEndian;
     }
-
-    if (not m_IsRowMajor)
+    else
     {
-        metaj["M"] = m_IsRowMajor;
+        metaj["A"] = address;
+        metaj["N"] = varName;
+        metaj["O"] = varStart;
+        metaj["C"] = varCount;
+        metaj["S"] = varShape;
+        metaj["Y"] = helper::GetType<T>();
+        metaj["P"] = localBuffer->size();
+
+        if (not m_IsRowMajor)
+        {
+            metaj["M"] = m_IsRowMajor;
+        }
+        if (not m_IsLittleEndian)
+        {
+            metaj["E"] = m_IsLittleEndian;
+        }
     }
-    if (not m_IsLittleEndian)
+
+    if (m_EnableStat)
     {
-        metaj["E"] = m_IsLittleEndian;
+        CalculateMinMax(inputData, varCount, var.min, var.max);
+        if (not binary && not var.max.empty())
+        {
+            metaj["+"] = var.max;
+            metaj["-"] = var.min;
+        }
     }
 
     size_t datasize = 0;
@@ -196,7 +228,28 @@ void DataManSerializer::PutVar(const T *inputData, const std::string &varName,
         datasize = std::accumulate(varCount.begin(), varCount.end(), sizeof(T),
                                    std::multiplies<size_t>());
     }
-    metaj["I"] = datasize;
+
+    if (binary)
+    {
+        var.size = datasize;
+        if (compressed)
+        {
+            // compression method and parameters were put in metaj
+            var.compression = metaj["Z"].get<std::string>();
+            for (auto i = metaj.begin(); i != metaj.end(); ++i)
+            {
+                auto pos = i.key().find(":");
+                if (pos != std::string::npos)
+                {
+                    var.params[i.key().substr(pos + 1)] = i.value();
+                }
+            }
+        }
+    }
+    else
+    {
+        metaj["I"] = datasize;
+    }
 
     if (localBuffer->capacity() < localBuffer->size() + datasize)
     {
@@ -216,7 +269,11 @@ void DataManSerializer::PutVar(const T *inputData, const std::string &varName,
                     inputData, datasize);
     }
 
-    if (metadataJson == nullptr)
+    if (binary)
+    {
+        PutBinaryVar(var);
+    }
+    else if (metadataJson == nullptr)
     {
         m_MetadataJson[std::to_string(step)][std::to_string(rank)].emplace_back(
             std::move(metaj));
@@ -227,10 +284,13 @@ void DataManSerializer::PutVar(const T *inputData, const std::string &varName,
             .emplace_back(std::move(metaj));
     }
 
-    Log(1,
-        "DataManSerializer::PutVar end with Step " + std::to_string(step) +
-            " Var " + varName,
-        true, true);
+    if (m_Verbosity >= 1)
+    {
+        Log(1,
+            "DataManSerializer::PutVar end with Step " + std::to_string(step) +
+                " Var " + varName,
+            true, true);
+    }
 }
 
 template <class T>
@@ -11,6 +11,7 @@
 #include "HDF5Common.h"
 #include "HDF5Common.tcc"
 
+#include <algorithm>
 #include <complex>
 #include <ios>
 #include <iostream>
@@ -32,6 +33,11 @@ const std::string HDF5Common::PREFIX_STAT = "ADIOS_STAT_";
 const std::string HDF5Common::PARAMETER_COLLECTIVE = "H5CollectiveMPIO";
 const std::string HDF5Common::PARAMETER_CHUNK_FLAG = "H5ChunkDim";
 const std::string HDF5Common::PARAMETER_CHUNK_VARS = "H5ChunkVars";
+const std::string HDF5Common::PARAMETER_CHUNK_BYTES = "H5ChunkBytes";
+const std::string HDF5Common::PARAMETER_ALIGNMENT = "H5Alignment";
+const std::string HDF5Common::PARAMETER_META_BLOCK_SIZE = "H5MetaBlockSize";
+const std::string HDF5Common::PARAMETER_COLLECTIVE_METADATA =
+    "H5CollectiveMetadata";
 
 /*
    //need to know ndim before defining this.
@@ -77,11 +83,19 @@ void HDF5Common::ParseParameters(core::IO &io)
     m_ChunkVarNames.clear();
     m_ChunkPID = -1;
     m_ChunkDim = 0;
+    m_AutoChunk = false;
+    m_AutoChunkBlocks.clear();
 
     {
         std::vector<hsize_t> chunkDim;
         auto chunkFlagKey = io.m_Parameters.find(PARAMETER_CHUNK_FLAG);
-        if (chunkFlagKey != io.m_Parameters.end())
+        if (chunkFlagKey != io.m_Parameters.end() &&
+            chunkFlagKey->second == "auto")
+        {
+            // chunk shapes are chosen per dataset in CreateDataset
+            m_AutoChunk = true;
+        }
+        else if (chunkFlagKey != io.m_Parameters.end())
         { // note space is the delimiter
             std::stringstream ss(chunkFlagKey->second);
             int i;
@@ -95,10 +109,45 @@ void HDF5Common::ParseParameters(core::IO &io)
         }
     }
 
+    auto chunkBytesKey = io.m_Parameters.find(PARAMETER_CHUNK_BYTES);
+    if (chunkBytesKey != io.m_Parameters.end())
+    {
+        m_ChunkBytes = std::stoull(chunkBytesKey->second);
+    }
+
+    // "threshold alignment", objects of at least threshold bytes start at a
+    // multiple of alignment in the file, note space is the delimiter
+    auto alignmentKey = io.m_Parameters.find(PARAMETER_ALIGNMENT);
+    if (alignmentKey != io.m_Parameters.end())
+    {
+        std::stringstream ss(alignmentKey->second);
+        ss >> m_AlignmentThreshold >> m_Alignment;
+        if (m_Alignment == 0)
+        {
+            // a single value is the alignment of every object
+            m_Alignment = m_AlignmentThreshold;
+            m_AlignmentThreshold = 1;
+        }
+    }
+
+    auto metaBlockKey = io.m_Parameters.find(PARAMETER_META_BLOCK_SIZE);
+    if (metaBlockKey != io.m_Parameters.end())
+    {
+        m_MetaBlockSize = std::stoull(metaBlockKey->second);
+    }
+
+    auto collectiveMetadataKey =
+        io.m_Parameters.find(PARAMETER_COLLECTIVE_METADATA);
+    if (collectiveMetadataKey != io.m_Parameters.end())
+    {
+        m_CollectiveMetadata = (collectiveMetadataKey->second == "yes" ||
+                                collectiveMetadataKey->second == "true");
+    }
+
     //
     // if no chunk dim specified, then ignore this parameter
     //
-    if (-1 != m_ChunkPID)
+    if (-1 != m_ChunkPID || m_AutoChunk)
     {
         auto chunkVarKey = io.m_Parameters.find(PARAMETER_CHUNK_VARS);
         if (chunkVarKey != io.m_Parameters.end())
@@ -114,14 +163,31 @@ void HDF5Common::ParseParameters(core::IO &io)
 void HDF5Common::Init(const std::string &name, MPI_Comm comm, bool toWrite)
 {
     m_WriteMode = toWrite;
+    m_Comm = comm;
     m_PropertyListId = H5Pcreate(H5P_FILE_ACCESS);
 
 #ifdef ADIOS2_HAVE_MPI
     H5Pset_fapl_mpio(m_PropertyListId, comm, MPI_INFO_NULL);
     MPI_Comm_rank(comm, &m_CommRank);
     MPI_Comm_size(comm, &m_CommSize);
+#if H5_VERSION_GE(1, 10, 0)
+    if (m_CollectiveMetadata)
+    {
+        H5Pset_all_coll_metadata_ops(m_PropertyListId, true);
+        H5Pset_coll_metadata_write(m_PropertyListId, true);
+    }
+#endif
 #endif
 
+    if (m_Alignment > 0)
+    {
+        H5Pset_alignment(m_PropertyListId, m_AlignmentThreshold, m_Alignment);
+    }
+    if (m_MetaBlockSize > 0)
+    {
+        H5Pset_meta_block_size(m_PropertyListId, m_MetaBlockSize);
+    }
+
     // std::string ts0 = "/AdiosStep0";
     std::string ts0;
     StaticGetAdiosStepString(ts0, 0);
@@ -704,7 +770,8 @@ hid_t HDF5Common::GetTypeStringScalar(const std::string &input)
 
 void HDF5Common::CreateDataset(const std::string &varName, hid_t h5Type,
                                hid_t filespaceID,
-                               std::vector<hid_t> &datasetChain)
+                               std::vector<hid_t> &datasetChain,
+                               const std::vector<hsize_t> &count)
 {
     std::vector<std::string> list;
     char delimiter = '/';
@@ -742,6 +809,7 @@ void HDF5Common::CreateDataset(const std::string &varName, hid_t h5Type,
     }
 
     hid_t varCreateProperty = H5P_DEFAULT;
+    hid_t autoChunkProperty = -1;
     if (-1 != m_ChunkPID)
     {
         if (m_ChunkVarNames.size() == 0) // applies to all var
@@ -749,10 +817,26 @@ void HDF5Common::CreateDataset(const std::string &varName, hid_t h5Type,
         else if (m_ChunkVarNames.find(varName) != m_ChunkVarNames.end())
             varCreateProperty = m_ChunkPID;
     }
+    else if (m_AutoChunk && !count.empty() &&
+             (m_ChunkVarNames.size() == 0 ||
+              m_ChunkVarNames.find(varName) != m_ChunkVarNames.end()))
+    {
+        autoChunkProperty =
+            CreateAutoChunkProperty(varName, filespaceID, h5Type, count);
+        if (-1 != autoChunkProperty)
+        {
+            varCreateProperty = autoChunkProperty;
+        }
+    }
 
     hid_t dsetID = H5Dcreate(topId, list.back().c_str(), h5Type, filespaceID,
                              H5P_DEFAULT, varCreateProperty, H5P_DEFAULT);
 
+    if (-1 != autoChunkProperty)
+    {
+        H5Pclose(autoChunkProperty);
+    }
+
     if (list.back().compare(varName) != 0)
     {
         StoreADIOSName(varName, dsetID); // only stores when not the same
@@ -761,6 +845,66 @@ void HDF5Common::CreateDataset(const std::string &varName, hid_t h5Type,
     // return dsetID;
 }
 
+hid_t HDF5Common::CreateAutoChunkProperty(const std::string &varName,
+                                          hid_t filespaceID, hid_t h5Type,
+                                          const std::vector<hsize_t> &count)
+{
+    // scalars have no dimensions
+    const int ndims = H5Sget_simple_extent_ndims(filespaceID);
+    if (ndims <= 0 || static_cast<size_t>(ndims) != count.size())
+    {
+        return -1;
+    }
+    std::vector<hsize_t> dims(ndims);
+    H5Sget_simple_extent_dims(filespaceID, dims.data(), NULL);
+    if (std::find(dims.begin(), dims.end(), 0) != dims.end())
+    {
+        // chunks can not be larger than a fixed size dataset
+        return -1;
+    }
+
+    // dataset creation is collective, so every rank has to pass the same
+    // chunk shape: use the largest block of any rank, then each rank writes
+    // whole chunks when the decomposition is regular, it is agreed once per
+    // variable, not at each step
+    std::vector<hsize_t> &block = m_AutoChunkBlocks[varName];
+    if (block.size() != count.size())
+    {
+        std::vector<unsigned long long> localCount(count.begin(),
+                                                   count.end());
+        std::vector<unsigned long long> maxCount(localCount);
+#ifdef ADIOS2_HAVE_MPI
+        MPI_Allreduce(localCount.data(), maxCount.data(), ndims,
+                      MPI_UNSIGNED_LONG_LONG, MPI_MAX, m_Comm);
+#endif
+        block.assign(maxCount.begin(), maxCount.end());
+    }
+
+    std::vector<hsize_t> chunk(ndims);
+    size_t chunkBytes = H5Tget_size(h5Type);
+    for (int i = 0; i < ndims; ++i)
+    {
+        chunk[i] = std::min<hsize_t>(std::max<hsize_t>(block[i], 1), dims[i]);
+        chunkBytes *= chunk[i];
+    }
+
+    // split along the slowest dimensions first so that chunks keep whole
+    // rows, which is how most readers access them
+    for (int i = 0; i < ndims && chunkBytes > m_ChunkBytes; ++i)
+    {
+        while (chunk[i] > 1 && chunkBytes > m_ChunkBytes)
+        {
+            chunkBytes /= chunk[i];
+            chunk[i] = (chunk[i] + 1) / 2;
+            chunkBytes *= chunk[i];
+        }
+    }
+
+    hid_t chunkPID = H5Pcreate(H5P_DATASET_CREATE);
+    H5Pset_chunk(chunkPID, ndims, chunk.data());
+    return chunkPID;
+}
+
 void HDF5Common::StoreADIOSName(const std::string adiosName, hid_t dsetID)
 {
     hid_t attrSpace = H5Screate(H5S_SCALAR);
@@ -13,6 +13,7 @@
 
 #include <hdf5.h>
 
+#include <map>
 #include <string>
 
 #include "adios2/ADIOSMPICommOnly.h"
@@ -119,6 +120,10 @@ public:
     static const std::string PARAMETER_COLLECTIVE;
     static const std::string PARAMETER_CHUNK_FLAG;
     static const std::string PARAMETER_CHUNK_VARS;
+    static const std::string PARAMETER_CHUNK_BYTES;
+    static const std::string PARAMETER_ALIGNMENT;
+    static const std::string PARAMETER_META_BLOCK_SIZE;
+    static const std::string PARAMETER_COLLECTIVE_METADATA;
 
     void ParseParameters(core::IO &io);
     void Init(const std::string &name, MPI_Comm comm, bool toWrite);
@@ -126,8 +131,14 @@ public:
     template <class T>
     void Write(core::Variable<T> &variable, const T *values);
 
+    /**
+     * Creates the dataset of a variable in the current step group
+     * @param count block written by this rank, used to choose the chunk
+     * shape when H5ChunkDim is auto, empty for scalars
+     */
     void CreateDataset(const std::string &varName, hid_t h5Type,
-                       hid_t filespaceID, std::vector<hid_t> &chain);
+                       hid_t filespaceID, std::vector<hid_t> &chain,
+                       const std::vector<hsize_t> &count = {});
     bool OpenDataset(const std::string &varName, std::vector<hid_t> &chain);
 
     void StoreADIOSName(const std::string adiosName, hid_t dsetID);
@@ -220,6 +231,26 @@ private:
     hid_t m_ChunkPID;
     int m_ChunkDim;
     std::set<std::string> m_ChunkVarNames;
+
+    /** H5ChunkDim auto: chunk shape follows the largest block of all ranks,
+     * capped by the global shape */
+    bool m_AutoChunk = false;
+    /** upper bound of an automatic chunk, H5ChunkBytes */
+    size_t m_ChunkBytes = 1024 * 1024;
+    /** largest block of all ranks per variable, agreed once at its first
+     * dataset as dataset creation is collective */
+    std::map<std::string, std::vector<hsize_t>> m_AutoChunkBlocks;
+    hid_t CreateAutoChunkProperty(const std::string &varName,
+                                  hid_t filespaceID, hid_t h5Type,
+                                  const std::vector<hsize_t> &count);
+
+    /** file access tuning, applied in Init, so parse parameters first */
+    hsize_t m_AlignmentThreshold = 0;
+    hsize_t m_Alignment = 0;
+    hsize_t m_MetaBlockSize = 0;
+    bool m_CollectiveMetadata = false;
+
+    MPI_Comm m_Comm;
 };
 
 // Explicit declaration of the public template methods
@@ -105,7 +105,8 @@ void HDF5Common::Write(core::Variable<T> &variable, const T *values)
     hid_t fileSpace = H5Screate_simple(dimSize, dimsf.data(), NULL);
 
     std::vector<hid_t> chain;
-    /*hid_t dsetID =*/CreateDataset(variable.m_Name, h5Type, fileSpace, chain);
+    /*hid_t dsetID =*/CreateDataset(variable.m_Name, h5Type, fileSpace, chain,
+                                    count);
     hid_t dsetID = chain.back();
     HDF5DatasetGuard g(chain);
     /*
@@ -65,6 +65,11 @@ void CP_validateParams(SstStream Stream, SstParams Params, int Writer)
         {
             Params->DataTransport = strdup("rdma");
         }
+        else if ((strcmp(SelectedTransport, "shm") == 0) ||
+                 (strcmp(SelectedTransport, "sharedmemory") == 0))
+        {
+            Params->DataTransport = strdup("shm");
+        }
         free(SelectedTransport);
     }
     if (Params->ControlTransport == NULL)
@@ -125,7 +130,7 @@ void CP_validateParams(SstStream Stream, SstParams Params, int Writer)
 
 static char *SstRegStr[] = {"File", "Screen", "Cloud"};
 static char *SstMarshalStr[] = {"FFS", "BP"};
-static char *SstQueueFullStr[] = {"Block", "Discard"};
+static char *SstQueueFullStr[] = {"Block", "Discard", "Adaptive"};
 static char *SstCompressStr[] = {"None", "ZFP"};
 static char *SstCommPatternStr[] = {"Min", "Peer"};
 
@@ -142,6 +147,11 @@ extern void CP_dumpParams(SstStream Stream, struct _SstParams *Params)
             (Params->QueueLimit == 0) ? "(unlimited)" : "");
     fprintf(stderr, "Param -   QueueFullPolicy:%s\n",
             SstQueueFullStr[Params->QueueFullPolicy]);
+    fprintf(stderr, "Param -   StallBudgetPercent:%d\n",
+            Params->StallBudgetPercent);
+    fprintf(stderr, "Param -   GuaranteedStepInterval:%d %s\n",
+            Params->GuaranteedStepInterval,
+            (Params->GuaranteedStepInterval == 0) ? "(none)" : "");
     fprintf(stderr, "Param -   DataTransport:%s\n",
             Params->DataTransport ? Params->DataTransport : "");
     fprintf(stderr, "Param -   ControlTransport:%s\n",
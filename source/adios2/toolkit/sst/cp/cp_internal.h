@@ -71,6 +71,8 @@ typedef struct _WS_ReaderInfo
     long LastSentTimestep;
     int LastReleasedTimestep;
     long OldestUnreleasedTimestep;
+    struct timeval LastReleaseTime;
+    double ReleaseIntervalSecs; /* moving average, 0 until two releases */
     struct _SentTimestepRec *SentTimestepList;
     void *DP_WSR_Stream;
     void *RS_StreamID;
@@ -100,6 +102,8 @@ typedef struct _CPTimestepEntry
     int Expired;
     int Pending;
     int PreciousTimestep;
+    int Discarded;
+    struct timeval ProvideTime;
     void **DP_TimestepInfo;
     int DPRegistered;
     SstData MetadataArray;
@@ -150,6 +154,15 @@ struct _SstStream
     int LastProvidedTimestep;
     int NewReaderPresent;
 
+    /* writer queue statistics */
+    size_t TimestepsProvided;
+    size_t TimestepsDiscarded;
+    int ConsecutiveDiscards;
+    double WriterStallSecs;
+    double QueueResidencySecs;
+    double MaxQueueResidencySecs;
+    size_t QueueResidencyCount;
+
     /* rendezvous condition */
     int FirstReaderCondition;
     RequestQueue ReadRequestQueue;
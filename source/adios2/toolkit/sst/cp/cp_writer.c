@@ -210,6 +210,14 @@ static void removeContactInfo(SstStream Stream)
     }
 }
 
+static double SecondsSince(const struct timeval *Then)
+{
+    struct timeval Now, Diff;
+    gettimeofday(&Now, NULL);
+    timersub(&Now, Then, &Diff);
+    return (double)Diff.tv_usec / 1e6 + Diff.tv_sec;
+}
+
 /*
 RemoveQueueEntries:
         If the number of timesteps older than OldestCurrentReaderTimestep, mark
@@ -241,6 +249,14 @@ static void RemoveQueueEntries(SstStream Stream)
             }
 
             Stream->QueuedTimestepCount--;
+            if (!ItemToFree->Discarded)
+            {
+                double Residency = SecondsSince(&ItemToFree->ProvideTime);
+                Stream->QueueResidencySecs += Residency;
+                Stream->QueueResidencyCount++;
+                if (Residency > Stream->MaxQueueResidencySecs)
+                    Stream->MaxQueueResidencySecs = Residency;
+            }
             //            printf("Rank %d FreeingTimestep %ld, reference count
             //            %d\n", Stream->Rank, ItemToFree->Timestep,
             //            ItemToFree->ReferenceCount);
@@ -1197,6 +1213,7 @@ SstStream SstWriterOpen(const char *Name, SstParams Params, MPI_Comm comm)
     }
     Stream->Filename = Filename;
     Stream->Status = Established;
+    gettimeofday(&Stream->ValidStartTime, NULL);
     CP_verbose(Stream, "Finish opening Stream \"%s\"\n", Filename);
     AddToLastCallFreeList(Stream);
     return Stream;
@@ -1279,6 +1296,46 @@ On writer close:
       UNLOCK
    Barrier()
 */
+/*
+ * Fill in the writer queue statistics (ASSUME LOCKED).  Discards, stall
+ * time and reader consumption rates are only tracked on rank 0.
+ */
+static void FillWriterStats(SstStream Stream, SstStats Stats)
+{
+    double SlowestInterval = 0.0;
+
+    Stats->TimestepsProvided = Stream->TimestepsProvided;
+    Stats->TimestepsDiscarded = Stream->TimestepsDiscarded;
+    Stats->WriterStallSecs = Stream->WriterStallSecs;
+    Stats->MaxQueueResidencySecs = Stream->MaxQueueResidencySecs;
+    Stats->MeanQueueResidencySecs = 0.0;
+    if (Stream->QueueResidencyCount)
+    {
+        Stats->MeanQueueResidencySecs =
+            Stream->QueueResidencySecs / Stream->QueueResidencyCount;
+    }
+    for (int i = 0; i < Stream->ReaderCount; i++)
+    {
+        WS_ReaderInfo Reader = Stream->Readers[i];
+        if ((Reader->ReaderStatus == Established) &&
+            (Reader->ReleaseIntervalSecs > SlowestInterval))
+        {
+            SlowestInterval = Reader->ReleaseIntervalSecs;
+        }
+    }
+    Stats->SlowestReaderStepsPerSec =
+        (SlowestInterval > 0.0) ? 1.0 / SlowestInterval : 0.0;
+}
+
+extern void SstWriterGetStats(SstStream Stream, SstStats Stats)
+{
+    PTHREAD_MUTEX_LOCK(&Stream->DataLock);
+    Stats->OpenTimeSecs = Stream->OpenTimeSecs;
+    Stats->ValidTimeSecs = SecondsSince(&Stream->ValidStartTime);
+    FillWriterStats(Stream, Stats);
+    PTHREAD_MUTEX_UNLOCK(&Stream->DataLock);
+}
+
 void SstWriterClose(SstStream Stream)
 {
     struct _WriterCloseMsg Msg;
@@ -1349,9 +1406,30 @@ void SstWriterClose(SstStream Stream)
     gettimeofday(&CloseTime, NULL);
     timersub(&CloseTime, &Stream->ValidStartTime, &Diff);
     if (Stream->Stats)
+    {
         Stream->Stats->ValidTimeSecs = (double)Diff.tv_usec / 1e6 + Diff.tv_sec;
+        PTHREAD_MUTEX_LOCK(&Stream->DataLock);
+        FillWriterStats(Stream, Stream->Stats);
+        PTHREAD_MUTEX_UNLOCK(&Stream->DataLock);
+    }
 
     CP_verbose(Stream, "All timesteps are released in WriterClose\n");
+    CP_verbose(Stream,
+               "Writer provided %zu timesteps, discarded %zu, stalled %g "
+               "secs, mean queue residency %g secs\n",
+               Stream->TimestepsProvided, Stream->TimestepsDiscarded,
+               Stream->WriterStallSecs,
+               Stream->QueueResidencyCount
+                   ? Stream->QueueResidencySecs / Stream->QueueResidencyCount
+                   : 0.0);
+    for (int i = 0; i < Stream->ReaderCount; i++)
+    {
+        WS_ReaderInfo Reader = Stream->Readers[i];
+        CP_verbose(Stream, "Reader [%d] consumed %g timesteps/sec\n", i,
+                   Reader->ReleaseIntervalSecs > 0.0
+                       ? 1.0 / Reader->ReleaseIntervalSecs
+                       : 0.0);
+    }
 
     /*
      *  Only rank 0 removes contact info, and only when everything is closed.
@@ -1532,6 +1610,79 @@ static void ProcessReaderStatusList(SstStream Stream,
     PTHREAD_MUTEX_UNLOCK(&Stream->DataLock);
 }
 
+/*
+Adaptive queue full policy:    (ASSUME LOCKED, Rank 0 only)
+        Block on a full queue only as long as the total writer stall stays
+within StallBudgetPercent of the time since open, then discard the new
+timestep.  With GuaranteedStepInterval N, never discard N timesteps in a row
+while a reader is connected, but block instead.  Returns 1 for discard.
+*/
+static int AdaptiveQueueFullWait(SstStream Stream)
+{
+    int Interval = Stream->ConfigParams->GuaranteedStepInterval;
+    int MustDeliver = 0;
+    double Budget;
+    struct timeval Start;
+
+    if ((Stream->QueueLimit == 0) ||
+        (Stream->QueuedTimestepCount <= Stream->QueueLimit))
+    {
+        Stream->ConsecutiveDiscards = 0;
+        return 0;
+    }
+    for (int i = 0; i < Stream->ReaderCount; i++)
+    {
+        if ((Stream->Readers[i]->ReaderStatus == Established) &&
+            (Interval > 0) && (Stream->ConsecutiveDiscards + 1 >= Interval))
+        {
+            MustDeliver = 1;
+        }
+    }
+    Budget = SecondsSince(&Stream->ValidStartTime) *
+                 Stream->ConfigParams->StallBudgetPercent / 100.0 -
+             Stream->WriterStallSecs;
+
+    gettimeofday(&Start, NULL);
+    while (Stream->QueuedTimestepCount > Stream->QueueLimit)
+    {
+        struct timeval Now;
+        struct timespec Deadline;
+        double Remaining = Budget - SecondsSince(&Start);
+        if (MustDeliver)
+        {
+            CP_verbose(Stream, "Blocking on QueueFull condition to deliver "
+                               "a guaranteed timestep\n");
+            pthread_cond_wait(&Stream->DataCondition, &Stream->DataLock);
+            continue;
+        }
+        if (Remaining <= 0.0)
+        {
+            break;
+        }
+        CP_verbose(Stream, "Waiting up to %g secs on QueueFull condition\n",
+                   Remaining);
+        gettimeofday(&Now, NULL);
+        Remaining += (double)Now.tv_usec / 1e6;
+        Deadline.tv_sec = Now.tv_sec + (time_t)Remaining;
+        Deadline.tv_nsec = (long)((Remaining - (time_t)Remaining) * 1e9);
+        pthread_cond_timedwait(&Stream->DataCondition, &Stream->DataLock,
+                               &Deadline);
+    }
+    Stream->WriterStallSecs += SecondsSince(&Start);
+
+    if (Stream->QueuedTimestepCount > Stream->QueueLimit)
+    {
+        CP_verbose(Stream,
+                   "Stall budget exhausted, discarding timestep after %d "
+                   "consecutive discards\n",
+                   Stream->ConsecutiveDiscards);
+        Stream->ConsecutiveDiscards++;
+        return 1;
+    }
+    Stream->ConsecutiveDiscards = 0;
+    return 0;
+}
+
 static void ProcessReleaseList(SstStream Stream, ReturnMetadataInfo Metadata)
 {
     PTHREAD_MUTEX_LOCK(&Stream->DataLock);
@@ -1785,6 +1936,7 @@ extern void SstInternalProvideTimestep(
         1; /* holding one for us, so it doesn't disappear under us */
     Entry->DPRegistered = 1;
     Entry->Timestep = Timestep;
+    gettimeofday(&Entry->ProvideTime, NULL);
     Entry->Msg = Msg;
     Entry->MetadataArray = Msg->Metadata;
     Entry->DP_TimestepInfo = Msg->DP_TimestepInfo;
@@ -1793,6 +1945,7 @@ extern void SstInternalProvideTimestep(
     Entry->Next = Stream->QueuedTimesteps;
     Stream->QueuedTimesteps = Entry;
     Stream->QueuedTimestepCount++;
+    Stream->TimestepsProvided++;
     /* no one waits on timesteps being added, so no condition signal to note
      * change */
 
@@ -1821,15 +1974,24 @@ extern void SstInternalProvideTimestep(
                 DiscardThisTimestep = 1;
             }
         }
+        else if (Stream->QueueFullPolicy == SstQueueFullAdaptive)
+        {
+            DiscardThisTimestep = AdaptiveQueueFullWait(Stream);
+        }
         else
         {
+            struct timeval Start;
+            gettimeofday(&Start, NULL);
             while ((Stream->QueueLimit > 0) &&
                    (Stream->QueuedTimestepCount > Stream->QueueLimit))
             {
                 CP_verbose(Stream, "Blocking on QueueFull condition\n");
                 pthread_cond_wait(&Stream->DataCondition, &Stream->DataLock);
             }
+            Stream->WriterStallSecs += SecondsSince(&Start);
         }
+        TAU_SAMPLE_COUNTER("Writer queue stall time",
+                           Stream->WriterStallSecs);
         TimestepMetaData.PendingReaderCount = 0;
         while (ArrivingReader)
         {
@@ -1894,6 +2056,9 @@ extern void SstInternalProvideTimestep(
 
     if (ReturnData->DiscardThisTimestep)
     {
+        Stream->TimestepsDiscarded++;
+        Entry->Discarded = 1;
+
         /* Data was actually discarded, but we want to send a message to each
          * reader so that it knows a step was discarded, but actually so that we
          * get an error return if the write fails */
@@ -2049,6 +2214,29 @@ void CP_ReaderActivateHandler(CManager cm, CMConnection conn, void *Msg_v,
     TAU_STOP_FUNC();
 }
 
+/*
+ * Track a moving average of the interval between timestep releases, the
+ * reader's consumption rate (ASSUME LOCKED)
+ */
+static void NoteReaderRelease(WS_ReaderInfo Reader)
+{
+    struct timeval Now, Diff;
+
+    gettimeofday(&Now, NULL);
+    if (Reader->LastReleaseTime.tv_sec || Reader->LastReleaseTime.tv_usec)
+    {
+        double Interval;
+        timersub(&Now, &Reader->LastReleaseTime, &Diff);
+        Interval = (double)Diff.tv_usec / 1e6 + Diff.tv_sec;
+        if (Reader->ReleaseIntervalSecs == 0.0)
+            Reader->ReleaseIntervalSecs = Interval;
+        else
+            Reader->ReleaseIntervalSecs =
+                0.8 * Reader->ReleaseIntervalSecs + 0.2 * Interval;
+    }
+    Reader->LastReleaseTime = Now;
+}
+
 extern void CP_ReleaseTimestepHandler(CManager cm, CMConnection conn,
                                       void *Msg_v, void *client_data,
                                       attr_list attrs)
@@ -2075,6 +2263,7 @@ extern void CP_ReleaseTimestepHandler(CManager cm, CMConnection conn,
     /* decrement the reference count for the released timestep */
     PTHREAD_MUTEX_LOCK(&ParentStream->DataLock);
     Reader->LastReleasedTimestep = Msg->Timestep;
+    NoteReaderRelease(Reader);
     if ((ParentStream->Rank == 0) &&
         (ParentStream->ConfigParams->CPCommPattern == SstCPCommMin))
     {
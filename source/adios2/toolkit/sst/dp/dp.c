@@ -13,6 +13,9 @@
 #ifdef SST_HAVE_LIBFABRIC
 extern CP_DP_Interface LoadRdmaDP();
 #endif /* SST_HAVE_LIBFABRIC */
+#ifdef SST_HAVE_SHM
+extern CP_DP_Interface LoadShmDP();
+#endif /* SST_HAVE_SHM */
 extern CP_DP_Interface LoadEVpathDP();
 
 typedef struct _DPElement
@@ -59,6 +62,9 @@ CP_DP_Interface SelectDP(CP_Services Svcs, void *CP_Stream,
     List =
         AddDPPossibility(Svcs, CP_Stream, List, LoadRdmaDP(), "rdma", Params);
 #endif /* SST_HAVE_LIBFABRIC */
+#ifdef SST_HAVE_SHM
+    List = AddDPPossibility(Svcs, CP_Stream, List, LoadShmDP(), "shm", Params);
+#endif /* SST_HAVE_SHM */
 
     int SelectedDP = -1;
     int BestPriority = -1;
@@ -0,0 +1,1036 @@
+#include <assert.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#include <unistd.h>
+
+#include <atl.h>
+#include <evpath.h>
+
+#include "sst_data.h"
+
+#include "adios2/toolkit/profiling/taustubs/taustubs.h"
+#include "dp_interface.h"
+
+/*
+ *  The "shm" data plane serves readers running on the same host as the
+ *  writer rank out of a System V shared memory segment holding a copy of
+ *  the timestep data, so that a remote memory read becomes a memcpy
+ *  instead of a round trip through the socket stack.
+ *
+ *   Reader and writer ranks exchange their host names in the contact
+ *   information.  On ProvideTimestep, a writer rank that has at least one
+ *   reader rank on its host copies the data block into a segment and
+ *   announces the segment id in the per-timestep info.  Segments of
+ *   released timesteps are kept for reuse, and readers keep their
+ *   attachments, so that in steady state neither side pays for mapping
+ *   fresh pages every timestep.
+ *
+ *   Everything else, writer ranks on other hosts, timesteps provided
+ *   before a local reader joined, segments that can't be created or
+ *   attached (limits, permissions, separate IPC namespaces), falls back
+ *   to the same request/reply over the control plane connections used by
+ *   the "evpath" data plane.  So this data plane is chosen over "evpath"
+ *   by default whenever it is available, without knowing in advance where
+ *   the peers run.
+ *
+ *   The conventions of evpath_dp.c apply here (`RS` reader-side, `WS`
+ *   writer-side, `WSR` writer-side per-reader, contact information
+ *   carrying the addresses of the stream structures).
+ */
+
+/* released segments a writer rank keeps for later timesteps */
+#define SHM_FREE_SEGMENTS 4
+/* timesteps a reader rank keeps an unused attachment */
+#define SHM_KEEP_ATTACHMENT 4
+
+typedef struct _ShmAttachment
+{
+    int Rank;
+    int ShmID;
+    long LastTimestep;
+    char *Segment; /* NULL if attaching failed */
+    struct _ShmAttachment *Next;
+} * ShmAttachment;
+
+typedef struct _ShmSegment
+{
+    int ShmID;
+    size_t Size;
+    char *Segment;
+    struct _ShmSegment *Next;
+} * ShmSegment;
+
+typedef struct _Shm_RS_Stream
+{
+    CManager cm;
+    void *CP_Stream;
+    CMFormat ReadRequestFormat;
+    int Rank;
+    char *HostName;
+
+    /* writer info */
+    int WriterCohortSize;
+    CP_PeerCohort PeerCohort;
+    struct _ShmWriterContactInfo *WriterContactInfo;
+    int *WriterIsLocal;
+    struct _ShmCompletionHandle *PendingReadRequests;
+    ShmAttachment Attachments;
+} * Shm_RS_Stream;
+
+typedef struct _Shm_WSR_Stream
+{
+    struct _Shm_WS_Stream *WS_Stream;
+    CP_PeerCohort PeerCohort;
+    int ReaderCohortSize;
+    struct _ShmReaderContactInfo *ReaderContactInfo;
+    struct _ShmWriterContactInfo
+        *WriterContactInfo; /* included so we can free on destroy */
+} * Shm_WSR_Stream;
+
+typedef struct _TimestepEntry
+{
+    long Timestep;
+    struct _SstData Data;
+    struct _ShmPerTimestepInfo *DP_TimestepInfo;
+    ShmSegment Segment; /* NULL if no segment */
+    struct _TimestepEntry *Next;
+} * TimestepList;
+
+typedef struct _Shm_WS_Stream
+{
+    CManager cm;
+    void *CP_Stream;
+    int Rank;
+    char *HostName;
+
+    TimestepList Timesteps;
+    CMFormat ReadReplyFormat;
+
+    /* reader ranks sharing the host, segments are only worth it if > 0 */
+    int LocalReaderRanks;
+    ShmSegment FreeSegments;
+
+    int ReaderCount;
+    Shm_WSR_Stream *Readers;
+} * Shm_WS_Stream;
+
+typedef struct _ShmReaderContactInfo
+{
+    char *ContactString;
+    char *HostName;
+    CMConnection Conn;
+    void *RS_Stream;
+} * ShmReaderContactInfo;
+
+typedef struct _ShmWriterContactInfo
+{
+    char *HostName;
+    void *WS_Stream;
+} * ShmWriterContactInfo;
+
+typedef struct _ShmPerTimestepInfo
+{
+    int ShmID; /* -1 if the timestep is only available through messages */
+} * ShmPerTimestepInfo;
+
+typedef struct _ShmReadRequestMsg
+{
+    long Timestep;
+    size_t Offset;
+    size_t Length;
+    void *WS_Stream;
+    void *RS_Stream;
+    int RequestingRank;
+    int NotifyCondition;
+} * ShmReadRequestMsg;
+
+static FMField ShmReadRequestList[] = {
+    {"Timestep", "integer", sizeof(long),
+     FMOffset(ShmReadRequestMsg, Timestep)},
+    {"Offset", "integer", sizeof(size_t), FMOffset(ShmReadRequestMsg, Offset)},
+    {"Length", "integer", sizeof(size_t), FMOffset(ShmReadRequestMsg, Length)},
+    {"WS_Stream", "integer", sizeof(void *),
+     FMOffset(ShmReadRequestMsg, WS_Stream)},
+    {"RS_Stream", "integer", sizeof(void *),
+     FMOffset(ShmReadRequestMsg, RS_Stream)},
+    {"RequestingRank", "integer", sizeof(int),
+     FMOffset(ShmReadRequestMsg, RequestingRank)},
+    {"NotifyCondition", "integer", sizeof(int),
+     FMOffset(ShmReadRequestMsg, NotifyCondition)},
+    {NULL, NULL, 0, 0}};
+
+static FMStructDescRec ShmReadRequestStructs[] = {
+    {"ShmReadRequest", ShmReadRequestList, sizeof(struct _ShmReadRequestMsg),
+     NULL},
+    {NULL, NULL, 0, NULL}};
+
+typedef struct _ShmReadReplyMsg
+{
+    long Timestep;
+    size_t DataLength;
+    void *RS_Stream;
+    char *Data;
+    int NotifyCondition;
+} * ShmReadReplyMsg;
+
+static FMField ShmReadReplyList[] = {
+    {"Timestep", "integer", sizeof(long), FMOffset(ShmReadReplyMsg, Timestep)},
+    {"RS_Stream", "integer", sizeof(void *),
+     FMOffset(ShmReadReplyMsg, RS_Stream)},
+    {"DataLength", "integer", sizeof(size_t),
+     FMOffset(ShmReadReplyMsg, DataLength)},
+    {"Data", "char[DataLength]", sizeof(char), FMOffset(ShmReadReplyMsg, Data)},
+    {"NotifyCondition", "integer", sizeof(int),
+     FMOffset(ShmReadReplyMsg, NotifyCondition)},
+    {NULL, NULL, 0, 0}};
+
+static FMStructDescRec ShmReadReplyStructs[] = {
+    {"ShmReadReply", ShmReadReplyList, sizeof(struct _ShmReadReplyMsg), NULL},
+    {NULL, NULL, 0, NULL}};
+
+static void ShmReadReplyHandler(CManager cm, CMConnection conn, void *msg_v,
+                                void *client_Data, attr_list attrs);
+
+static char *GetHostName()
+{
+    char HostName[256] = {0};
+    if (gethostname(HostName, sizeof(HostName) - 1) != 0)
+    {
+        /* never matches a peer, every read goes through messages */
+        return strdup("");
+    }
+    return strdup(HostName);
+}
+
+static int SameHost(const char *HostName, const char *PeerHostName)
+{
+    return HostName[0] != 0 && PeerHostName != NULL &&
+           strcmp(HostName, PeerHostName) == 0;
+}
+
+static DP_RS_Stream ShmInitReader(CP_Services Svcs, void *CP_Stream,
+                                  void **ReaderContactInfoPtr,
+                                  struct _SstParams *Params)
+{
+    Shm_RS_Stream Stream = malloc(sizeof(struct _Shm_RS_Stream));
+    ShmReaderContactInfo Contact = malloc(sizeof(struct _ShmReaderContactInfo));
+    CManager cm = Svcs->getCManager(CP_Stream);
+    MPI_Comm comm = Svcs->getMPIComm(CP_Stream);
+    CMFormat F;
+    attr_list ListenAttrs = create_attr_list();
+
+    memset(Stream, 0, sizeof(*Stream));
+    memset(Contact, 0, sizeof(*Contact));
+
+    /*
+     * save the CP_stream value of later use
+     */
+    Stream->CP_Stream = CP_Stream;
+    Stream->HostName = GetHostName();
+
+    MPI_Comm_rank(comm, &Stream->Rank);
+
+    /*
+     * listen for the replies from writer ranks on other hosts
+     */
+    set_string_attr(ListenAttrs, attr_atom_from_string("CM_TRANSPORT"),
+                    "sockets");
+
+    CMlisten_specific(cm, ListenAttrs);
+    attr_list ContactList = CMget_specific_contact_list(cm, ListenAttrs);
+
+    Stream->ReadRequestFormat = CMregister_format(cm, ShmReadRequestStructs);
+    F = CMregister_format(cm, ShmReadReplyStructs);
+    CMregister_handler(F, ShmReadReplyHandler, Svcs);
+
+    Contact->ContactString = attr_list_to_string(ContactList);
+    Contact->HostName = strdup(Stream->HostName);
+    Contact->RS_Stream = Stream;
+
+    *ReaderContactInfoPtr = Contact;
+
+    return Stream;
+}
+
+static void DetachSegments(Shm_RS_Stream Stream, long BeforeTimestep)
+{
+    ShmAttachment *Link = &Stream->Attachments;
+    while (*Link != NULL)
+    {
+        ShmAttachment Tmp = *Link;
+        if (Tmp->LastTimestep < BeforeTimestep)
+        {
+            if (Tmp->Segment)
+            {
+                shmdt(Tmp->Segment);
+            }
+            *Link = Tmp->Next;
+            free(Tmp);
+        }
+        else
+        {
+            Link = &Tmp->Next;
+        }
+    }
+}
+
+static void ShmDestroyReader(CP_Services Svcs, DP_RS_Stream RS_Stream_v)
+{
+    Shm_RS_Stream RS_Stream = (Shm_RS_Stream)RS_Stream_v;
+    DetachSegments(RS_Stream, LONG_MAX);
+    for (int i = 0; i < RS_Stream->WriterCohortSize; i++)
+    {
+        free(RS_Stream->WriterContactInfo[i].HostName);
+    }
+    free(RS_Stream->WriterContactInfo);
+    free(RS_Stream->WriterIsLocal);
+    free(RS_Stream->HostName);
+    free(RS_Stream);
+}
+
+static void ShmReadRequestHandler(CManager cm, CMConnection conn, void *msg_v,
+                                  void *client_Data, attr_list attrs)
+{
+    TAU_START_FUNC();
+    ShmReadRequestMsg ReadRequestMsg = (ShmReadRequestMsg)msg_v;
+    Shm_WSR_Stream WSR_Stream = ReadRequestMsg->WS_Stream;
+
+    Shm_WS_Stream WS_Stream = WSR_Stream->WS_Stream;
+    TimestepList tmp = WS_Stream->Timesteps;
+    CP_Services Svcs = (CP_Services)client_Data;
+    ShmReaderContactInfo Reader =
+        &WSR_Stream->ReaderContactInfo[ReadRequestMsg->RequestingRank];
+
+    Svcs->verbose(WS_Stream->CP_Stream,
+                  "Got a request to read remote memory "
+                  "from reader rank %d: timestep %d, "
+                  "offset %d, length %d\n",
+                  ReadRequestMsg->RequestingRank, ReadRequestMsg->Timestep,
+                  ReadRequestMsg->Offset, ReadRequestMsg->Length);
+    while (tmp != NULL)
+    {
+        if (tmp->Timestep == ReadRequestMsg->Timestep)
+        {
+            struct _ShmReadReplyMsg ReadReplyMsg;
+            /* memset avoids uninit byte warnings from valgrind */
+            memset(&ReadReplyMsg, 0, sizeof(ReadReplyMsg));
+            ReadReplyMsg.Timestep = ReadRequestMsg->Timestep;
+            ReadReplyMsg.DataLength = ReadRequestMsg->Length;
+            ReadReplyMsg.Data = tmp->Data.block + ReadRequestMsg->Offset;
+            ReadReplyMsg.RS_Stream = ReadRequestMsg->RS_Stream;
+            ReadReplyMsg.NotifyCondition = ReadRequestMsg->NotifyCondition;
+            Svcs->verbose(
+                WS_Stream->CP_Stream,
+                "Sending a reply to reader rank %d for remote memory read\n",
+                ReadRequestMsg->RequestingRank);
+            if (!Reader->Conn)
+            {
+                attr_list List = attr_list_from_string(Reader->ContactString);
+                Reader->Conn = CMget_conn(cm, List);
+                free_attr_list(List);
+            }
+            CMwrite(Reader->Conn, WS_Stream->ReadReplyFormat, &ReadReplyMsg);
+
+            TAU_STOP_FUNC();
+            return;
+        }
+        tmp = tmp->Next;
+    }
+    /*
+     * Shouldn't ever get here because we should never get a request for a
+     * timestep that we don't have.
+     */
+    fprintf(stderr,
+            "Writer rank %d - Failed to read Timestep %ld, not found DYING\n",
+            WS_Stream->Rank, ReadRequestMsg->Timestep);
+    exit(1);
+    TAU_STOP_FUNC();
+}
+
+typedef struct _ShmCompletionHandle
+{
+    int CMcondition; /* -1 if the read was served from shared memory */
+    CManager cm;
+    void *CPStream;
+    void *DPStream;
+    void *Buffer;
+    int Failed;
+    int Rank;
+    struct _ShmCompletionHandle *Next;
+} * ShmCompletionHandle;
+
+static void ShmReadReplyHandler(CManager cm, CMConnection conn, void *msg_v,
+                                void *client_Data, attr_list attrs)
+{
+    TAU_START_FUNC();
+    ShmReadReplyMsg ReadReplyMsg = (ShmReadReplyMsg)msg_v;
+    Shm_RS_Stream RS_Stream = ReadReplyMsg->RS_Stream;
+    CP_Services Svcs = (CP_Services)client_Data;
+    ShmCompletionHandle Handle = NULL;
+
+    if (CMCondition_has_signaled(cm, ReadReplyMsg->NotifyCondition))
+    {
+        Svcs->verbose(RS_Stream->CP_Stream, "Got a reply to remote memory "
+                                            "read, but the condition is "
+                                            "already signalled, returning\n");
+        TAU_STOP_FUNC();
+        return;
+    }
+    Handle = CMCondition_get_client_data(cm, ReadReplyMsg->NotifyCondition);
+
+    if (!Handle)
+    {
+        Svcs->verbose(
+            RS_Stream->CP_Stream,
+            "Got a reply to remote memory read, but condition not found\n");
+        TAU_STOP_FUNC();
+        return;
+    }
+    Svcs->verbose(
+        RS_Stream->CP_Stream,
+        "Got a reply to remote memory read from rank %d, condition is %d\n",
+        Handle->Rank, ReadReplyMsg->NotifyCondition);
+
+    memcpy(Handle->Buffer, ReadReplyMsg->Data, ReadReplyMsg->DataLength);
+
+    CMCondition_signal(cm, ReadReplyMsg->NotifyCondition);
+    TAU_STOP_FUNC();
+}
+
+static DP_WS_Stream ShmInitWriter(CP_Services Svcs, void *CP_Stream,
+                                  struct _SstParams *Params)
+{
+    Shm_WS_Stream Stream = malloc(sizeof(struct _Shm_WS_Stream));
+    CManager cm = Svcs->getCManager(CP_Stream);
+    MPI_Comm comm = Svcs->getMPIComm(CP_Stream);
+    CMFormat F;
+
+    memset(Stream, 0, sizeof(struct _Shm_WS_Stream));
+
+    MPI_Comm_rank(comm, &Stream->Rank);
+
+    /*
+     * save the CP_stream value of later use
+     */
+    Stream->CP_Stream = CP_Stream;
+    Stream->HostName = GetHostName();
+
+    /*
+     * add a handler for read request messages
+     */
+    F = CMregister_format(cm, ShmReadRequestStructs);
+    CMregister_handler(F, ShmReadRequestHandler, Svcs);
+
+    /*
+     * register read reply message structure so we can send later
+     */
+    Stream->ReadReplyFormat = CMregister_format(cm, ShmReadReplyStructs);
+
+    return (void *)Stream;
+}
+
+static void DestroySegment(ShmSegment Segment)
+{
+    shmdt(Segment->Segment);
+#ifndef __linux__
+    shmctl(Segment->ShmID, IPC_RMID, NULL);
+#endif
+    free(Segment);
+}
+
+/*
+ * Returns the smallest free segment of at least Size bytes, or a new one,
+ * NULL if it can't be created
+ */
+static ShmSegment GetFreeSegment(Shm_WS_Stream Stream, size_t Size)
+{
+    ShmSegment *Best = NULL;
+    for (ShmSegment *Link = &Stream->FreeSegments; *Link != NULL;
+         Link = &(*Link)->Next)
+    {
+        if ((*Link)->Size >= Size && (!Best || (*Link)->Size < (*Best)->Size))
+        {
+            Best = Link;
+        }
+    }
+    if (Best)
+    {
+        ShmSegment Segment = *Best;
+        *Best = Segment->Next;
+        return Segment;
+    }
+
+    const int ShmID = shmget(IPC_PRIVATE, Size, IPC_CREAT | 0600);
+    if (ShmID == -1)
+    {
+        return NULL;
+    }
+    char *Address = shmat(ShmID, NULL, 0);
+    if (Address == (char *)-1)
+    {
+        shmctl(ShmID, IPC_RMID, NULL);
+        return NULL;
+    }
+#ifdef __linux__
+    /*
+     * Linux lets readers attach a segment marked for removal, so it goes
+     * away with the last attachment even if we die
+     */
+    shmctl(ShmID, IPC_RMID, NULL);
+#endif
+    ShmSegment Segment = malloc(sizeof(struct _ShmSegment));
+    Segment->ShmID = ShmID;
+    Segment->Size = Size;
+    Segment->Segment = Address;
+    Segment->Next = NULL;
+    return Segment;
+}
+
+/* keeps the segment of a released timestep, up to SHM_FREE_SEGMENTS */
+static void ReleaseSegment(Shm_WS_Stream Stream, TimestepList Entry)
+{
+    if (!Entry->Segment)
+    {
+        return;
+    }
+    Entry->Segment->Next = Stream->FreeSegments;
+    Stream->FreeSegments = Entry->Segment;
+    Entry->Segment = NULL;
+
+    int Count = 0;
+    for (ShmSegment *Link = &Stream->FreeSegments; *Link != NULL;)
+    {
+        if (++Count > SHM_FREE_SEGMENTS)
+        {
+            ShmSegment Tmp = *Link;
+            *Link = Tmp->Next;
+            DestroySegment(Tmp);
+        }
+        else
+        {
+            Link = &(*Link)->Next;
+        }
+    }
+}
+
+static void ShmDestroyWriter(CP_Services Svcs, DP_WS_Stream WS_Stream_v)
+{
+    Shm_WS_Stream WS_Stream = (Shm_WS_Stream)WS_Stream_v;
+    TimestepList List = WS_Stream->Timesteps;
+    while (List != NULL)
+    {
+        TimestepList Next = List->Next;
+        if (List->Segment)
+        {
+            DestroySegment(List->Segment);
+        }
+        free(List->DP_TimestepInfo);
+        free(List);
+        List = Next;
+    }
+    while (WS_Stream->FreeSegments != NULL)
+    {
+        ShmSegment Next = WS_Stream->FreeSegments->Next;
+        DestroySegment(WS_Stream->FreeSegments);
+        WS_Stream->FreeSegments = Next;
+    }
+    for (int i = 0; i < WS_Stream->ReaderCount; i++)
+    {
+        Shm_WSR_Stream WSR_Stream = WS_Stream->Readers[i];
+        if (WSR_Stream)
+        {
+            free(WSR_Stream->WriterContactInfo->HostName);
+            free(WSR_Stream->WriterContactInfo);
+            for (int j = 0; j < WSR_Stream->ReaderCohortSize; j++)
+            {
+                free(WSR_Stream->ReaderContactInfo[j].ContactString);
+                free(WSR_Stream->ReaderContactInfo[j].HostName);
+                if (WSR_Stream->ReaderContactInfo[j].Conn)
+                    CMConnection_close(WSR_Stream->ReaderContactInfo[j].Conn);
+            }
+            free(WSR_Stream->ReaderContactInfo);
+            free(WSR_Stream);
+        }
+    }
+    free(WS_Stream->Readers);
+    free(WS_Stream->HostName);
+    free(WS_Stream);
+}
+
+static DP_WSR_Stream ShmInitWriterPerReader(CP_Services Svcs,
+                                            DP_WS_Stream WS_Stream_v,
+                                            int readerCohortSize,
+                                            CP_PeerCohort PeerCohort,
+                                            void **providedReaderInfo_v,
+                                            void **WriterContactInfoPtr)
+{
+    Shm_WS_Stream WS_Stream = (Shm_WS_Stream)WS_Stream_v;
+    Shm_WSR_Stream WSR_Stream = malloc(sizeof(*WSR_Stream));
+    ShmWriterContactInfo ContactInfo;
+    ShmReaderContactInfo *providedReaderInfo =
+        (ShmReaderContactInfo *)providedReaderInfo_v;
+
+    WSR_Stream->WS_Stream = WS_Stream; /* pointer to writer struct */
+    WSR_Stream->PeerCohort = PeerCohort;
+    WSR_Stream->ReaderCohortSize = readerCohortSize;
+
+    /*
+     * make a copy of reader contact information (original will not be
+     * preserved)
+     */
+    WSR_Stream->ReaderContactInfo =
+        malloc(sizeof(struct _ShmReaderContactInfo) * readerCohortSize);
+    for (int i = 0; i < readerCohortSize; i++)
+    {
+        ShmReaderContactInfo Reader = &WSR_Stream->ReaderContactInfo[i];
+        Reader->ContactString = strdup(providedReaderInfo[i]->ContactString);
+        Reader->HostName = strdup(providedReaderInfo[i]->HostName
+                                      ? providedReaderInfo[i]->HostName
+                                      : "");
+        Reader->Conn = NULL;
+        Reader->RS_Stream = providedReaderInfo[i]->RS_Stream;
+        if (SameHost(WS_Stream->HostName, Reader->HostName))
+        {
+            WS_Stream->LocalReaderRanks++;
+        }
+        Svcs->verbose(WS_Stream->CP_Stream,
+                      "Received contact info \"%s\", host \"%s\", RD_Stream "
+                      "%p for Reader Rank %d\n",
+                      Reader->ContactString, Reader->HostName,
+                      Reader->RS_Stream, i);
+    }
+    Svcs->verbose(WS_Stream->CP_Stream,
+                  "%d reader ranks share host \"%s\" with writer rank %d\n",
+                  WS_Stream->LocalReaderRanks, WS_Stream->HostName,
+                  WS_Stream->Rank);
+
+    /*
+     * add this writer-side reader-specific stream to the parent writer stream
+     * structure
+     */
+    WS_Stream->Readers = realloc(
+        WS_Stream->Readers, sizeof(*WSR_Stream) * (WS_Stream->ReaderCount + 1));
+    WS_Stream->Readers[WS_Stream->ReaderCount] = WSR_Stream;
+    WS_Stream->ReaderCount++;
+
+    ContactInfo = malloc(sizeof(struct _ShmWriterContactInfo));
+    memset(ContactInfo, 0, sizeof(struct _ShmWriterContactInfo));
+    ContactInfo->HostName = strdup(WS_Stream->HostName);
+    ContactInfo->WS_Stream = WSR_Stream;
+    *WriterContactInfoPtr = ContactInfo;
+    WSR_Stream->WriterContactInfo = ContactInfo;
+
+    return WSR_Stream;
+}
+
+static void ShmDestroyWriterPerReader(CP_Services Svcs,
+                                      DP_WSR_Stream WSR_Stream_v)
+{
+    Shm_WSR_Stream WSR_Stream = (Shm_WSR_Stream)WSR_Stream_v;
+    Shm_WS_Stream WS_Stream = WSR_Stream->WS_Stream;
+
+    /* once no reader ranks share the host, timesteps are no longer copied */
+    for (int i = 0; i < WSR_Stream->ReaderCohortSize; i++)
+    {
+        if (SameHost(WS_Stream->HostName,
+                     WSR_Stream->ReaderContactInfo[i].HostName))
+        {
+            WS_Stream->LocalReaderRanks--;
+        }
+        free(WSR_Stream->ReaderContactInfo[i].ContactString);
+        free(WSR_Stream->ReaderContactInfo[i].HostName);
+        if (WSR_Stream->ReaderContactInfo[i].Conn)
+            CMConnection_close(WSR_Stream->ReaderContactInfo[i].Conn);
+    }
+    for (int i = 0; i < WS_Stream->ReaderCount; i++)
+    {
+        if (WS_Stream->Readers[i] == WSR_Stream)
+        {
+            WS_Stream->Readers[i] = NULL;
+        }
+    }
+    free(WSR_Stream->WriterContactInfo->HostName);
+    free(WSR_Stream->WriterContactInfo);
+    free(WSR_Stream->ReaderContactInfo);
+    free(WSR_Stream);
+}
+
+static void ShmProvideWriterDataToReader(CP_Services Svcs,
+                                         DP_RS_Stream RS_Stream_v,
+                                         int writerCohortSize,
+                                         CP_PeerCohort PeerCohort,
+                                         void **providedWriterInfo_v)
+{
+    Shm_RS_Stream RS_Stream = (Shm_RS_Stream)RS_Stream_v;
+    ShmWriterContactInfo *providedWriterInfo =
+        (ShmWriterContactInfo *)providedWriterInfo_v;
+
+    RS_Stream->PeerCohort = PeerCohort;
+    RS_Stream->WriterCohortSize = writerCohortSize;
+
+    /*
+     * make a copy of writer contact information (original will not be
+     * preserved)
+     */
+    RS_Stream->WriterContactInfo =
+        malloc(sizeof(struct _ShmWriterContactInfo) * writerCohortSize);
+    RS_Stream->WriterIsLocal = malloc(sizeof(int) * writerCohortSize);
+    for (int i = 0; i < writerCohortSize; i++)
+    {
+        ShmWriterContactInfo Writer = &RS_Stream->WriterContactInfo[i];
+        Writer->HostName = strdup(providedWriterInfo[i]->HostName
+                                      ? providedWriterInfo[i]->HostName
+                                      : "");
+        Writer->WS_Stream = providedWriterInfo[i]->WS_Stream;
+        RS_Stream->WriterIsLocal[i] =
+            SameHost(RS_Stream->HostName, Writer->HostName);
+        Svcs->verbose(RS_Stream->CP_Stream,
+                      "Received contact info for WSR Rank %d, host \"%s\" "
+                      "(%s), WS_stream %p\n",
+                      i, Writer->HostName,
+                      RS_Stream->WriterIsLocal[i] ? "local" : "remote",
+                      Writer->WS_Stream);
+    }
+}
+
+static void AddRequestToList(CP_Services Svcs, Shm_RS_Stream Stream,
+                             ShmCompletionHandle Handle)
+{
+    Handle->Next = Stream->PendingReadRequests;
+    Stream->PendingReadRequests = Handle;
+}
+
+static void RemoveRequestFromList(CP_Services Svcs, Shm_RS_Stream Stream,
+                                  ShmCompletionHandle Handle)
+{
+    ShmCompletionHandle Tmp = Stream->PendingReadRequests;
+
+    if (Stream->PendingReadRequests == Handle)
+    {
+        Stream->PendingReadRequests = Handle->Next;
+        return;
+    }
+
+    while (Tmp != NULL && Tmp->Next != Handle)
+    {
+        Tmp = Tmp->Next;
+    }
+
+    if (Tmp == NULL)
+        return;
+
+    // Tmp->Next must be the handle to remove
+    Tmp->Next = Tmp->Next->Next;
+}
+
+static void FailRequestsToRank(CP_Services Svcs, CManager cm,
+                               Shm_RS_Stream Stream, int FailedRank)
+{
+    ShmCompletionHandle Tmp = Stream->PendingReadRequests;
+    Svcs->verbose(Stream->CP_Stream,
+                  "Fail pending requests to writer rank %d\n", FailedRank);
+    while (Tmp != NULL)
+    {
+        if (Tmp->Rank == FailedRank)
+        {
+            Tmp->Failed = 1;
+            Svcs->verbose(Tmp->CPStream,
+                          "Found a pending remote memory read "
+                          "to failed writer rank %d, marking as "
+                          "failed and signalling condition %d\n",
+                          Tmp->Rank, Tmp->CMcondition);
+            CMCondition_signal(cm, Tmp->CMcondition);
+        }
+        Tmp = Tmp->Next;
+    }
+}
+
+/*
+ * Returns the reader attachment of the segment holding timestep `Timestep`
+ * of writer rank `Rank`, or NULL if it has to be read through messages.
+ * Attachments unused for SHM_KEEP_ATTACHMENT timesteps are detached, the
+ * writer has most likely destroyed their segments.
+ */
+static char *GetSegment(CP_Services Svcs, Shm_RS_Stream Stream, int Rank,
+                        long Timestep, ShmPerTimestepInfo Info)
+{
+    if (Info == NULL || Info->ShmID == -1 || !Stream->WriterIsLocal[Rank])
+    {
+        return NULL;
+    }
+
+    DetachSegments(Stream, Timestep - SHM_KEEP_ATTACHMENT);
+
+    ShmAttachment Tmp = Stream->Attachments;
+    while (Tmp != NULL)
+    {
+        if (Tmp->Rank == Rank && Tmp->ShmID == Info->ShmID)
+        {
+            Tmp->LastTimestep = Timestep;
+            return Tmp->Segment;
+        }
+        Tmp = Tmp->Next;
+    }
+
+    Tmp = malloc(sizeof(struct _ShmAttachment));
+    Tmp->LastTimestep = Timestep;
+    Tmp->Rank = Rank;
+    Tmp->ShmID = Info->ShmID;
+    Tmp->Segment = shmat(Info->ShmID, NULL, SHM_RDONLY);
+    if (Tmp->Segment == (char *)-1)
+    {
+        Svcs->verbose(Stream->CP_Stream,
+                      "Could not attach segment %d of writer rank %d, "
+                      "timestep %ld, reading through messages\n",
+                      Info->ShmID, Rank, Timestep);
+        Tmp->Segment = NULL;
+    }
+    Tmp->Next = Stream->Attachments;
+    Stream->Attachments = Tmp;
+    return Tmp->Segment;
+}
+
+static void *ShmReadRemoteMemory(CP_Services Svcs, DP_RS_Stream Stream_v,
+                                 int Rank, long Timestep, size_t Offset,
+                                 size_t Length, void *Buffer,
+                                 void *DP_TimestepInfo)
+{
+    Shm_RS_Stream Stream = (Shm_RS_Stream)
+        Stream_v; /* DP_RS_Stream is the return from InitReader */
+    CManager cm = Svcs->getCManager(Stream->CP_Stream);
+    ShmCompletionHandle ret = malloc(sizeof(struct _ShmCompletionHandle));
+    struct _ShmReadRequestMsg ReadRequestMsg;
+    char *Segment = GetSegment(Svcs, Stream, Rank, Timestep,
+                               (ShmPerTimestepInfo)DP_TimestepInfo);
+
+    memset(ret, 0, sizeof(*ret));
+    ret->CPStream = Stream->CP_Stream;
+    ret->DPStream = Stream;
+    ret->cm = cm;
+    ret->Buffer = Buffer;
+    ret->Rank = Rank;
+
+    if (Segment)
+    {
+        TAU_START("Shm DP local read");
+        memcpy(Buffer, Segment + Offset, Length);
+        TAU_STOP("Shm DP local read");
+        ret->CMcondition = -1;
+        return ret;
+    }
+
+    ret->CMcondition = CMCondition_get(cm, NULL);
+
+    /*
+     * set the completion handle as client Data on the condition so that
+     * handler has access to it.
+     */
+    AddRequestToList(Svcs, Stream, ret);
+    CMCondition_set_client_data(cm, ret->CMcondition, ret);
+
+    Svcs->verbose(Stream->CP_Stream,
+                  "Adios requesting to read remote memory for Timestep %d "
+                  "from Rank %d, WSR_Stream = %p\n",
+                  Timestep, Rank, Stream->WriterContactInfo[Rank].WS_Stream);
+
+    /* send request to appropriate writer */
+    /* memset avoids uninit byte warnings from valgrind */
+    memset(&ReadRequestMsg, 0, sizeof(ReadRequestMsg));
+    ReadRequestMsg.Timestep = Timestep;
+    ReadRequestMsg.Offset = Offset;
+    ReadRequestMsg.Length = Length;
+    ReadRequestMsg.WS_Stream = Stream->WriterContactInfo[Rank].WS_Stream;
+    ReadRequestMsg.RS_Stream = Stream;
+    ReadRequestMsg.RequestingRank = Stream->Rank;
+    ReadRequestMsg.NotifyCondition = ret->CMcondition;
+    Svcs->sendToPeer(Stream->CP_Stream, Stream->PeerCohort, Rank,
+                     Stream->ReadRequestFormat, &ReadRequestMsg);
+
+    return ret;
+}
+
+static int ShmWaitForCompletion(CP_Services Svcs, void *Handle_v)
+{
+    ShmCompletionHandle Handle = (ShmCompletionHandle)Handle_v;
+    int Ret = 1;
+    if (Handle->CMcondition == -1)
+    {
+        /* served from shared memory when it was issued */
+        free(Handle);
+        return Ret;
+    }
+    Svcs->verbose(
+        Handle->CPStream,
+        "Waiting for completion of memory read to rank %d, condition %d\n",
+        Handle->Rank, Handle->CMcondition);
+    CMCondition_wait(Handle->cm, Handle->CMcondition);
+    if (Handle->Failed)
+    {
+        Svcs->verbose(Handle->CPStream,
+                      "Remote memory read to rank %d with "
+                      "condition %d has FAILED because of "
+                      "writer failure\n",
+                      Handle->Rank, Handle->CMcondition);
+        Ret = 0;
+    }
+    RemoveRequestFromList(Svcs, Handle->DPStream, Handle);
+    free(Handle);
+    return Ret;
+}
+
+static void ShmNotifyConnFailure(CP_Services Svcs, DP_RS_Stream Stream_v,
+                                 int FailedPeerRank)
+{
+    Shm_RS_Stream Stream = (Shm_RS_Stream)
+        Stream_v; /* DP_RS_Stream is the return from InitReader */
+    CManager cm = Svcs->getCManager(Stream->CP_Stream);
+    Svcs->verbose(Stream->CP_Stream,
+                  "received notification that writer peer "
+                  "%d has failed, failing any pending "
+                  "requests\n",
+                  FailedPeerRank);
+    FailRequestsToRank(Svcs, cm, Stream, FailedPeerRank);
+}
+
+static void ShmProvideTimestep(CP_Services Svcs, DP_WS_Stream Stream_v,
+                               struct _SstData *Data,
+                               struct _SstData *LocalMetadata, long Timestep,
+                               void **TimestepInfoPtr)
+{
+    Shm_WS_Stream Stream = (Shm_WS_Stream)Stream_v;
+    TimestepList Entry = malloc(sizeof(struct _TimestepEntry));
+    ShmPerTimestepInfo Info = malloc(sizeof(struct _ShmPerTimestepInfo));
+
+    Info->ShmID = -1;
+    Entry->Segment = NULL;
+    if (Stream->LocalReaderRanks > 0 && Data->DataSize > 0)
+    {
+        TAU_START("Shm DP copy to segment");
+        Entry->Segment = GetFreeSegment(Stream, Data->DataSize);
+        if (Entry->Segment)
+        {
+            memcpy(Entry->Segment->Segment, Data->block, Data->DataSize);
+            Info->ShmID = Entry->Segment->ShmID;
+        }
+        else
+        {
+            Svcs->verbose(Stream->CP_Stream,
+                          "Could not create a %zu bytes segment for timestep "
+                          "%ld, local readers will use messages\n",
+                          Data->DataSize, Timestep);
+        }
+        TAU_STOP("Shm DP copy to segment");
+    }
+
+    Entry->Data = *Data;
+    Entry->Timestep = Timestep;
+    Entry->DP_TimestepInfo = Info;
+
+    Entry->Next = Stream->Timesteps;
+    Stream->Timesteps = Entry;
+    *TimestepInfoPtr = Info;
+}
+
+static void ShmReleaseTimestep(CP_Services Svcs, DP_WS_Stream Stream_v,
+                               long Timestep)
+{
+    Shm_WS_Stream Stream = (Shm_WS_Stream)Stream_v;
+    TimestepList *Link = &Stream->Timesteps;
+
+    Svcs->verbose(Stream->CP_Stream, "Releasing timestep %ld\n", Timestep);
+    while (*Link != NULL)
+    {
+        TimestepList List = *Link;
+        if (List->Timestep == Timestep)
+        {
+            *Link = List->Next;
+            ReleaseSegment(Stream, List);
+            free(List->DP_TimestepInfo);
+            free(List);
+            return;
+        }
+        Link = &List->Next;
+    }
+    /*
+     * Shouldn't ever get here because we should never release a
+     * timestep that we don't have.
+     */
+    fprintf(stderr, "Failed to release Timestep %ld, not found\n", Timestep);
+    assert(0);
+}
+
+static FMField ShmReaderContactList[] = {
+    {"ContactString", "string", sizeof(char *),
+     FMOffset(ShmReaderContactInfo, ContactString)},
+    {"HostName", "string", sizeof(char *),
+     FMOffset(ShmReaderContactInfo, HostName)},
+    {"reader_ID", "integer", sizeof(void *),
+     FMOffset(ShmReaderContactInfo, RS_Stream)},
+    {NULL, NULL, 0, 0}};
+
+static FMStructDescRec ShmReaderContactStructs[] = {
+    {"ShmReaderContactInfo", ShmReaderContactList,
+     sizeof(struct _ShmReaderContactInfo), NULL},
+    {NULL, NULL, 0, NULL}};
+
+static FMField ShmWriterContactList[] = {
+    {"HostName", "string", sizeof(char *),
+     FMOffset(ShmWriterContactInfo, HostName)},
+    {"writer_ID", "integer", sizeof(void *),
+     FMOffset(ShmWriterContactInfo, WS_Stream)},
+    {NULL, NULL, 0, 0}};
+
+static FMStructDescRec ShmWriterContactStructs[] = {
+    {"ShmWriterContactInfo", ShmWriterContactList,
+     sizeof(struct _ShmWriterContactInfo), NULL},
+    {NULL, NULL, 0, NULL}};
+
+static FMField ShmTimestepInfoList[] = {
+    {"ShmID", "integer", sizeof(int), FMOffset(ShmPerTimestepInfo, ShmID)},
+    {NULL, NULL, 0, 0}};
+
+static FMStructDescRec ShmTimestepInfoStructs[] = {
+    {"ShmTimestepInfo", ShmTimestepInfoList,
+     sizeof(struct _ShmPerTimestepInfo), NULL},
+    {NULL, NULL, 0, NULL}};
+
+static struct _CP_DP_Interface shmDPInterface;
+
+static int ShmGetPriority(CP_Services Svcs, void *CP_Stream,
+                          struct _SstParams *Params)
+{
+    /*
+     * Above evpath, which it falls back to for peers on other hosts, below
+     * any RDMA dp, which is the better choice across nodes.  Not probed at
+     * run time so that readers and writers of the same build agree.
+     */
+    return 5;
+}
+
+extern CP_DP_Interface LoadShmDP()
+{
+    memset(&shmDPInterface, 0, sizeof(shmDPInterface));
+    shmDPInterface.ReaderContactFormats = ShmReaderContactStructs;
+    shmDPInterface.WriterContactFormats = ShmWriterContactStructs;
+    shmDPInterface.TimestepInfoFormats = ShmTimestepInfoStructs;
+    shmDPInterface.initReader = ShmInitReader;
+    shmDPInterface.initWriter = ShmInitWriter;
+    shmDPInterface.initWriterPerReader = ShmInitWriterPerReader;
+    shmDPInterface.provideWriterDataToReader = ShmProvideWriterDataToReader;
+    shmDPInterface.readRemoteMemory = ShmReadRemoteMemory;
+    shmDPInterface.waitForCompletion = ShmWaitForCompletion;
+    shmDPInterface.notifyConnFailure = ShmNotifyConnFailure;
+    shmDPInterface.provideTimestep = ShmProvideTimestep;
+    shmDPInterface.releaseTimestep = ShmReleaseTimestep;
+    shmDPInterface.destroyReader = ShmDestroyReader;
+    shmDPInterface.destroyWriter = ShmDestroyWriter;
+    shmDPInterface.destroyWriterPerReader = ShmDestroyWriterPerReader;
+    shmDPInterface.getPriority = ShmGetPriority;
+    shmDPInterface.unGetPriority = NULL;
+    return &shmDPInterface;
+}
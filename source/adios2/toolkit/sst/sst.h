@@ -54,6 +54,13 @@ typedef struct _SstStats
     double CloseTimeSecs;
     double ValidTimeSecs;
     size_t BytesTransferred;
+    /* writer-side queue statistics, complete on rank 0 */
+    size_t TimestepsProvided;
+    size_t TimestepsDiscarded;
+    double WriterStallSecs;
+    double MeanQueueResidencySecs;
+    double MaxQueueResidencySecs;
+    double SlowestReaderStepsPerSec;
 } * SstStats;
 
 typedef struct _SstParams *SstParams;
@@ -73,7 +80,8 @@ typedef enum
 typedef enum
 {
     SstQueueFullBlock = 0,
-    SstQueueFullDiscard = 1
+    SstQueueFullDiscard = 1,
+    SstQueueFullAdaptive = 2
 } SstQueueFullPolicy;
 
 typedef enum
@@ -98,6 +106,7 @@ extern void SstProvideTimestep(SstStream s, SstData LocalMetadata,
                                DataFreeFunc FreeAttribute,
                                void *FreeAttributeClientData);
 extern void SstWriterClose(SstStream stream);
+extern void SstWriterGetStats(SstStream stream, SstStats Stats);
 
 /*
  *  Reader-side operations
@@ -32,6 +32,8 @@ struct _SstBlock
     MACRO(QueueLimit, Int, int, 0)                                             \
     MACRO(ReserveQueueLimit, Int, int, 0)                                      \
     MACRO(QueueFullPolicy, QueueFullPolicy, size_t, 0)                         \
+    MACRO(StallBudgetPercent, Int, int, 2)                                     \
+    MACRO(GuaranteedStepInterval, Int, int, 0)                                 \
     MACRO(IsRowMajor, IsRowMajor, int, 0)                                      \
     MACRO(FirstTimestepPrecious, Bool, int, 0)                                 \
     MACRO(ControlTransport, String, char *, NULL)                              \
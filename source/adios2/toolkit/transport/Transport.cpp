@@ -30,11 +30,27 @@ void Transport::IWrite(const char *buffer, size_t size, Status &status,
     throw std::invalid_argument("ERROR: this class doesn't implement IWrite\n");
 }
 
+void Transport::WriteV(const core::iovec *iov, const int iovcnt, size_t start)
+{
+    for (int i = 0; i < iovcnt; ++i)
+    {
+        Write(static_cast<const char *>(iov[i].iov_base), iov[i].iov_len,
+              (i == 0) ? start : MaxSizeT);
+    }
+}
+
 void Transport::IRead(char *buffer, size_t size, Status &status, size_t start)
 {
     throw std::invalid_argument("ERROR: this class doesn't implement IRead\n");
 }
 
+const char *Transport::Data(const size_t /*start*/, const size_t /*size*/)
+{
+    return nullptr;
+}
+
+void Transport::WillRead(const size_t /*start*/, const size_t /*size*/) {}
+
 void Transport::InitProfiler(const Mode openMode, const TimeUnit timeUnit)
 {
     m_Profiler.IsActive = true;
@@ -87,6 +87,16 @@ public:
     virtual void IWrite(const char *buffer, size_t size, Status &status,
                         size_t start = MaxSizeT);
 
+    /**
+     * Writes several buffers back to back, default calls Write for each
+     * @param iov buffers to be written, in order
+     * @param iovcnt number of buffers
+     * @param start starting position for writing the first buffer, if not
+     * passed then start at current stream position
+     */
+    virtual void WriteV(const core::iovec *iov, const int iovcnt,
+                        size_t start = MaxSizeT);
+
     /**
      * Reads from transport "size" bytes from a certain position. Note that size
      * and position and non-const due to the nature of underlying transport
@@ -102,6 +112,24 @@ public:
     virtual void IRead(char *buffer, size_t size, Status &status,
                        size_t start = MaxSizeT);
 
+    /**
+     * Direct access to contents for transports holding them in memory (e.g.
+     * a file mapping), avoids the copy of Read
+     * @param start position of the first byte
+     * @param size number of bytes that will be accessed
+     * @return pointer to the byte at start, valid until the next call to a
+     * transport function, nullptr if not supported
+     */
+    virtual const char *Data(const size_t start, const size_t size);
+
+    /**
+     * Hint that [start, start + size) will be read soon, so transports can
+     * prefetch it. Default does nothing.
+     * @param start
+     * @param size
+     */
+    virtual void WillRead(const size_t start, const size_t size);
+
     /**
      * Returns the size of current data in transport
      * @return size as size_t
@@ -0,0 +1,219 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * FileMMAP.cpp read-only file transport using POSIX mmap
+ */
+#include "FileMMAP.h"
+
+#include <fcntl.h>     // open
+#include <sys/mman.h>  // mmap, munmap, madvise
+#include <sys/stat.h>  // open, fstat
+#include <sys/types.h> // open
+#include <unistd.h>    // close, sysconf
+
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <algorithm> //std::min
+#include <cstring>   //std::memcpy
+#include <ios>       //std::ios_base::failure
+#include <stdexcept>
+/// \endcond
+
+namespace adios2
+{
+namespace transport
+{
+
+FileMMAP::FileMMAP(MPI_Comm mpiComm, const bool debugMode)
+: Transport("File", "MMAP", mpiComm, debugMode)
+{
+}
+
+FileMMAP::~FileMMAP()
+{
+    Unmap();
+    if (m_IsOpen)
+    {
+        close(m_FileDescriptor);
+    }
+}
+
+void FileMMAP::Open(const std::string &name, const Mode openMode)
+{
+    m_Name = name;
+    CheckName();
+    m_OpenMode = openMode;
+
+    if (m_OpenMode != Mode::Read)
+    {
+        throw std::invalid_argument("ERROR: MMAP library only supports "
+                                    "Mode::Read, for file " +
+                                    m_Name + ", in call to Open\n");
+    }
+
+    ProfilerStart("open");
+    m_FileDescriptor = open(m_Name.c_str(), O_RDONLY);
+    ProfilerStop("open");
+
+    CheckFile("couldn't open file " + m_Name +
+              ", check permissions or path existence, in call to POSIX open");
+
+    m_IsOpen = true;
+    m_Position = 0;
+    CheckMapping(0, 0, "in call to MMAP Open");
+}
+
+void FileMMAP::Write(const char * /*buffer*/, size_t /*size*/,
+                     size_t /*start*/)
+{
+    throw std::invalid_argument("ERROR: MMAP library is read-only, can't "
+                                "write to file " +
+                                m_Name + ", in call to Write\n");
+}
+
+void FileMMAP::Read(char *buffer, size_t size, size_t start)
+{
+    if (start == MaxSizeT)
+    {
+        start = m_Position;
+    }
+
+    const char *data = Data(start, size);
+
+    // whole file reads, e.g. metadata, are a single pass: read ahead
+    // aggressively, only a hint, failures are ignored
+    const bool wholeFile = (start == 0 && size == m_MappingSize && size > 0);
+    if (wholeFile)
+    {
+        madvise(m_Mapping, m_MappingSize, MADV_SEQUENTIAL);
+    }
+
+    ProfilerStart("read");
+    std::memcpy(buffer, data, size);
+    ProfilerStop("read");
+
+    if (wholeFile)
+    {
+        madvise(m_Mapping, m_MappingSize, MADV_NORMAL);
+    }
+
+    m_Position = start + size;
+}
+
+const char *FileMMAP::Data(const size_t start, const size_t size)
+{
+    CheckMapping(start, size, "in call to MMAP Data");
+    return m_Mapping + start;
+}
+
+void FileMMAP::WillRead(const size_t start, const size_t size)
+{
+    if (m_Mapping == nullptr || start >= m_MappingSize || size == 0)
+    {
+        return;
+    }
+
+    // madvise requires a page aligned address
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t alignedStart = start / pageSize * pageSize;
+    const size_t end = std::min(start + size, m_MappingSize);
+
+    // only a hint, failures are ignored
+    madvise(m_Mapping + alignedStart, end - alignedStart, MADV_WILLNEED);
+}
+
+size_t FileMMAP::GetSize()
+{
+    struct stat fileStat;
+    if (fstat(m_FileDescriptor, &fileStat) == -1)
+    {
+        throw std::ios_base::failure("ERROR: couldn't get size of file " +
+                                     m_Name + "\n");
+    }
+    return static_cast<size_t>(fileStat.st_size);
+}
+
+void FileMMAP::Flush() {}
+
+void FileMMAP::Close()
+{
+    Unmap();
+
+    ProfilerStart("close");
+    const int status = close(m_FileDescriptor);
+    ProfilerStop("close");
+
+    if (status == -1)
+    {
+        throw std::ios_base::failure("ERROR: couldn't close file " + m_Name +
+                                     ", in call to POSIX IO close\n");
+    }
+
+    m_IsOpen = false;
+}
+
+// PRIVATE
+void FileMMAP::CheckMapping(const size_t start, const size_t size,
+                            const std::string hint)
+{
+    if (start + size <= m_MappingSize && m_Mapping != nullptr)
+    {
+        return;
+    }
+
+    const size_t fileSize = GetSize();
+    if (start + size > fileSize)
+    {
+        throw std::ios_base::failure(
+            "ERROR: couldn't read " + std::to_string(size) +
+            " bytes at position " + std::to_string(start) + " of file " +
+            m_Name + " of size " + std::to_string(fileSize) + ", " + hint +
+            "\n");
+    }
+
+    if (fileSize == m_MappingSize)
+    {
+        return;
+    }
+
+    Unmap();
+    if (fileSize == 0)
+    {
+        return;
+    }
+
+    ProfilerStart("open");
+    void *mapping =
+        mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, m_FileDescriptor, 0);
+    ProfilerStop("open");
+
+    if (mapping == MAP_FAILED)
+    {
+        throw std::ios_base::failure("ERROR: couldn't map file " + m_Name +
+                                     ", in call to POSIX mmap, " + hint + "\n");
+    }
+
+    m_Mapping = static_cast<char *>(mapping);
+    m_MappingSize = fileSize;
+}
+
+void FileMMAP::Unmap() noexcept
+{
+    if (m_Mapping != nullptr)
+    {
+        munmap(m_Mapping, m_MappingSize);
+    }
+    m_Mapping = nullptr;
+    m_MappingSize = 0;
+}
+
+void FileMMAP::CheckFile(const std::string hint) const
+{
+    if (m_FileDescriptor == -1)
+    {
+        throw std::ios_base::failure("ERROR: " + hint + "\n");
+    }
+}
+
+} // end namespace transport
+} // end namespace adios2
@@ -0,0 +1,81 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * FileMMAP.h read-only file transport using POSIX mmap
+ */
+
+#ifndef ADIOS2_TOOLKIT_TRANSPORT_FILE_FILEMMAP_H_
+#define ADIOS2_TOOLKIT_TRANSPORT_FILE_FILEMMAP_H_
+
+#include "adios2/ADIOSConfig.h"
+#include "adios2/toolkit/transport/Transport.h"
+
+namespace adios2
+{
+namespace transport
+{
+
+/** Read-only file transport mapping the whole file in memory, reads are
+ * served from the page cache and Data exposes the mapping directly */
+class FileMMAP : public Transport
+{
+
+public:
+    FileMMAP(MPI_Comm mpiComm, const bool debugMode);
+
+    ~FileMMAP();
+
+    /** only Mode::Read is supported */
+    void Open(const std::string &name, const Mode openMode) final;
+
+    /** not supported, throws */
+    void Write(const char *buffer, size_t size, size_t start = MaxSizeT) final;
+
+    void Read(char *buffer, size_t size, size_t start = MaxSizeT) final;
+
+    const char *Data(const size_t start, const size_t size) final;
+
+    void WillRead(const size_t start, const size_t size) final;
+
+    size_t GetSize() final;
+
+    /** Does nothing, the mapping is read-only */
+    void Flush() final;
+
+    void Close() final;
+
+private:
+    /** POSIX file handle returned by Open */
+    int m_FileDescriptor = -1;
+
+    /** start of the mapping, nullptr for an empty file */
+    char *m_Mapping = nullptr;
+    size_t m_MappingSize = 0;
+
+    /** used by Read when start is not passed */
+    size_t m_Position = 0;
+
+    /**
+     * Maps the current file size if [start, start + size) is beyond the
+     * current mapping, files being written can grow after Open
+     * @param start
+     * @param size
+     * @param hint exception message
+     */
+    void CheckMapping(const size_t start, const size_t size,
+                      const std::string hint);
+
+    void Unmap() noexcept;
+
+    /**
+     * Check if m_FileDescriptor is -1 after an operation
+     * @param hint exception message
+     */
+    void CheckFile(const std::string hint) const;
+};
+
+} // end namespace transport
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_TRANSPORT_FILE_FILEMMAP_H_ */
@@ -10,13 +10,17 @@
 #include "FilePOSIX.h"
 
 #include <fcntl.h>     // open
+#include <limits.h>    // IOV_MAX
 #include <stddef.h>    // write output
 #include <sys/stat.h>  // open, fstat
 #include <sys/types.h> // open
+#include <sys/uio.h>   // writev
 #include <unistd.h>    // write, close
 
 /// \cond EXCLUDE_FROM_DOXYGEN
-#include <ios> //std::ios_base::failure
+#include <algorithm> //std::min
+#include <ios>       //std::ios_base::failure
+#include <vector>
 /// \endcond
 
 namespace adios2
@@ -136,6 +140,73 @@ void FilePOSIX::Write(const char *buffer, size_t size, size_t start)
     }
 }
 
+void FilePOSIX::WriteV(const core::iovec *iov, const int iovcnt, size_t start)
+{
+    if (start != MaxSizeT)
+    {
+        const auto newPosition = lseek(m_FileDescriptor, start, SEEK_SET);
+
+        if (static_cast<size_t>(newPosition) != start)
+        {
+            throw std::ios_base::failure(
+                "ERROR: couldn't move to start position " +
+                std::to_string(start) + " in file " + m_Name +
+                ", in call to POSIX lseek\n");
+        }
+    }
+
+    // core::iovec has the layout of struct iovec, but writev may modify
+    // the entries after a partial write
+    std::vector<struct iovec> iovs(static_cast<size_t>(iovcnt));
+    for (int i = 0; i < iovcnt; ++i)
+    {
+        iovs[i].iov_base = const_cast<void *>(iov[i].iov_base);
+        iovs[i].iov_len = iov[i].iov_len;
+    }
+
+    int first = 0;
+    while (first < iovcnt)
+    {
+        if (iovs[first].iov_len == 0)
+        {
+            ++first;
+            continue;
+        }
+
+        const int count = std::min(iovcnt - first, IOV_MAX);
+        ProfilerStart("write");
+        const auto writtenSize = writev(m_FileDescriptor, &iovs[first], count);
+        ProfilerStop("write");
+
+        if (writtenSize == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            throw std::ios_base::failure("ERROR: couldn't write to file " +
+                                         m_Name +
+                                         ", in call to POSIX writev\n");
+        }
+
+        // skip what was written, possibly in the middle of a buffer
+        size_t remaining = static_cast<size_t>(writtenSize);
+        while (remaining > 0 && first < iovcnt)
+        {
+            const size_t size = std::min(remaining, iovs[first].iov_len);
+            iovs[first].iov_base =
+                static_cast<char *>(iovs[first].iov_base) + size;
+            iovs[first].iov_len -= size;
+            remaining -= size;
+            if (iovs[first].iov_len == 0)
+            {
+                ++first;
+            }
+        }
+    }
+}
+
 void FilePOSIX::Read(char *buffer, size_t size, size_t start)
 {
     auto lf_Read = [&](char *buffer, size_t size) {
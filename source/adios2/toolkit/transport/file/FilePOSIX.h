@@ -32,6 +32,10 @@ public:
 
     void Write(const char *buffer, size_t size, size_t start = MaxSizeT) final;
 
+    /** single writev system call per IOV_MAX buffers */
+    void WriteV(const core::iovec *iov, const int iovcnt,
+                size_t start = MaxSizeT) final;
+
     void Read(char *buffer, size_t size, size_t start = MaxSizeT) final;
 
     size_t GetSize() final;
@@ -18,6 +18,7 @@
 
 /// transports
 #ifndef _WIN32
+#include "adios2/toolkit/transport/file/FileMMAP.h"
 #include "adios2/toolkit/transport/file/FilePOSIX.h"
 #endif
 
@@ -193,6 +194,52 @@ void TransportMan::WriteFiles(const char *buffer, const size_t size,
     }
 }
 
+void TransportMan::WriteFiles(const core::iovec *iov, const size_t iovcnt,
+                              const int transportIndex)
+{
+    if (transportIndex == -1)
+    {
+        for (auto &transportPair : m_Transports)
+        {
+            auto &transport = transportPair.second;
+            if (transport->m_Type == "File")
+            {
+                transport->WriteV(iov, static_cast<int>(iovcnt));
+            }
+        }
+    }
+    else
+    {
+        auto itTransport = m_Transports.find(transportIndex);
+        CheckFile(itTransport, ", in call to WriteFiles with index " +
+                                   std::to_string(transportIndex));
+        itTransport->second->WriteV(iov, static_cast<int>(iovcnt));
+    }
+}
+
+void TransportMan::WriteFileAt(const char *buffer, const size_t size,
+                               const size_t start, const int transportIndex)
+{
+    if (transportIndex == -1)
+    {
+        for (auto &transportPair : m_Transports)
+        {
+            auto &transport = transportPair.second;
+            if (transport->m_Type == "File")
+            {
+                transport->Write(buffer, size, start);
+            }
+        }
+    }
+    else
+    {
+        auto itTransport = m_Transports.find(transportIndex);
+        CheckFile(itTransport, ", in call to WriteFileAt with index " +
+                                   std::to_string(transportIndex));
+        itTransport->second->Write(buffer, size, start);
+    }
+}
+
 size_t TransportMan::GetFileSize(const size_t transportIndex) const
 {
     auto itTransport = m_Transports.find(transportIndex);
@@ -210,6 +257,24 @@ void TransportMan::ReadFile(char *buffer, const size_t size, const size_t start,
     itTransport->second->Read(buffer, size, start);
 }
 
+const char *TransportMan::GetFileData(const size_t start, const size_t size,
+                                      const size_t transportIndex)
+{
+    auto itTransport = m_Transports.find(transportIndex);
+    CheckFile(itTransport, ", in call to GetFileData with index " +
+                               std::to_string(transportIndex));
+    return itTransport->second->Data(start, size);
+}
+
+void TransportMan::WillReadFile(const size_t start, const size_t size,
+                                const size_t transportIndex)
+{
+    auto itTransport = m_Transports.find(transportIndex);
+    CheckFile(itTransport, ", in call to WillReadFile with index " +
+                               std::to_string(transportIndex));
+    itTransport->second->WillRead(start, size);
+}
+
 void TransportMan::FlushFiles(const int transportIndex)
 {
     if (transportIndex == -1)
@@ -296,6 +361,21 @@ TransportMan::OpenFileTransport(const std::string &fileName,
             transport =
                 std::make_shared<transport::FilePOSIX>(m_MPIComm, m_DebugMode);
         }
+        else if (library == "MMAP" || library == "mmap")
+        {
+            // mappings are read-only, writers sharing the IO transport
+            // parameters with readers use POSIX
+            if (openMode == Mode::Read)
+            {
+                transport = std::make_shared<transport::FileMMAP>(m_MPIComm,
+                                                                  m_DebugMode);
+            }
+            else
+            {
+                transport = std::make_shared<transport::FilePOSIX>(
+                    m_MPIComm, m_DebugMode);
+            }
+        }
 #endif
         else
         {
@@ -303,7 +383,7 @@ TransportMan::OpenFileTransport(const std::string &fileName,
             {
                 throw std::invalid_argument(
                     "ERROR: invalid IO AddTransport library " + library +
-                    ", only POSIX, stdio, fstream are supported\n");
+                    ", only POSIX, MMAP, stdio, fstream are supported\n");
             }
         }
     };
@@ -117,6 +117,27 @@ public:
     void WriteFiles(const char *buffer, const size_t size,
                     const int transportIndex = -1);
 
+    /**
+     * Write several buffers back to back to file transports, with vectored
+     * I/O if the transport supports it
+     * @param iov buffers in file order
+     * @param iovcnt number of buffers
+     * @param transportIndex
+     */
+    void WriteFiles(const core::iovec *iov, const size_t iovcnt,
+                    const int transportIndex = -1);
+
+    /**
+     * Write to file transports at a given position, used to overwrite
+     * contents already written (e.g. header flags)
+     * @param buffer
+     * @param size
+     * @param start position from the beginning of the file
+     * @param transportIndex
+     */
+    void WriteFileAt(const char *buffer, const size_t size, const size_t start,
+                     const int transportIndex = -1);
+
     size_t GetFileSize(const size_t transportIndex = 0) const;
 
     /**
@@ -129,6 +150,28 @@ public:
     void ReadFile(char *buffer, const size_t size, const size_t start = 0,
                   const size_t transportIndex = 0);
 
+    /**
+     * Direct access to contents of a single file if its transport supports
+     * it (e.g. MMAP library)
+     * @param start
+     * @param size
+     * @param transportIndex
+     * @return pointer to file contents at start, nullptr if not supported,
+     * then ReadFile must be used
+     */
+    const char *GetFileData(const size_t start, const size_t size,
+                            const size_t transportIndex = 0);
+
+    /**
+     * Hints the transport of a single file that [start, start + size) will
+     * be read soon
+     * @param start
+     * @param size
+     * @param transportIndex
+     */
+    void WillReadFile(const size_t start, const size_t size,
+                      const size_t transportIndex = 0);
+
     /**
      * Flush file or files depending on transport index. Throws an exception
      * if transport is not a file when transportIndex > -1.
@@ -19,9 +19,14 @@
 
 #include "bpls.h"
 
+#include <algorithm>
 #include <cinttypes>
+#include <cmath>
 #include <cstdio>
+#include <cstring>
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <vector>
 
 #include <errno.h>
@@ -90,6 +95,10 @@ bool plot;             // dump histogram related information
 bool hidden_attrs;     // show hidden attrs in BP file
 int hidden_attrs_flag; // to be passed on in option struct
 bool show_decomp;      // show decomposition of arrays
+bool stats;            // read the data and compute min/max/avg/std dev
+int nbins;             // number of histogram bins with --stats (0: none)
+int nthreads;          // threads used for statistics (0: all cores)
+int mpirank, mpisize;  // ranks share the reading of data in --stats mode
 
 // other global variables
 char *prgname; /* argv[0] */
@@ -134,8 +143,19 @@ void display_help()
         "-a\n"
         "  --regexp    | -e           Treat masks as extended regular "
         "expressions\n"
+        "  --stats                    Read the data and print min/max/avg/std "
+        "dev\n"
+        "                               Arrays are streamed in bounded memory "
+        "slabs,\n"
+        "                               which are split among MPI ranks\n"
+        "  --histogram    \"bins\"      Also print a histogram of the data "
+        "(implies --stats)\n"
+        "  --threads      \"num\"       Number of threads for statistics "
+        "(default is all cores)\n"
         "  --plot      | -p           Dumps the histogram information that can "
         "be read by gnuplot\n"
+        "                               into <var>.hist and <var>.gpl (implies "
+        "--stats)\n"
         "  --output    | -o <path>    Print to a file instead of stdout\n"
         /*
            "  --xml    | -x            # print as xml instead of ascii text\n"
@@ -342,6 +362,17 @@ int bplsMain(int argc, char *argv[])
         "--decompose", &show_decomp,
         "| -D Show decomposition of variables as layed out in file");
     arg.AddBooleanArgument("-D", &show_decomp, "");
+    arg.AddBooleanArgument(
+        "--stats", &stats,
+        "  Read the data and print min/max/avg/std dev of arrays");
+    arg.AddArgument("--histogram", argT::SPACE_ARGUMENT, &nbins,
+                    "  opt    Number of histogram bins (implies --stats)");
+    arg.AddArgument("--threads", argT::SPACE_ARGUMENT, &nthreads,
+                    "  opt    Number of threads to compute statistics with");
+    arg.AddBooleanArgument(
+        "--plot", &plot,
+        "| -p Dump the histogram into files that can be read by gnuplot");
+    arg.AddBooleanArgument("-p", &plot, "");
 
     if (!arg.Parse())
     {
@@ -389,6 +420,24 @@ int bplsMain(int argc, char *argv[])
     if (attrsonly)
         listattrs = true;
 
+    if (plot && nbins <= 0)
+        nbins = 10;
+
+    if (nbins > 0)
+        stats = true;
+
+    if (nthreads <= 0)
+        nthreads = static_cast<int>(std::thread::hardware_concurrency());
+    if (nthreads <= 0)
+        nthreads = 1;
+
+    mpirank = 0;
+    mpisize = 1;
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpirank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpisize);
+#endif
+
     if (verbose > 1)
         printSettings();
 
@@ -444,6 +493,9 @@ void init_globals()
     // timeto               = -1;
     use_regexp = false;
     plot = false;
+    stats = false;
+    nbins = 0;
+    nthreads = 0;
     hidden_attrs = false;
     hidden_attrs_flag = 0;
     printByteAsChar = false;
@@ -522,6 +574,13 @@ void printSettings(void)
         printf("      -x : output data in XML format\n");
     if (show_decomp)
         printf("      -D : show decomposition of variables in the file\n");
+    if (stats)
+        printf(" --stats : compute statistics of arrays with %d threads\n",
+               nthreads);
+    if (nbins > 0)
+        printf("         : histogram with %d bins\n", nbins);
+    if (plot)
+        printf("      -p : write histograms for gnuplot\n");
     if (hidden_attrs)
     {
         printf("         : show hidden attributes in the file\n");
@@ -926,18 +985,29 @@ int printVariableInfo(core::Engine *fp, core::IO *io,
         }
     }
 
-    if (dump && !show_decomp)
+    if ((dump || (stats && !isGlobalValue)) && !show_decomp)
     {
         // print variable content
         if (variable->m_ShapeID == ShapeID::LocalArray)
         {
-            print_decomp(fp, io, variable);
+            if (dump)
+            {
+                print_decomp(fp, io, variable);
+            }
+            else
+            {
+                fprintf(outf, "%c   no statistics for local arrays\n",
+                        commentchar);
+            }
         }
         else
         {
             retval = readVar(fp, io, variable);
         }
-        fprintf(outf, "\n");
+        if (dump)
+        {
+            fprintf(outf, "\n");
+        }
     }
     return retval;
 }
@@ -1262,71 +1332,375 @@ int doList(const char *path)
     return 0;
 }
 
-/*
-int print_data_hist(ADIOS_VARINFO *vi, char *varname)
+int print_data_hist(const std::string &varname, double lo, double width,
+                    const std::vector<uint64_t> &hist)
 {
-    char hist_file[256], gnuplot_file[256];
-    int i;
-    char xtics[512], str[512];
+    // variable names may contain '/', which cannot be used in file names
+    std::string base(varname);
+    std::replace(base.begin(), base.end(), '/', '_');
+    const std::string hist_file = base + ".hist";
+    const std::string gnuplot_file = base + ".gpl";
     FILE *out_hist, *out_plot;
-    struct ADIOS_HIST *h = vi->statistics->histogram;
-
-    memcpy(hist_file, varname, strlen(varname) + 1);
-    strcat(hist_file, ".hist");
 
-    if ((out_hist = fopen(hist_file, "w")) == NULL)
+    if ((out_hist = fopen(hist_file.c_str(), "w")) == NULL)
     {
         fprintf(stderr, "Error at opening for writing file %s: %s\n",
-hist_file,
-                strerror(errno));
+                hist_file.c_str(), strerror(errno));
         return 30;
     }
 
-    memcpy(gnuplot_file, varname, strlen(varname) + 1);
-    strcat(gnuplot_file, ".gpl");
-
-    if ((out_plot = fopen(gnuplot_file, "w")) == NULL)
+    if ((out_plot = fopen(gnuplot_file.c_str(), "w")) == NULL)
     {
         fprintf(stderr, "Error at opening for writing file %s: %s\n",
-                gnuplot_file, strerror(errno));
+                gnuplot_file.c_str(), strerror(errno));
+        fclose(out_hist);
         return 30;
     }
 
-    xtics[0] = '\0';
-    strcat(xtics, "set xtics offset start axis (");
-    for (i = 0; i <= h->num_breaks; i++)
+    const size_t nb = hist.size();
+    if (!(width > 0.0))
+    {
+        width = 1.0;
+    }
+    for (size_t i = 0; i < nb; i++)
+    {
+        fprintf(out_hist, "%.10g %.10g %" PRIu64 "\n", lo + i * width,
+                lo + (i + 1) * width, hist[i]);
+    }
+
+    fprintf(out_plot, "set boxwidth %g\nset style fill solid border -1\n",
+            width);
+    fprintf(out_plot, "plot '%s' using (($1+$2)/2):3 with boxes title '%s'\n",
+            hist_file.c_str(), varname.c_str());
+    fprintf(out_plot, "pause -1 'Press Enter to quit'\n");
+
+    fclose(out_hist);
+    fclose(out_plot);
+    return 0;
+}
+
+/** a - b, subtracted in T so that nearby 64-bit integers, which are the
+ *  same once converted to double, still differ */
+template <class T>
+typename std::enable_if<std::is_integral<T>::value, double>::type
+stats_diff(const T a, const T b)
+{
+    // U is cast again as narrow types are promoted to int
+    using U = typename std::make_unsigned<T>::type;
+    return a < b ? -static_cast<double>(
+                       static_cast<U>(static_cast<U>(b) - static_cast<U>(a)))
+                 : static_cast<double>(
+                       static_cast<U>(static_cast<U>(a) - static_cast<U>(b)));
+}
+
+template <class T>
+typename std::enable_if<!std::is_integral<T>::value, double>::type
+stats_diff(const T a, const T b)
+{
+    return static_cast<double>(a) - static_cast<double>(b);
+}
+
+/** Accumulate one contiguous chunk of data in the calling thread.
+ *  The sum of squared differences is computed in a second pass over the
+ *  chunk against the chunk mean, which is more accurate than summing
+ *  squares and still cheap as the chunk is hot in the cache */
+template <class T>
+void stats_add_chunk(VarStats<T> &st, const T *data, size_t n, T lo, T hi)
+{
+    if (n == 0)
+        return;
+
+    VarStats<T> chunk;
+    chunk.n = n;
+    chunk.min = data[0];
+    chunk.max = data[0];
+    chunk.ref = data[0];
+    double sum = 0.0;
+    for (size_t i = 0; i < n; i++)
+    {
+        const T v = data[i];
+        if (v < chunk.min)
+            chunk.min = v;
+        if (v > chunk.max)
+            chunk.max = v;
+        sum += stats_diff(v, chunk.ref);
+    }
+    chunk.mean = sum / n;
+    for (size_t i = 0; i < n; i++)
+    {
+        const double d = stats_diff(data[i], chunk.ref) - chunk.mean;
+        chunk.m2 += d * d;
+    }
+
+    const size_t nb = st.hist.size();
+    if (nb > 0)
     {
-        if (i == 0)
+        const double scale = lo < hi ? nb / stats_diff(hi, lo) : 0.0;
+        for (size_t i = 0; i < n; i++)
         {
-            fprintf(out_hist, "-Inf %.2lf %u\n", h->breaks[i],
-                    h->gfrequencies[i]);
-            sprintf(str, "\"-Inf\" pos(%d)", i);
+            const double x = stats_diff(data[i], lo) * scale;
+            size_t bin = 0;
+            if (x >= static_cast<double>(nb))
+                bin = nb - 1;
+            else if (x > 0.0)
+                bin = static_cast<size_t>(x);
+            ++st.hist[bin];
         }
-        else if (i < h->num_breaks)
-        {
-            fprintf(out_hist, "%.2lf %.2lf %u\n", h->breaks[i - 1],
-                    h->breaks[i], h->gfrequencies[i]);
-            sprintf(str, ", \"%.2lf\" pos(%d)", h->breaks[i - 1], i);
+    }
+
+    stats_merge(st, chunk);
+}
+
+template <class T>
+void stats_add(VarStats<T> &st, const T *data, size_t n, T lo, T hi)
+{
+    // small slabs are not worth starting threads for
+    const size_t minChunk = 65536;
+    size_t nt = std::min(static_cast<size_t>(nthreads), n / minChunk);
+    if (nt <= 1)
+    {
+        stats_add_chunk(st, data, n, lo, hi);
+        return;
+    }
+
+    std::vector<VarStats<T>> partial(nt);
+    for (auto &p : partial)
+    {
+        p.hist.assign(st.hist.size(), 0);
+    }
+
+    const size_t chunk = n / nt;
+    adios2::helper::GetThreadPool().ParallelFor(
+        nt, static_cast<unsigned int>(nt), [&](const size_t t) {
+            const size_t len = (t == nt - 1 ? n - t * chunk : chunk);
+            stats_add_chunk(partial[t], data + t * chunk, len, lo, hi);
+        });
+
+    for (const auto &p : partial)
+    {
+        stats_merge(st, p);
+    }
+}
+
+template <class T>
+void stats_merge(VarStats<T> &to, const VarStats<T> &from)
+{
+    const size_t nb = std::min(to.hist.size(), from.hist.size());
+    for (size_t i = 0; i < nb; i++)
+    {
+        to.hist[i] += from.hist[i];
+    }
+
+    if (from.n == 0)
+        return;
+
+    if (to.n == 0)
+    {
+        to.n = from.n;
+        to.min = from.min;
+        to.max = from.max;
+        to.ref = from.ref;
+        to.mean = from.mean;
+        to.m2 = from.m2;
+        return;
+    }
+
+    if (from.min < to.min)
+        to.min = from.min;
+    if (from.max > to.max)
+        to.max = from.max;
+
+    // combine mean and squared differences of the two sets (Chan et al.),
+    // the means are relative to the ref of each set
+    const double na = static_cast<double>(to.n);
+    const double nf = static_cast<double>(from.n);
+    const double delta = stats_diff(from.ref, to.ref) + from.mean - to.mean;
+    to.mean += delta * nf / (na + nf);
+    to.m2 += from.m2 + delta * delta * na * nf / (na + nf);
+    to.n += from.n;
+}
+
+/** Combine the statistics of all MPI ranks, every rank gets the result */
+template <class T>
+void stats_reduce(VarStats<T> &st)
+{
+#ifdef ADIOS2_HAVE_MPI
+    if (mpisize < 2)
+        return;
+
+    const size_t nb = st.hist.size();
+    const size_t recsize = sizeof(uint64_t) + 3 * sizeof(T) +
+                           2 * sizeof(double) + nb * sizeof(uint64_t);
+
+    auto lf_Pack = [&](const VarStats<T> &from, char *to) {
+        std::memcpy(to, &from.n, sizeof(uint64_t));
+        to += sizeof(uint64_t);
+        std::memcpy(to, &from.min, sizeof(T));
+        to += sizeof(T);
+        std::memcpy(to, &from.max, sizeof(T));
+        to += sizeof(T);
+        std::memcpy(to, &from.ref, sizeof(T));
+        to += sizeof(T);
+        std::memcpy(to, &from.mean, sizeof(double));
+        to += sizeof(double);
+        std::memcpy(to, &from.m2, sizeof(double));
+        to += sizeof(double);
+        std::memcpy(to, from.hist.data(), nb * sizeof(uint64_t));
+    };
+
+    auto lf_Unpack = [&](const char *from, VarStats<T> &to) {
+        std::memcpy(&to.n, from, sizeof(uint64_t));
+        from += sizeof(uint64_t);
+        std::memcpy(&to.min, from, sizeof(T));
+        from += sizeof(T);
+        std::memcpy(&to.max, from, sizeof(T));
+        from += sizeof(T);
+        std::memcpy(&to.ref, from, sizeof(T));
+        from += sizeof(T);
+        std::memcpy(&to.mean, from, sizeof(double));
+        from += sizeof(double);
+        std::memcpy(&to.m2, from, sizeof(double));
+        from += sizeof(double);
+        to.hist.resize(nb);
+        std::memcpy(to.hist.data(), from, nb * sizeof(uint64_t));
+    };
+
+    std::vector<char> rec(recsize);
+    lf_Pack(st, rec.data());
+
+    std::vector<char> all(mpirank == 0 ? recsize * mpisize : 0);
+    MPI_Gather(rec.data(), static_cast<int>(recsize), MPI_CHAR, all.data(),
+               static_cast<int>(recsize), MPI_CHAR, 0, MPI_COMM_WORLD);
+
+    if (mpirank == 0)
+    {
+        VarStats<T> total;
+        total.hist.assign(nb, 0);
+        VarStats<T> one;
+        for (int r = 0; r < mpisize; r++)
+        {
+            lf_Unpack(all.data() + r * recsize, one);
+            stats_merge(total, one);
+        }
+        lf_Pack(total, rec.data());
+    }
+
+    MPI_Bcast(rec.data(), static_cast<int>(recsize), MPI_CHAR, 0,
+              MPI_COMM_WORLD);
+    lf_Unpack(rec.data(), st);
+#endif
+}
+
+template <class T>
+void print_stats(core::Variable<T> *variable, const VarStats<T> &st, T lo,
+                 T hi)
+{
+    enum ADIOS_DATATYPES adiosvartype = type_to_enum(variable->m_Type);
+
+    fprintf(outf, "%c   elements = %" PRIu64, commentchar, st.n);
+    if (st.n > 0)
+    {
+        fprintf(outf, "  min = ");
+        print_data(&st.min, 0, adiosvartype, false);
+        fprintf(outf, "  max = ");
+        print_data(&st.max, 0, adiosvartype, false);
+        fprintf(outf, "  avg = %g  std dev = %g",
+                static_cast<double>(st.ref) + st.mean,
+                std::sqrt(st.m2 / st.n));
+    }
+    fprintf(outf, "\n");
+
+    const size_t nb = st.hist.size();
+    if (nb == 0)
+        return;
+
+    fprintf(outf, "%c   histogram:\n", commentchar);
+    const double low = static_cast<double>(lo);
+    const double width = lo < hi ? stats_diff(hi, lo) / nb : 0.0;
+    for (size_t i = 0; i < nb; i++)
+    {
+        fprintf(outf, "%c     [%.10g, %.10g%c  %" PRIu64 "\n", commentchar,
+                low + i * width, low + (i + 1) * width,
+                (i == nb - 1 ? ']' : ')'), st.hist[i]);
+    }
+
+    if (plot && mpirank == 0)
+    {
+        print_data_hist(variable->m_Name, low, width, st.hist);
+    }
+}
+
+/** Statistics of one variable as its slabs are read in by readVar.
+ *  Only arithmetic types have statistics, the primary template is a
+ *  no-op for all others. */
+template <class T, bool = std::is_arithmetic<T>::value>
+class SlabStats
+{
+public:
+    SlabStats(core::Variable<T> *) {}
+    bool Enabled() const { return false; }
+    bool Scanning() const { return false; }
+    void Add(const T *, size_t) {}
+    void EndScan() {}
+    void Print() {}
+};
+
+template <class T>
+class SlabStats<T, true>
+{
+public:
+    SlabStats(core::Variable<T> *variable) : m_Variable(variable)
+    {
+        if (stats && nbins > 0)
+        {
+            // the histogram range is taken from the min/max in the
+            // metadata, without them (e.g. in HDF5 files) the range is
+            // found in an extra pass over the data
+            m_Lo = variable->m_Min;
+            m_Hi = variable->m_Max;
+            m_Scanning = !(m_Lo < m_Hi);
+            if (!m_Scanning)
+            {
+                m_Stats.hist.assign(nbins, 0);
+            }
         }
-        else
+    }
+
+    bool Enabled() const { return stats; }
+    bool Scanning() const { return m_Scanning; }
+
+    void Add(const T *data, size_t n)
+    {
+        stats_add(m_Stats, data, n, m_Lo, m_Hi);
+    }
+
+    void EndScan()
+    {
+        stats_reduce(m_Stats);
+        m_Lo = m_Stats.min;
+        m_Hi = m_Stats.max;
+        m_Stats = VarStats<T>();
+        // all values are the same, there is nothing to bin
+        if (m_Lo < m_Hi)
         {
-            fprintf(out_hist, "%.2lf Inf %u\n", h->breaks[i],
-                    h->gfrequencies[i]);
-            sprintf(str, ", \"Inf\" pos(%d)", i);
+            m_Stats.hist.assign(nbins, 0);
         }
-        strcat(xtics, str);
+        m_Scanning = false;
     }
-    strcat(xtics, ")\n");
 
-    fprintf(out_plot, "start = -0.5\npos(x) = start + x * 1\nset boxwidth "
-                      "1\nset style fill solid border 5#5lt6#6\n");
-    fputs(xtics, out_plot);
-    fprintf(out_plot, "plot '%s' using 3 smooth frequency w boxes\n",
-            hist_file);
-    fprintf(out_plot, "pause -1 'Press Enter to quit'\n");
-    return 0;
-}
-*/
+    void Print()
+    {
+        stats_reduce(m_Stats);
+        print_stats(m_Variable, m_Stats, m_Lo, m_Hi);
+    }
+
+private:
+    core::Variable<T> *m_Variable;
+    VarStats<T> m_Stats;
+    T m_Lo = T();
+    T m_Hi = T();
+    bool m_Scanning = false;
+};
 
 int cmpstringp(const void *p1, const void *p2)
 {
@@ -1597,108 +1971,162 @@ int readVar(core::Engine *fp, core::IO *io, core::Variable<T> *variable)
                " in total (nelems=%" PRIu64 ")\n",
                actualreadn, sum, nelems);
 
-    // init s and c
-    // and calculate ndigits_dims
-    for (j = 0; j < tdims; j++)
+    SlabStats<T> slabstats(variable);
+    const bool dostats = slabstats.Enabled();
+    if (!dump && !dostats)
     {
-        s[j] = start_t[j];
-        c[j] = readn[j];
-
-        ndigits_dims[j] = ndigits(start_t[j] + count_t[j] -
-                                  1); // -1: dim=100 results in 2 digits (0..99)
+        fprintf(outf, "%c   no statistics for type %s\n", commentchar,
+                variable->m_Type.c_str());
+        return 0;
     }
 
-    // read until read all 'nelems' elements
-    sum = 0;
-    while (sum < nelems)
+    // An optional first pass finds the histogram range. Slabs are only
+    // split among the MPI ranks if they need not be printed in order.
+    for (int pass = (slabstats.Scanning() ? 0 : 1); pass < 2; pass++)
     {
+        const bool scan = (pass == 0);
+        const bool split = scan || !dump;
 
-        // how many elements do we read in next?
-        actualreadn = 1;
+        // init s and c
+        // and calculate ndigits_dims
         for (j = 0; j < tdims; j++)
-            actualreadn *= c[j];
-
-        if (verbose > 2)
         {
-            printf("adios_read_var name=%s ", variable->m_Name.c_str());
-            PRINT_DIMS_UINT64("  start", s, tdims, j);
-            PRINT_DIMS_UINT64("  count", c, tdims, j);
-            printf("  read %" PRIu64 " elems\n", actualreadn);
-        }
-
-        // read a slice finally
-        const Dims startv =
-            variable->m_ShapeID == ShapeID::GlobalArray
-                ? helper::Uint64ArrayToSizetVector(tdims - tidx, s + tidx)
-                : Dims();
-        const Dims countv =
-            variable->m_ShapeID == ShapeID::GlobalArray
-                ? helper::Uint64ArrayToSizetVector(tdims - tidx, c + tidx)
-                : Dims();
+            s[j] = start_t[j];
+            c[j] = readn[j];
 
-        if (verbose > 2)
-        {
-            printf("set selection: ");
-            PRINT_DIMS_SIZET("  start", startv.data(), tdims - tidx, j);
-            PRINT_DIMS_SIZET("  count", countv.data(), tdims - tidx, j);
-            printf("\n");
+            ndigits_dims[j] = ndigits(
+                start_t[j] + count_t[j] -
+                1); // -1: dim=100 results in 2 digits (0..99)
         }
 
-        if (!variable->m_SingleValue)
+        // read until read all 'nelems' elements
+        uint64_t slab = 0;
+        sum = 0;
+        while (sum < nelems)
         {
-            if (variable->m_ShapeID == ShapeID::GlobalArray)
-            {
-                variable->SetSelection({startv, countv});
-            }
-        }
 
-        if (nsteps > 1)
-        {
-            if (verbose > 2)
+            // how many elements do we read in next?
+            actualreadn = 1;
+            for (j = 0; j < tdims; j++)
+                actualreadn *= c[j];
+
+            const bool myslab = split
+                                    ? (slab % mpisize ==
+                                       static_cast<uint64_t>(mpirank))
+                                    : (mpirank == 0);
+            slab++;
+
+            if (myslab)
             {
-                printf("set Step selection: from %" PRIu64 " read %" PRIu64
-                       " steps\n",
-                       s[0], c[0]);
-            }
-            variable->SetStepSelection({s[0], c[0]});
-        }
+                if (verbose > 2)
+                {
+                    printf("adios_read_var name=%s ",
+                           variable->m_Name.c_str());
+                    PRINT_DIMS_UINT64("  start", s, tdims, j);
+                    PRINT_DIMS_UINT64("  count", c, tdims, j);
+                    printf("  read %" PRIu64 " elems\n", actualreadn);
+                }
 
-        dataV.resize(variable->SelectionSize());
-        fp->Get(*variable, dataV, adios2::Mode::Sync);
+                // read a slice finally
+                const Dims startv =
+                    variable->m_ShapeID == ShapeID::GlobalArray
+                        ? helper::Uint64ArrayToSizetVector(tdims - tidx,
+                                                           s + tidx)
+                        : Dims();
+                const Dims countv =
+                    variable->m_ShapeID == ShapeID::GlobalArray
+                        ? helper::Uint64ArrayToSizetVector(tdims - tidx,
+                                                           c + tidx)
+                        : Dims();
+
+                if (verbose > 2)
+                {
+                    printf("set selection: ");
+                    PRINT_DIMS_SIZET("  start", startv.data(), tdims - tidx,
+                                     j);
+                    PRINT_DIMS_SIZET("  count", countv.data(), tdims - tidx,
+                                     j);
+                    printf("\n");
+                }
 
-        // print slice
-        print_dataset(dataV.data(), variable->m_Type, s, c, tdims,
-                      ndigits_dims);
+                if (!variable->m_SingleValue)
+                {
+                    if (variable->m_ShapeID == ShapeID::GlobalArray)
+                    {
+                        variable->SetSelection({startv, countv});
+                    }
+                }
 
-        // prepare for next read
-        sum += actualreadn;
-        incdim = true; // largest dim should be increased
-        for (j = tdims - 1; j >= 0; j--)
-        {
-            if (incdim)
-            {
-                if (s[j] + c[j] == start_t[j] + count_t[j])
+                if (nsteps > 1)
                 {
-                    // reached the end of this dimension
-                    s[j] = start_t[j];
-                    c[j] = readn[j];
-                    incdim = true; // next smaller dim can increase too
+                    if (verbose > 2)
+                    {
+                        printf("set Step selection: from %" PRIu64
+                               " read %" PRIu64 " steps\n",
+                               s[0], c[0]);
+                    }
+                    variable->SetStepSelection({s[0], c[0]});
                 }
-                else
+
+                dataV.resize(variable->SelectionSize());
+                fp->Get(*variable, dataV, adios2::Mode::Sync);
+
+                // print slice
+                if (dump && !scan)
                 {
-                    // move up in this dimension up to total count
-                    s[j] += readn[j];
-                    if (s[j] + c[j] > start_t[j] + count_t[j])
+                    print_dataset(dataV.data(), variable->m_Type, s, c,
+                                  tdims, ndigits_dims);
+                }
+
+                if (dostats)
+                {
+                    slabstats.Add(dataV.data(), dataV.size());
+                }
+            }
+
+            // prepare for next read
+            sum += actualreadn;
+            incdim = true; // largest dim should be increased
+            for (j = tdims - 1; j >= 0; j--)
+            {
+                if (incdim)
+                {
+                    if (s[j] + c[j] == start_t[j] + count_t[j])
                     {
-                        // do not reach over the limit
-                        c[j] = start_t[j] + count_t[j] - s[j];
+                        // reached the end of this dimension
+                        s[j] = start_t[j];
+                        c[j] = readn[j];
+                        incdim = true; // next smaller dim can increase too
+                    }
+                    else
+                    {
+                        // move up in this dimension up to total count
+                        s[j] += readn[j];
+                        if (s[j] + c[j] > start_t[j] + count_t[j])
+                        {
+                            // do not reach over the limit
+                            c[j] = start_t[j] + count_t[j] - s[j];
+                        }
+                        incdim = false;
                     }
-                    incdim = false;
                 }
             }
+        } // end while sum < nelems
+
+        if (scan)
+        {
+            slabstats.EndScan();
         }
-    } // end while sum < nelems
-    print_endline();
+    }
+
+    if (dump)
+    {
+        print_endline();
+    }
+    if (dostats)
+    {
+        slabstats.Print();
+    }
     return 0;
 }
 
@@ -2022,7 +2450,16 @@ bool matchesAMask(const char *name)
 
 int print_start(const std::string &fname)
 {
-    if (fname.empty())
+    if (mpirank > 0)
+    {
+        // only the first rank prints, the others help reading the data
+#ifdef _WIN32
+        outf = fopen("NUL", "w");
+#else
+        outf = fopen("/dev/null", "w");
+#endif
+    }
+    else if (fname.empty())
     {
         outf = stdout;
     }
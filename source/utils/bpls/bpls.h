@@ -14,8 +14,11 @@
 #include "adios2/core/IO.h"
 #include "adios2/core/Variable.h"
 #include "adios2/helper/adiosFunctions.h"
+#include "adios2/helper/adiosThreadPool.h"
 
 #include <map>
+#include <string>
+#include <vector>
 
 namespace adios2
 {
@@ -69,6 +72,19 @@ struct Entry
     }
 };
 
+/* running statistics of the values read from one variable (--stats) */
+template <class T>
+struct VarStats
+{
+    uint64_t n = 0; // number of elements seen
+    T min = T();
+    T max = T();
+    T ref = T();       // mean is relative to ref, as 64-bit integers may
+    double mean = 0.0; // not differ anymore once converted to double
+    double m2 = 0.0;            // sum of squared differences from the mean
+    std::vector<uint64_t> hist; // bin counts, empty if no histogram
+};
+
 // how to print one data item of an array
 // enum PrintDataType {STRING, INT, FLOAT, DOUBLE, COMPLEX};
 
@@ -95,6 +111,16 @@ template <class T>
 int readVarBlock(core::Engine *fp, core::IO *io, core::Variable<T> *variable,
                  int blockid);
 
+template <class T>
+void stats_add(VarStats<T> &st, const T *data, size_t n, T lo, T hi);
+template <class T>
+void stats_merge(VarStats<T> &to, const VarStats<T> &from);
+template <class T>
+void stats_reduce(VarStats<T> &st);
+template <class T>
+void print_stats(core::Variable<T> *variable, const VarStats<T> &st, T lo,
+                 T hi);
+
 template <class T>
 Dims get_global_array_signature(core::Engine *fp, core::IO *io,
                                 core::Variable<T> *variable);
@@ -120,7 +146,8 @@ int print_dataset(const void *data, const std::string vartype, uint64_t *s,
                   uint64_t *c, int tdims, int *ndigits);
 void print_endline(void);
 void print_stop(void);
-int print_data_hist(core::VariableBase *vi, char *varname);
+int print_data_hist(const std::string &varname, double lo, double width,
+                    const std::vector<uint64_t> &hist);
 int print_data_characteristics(void *min, void *max, double *avg,
                                double *std_dev,
                                enum ADIOS_DATATYPES adiosvartypes,
@@ -0,0 +1,69 @@
+#!/usr/bin/env python
+
+#
+# Distributed under the OSI-approved Apache License, Version 2.0.  See
+# accompanying file Copyright.txt for details.
+#
+# TestBPReadOutHighLevelAPI.py: read into existing numpy arrays and
+# read_many batches with the File API
+
+import numpy as np
+from mpi4py import MPI
+import adios2
+
+comm = MPI.COMM_WORLD
+rank = comm.Get_rank()
+size = comm.Get_size()
+
+Nx = 8
+NSteps = 3
+
+shape = [size * Nx]
+start = [rank * Nx]
+count = [Nx]
+
+with adios2.open('readOut.bp', 'w', comm) as fw:
+    for step in range(NSteps):
+        i32 = np.arange(Nx, dtype=np.int32) + rank * Nx + step * 100
+        r64 = np.arange(Nx, dtype=np.float64) / 2 + step
+        fw.write('step', np.array([step], dtype=np.int64))
+        fw.write('i32', i32, shape, start, count)
+        fw.write('r64', r64, shape, start, count, end_step=True)
+
+# read into the same arrays at every step
+outI32 = np.zeros(size * Nx, dtype=np.int32)
+outR64 = np.zeros(Nx, dtype=np.float64)
+outStep = np.zeros(1, dtype=np.int64)
+
+with adios2.open('readOut.bp', 'r', comm) as fr:
+    for fr_step in fr:
+        step = fr_step.current_step()
+
+        result = fr_step.read('i32', out=outI32)
+        assert(result is outI32)
+        assert(np.array_equal(
+            outI32, np.arange(size * Nx, dtype=np.int32) + step * 100))
+
+        fr_step.read('r64', start, count, out=outR64)
+        assert(np.array_equal(
+            outR64, np.arange(Nx, dtype=np.float64) / 2 + step))
+
+        # batch allocating its own arrays
+        i32, r64, readStep = fr_step.read_many(['i32', 'r64', 'step'])
+        assert(np.array_equal(i32, outI32))
+        assert(r64.shape == (size * Nx,))
+        assert(readStep[0] == step)
+
+        # batch into existing arrays
+        results = fr_step.read_many(['step', 'i32'], [outStep, outI32])
+        assert(results[0] is outStep and results[1] is outI32)
+        assert(outStep[0] == step)
+
+        # wrong type or size is rejected
+        for badOut in [np.zeros(size * Nx, dtype=np.float32),
+                       np.zeros(size * Nx + 1, dtype=np.int32)]:
+            try:
+                fr_step.read('i32', out=badOut)
+                raise AssertionError('read into invalid out array')
+            except ValueError:
+                pass
@@ -0,0 +1,183 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * TestBPReadCoalesce.cpp : BP4 merges the reads of adjacent and nearby
+ * blocks, each block must still land in its own Get
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <stdexcept>
+#include <tuple>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+using ParamType = std::tuple<std::string, std::string>;
+
+class BPReadCoalesce : public ::testing::TestWithParam<ParamType>
+{
+public:
+    BPReadCoalesce() = default;
+};
+
+TEST_P(BPReadCoalesce, ADIOS2BPReadBlocks)
+{
+    const std::string gap = std::get<0>(GetParam());
+    const std::string threads = std::get<1>(GetParam());
+    const std::string fname("BPReadCoalesce_" + gap + "_" + threads + ".bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 100;
+    const size_t NBlocks = 6;
+    const size_t NSteps = 2;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    auto lf_Value = [](const size_t step, const size_t block,
+                       const size_t i) -> double {
+        return static_cast<double>(step * 1000000 + block * 1000 + i);
+    };
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        auto var_r64 = io.DefineVariable<double>("r64", {}, {}, {Nx});
+        auto var_i32 = io.DefineVariable<int32_t>("i32", {}, {}, {Nx});
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        std::vector<double> r64(Nx);
+        std::vector<int32_t> i32(Nx);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            bpWriter.BeginStep();
+            // blocks of both variables are interleaved in the payload
+            for (size_t b = 0; b < NBlocks; ++b)
+            {
+                const size_t block = mpiRank * NBlocks + b;
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    r64[i] = lf_Value(step, block, i);
+                    i32[i] = -static_cast<int32_t>(lf_Value(step, block, i));
+                }
+                bpWriter.Put(var_r64, r64.data(), adios2::Mode::Sync);
+                bpWriter.Put(var_i32, i32.data(), adios2::Mode::Sync);
+            }
+            bpWriter.EndStep();
+        }
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.SetParameters({{"ReadCoalesceGap", gap}, {"Threads", threads}});
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        // 0, 1, 2 are adjacent, 4 skips a block, the last one is read from
+        // the next rank's subfile
+        const size_t first = mpiRank * NBlocks;
+        const std::vector<size_t> blocks = {
+            first,     first + 1, first + 2,
+            first + 4, ((mpiRank + 1) % mpiSize) * NBlocks + NBlocks - 1};
+        size_t readSteps = 0;
+
+        while (bpReader.BeginStep() == adios2::StepStatus::OK)
+        {
+            const size_t step = bpReader.CurrentStep();
+
+            auto var_r64 = io.InquireVariable<double>("r64");
+            auto var_i32 = io.InquireVariable<int32_t>("i32");
+            ASSERT_TRUE(var_r64);
+            ASSERT_TRUE(var_i32);
+
+            std::vector<std::vector<double>> r64(blocks.size());
+            std::vector<std::vector<int32_t>> i32(blocks.size());
+            for (size_t b = 0; b < blocks.size(); ++b)
+            {
+                var_r64.SetBlockSelection(blocks[b]);
+                bpReader.Get(var_r64, r64[b]);
+                // only the blocks around the skipped one for i32
+                if (b >= 2)
+                {
+                    var_i32.SetBlockSelection(blocks[b]);
+                    bpReader.Get(var_i32, i32[b]);
+                }
+            }
+            bpReader.EndStep();
+
+            for (size_t b = 0; b < blocks.size(); ++b)
+            {
+                ASSERT_EQ(r64[b].size(), Nx);
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    ASSERT_EQ(r64[b][i], lf_Value(step, blocks[b], i));
+                }
+
+                if (b < 2)
+                {
+                    continue;
+                }
+                ASSERT_EQ(i32[b].size(), Nx);
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    ASSERT_EQ(i32[b][i], -static_cast<int32_t>(
+                                             lf_Value(step, blocks[b], i)));
+                }
+            }
+            ++readSteps;
+        }
+
+        EXPECT_EQ(readSteps, NSteps);
+        bpReader.Close();
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(GapThreads, BPReadCoalesce,
+                        ::testing::Combine(::testing::Values("0", "1048576"),
+                                           ::testing::Values("1", "2")));
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+
+    result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
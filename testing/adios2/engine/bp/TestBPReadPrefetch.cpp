@@ -0,0 +1,170 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * TestBPReadPrefetch.cpp : BP4 reads the next step in the background and
+ * bounds the number of open subfiles
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <stdexcept>
+#include <tuple>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+using ParamType = std::tuple<std::string, std::string>;
+
+class BPReadPrefetch : public ::testing::TestWithParam<ParamType>
+{
+public:
+    BPReadPrefetch() = default;
+};
+
+TEST_P(BPReadPrefetch, ADIOS2BPReadSteps)
+{
+    const std::string prefetch = std::get<0>(GetParam());
+    const std::string maxOpenSubFiles = std::get<1>(GetParam());
+    const std::string fname("BPReadPrefetch_" + prefetch + "_" +
+                            maxOpenSubFiles + ".bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 1000;
+    const size_t NSteps = 6;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    auto lf_Value = [](const size_t step, const size_t i) -> double {
+        return static_cast<double>(step * 1000000 + i);
+    };
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        const size_t first = mpiRank * Nx;
+        auto var_r64 = io.DefineVariable<double>(
+            "r64", {static_cast<size_t>(mpiSize * Nx)}, {first}, {Nx});
+        auto var_local = io.DefineVariable<int32_t>("local", {}, {}, {Nx});
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        std::vector<double> r64(Nx);
+        std::vector<int32_t> local(Nx);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                r64[i] = lf_Value(step, first + i);
+                local[i] = static_cast<int32_t>(lf_Value(step, first + i));
+            }
+
+            bpWriter.BeginStep();
+            bpWriter.Put(var_r64, r64.data());
+            bpWriter.Put(var_local, local.data());
+            bpWriter.EndStep();
+        }
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.SetParameters(
+            {{"Prefetch", prefetch}, {"MaxOpenSubFiles", maxOpenSubFiles}});
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        const size_t globalSize = mpiSize * Nx;
+        std::vector<double> r64;
+        std::vector<int32_t> local;
+        size_t readSteps = 0;
+
+        while (bpReader.BeginStep() == adios2::StepStatus::OK)
+        {
+            const size_t step = bpReader.CurrentStep();
+
+            auto var_r64 = io.InquireVariable<double>("r64");
+            auto var_local = io.InquireVariable<int32_t>("local");
+            ASSERT_TRUE(var_r64);
+            ASSERT_TRUE(var_local);
+
+            // the selection changes at step 3, data prefetched with the
+            // previous selection is not enough
+            const size_t start = (step < 3) ? 0 : Nx / 2;
+            const size_t count = (step < 3) ? globalSize : globalSize - Nx;
+            var_r64.SetSelection({{start}, {count}});
+
+            // a block from each subfile
+            const size_t blockID = (mpiRank + step) % mpiSize;
+            var_local.SetBlockSelection(blockID);
+
+            bpReader.Get(var_r64, r64);
+            bpReader.Get(var_local, local);
+            bpReader.EndStep();
+
+            ASSERT_EQ(r64.size(), count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                ASSERT_EQ(r64[i], lf_Value(step, start + i));
+            }
+
+            ASSERT_EQ(local.size(), Nx);
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                ASSERT_EQ(local[i], static_cast<int32_t>(
+                                        lf_Value(step, blockID * Nx + i)));
+            }
+            ++readSteps;
+        }
+
+        EXPECT_EQ(readSteps, NSteps);
+        bpReader.Close();
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(PrefetchMaxOpenSubFiles, BPReadPrefetch,
+                        ::testing::Combine(::testing::Values("Off", "On"),
+                                           ::testing::Values("0", "1")));
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+
+    result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
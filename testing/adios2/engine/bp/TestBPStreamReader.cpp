@@ -0,0 +1,203 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * TestBPStreamReader.cpp : BP4 reader following a file still being written
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <numeric> //std::iota
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+class BPStreamReader : public ::testing::Test
+{
+public:
+    BPStreamReader() = default;
+};
+
+TEST_F(BPStreamReader, ADIOS2BPStreamReader1D)
+{
+    const std::string fname("BPStreamReader1D.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 100;
+    const size_t NSteps = 4;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+
+    const adios2::Dims shape{static_cast<size_t>(Nx * mpiSize)};
+    const adios2::Dims start{static_cast<size_t>(Nx * mpiRank)};
+    const adios2::Dims count{Nx};
+
+    adios2::IO writeIO = adios.DeclareIO("WriteIO");
+    adios2::IO readIO = adios.DeclareIO("ReadIO");
+    if (!engineName.empty())
+    {
+        writeIO.SetEngine(engineName);
+        readIO.SetEngine(engineName);
+    }
+    readIO.SetParameters(
+        {{"StreamReader", "On"}, {"BeginStepPollingFrequencySecs", "0.01"}});
+
+    auto var_r64 = writeIO.DefineVariable<double>("r64", shape, start, count,
+                                                  adios2::ConstantDims);
+
+    std::vector<double> r64(Nx);
+    auto lf_WriteStep = [&](adios2::Engine &bpWriter, const size_t step) {
+        std::iota(r64.begin(), r64.end(),
+                  static_cast<double>(step * 1000 + mpiRank * Nx));
+        bpWriter.BeginStep();
+        bpWriter.Put(var_r64, r64.data());
+        bpWriter.EndStep();
+    };
+
+    auto lf_ReadStep = [&](adios2::Engine &bpReader, const size_t step) {
+        ASSERT_EQ(bpReader.CurrentStep(), step);
+        auto var = readIO.InquireVariable<double>("r64");
+        ASSERT_TRUE(var);
+        EXPECT_EQ(var.Shape()[0], Nx * mpiSize);
+
+        std::vector<double> data;
+        var.SetSelection({{mpiRank * Nx}, {Nx}});
+        bpReader.Get(var, data);
+        bpReader.EndStep();
+
+        for (size_t i = 0; i < Nx; ++i)
+        {
+            ASSERT_EQ(data[i],
+                      static_cast<double>(step * 1000 + mpiRank * Nx + i));
+        }
+    };
+
+    adios2::Engine bpWriter = writeIO.Open(fname, adios2::Mode::Write);
+    lf_WriteStep(bpWriter, 0);
+
+    adios2::Engine bpReader = readIO.Open(fname, adios2::Mode::Read);
+
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        if (step > 0)
+        {
+            // nothing new yet, the reader must not skip the pending step
+            EXPECT_EQ(bpReader.BeginStep(adios2::StepMode::NextAvailable, 0.f),
+                      adios2::StepStatus::NotReady);
+            lf_WriteStep(bpWriter, step);
+        }
+
+        ASSERT_EQ(bpReader.BeginStep(adios2::StepMode::NextAvailable, 0.f),
+                  adios2::StepStatus::OK);
+        lf_ReadStep(bpReader, step);
+    }
+
+    bpWriter.Close();
+
+    EXPECT_EQ(bpReader.BeginStep(), adios2::StepStatus::EndOfStream);
+    bpReader.Close();
+}
+
+TEST_F(BPStreamReader, ADIOS2BPStreamReaderClosedFile)
+{
+    const std::string fname("BPStreamReaderClosedFile.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 10;
+    const size_t NSteps = 3;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        auto var_i32 = io.DefineVariable<int32_t>(
+            "i32", {Nx * mpiSize}, {Nx * mpiRank}, {Nx}, adios2::ConstantDims);
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+        std::vector<int32_t> i32(Nx);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            std::iota(i32.begin(), i32.end(), static_cast<int32_t>(step));
+            bpWriter.BeginStep();
+            bpWriter.Put(var_i32, i32.data());
+            bpWriter.EndStep();
+        }
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.SetParameters({{"StreamReader", "On"}});
+
+        // the writer is gone, no waiting on a timeout-less BeginStep
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+        size_t readSteps = 0;
+        while (bpReader.BeginStep() == adios2::StepStatus::OK)
+        {
+            auto var_i32 = io.InquireVariable<int32_t>("i32");
+            ASSERT_TRUE(var_i32);
+            std::vector<int32_t> i32;
+            var_i32.SetSelection({{Nx * mpiRank}, {Nx}});
+            bpReader.Get(var_i32, i32);
+            bpReader.EndStep();
+            EXPECT_EQ(i32.front(), static_cast<int32_t>(readSteps));
+            ++readSteps;
+        }
+        EXPECT_EQ(readSteps, NSteps);
+        bpReader.Close();
+    }
+}
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+
+    result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -17,7 +17,8 @@
 std::string engineName; // comes from command line
 
 // ADIOS2 BP write
-void WriteAggRead1D8(const std::string substreams)
+void WriteAggRead1D8(const std::string substreams,
+                     const adios2::Params &aggregation = adios2::Params())
 {
     // Each process would write a 1x8 array and all processes would
     // form a mpiSize * Nx 1D array
@@ -42,6 +43,10 @@ void WriteAggRead1D8(const std::string substreams)
         if (mpiSize > 1)
         {
             io.SetParameter("Substreams", substreams);
+            for (const auto &parameter : aggregation)
+            {
+                io.SetParameter(parameter.first, parameter.second);
+            }
         }
 
         // Declare 1D variables (NumOfProcesses * Nx)
@@ -318,7 +323,8 @@ void WriteAggRead1D8(const std::string substreams)
     }
 }
 
-void WriteAggRead2D4x2(const std::string substreams)
+void WriteAggRead2D4x2(const std::string substreams,
+                       const adios2::Params &aggregation = adios2::Params())
 {
     // Each process would write a 2x4 array and all processes would
     // form a 2D 2 * (numberOfProcess*Nx) matrix where Nx is 4 here
@@ -348,6 +354,10 @@ void WriteAggRead2D4x2(const std::string substreams)
         {
             const int subStreams = mpiSize / 2;
             io.SetParameter("Substreams", std::to_string(subStreams));
+            for (const auto &parameter : aggregation)
+            {
+                io.SetParameter(parameter.first, parameter.second);
+            }
         }
 
         // Declare 2D variables (Ny * (NumOfProcesses * Nx))
@@ -630,7 +640,8 @@ void WriteAggRead2D4x2(const std::string substreams)
     }
 }
 
-void WriteAggRead2D2x4(const std::string substreams)
+void WriteAggRead2D2x4(const std::string substreams,
+                       const adios2::Params &aggregation = adios2::Params())
 {
     // Each process would write a 4x2 array and all processes would
     // form a 2D 4 * (NumberOfProcess * Nx) matrix where Nx is 2 here
@@ -657,6 +668,10 @@ void WriteAggRead2D2x4(const std::string substreams)
         if (mpiSize > 1)
         {
             io.SetParameter("Substreams", substreams);
+            for (const auto &parameter : aggregation)
+            {
+                io.SetParameter(parameter.first, parameter.second);
+            }
         }
 
         // Declare 2D variables (4 * (NumberOfProcess * Nx))
@@ -959,6 +974,41 @@ TEST_P(BPWriteAggregateReadTest, ADIOS2BPWriteAggregateRead2D4x2)
 INSTANTIATE_TEST_CASE_P(Substreams, BPWriteAggregateReadTest,
                         ::testing::Values("1", "2", "3", "4", "5"));
 
+class BPWriteAggregateReadTwoLevelTest
+: public ::testing::TestWithParam<std::string>
+{
+public:
+    BPWriteAggregateReadTwoLevelTest() = default;
+
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+
+    /** node groups of GetParam() ranks, single substream so data from every
+     * group goes through the consumer ring buffers */
+    adios2::Params GetAggregation() const
+    {
+        return {{"AggregatorType", "TwoLevel"}, {"NodeGroupSize", GetParam()}};
+    }
+};
+
+TEST_P(BPWriteAggregateReadTwoLevelTest, ADIOS2BPWriteAggregateRead1D8)
+{
+    WriteAggRead1D8("1", GetAggregation());
+}
+
+TEST_P(BPWriteAggregateReadTwoLevelTest, ADIOS2BPWriteAggregateRead2D2x4)
+{
+    WriteAggRead2D2x4("1", GetAggregation());
+}
+
+TEST_P(BPWriteAggregateReadTwoLevelTest, ADIOS2BPWriteAggregateRead2D4x2)
+{
+    WriteAggRead2D4x2("1", GetAggregation());
+}
+
+INSTANTIATE_TEST_CASE_P(NodeGroupSize, BPWriteAggregateReadTwoLevelTest,
+                        ::testing::Values("0", "1", "2"));
+
 int main(int argc, char **argv)
 {
     MPI_Init(nullptr, nullptr);
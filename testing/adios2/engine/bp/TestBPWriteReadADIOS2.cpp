@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <cstring>
 
+#include <algorithm> //std::fill
 #include <iostream>
 #include <numeric> //std::iota
 #include <stdexcept>
@@ -1564,6 +1565,182 @@ TEST_F(BPWriteReadTestADIOS2, ReadStartCount)
     }
 }
 
+TEST_F(BPWriteReadTestADIOS2, AvailableVariablesKeys)
+{
+    const std::string fname("AvailableVariablesKeys.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+
+    const std::size_t Nx = 10;
+    const std::size_t NSteps = 3;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    const std::size_t gNx = static_cast<std::size_t>(Nx * mpiSize);
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("AvailableVariablesWrite");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        auto varRange = io.DefineVariable<int64_t>(
+            "range", {gNx}, {static_cast<std::size_t>(Nx * mpiRank)}, {Nx});
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        std::vector<int64_t> localData(Nx);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            std::iota(localData.begin(), localData.end(),
+                      static_cast<int64_t>(step * 1000 + mpiRank * Nx));
+            bpWriter.BeginStep();
+            bpWriter.Put(varRange, localData.data());
+            bpWriter.EndStep();
+        }
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("AvailableVariablesRead");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        size_t step = 0;
+        while (bpReader.BeginStep() == adios2::StepStatus::OK)
+        {
+            const int64_t min = static_cast<int64_t>(step * 1000);
+            const int64_t max = static_cast<int64_t>(step * 1000 + gNx - 1);
+
+            // repeated calls in a step hit the cached statistics
+            for (size_t i = 0; i < 2; ++i)
+            {
+                auto variables = io.AvailableVariables();
+                ASSERT_EQ(variables.size(), 1);
+                adios2::Params &info = variables["range"];
+                EXPECT_EQ(info["Type"], "int64_t");
+                EXPECT_EQ(info["Shape"], std::to_string(gNx));
+                EXPECT_EQ(info["SingleValue"], "false");
+                EXPECT_EQ(info["Min"], std::to_string(min));
+                EXPECT_EQ(info["Max"], std::to_string(max));
+            }
+
+            auto variables = io.AvailableVariables({"Type", "Shape"});
+            ASSERT_EQ(variables.size(), 1);
+            const adios2::Params &info = variables["range"];
+            ASSERT_EQ(info.size(), 2);
+            EXPECT_EQ(info.at("Type"), "int64_t");
+            EXPECT_EQ(info.at("Shape"), std::to_string(gNx));
+
+            auto varRange = io.InquireVariable<int64_t>("range");
+            EXPECT_EQ(varRange.Min(), min);
+            EXPECT_EQ(varRange.Max(), max);
+
+            bpReader.EndStep();
+            ++step;
+        }
+        EXPECT_EQ(step, NSteps);
+        bpReader.Close();
+    }
+}
+
+TEST_F(BPWriteReadTestADIOS2, RemoveDeferredVariable)
+{
+    // a variable removed before its deferred Put is performed is skipped
+    const std::string fname("RemoveDeferredVariable.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 10;
+    const size_t NSteps = 2;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+
+    const adios2::Dims shape{static_cast<size_t>(mpiSize * Nx)};
+    const adios2::Dims start{static_cast<size_t>(mpiRank * Nx)};
+    const adios2::Dims count{Nx};
+    {
+        adios2::IO io = adios.DeclareIO("RemoveDeferredWrite");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        std::vector<double> kept(Nx);
+        std::vector<double> removed(Nx);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            auto varKept = (step == 0)
+                               ? io.DefineVariable<double>("kept", shape,
+                                                           start, count)
+                               : io.InquireVariable<double>("kept");
+            auto varRemoved =
+                io.DefineVariable<double>("removed", shape, start, count);
+
+            std::iota(kept.begin(), kept.end(),
+                      static_cast<double>(step * 1000 + mpiRank * Nx));
+            std::fill(removed.begin(), removed.end(), -1.);
+
+            bpWriter.BeginStep();
+            bpWriter.Put(varRemoved, removed.data());
+            bpWriter.Put(varKept, kept.data());
+            EXPECT_TRUE(io.RemoveVariable("removed"));
+            bpWriter.EndStep();
+        }
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("RemoveDeferredRead");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        std::vector<double> kept;
+        size_t step = 0;
+        while (bpReader.BeginStep() == adios2::StepStatus::OK)
+        {
+            EXPECT_FALSE(io.InquireVariable<double>("removed"));
+            auto varKept = io.InquireVariable<double>("kept");
+            ASSERT_TRUE(varKept);
+            bpReader.Get(varKept, kept);
+            bpReader.EndStep();
+
+            ASSERT_EQ(kept.size(), mpiSize * Nx);
+            for (size_t i = 0; i < kept.size(); ++i)
+            {
+                EXPECT_EQ(kept[i], static_cast<double>(step * 1000 + i));
+            }
+            ++step;
+        }
+        EXPECT_EQ(step, NSteps);
+        bpReader.Close();
+    }
+}
+
 //******************************************************************************
 // main
 //******************************************************************************
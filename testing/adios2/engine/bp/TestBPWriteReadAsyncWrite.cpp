@@ -0,0 +1,165 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * TestBPWriteReadAsyncWrite.cpp : BP4 writes drained by a background thread
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <numeric> //std::iota
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+class BPWriteReadAsyncWrite : public ::testing::TestWithParam<std::string>
+{
+public:
+    BPWriteReadAsyncWrite() = default;
+};
+
+TEST_P(BPWriteReadAsyncWrite, ADIOS2BPWriteRead1D)
+{
+    const std::string queueLimit = GetParam();
+    const std::string fname("BPWriteReadAsyncWrite1D_" + queueLimit + ".bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 1000;
+    const size_t NSteps = 6;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.SetParameters(
+            {{"AsyncWrite", "On"}, {"AsyncQueueLimit", queueLimit}});
+
+        const adios2::Dims shape{static_cast<size_t>(Nx * mpiSize)};
+        const adios2::Dims start{static_cast<size_t>(Nx * mpiRank)};
+        const adios2::Dims count{Nx};
+
+        auto var_r64 = io.DefineVariable<double>("r64", shape, start, count,
+                                                 adios2::ConstantDims);
+        auto var_i32 = io.DefineVariable<int32_t>("i32", shape, start, count,
+                                                  adios2::ConstantDims);
+        auto var_step = io.DefineVariable<uint64_t>("step");
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        std::vector<double> r64(Nx);
+        std::vector<int32_t> i32(Nx);
+
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            std::iota(r64.begin(), r64.end(),
+                      static_cast<double>(step * 10000 + mpiRank * Nx));
+            std::iota(i32.begin(), i32.end(),
+                      static_cast<int32_t>(step * 10000 + mpiRank * Nx));
+
+            bpWriter.BeginStep();
+            bpWriter.Put(var_r64, r64.data());
+            bpWriter.Put(var_i32, i32.data());
+            bpWriter.Put(var_step, static_cast<uint64_t>(step));
+            bpWriter.EndStep();
+
+            // reuse the application buffers right away, the serialized
+            // copies are drained in the background
+            std::fill(r64.begin(), r64.end(), -1.);
+            std::fill(i32.begin(), i32.end(), -1);
+        }
+
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        std::vector<double> r64;
+        std::vector<int32_t> i32;
+        size_t readSteps = 0;
+
+        while (bpReader.BeginStep() == adios2::StepStatus::OK)
+        {
+            const size_t step = bpReader.CurrentStep();
+
+            auto var_r64 = io.InquireVariable<double>("r64");
+            auto var_i32 = io.InquireVariable<int32_t>("i32");
+            auto var_step = io.InquireVariable<uint64_t>("step");
+            ASSERT_TRUE(var_r64);
+            ASSERT_TRUE(var_i32);
+            ASSERT_TRUE(var_step);
+            EXPECT_EQ(var_r64.Shape()[0], Nx * mpiSize);
+
+            const adios2::Box<adios2::Dims> sel({mpiRank * Nx}, {Nx});
+            var_r64.SetSelection(sel);
+            var_i32.SetSelection(sel);
+
+            uint64_t stepValue = 0;
+            bpReader.Get(var_r64, r64);
+            bpReader.Get(var_i32, i32);
+            bpReader.Get(var_step, stepValue);
+            bpReader.EndStep();
+
+            EXPECT_EQ(stepValue, step);
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                const size_t expected = step * 10000 + mpiRank * Nx + i;
+                ASSERT_EQ(r64[i], static_cast<double>(expected));
+                ASSERT_EQ(i32[i], static_cast<int32_t>(expected));
+            }
+            ++readSteps;
+        }
+
+        EXPECT_EQ(readSteps, NSteps);
+        bpReader.Close();
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(QueueLimit, BPWriteReadAsyncWrite,
+                        ::testing::Values("1", "2", "4"));
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+
+    result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
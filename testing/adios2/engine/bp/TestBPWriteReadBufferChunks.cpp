@@ -0,0 +1,164 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * TestBPWriteReadBufferChunks.cpp : BP4 payloads that don't fit in the data
+ * buffer go to buffer chunks
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <numeric> //std::iota
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+class BPWriteReadBufferChunks : public ::testing::TestWithParam<std::string>
+{
+public:
+    BPWriteReadBufferChunks() = default;
+};
+
+TEST_P(BPWriteReadBufferChunks, ADIOS2BPWriteReadMultiblock)
+{
+    const std::string chunkSize = GetParam();
+    const std::string fname("BPWriteReadBufferChunks_" + chunkSize + ".bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    // blocks smaller, equal and larger than chunks, written in sync and
+    // deferred mode
+    const std::vector<size_t> blockSizes = {100, 1000, 2048, 3000, 20000};
+    const size_t Nx =
+        std::accumulate(blockSizes.begin(), blockSizes.end(), size_t(0));
+    const size_t NSteps = 4;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.SetParameters(
+            {{"InitialBufferSize", "16Kb"}, {"BufferChunkSize", chunkSize}});
+
+        const adios2::Dims shape{static_cast<size_t>(Nx * mpiSize)};
+        auto var_r64 =
+            io.DefineVariable<double>("r64", shape, {0}, {blockSizes[0]});
+        auto var_i32 =
+            io.DefineVariable<int32_t>("i32", shape, {0}, {blockSizes[0]});
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        std::vector<double> r64(Nx);
+        std::vector<int32_t> i32(Nx);
+
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            std::iota(r64.begin(), r64.end(),
+                      static_cast<double>(step * 1000000 + mpiRank * Nx));
+            std::iota(i32.begin(), i32.end(),
+                      static_cast<int32_t>(step * 1000000 + mpiRank * Nx));
+
+            bpWriter.BeginStep();
+            size_t offset = 0;
+            for (const size_t blockSize : blockSizes)
+            {
+                const adios2::Box<adios2::Dims> sel({mpiRank * Nx + offset},
+                                                    {blockSize});
+                var_r64.SetSelection(sel);
+                var_i32.SetSelection(sel);
+                bpWriter.Put(var_r64, r64.data() + offset);
+                bpWriter.Put(var_i32, i32.data() + offset,
+                             adios2::Mode::Sync);
+                offset += blockSize;
+            }
+            bpWriter.EndStep();
+        }
+
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        std::vector<double> r64;
+        std::vector<int32_t> i32;
+        size_t readSteps = 0;
+
+        while (bpReader.BeginStep() == adios2::StepStatus::OK)
+        {
+            const size_t step = bpReader.CurrentStep();
+
+            auto var_r64 = io.InquireVariable<double>("r64");
+            auto var_i32 = io.InquireVariable<int32_t>("i32");
+            ASSERT_TRUE(var_r64);
+            ASSERT_TRUE(var_i32);
+
+            const adios2::Box<adios2::Dims> sel({mpiRank * Nx}, {Nx});
+            var_r64.SetSelection(sel);
+            var_i32.SetSelection(sel);
+
+            bpReader.Get(var_r64, r64);
+            bpReader.Get(var_i32, i32);
+            bpReader.EndStep();
+
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                const size_t expected = step * 1000000 + mpiRank * Nx + i;
+                ASSERT_EQ(r64[i], static_cast<double>(expected));
+                ASSERT_EQ(i32[i], static_cast<int32_t>(expected));
+            }
+            ++readSteps;
+        }
+
+        EXPECT_EQ(readSteps, NSteps);
+        bpReader.Close();
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(ChunkSize, BPWriteReadBufferChunks,
+                        ::testing::Values("0", "16Kb", "1Mb"));
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+
+    result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
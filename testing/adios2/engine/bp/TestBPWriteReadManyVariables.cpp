@@ -0,0 +1,203 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * TestBPWriteReadManyVariables.cpp : many deferred variables per step, BP4
+ * serializes them concurrently with Threads > 1
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+class BPWriteReadManyVariables : public ::testing::TestWithParam<std::string>
+{
+public:
+    BPWriteReadManyVariables() = default;
+};
+
+TEST_P(BPWriteReadManyVariables, ADIOS2BPWriteReadDeferred)
+{
+    const std::string threads = GetParam();
+    const std::string fname("BPWriteReadManyVariables_" + threads + ".bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t NVariables = 64;
+    const size_t NBlocks = 3;
+    const size_t Nx = 500;
+    const size_t NSteps = 3;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    // global index i of variable v at step
+    auto lf_Value = [](const size_t step, const size_t v,
+                       const size_t i) -> size_t {
+        return step * 1000000 + v * 10000 + i;
+    };
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.SetParameters({{"Threads", threads}, {"InitialBufferSize", "16Kb"}});
+
+        const adios2::Dims shape{static_cast<size_t>(NBlocks * Nx * mpiSize)};
+        std::vector<adios2::Variable<double>> vars_r64;
+        std::vector<adios2::Variable<int32_t>> vars_i32;
+        for (size_t v = 0; v < NVariables; ++v)
+        {
+            vars_r64.push_back(io.DefineVariable<double>(
+                "r64_" + std::to_string(v), shape, {0}, {Nx}));
+            vars_i32.push_back(io.DefineVariable<int32_t>(
+                "i32_" + std::to_string(v), shape, {0}, {Nx}));
+        }
+        auto var_str = io.DefineVariable<std::string>("str");
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        const size_t first = mpiRank * NBlocks * Nx;
+        std::vector<std::vector<double>> r64(
+            NVariables, std::vector<double>(NBlocks * Nx));
+        std::vector<std::vector<int32_t>> i32(
+            NVariables, std::vector<int32_t>(NBlocks * Nx));
+
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            bpWriter.BeginStep();
+            for (size_t v = 0; v < NVariables; ++v)
+            {
+                for (size_t i = 0; i < NBlocks * Nx; ++i)
+                {
+                    r64[v][i] =
+                        static_cast<double>(lf_Value(step, v, first + i));
+                    i32[v][i] =
+                        static_cast<int32_t>(lf_Value(step, v, first + i));
+                }
+
+                for (size_t b = 0; b < NBlocks; ++b)
+                {
+                    const adios2::Box<adios2::Dims> sel({first + b * Nx},
+                                                        {Nx});
+                    vars_r64[v].SetSelection(sel);
+                    vars_i32[v].SetSelection(sel);
+                    bpWriter.Put(vars_r64[v], r64[v].data() + b * Nx);
+                    bpWriter.Put(vars_i32[v], i32[v].data() + b * Nx);
+                }
+            }
+            bpWriter.Put(var_str, "step " + std::to_string(step));
+            bpWriter.EndStep();
+        }
+
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        const size_t first = mpiRank * NBlocks * Nx;
+        std::vector<double> r64;
+        std::vector<int32_t> i32;
+        std::string str;
+        size_t readSteps = 0;
+
+        while (bpReader.BeginStep() == adios2::StepStatus::OK)
+        {
+            const size_t step = bpReader.CurrentStep();
+
+            for (size_t v = 0; v < NVariables; ++v)
+            {
+                auto var_r64 =
+                    io.InquireVariable<double>("r64_" + std::to_string(v));
+                auto var_i32 =
+                    io.InquireVariable<int32_t>("i32_" + std::to_string(v));
+                ASSERT_TRUE(var_r64);
+                ASSERT_TRUE(var_i32);
+
+                // min/max are computed apart from the block metadata
+                const auto blocks = bpReader.BlocksInfo(var_r64, step);
+                ASSERT_EQ(blocks.size(), NBlocks * mpiSize);
+                for (const auto &block : blocks)
+                {
+                    EXPECT_EQ(block.Min, static_cast<double>(lf_Value(
+                                             step, v, block.Start[0])));
+                    EXPECT_EQ(block.Max,
+                              static_cast<double>(lf_Value(
+                                  step, v, block.Start[0] + Nx - 1)));
+                }
+
+                const adios2::Box<adios2::Dims> sel({first}, {NBlocks * Nx});
+                var_r64.SetSelection(sel);
+                var_i32.SetSelection(sel);
+                bpReader.Get(var_r64, r64, adios2::Mode::Sync);
+                bpReader.Get(var_i32, i32, adios2::Mode::Sync);
+
+                for (size_t i = 0; i < NBlocks * Nx; ++i)
+                {
+                    ASSERT_EQ(r64[i], static_cast<double>(
+                                          lf_Value(step, v, first + i)));
+                    ASSERT_EQ(i32[i], static_cast<int32_t>(
+                                          lf_Value(step, v, first + i)));
+                }
+            }
+
+            auto var_str = io.InquireVariable<std::string>("str");
+            ASSERT_TRUE(var_str);
+            bpReader.Get(var_str, str, adios2::Mode::Sync);
+            EXPECT_EQ(str, "step " + std::to_string(step));
+            bpReader.EndStep();
+            ++readSteps;
+        }
+
+        EXPECT_EQ(readSteps, NSteps);
+        bpReader.Close();
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(Threads, BPWriteReadManyVariables,
+                        ::testing::Values("1", "2", "4"));
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+
+    result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
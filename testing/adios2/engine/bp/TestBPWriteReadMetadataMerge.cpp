@@ -0,0 +1,206 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * TestBPWriteReadMetadataMerge.cpp : BP4 collective metadata merged over a
+ * tree with MetadataMergeRadix keeps the blocks in rank order
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+class BPWriteReadMetadataMerge : public ::testing::TestWithParam<std::string>
+{
+public:
+    BPWriteReadMetadataMerge() = default;
+};
+
+TEST_P(BPWriteReadMetadataMerge, ADIOS2BPWriteReadBlocks)
+{
+    const std::string radix = GetParam();
+    const std::string fname("BPWriteReadMetadataMerge_" + radix + ".bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 10;
+    const size_t NSteps = 3;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    // value i of the block of rank at step
+    auto lf_Value = [](const size_t step, const size_t rank,
+                       const size_t i) -> int32_t {
+        return static_cast<int32_t>(step * 10000 + rank * 100 + i);
+    };
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.SetParameter("MetadataMergeRadix", radix);
+
+        const size_t rank = static_cast<size_t>(mpiRank);
+        const size_t size = static_cast<size_t>(mpiSize);
+
+        auto var_global = io.DefineVariable<int32_t>("global", {size * Nx},
+                                                     {rank * Nx}, {Nx});
+        // only even ranks write it
+        auto var_even = io.DefineVariable<int32_t>("even", {size * Nx},
+                                                   {rank * Nx}, {Nx});
+        // rank r writes r + 1 elements
+        auto var_local = io.DefineVariable<int32_t>("local", {}, {},
+                                                    {rank + 1});
+        auto var_step = io.DefineVariable<uint64_t>("step");
+        io.DefineAttribute<std::string>("description", "metadata merge");
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        std::vector<int32_t> data(Nx);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                data[i] = lf_Value(step, rank, i);
+            }
+
+            bpWriter.BeginStep();
+            bpWriter.Put(var_global, data.data());
+            if (rank % 2 == 0)
+            {
+                bpWriter.Put(var_even, data.data());
+            }
+            bpWriter.Put(var_local, data.data());
+            if (rank == 0)
+            {
+                bpWriter.Put(var_step, static_cast<uint64_t>(step));
+            }
+            bpWriter.EndStep();
+        }
+
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        std::vector<int32_t> data;
+        size_t readSteps = 0;
+
+        while (bpReader.BeginStep() == adios2::StepStatus::OK)
+        {
+            const size_t step = bpReader.CurrentStep();
+
+            auto var_global = io.InquireVariable<int32_t>("global");
+            auto var_even = io.InquireVariable<int32_t>("even");
+            auto var_local = io.InquireVariable<int32_t>("local");
+            auto var_step = io.InquireVariable<uint64_t>("step");
+            ASSERT_TRUE(var_global);
+            ASSERT_TRUE(var_even);
+            ASSERT_TRUE(var_local);
+            ASSERT_TRUE(var_step);
+
+            // blocks come in the order of the writer ranks
+            const auto globalBlocks = bpReader.BlocksInfo(var_global, step);
+            ASSERT_EQ(globalBlocks.size(), static_cast<size_t>(mpiSize));
+            for (size_t b = 0; b < globalBlocks.size(); ++b)
+            {
+                EXPECT_EQ(globalBlocks[b].Start[0], b * Nx);
+                EXPECT_EQ(globalBlocks[b].Min, lf_Value(step, b, 0));
+                EXPECT_EQ(globalBlocks[b].Max, lf_Value(step, b, Nx - 1));
+            }
+
+            const auto evenBlocks = bpReader.BlocksInfo(var_even, step);
+            ASSERT_EQ(evenBlocks.size(),
+                      static_cast<size_t>((mpiSize + 1) / 2));
+            for (size_t b = 0; b < evenBlocks.size(); ++b)
+            {
+                EXPECT_EQ(evenBlocks[b].Start[0], 2 * b * Nx);
+            }
+
+            const auto localBlocks = bpReader.BlocksInfo(var_local, step);
+            ASSERT_EQ(localBlocks.size(), static_cast<size_t>(mpiSize));
+            for (size_t b = 0; b < localBlocks.size(); ++b)
+            {
+                ASSERT_EQ(localBlocks[b].Count[0], b + 1);
+                var_local.SetBlockSelection(b);
+                bpReader.Get(var_local, data, adios2::Mode::Sync);
+                ASSERT_EQ(data.size(), b + 1);
+                for (size_t i = 0; i < b + 1; ++i)
+                {
+                    EXPECT_EQ(data[i], lf_Value(step, b, i));
+                }
+            }
+
+            bpReader.Get(var_global, data, adios2::Mode::Sync);
+            ASSERT_EQ(data.size(), mpiSize * Nx);
+            for (size_t i = 0; i < data.size(); ++i)
+            {
+                EXPECT_EQ(data[i], lf_Value(step, i / Nx, i % Nx));
+            }
+
+            uint64_t stepValue = 0;
+            bpReader.Get(var_step, stepValue, adios2::Mode::Sync);
+            EXPECT_EQ(stepValue, step);
+
+            auto attr = io.InquireAttribute<std::string>("description");
+            ASSERT_TRUE(attr);
+            ASSERT_EQ(attr.Data().size(), 1);
+            EXPECT_EQ(attr.Data().front(), "metadata merge");
+
+            bpReader.EndStep();
+            ++readSteps;
+        }
+
+        EXPECT_EQ(readSteps, NSteps);
+        bpReader.Close();
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(Radix, BPWriteReadMetadataMerge,
+                        ::testing::Values("0", "2", "3"));
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+
+    result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
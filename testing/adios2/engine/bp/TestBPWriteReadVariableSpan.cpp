@@ -2,6 +2,7 @@
  * Distributed under the OSI-approved Apache License, Version 2.0.  See
  * accompanying file Copyright.txt for details.
  */
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 
@@ -52,10 +53,10 @@ TEST_F(BPWriteReadSpan, BPWriteRead1D8)
     {
         adios2::IO io = adios.DeclareIO("TestIO");
 
-        //        if (!engineName.empty())
-        //        {
-        //            io.SetEngine(engineName);
-        //        }
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
 
         const adios2::Dims shape{static_cast<size_t>(Nx * mpiSize)};
         const adios2::Dims start{static_cast<size_t>(Nx * mpiRank)};
@@ -140,7 +141,6 @@ TEST_F(BPWriteReadSpan, BPWriteRead1D8)
                 cr64Span.at(i) = currentTestData.CR64[i];
             }
 
-            // TODO: update min/max for spans
             bpWriter.EndStep();
         }
 
@@ -150,10 +150,10 @@ TEST_F(BPWriteReadSpan, BPWriteRead1D8)
     {
         adios2::IO io = adios.DeclareIO("ReadIO");
 
-        //        if (!engineName.empty())
-        //        {
-        //            io.SetEngine(engineName);
-        //        }
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
 
         adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
 
@@ -281,6 +281,22 @@ TEST_F(BPWriteReadSpan, BPWriteRead1D8)
             bpReader.Get(var_cr32, CR32.data());
             bpReader.Get(var_cr64, CR64.data());
 
+            // min/max are computed from the populated spans
+            const auto i32Blocks = bpReader.BlocksInfo(var_i32, currentStep);
+            const auto r64Blocks = bpReader.BlocksInfo(var_r64, currentStep);
+            ASSERT_EQ(i32Blocks.size(), static_cast<size_t>(mpiSize));
+            ASSERT_EQ(r64Blocks.size(), static_cast<size_t>(mpiSize));
+            const auto i32MinMax =
+                std::minmax_element(currentTestData.I32.begin(),
+                                    currentTestData.I32.begin() + Nx);
+            const auto r64MinMax =
+                std::minmax_element(currentTestData.R64.begin(),
+                                    currentTestData.R64.begin() + Nx);
+            EXPECT_EQ(i32Blocks[mpiRank].Min, *i32MinMax.first);
+            EXPECT_EQ(i32Blocks[mpiRank].Max, *i32MinMax.second);
+            EXPECT_EQ(r64Blocks[mpiRank].Min, *r64MinMax.first);
+            EXPECT_EQ(r64Blocks[mpiRank].Max, *r64MinMax.second);
+
             bpReader.EndStep();
 
             EXPECT_EQ(IStep, currentStep);
@@ -379,15 +395,10 @@ TEST_F(BPWriteReadSpan, BPWriteRead2D2x4)
         auto var_cr64 = io.DefineVariable<std::complex<double>>(
             "cr64", shape, start, count, adios2::ConstantDims);
 
-        //        if (!engineName.empty())
-        //        {
-        //            io.SetEngine(engineName);
-        //        }
-        //        else
-        //        {
-        //            // Create the BP Engine
-        //            io.SetEngine("BPFile");
-        //        }
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
 
         adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
 
@@ -456,10 +467,10 @@ TEST_F(BPWriteReadSpan, BPWriteRead2D2x4)
     {
         adios2::IO io = adios.DeclareIO("ReadIO");
 
-        //        if (!engineName.empty())
-        //        {
-        //            io.SetEngine(engineName);
-        //        }
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
 
         adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
 
@@ -661,10 +672,10 @@ TEST_F(BPWriteReadSpan, BPWriteRead1D8Local)
     {
         adios2::IO io = adios.DeclareIO("TestIO");
 
-        //        if (!engineName.empty())
-        //        {
-        //            io.SetEngine(engineName);
-        //        }
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
 
         const adios2::Dims shape{};
         const adios2::Dims start{};
@@ -756,10 +767,10 @@ TEST_F(BPWriteReadSpan, BPWriteRead1D8Local)
     {
         adios2::IO io = adios.DeclareIO("ReadIO");
 
-        //        if (!engineName.empty())
-        //        {
-        //            io.SetEngine(engineName);
-        //        }
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
 
         adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
 
@@ -959,15 +970,10 @@ TEST_F(BPWriteReadSpan, BPWriteRead2D2x4Local)
         auto var_cr64 = io.DefineVariable<std::complex<double>>(
             "cr64", shape, start, count, adios2::ConstantDims);
 
-        //        if (!engineName.empty())
-        //        {
-        //            io.SetEngine(engineName);
-        //        }
-        //        else
-        //        {
-        //            // Create the BP Engine
-        //            io.SetEngine("BPFile");
-        //        }
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
 
         adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
 
@@ -1036,10 +1042,10 @@ TEST_F(BPWriteReadSpan, BPWriteRead2D2x4Local)
     {
         adios2::IO io = adios.DeclareIO("ReadIO");
 
-        //        if (!engineName.empty())
-        //        {
-        //            io.SetEngine(engineName);
-        //        }
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
 
         adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
 
@@ -1212,10 +1218,10 @@ TEST_F(BPWriteReadSpan, BPWriteRead1D8FillValue)
     {
         adios2::IO io = adios.DeclareIO("TestIO");
 
-        //        if (!engineName.empty())
-        //        {
-        //            io.SetEngine(engineName);
-        //        }
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
 
         const adios2::Dims shape{static_cast<size_t>(Nx * mpiSize)};
         const adios2::Dims start{static_cast<size_t>(Nx * mpiRank)};
@@ -1296,10 +1302,10 @@ TEST_F(BPWriteReadSpan, BPWriteRead1D8FillValue)
     {
         adios2::IO io = adios.DeclareIO("ReadIO");
 
-        //        if (!engineName.empty())
-        //        {
-        //            io.SetEngine(engineName);
-        //        }
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
 
         adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
 
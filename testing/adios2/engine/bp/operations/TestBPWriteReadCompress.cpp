@@ -0,0 +1,628 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * TestBPWriteReadCompress.cpp : built-in lossless "compress" operator, also
+ * with blocks in chunks and followed by other operations
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+class BPWriteReadCompress : public ::testing::TestWithParam<std::string>
+{
+public:
+    BPWriteReadCompress() = default;
+};
+
+TEST_P(BPWriteReadCompress, ADIOS2BPWriteReadCompress1D)
+{
+    const std::string shuffle = GetParam();
+    const std::string fname("BPWriteReadCompress1D_" + shuffle + ".bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 10000;
+    const size_t NSteps = 3;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    // mesh connectivity-like, slowly varying
+    auto lf_I32 = [](const size_t step, const size_t i) -> int32_t {
+        return static_cast<int32_t>(step * 100 + i / 4);
+    };
+    auto lf_R64 = [](const size_t step, const size_t i) -> double {
+        return static_cast<double>(step) + 0.5 * static_cast<double>(i % 64);
+    };
+    // incompressible, stored as is
+    auto lf_U8 = [](const size_t step, const size_t rank) {
+        std::vector<uint8_t> u8(Nx);
+        std::mt19937 generator(static_cast<unsigned int>(step * 1000 + rank));
+        for (auto &value : u8)
+        {
+            value = static_cast<uint8_t>(generator());
+        }
+        return u8;
+    };
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        const adios2::Dims shape{static_cast<size_t>(Nx * mpiSize)};
+        const adios2::Dims start{static_cast<size_t>(Nx * mpiRank)};
+        const adios2::Dims count{Nx};
+
+        auto var_i32 = io.DefineVariable<int32_t>("i32", shape, start, count);
+        auto var_r64 = io.DefineVariable<double>("r64", shape, start, count);
+        auto var_u8 = io.DefineVariable<uint8_t>("u8", shape, start, count);
+
+        adios2::Operator op =
+            adios.DefineOperator("lossless", "compress", {{"Shuffle", "none"}});
+        var_i32.AddOperation(op, {{"Shuffle", shuffle}});
+        var_r64.AddOperation(op, {{"Shuffle", shuffle}});
+        var_u8.AddOperation(op);
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        std::vector<int32_t> i32(Nx);
+        std::vector<double> r64(Nx);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                i32[i] = lf_I32(step, Nx * mpiRank + i);
+                r64[i] = lf_R64(step, Nx * mpiRank + i);
+            }
+            const std::vector<uint8_t> u8 = lf_U8(step, mpiRank);
+
+            bpWriter.BeginStep();
+            bpWriter.Put(var_i32, i32.data());
+            bpWriter.Put(var_r64, r64.data());
+            bpWriter.Put(var_u8, u8.data());
+            bpWriter.EndStep();
+        }
+        bpWriter.Close();
+    }
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+
+    if (mpiRank == 0 && mpiSize == 1 && engineName == "BP4")
+    {
+        // i32 and r64 shrink, u8 can't
+        std::ifstream data(fname + "/data.0",
+                           std::ios_base::binary | std::ios_base::ate);
+        ASSERT_TRUE(data.good());
+        const size_t rawSize = NSteps * Nx * (sizeof(int32_t) + sizeof(double));
+        EXPECT_LT(static_cast<size_t>(data.tellg()), rawSize / 2);
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        std::vector<int32_t> i32;
+        std::vector<double> r64;
+        std::vector<uint8_t> u8;
+        size_t readSteps = 0;
+
+        while (bpReader.BeginStep() == adios2::StepStatus::OK)
+        {
+            const size_t step = bpReader.CurrentStep();
+
+            auto var_i32 = io.InquireVariable<int32_t>("i32");
+            auto var_r64 = io.InquireVariable<double>("r64");
+            auto var_u8 = io.InquireVariable<uint8_t>("u8");
+            ASSERT_TRUE(var_i32);
+            ASSERT_TRUE(var_r64);
+            ASSERT_TRUE(var_u8);
+
+            // straddles two blocks when mpiSize > 1
+            const size_t start = Nx * mpiRank + Nx / 3;
+            const size_t count = (mpiRank + 1 < mpiSize) ? Nx : Nx - Nx / 3;
+            var_i32.SetSelection({{start}, {count}});
+            var_r64.SetSelection({{start}, {count}});
+            var_u8.SetSelection({{Nx * mpiRank}, {Nx}});
+
+            bpReader.Get(var_i32, i32);
+            bpReader.Get(var_r64, r64);
+            bpReader.Get(var_u8, u8);
+            bpReader.EndStep();
+
+            ASSERT_EQ(i32.size(), count);
+            ASSERT_EQ(r64.size(), count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                ASSERT_EQ(i32[i], lf_I32(step, start + i));
+                ASSERT_EQ(r64[i], lf_R64(step, start + i));
+            }
+            EXPECT_EQ(u8, lf_U8(step, mpiRank));
+            ++readSteps;
+        }
+
+        EXPECT_EQ(readSteps, NSteps);
+        bpReader.Close();
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(Shuffle, BPWriteReadCompress,
+                        ::testing::Values("byte", "none"));
+
+class BPWriteReadCompressChunks : public ::testing::TestWithParam<std::string>
+{
+public:
+    BPWriteReadCompressChunks() = default;
+};
+
+TEST_P(BPWriteReadCompressChunks, ADIOS2BPWriteReadCompress2D)
+{
+    const std::string threads = GetParam();
+    const std::string fname("BPWriteReadCompressChunks2D_" + threads + ".bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Ny = 100;
+    const size_t Nx = 250;
+    const size_t NSteps = 2;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    auto lf_Value = [](const size_t step, const size_t y,
+                       const size_t x) -> double {
+        return static_cast<double>(step * 1000000 + y * 1000 + x % 8);
+    };
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.SetParameter("Threads", threads);
+
+        const adios2::Dims shape{static_cast<size_t>(Ny * mpiSize), Nx};
+        const adios2::Dims start{static_cast<size_t>(Ny * mpiRank), 0};
+        const adios2::Dims count{Ny, Nx};
+
+        auto var_r64 = io.DefineVariable<double>("r64", shape, start, count);
+        auto var_local = io.DefineVariable<double>("local", {}, {}, count);
+
+        // 7 rows per chunk, 15 chunks per block
+        adios2::Operator op = adios.DefineOperator(
+            "lossless", "compress",
+            {{"ChunkSize", std::to_string(7 * Nx * sizeof(double))}});
+        var_r64.AddOperation(op);
+        var_local.AddOperation(op);
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        std::vector<double> r64(Ny * Nx);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            for (size_t y = 0; y < Ny; ++y)
+            {
+                for (size_t x = 0; x < Nx; ++x)
+                {
+                    r64[y * Nx + x] = lf_Value(step, Ny * mpiRank + y, x);
+                }
+            }
+
+            bpWriter.BeginStep();
+            bpWriter.Put(var_r64, r64.data());
+            bpWriter.Put(var_local, r64.data());
+            bpWriter.EndStep();
+        }
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.SetParameter("Threads", threads);
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        std::vector<double> r64;
+        std::vector<double> local;
+        size_t readSteps = 0;
+
+        while (bpReader.BeginStep() == adios2::StepStatus::OK)
+        {
+            const size_t step = bpReader.CurrentStep();
+
+            auto var_r64 = io.InquireVariable<double>("r64");
+            auto var_local = io.InquireVariable<double>("local");
+            ASSERT_TRUE(var_r64);
+            ASSERT_TRUE(var_local);
+
+            // a few chunks of one or two blocks
+            const adios2::Dims start{Ny * mpiRank + 33, 10};
+            const adios2::Dims count{(mpiRank + 1 < mpiSize) ? Ny : Ny - 40,
+                                     Nx - 20};
+            var_r64.SetSelection({start, count});
+
+            // the last chunk is shorter
+            const size_t blockID = static_cast<size_t>(mpiRank);
+            var_local.SetBlockSelection(blockID);
+            var_local.SetSelection({{95, 0}, {Ny - 95, Nx}});
+
+            bpReader.Get(var_r64, r64);
+            bpReader.Get(var_local, local);
+            bpReader.EndStep();
+
+            ASSERT_EQ(r64.size(), count[0] * count[1]);
+            for (size_t y = 0; y < count[0]; ++y)
+            {
+                for (size_t x = 0; x < count[1]; ++x)
+                {
+                    ASSERT_EQ(r64[y * count[1] + x],
+                              lf_Value(step, start[0] + y, start[1] + x));
+                }
+            }
+
+            ASSERT_EQ(local.size(), (Ny - 95) * Nx);
+            for (size_t y = 0; y < Ny - 95; ++y)
+            {
+                for (size_t x = 0; x < Nx; ++x)
+                {
+                    ASSERT_EQ(local[y * Nx + x],
+                              lf_Value(step, Ny * blockID + 95 + y, x));
+                }
+            }
+            ++readSteps;
+        }
+
+        EXPECT_EQ(readSteps, NSteps);
+        bpReader.Close();
+    }
+}
+
+TEST_P(BPWriteReadCompressChunks, ADIOS2BPWriteReadEmptyRows2D)
+{
+    const std::string threads = GetParam();
+    const std::string fname("BPWriteReadCompressEmptyRows2D_" + threads +
+                            ".bp");
+
+    int mpiRank = 0;
+    const size_t Ny = 16;
+    const size_t Nx = 8;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    // 2 rows per chunk, rows of the empty block are 0 bytes
+    adios2::Operator op = adios.DefineOperator(
+        "lossless", "compress",
+        {{"ChunkSize", std::to_string(2 * Nx * sizeof(double))}});
+
+    std::vector<double> r64(Ny * Nx);
+    for (size_t i = 0; i < r64.size(); ++i)
+    {
+        r64[i] = static_cast<double>(mpiRank * 1000 + i);
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.SetParameter("Threads", threads);
+
+        auto var_r64 = io.DefineVariable<double>("r64", {}, {}, {Ny, Nx});
+        auto var_empty = io.DefineVariable<double>("empty", {}, {}, {Ny, 0});
+        var_r64.AddOperation(op);
+        var_empty.AddOperation(op);
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+        bpWriter.BeginStep();
+        bpWriter.Put(var_empty, r64.data());
+        bpWriter.Put(var_r64, r64.data());
+        bpWriter.EndStep();
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        io.SetParameter("Threads", threads);
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+        ASSERT_EQ(bpReader.BeginStep(), adios2::StepStatus::OK);
+
+        auto var_r64 = io.InquireVariable<double>("r64");
+        ASSERT_TRUE(var_r64);
+        var_r64.SetBlockSelection(static_cast<size_t>(mpiRank));
+
+        std::vector<double> in;
+        bpReader.Get(var_r64, in, adios2::Mode::Sync);
+        EXPECT_EQ(in, r64);
+        bpReader.EndStep();
+        bpReader.Close();
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(Threads, BPWriteReadCompressChunks,
+                        ::testing::Values("1", "4"));
+
+class BPWriteReadCompressPipeline : public ::testing::TestWithParam<std::string>
+{
+public:
+    BPWriteReadCompressPipeline() = default;
+};
+
+TEST_P(BPWriteReadCompressPipeline, ADIOS2BPWriteReadPipeline2D)
+{
+    const std::string next = GetParam();
+    const std::string fname("BPWriteReadCompressPipeline2D_" + next + ".bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Ny = 60;
+    const size_t Nx = 100;
+    const size_t NSteps = 2;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    auto lf_Value = [](const size_t step, const size_t y,
+                       const size_t x) -> double {
+        return static_cast<double>(step * 1000000 + y * 1000 + x % 8);
+    };
+    // incompressible, the last operation gets more bytes than the block
+    auto lf_U8 = [](const size_t step, const size_t rank) {
+        std::vector<uint8_t> u8(Ny * Nx);
+        std::mt19937 generator(static_cast<unsigned int>(step * 1000 + rank));
+        for (auto &value : u8)
+        {
+            value = static_cast<uint8_t>(generator());
+        }
+        return u8;
+    };
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        const adios2::Dims shape{static_cast<size_t>(Ny * mpiSize), Nx};
+        const adios2::Dims start{static_cast<size_t>(Ny * mpiRank), 0};
+        const adios2::Dims count{Ny, Nx};
+
+        auto var_r64 = io.DefineVariable<double>("r64", shape, start, count);
+        auto var_u8 = io.DefineVariable<uint8_t>("u8", shape, start, count);
+
+        // chunks of 8 rows, then the whole block through next
+        adios2::Operator compress = adios.DefineOperator(
+            "lossless", "compress",
+            {{"ChunkSize", std::to_string(8 * Nx * sizeof(double))}});
+        adios2::Operator nextOp = (next == "compress")
+                                      ? compress
+                                      : adios.DefineOperator("next", next);
+        var_r64.AddOperation(compress);
+        var_r64.AddOperation(nextOp);
+        var_u8.AddOperation(compress);
+        var_u8.AddOperation(nextOp);
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+
+        std::vector<double> r64(Ny * Nx);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            for (size_t y = 0; y < Ny; ++y)
+            {
+                for (size_t x = 0; x < Nx; ++x)
+                {
+                    r64[y * Nx + x] = lf_Value(step, Ny * mpiRank + y, x);
+                }
+            }
+            const std::vector<uint8_t> u8 = lf_U8(step, mpiRank);
+
+            bpWriter.BeginStep();
+            bpWriter.Put(var_r64, r64.data());
+            bpWriter.Put(var_u8, u8.data());
+            bpWriter.EndStep();
+        }
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        std::vector<double> r64;
+        std::vector<uint8_t> u8;
+        size_t readSteps = 0;
+
+        while (bpReader.BeginStep() == adios2::StepStatus::OK)
+        {
+            const size_t step = bpReader.CurrentStep();
+
+            auto var_r64 = io.InquireVariable<double>("r64");
+            auto var_u8 = io.InquireVariable<uint8_t>("u8");
+            ASSERT_TRUE(var_r64);
+            ASSERT_TRUE(var_u8);
+
+            const adios2::Dims start{Ny * mpiRank + 21, 5};
+            const adios2::Dims count{(mpiRank + 1 < mpiSize) ? Ny : Ny - 30,
+                                     Nx - 10};
+            var_r64.SetSelection({start, count});
+            var_u8.SetSelection({{Ny * mpiRank, 0}, {Ny, Nx}});
+
+            bpReader.Get(var_r64, r64);
+            bpReader.Get(var_u8, u8);
+            bpReader.EndStep();
+
+            ASSERT_EQ(r64.size(), count[0] * count[1]);
+            for (size_t y = 0; y < count[0]; ++y)
+            {
+                for (size_t x = 0; x < count[1]; ++x)
+                {
+                    ASSERT_EQ(r64[y * count[1] + x],
+                              lf_Value(step, start[0] + y, start[1] + x));
+                }
+            }
+            EXPECT_EQ(u8, lf_U8(step, mpiRank));
+            ++readSteps;
+        }
+
+        EXPECT_EQ(readSteps, NSteps);
+        bpReader.Close();
+    }
+}
+
+#ifdef ADIOS2_HAVE_BZIP2
+INSTANTIATE_TEST_CASE_P(Next, BPWriteReadCompressPipeline,
+                        ::testing::Values("compress", "bzip2"));
+#else
+INSTANTIATE_TEST_CASE_P(Next, BPWriteReadCompressPipeline,
+                        ::testing::Values("compress"));
+#endif
+
+#ifdef ADIOS2_HAVE_BZIP2
+TEST(BPWriteReadBZip2, ADIOS2BPWriteReadIncompressible1D)
+{
+    // bzip2 output of random data is larger than its input, the buffer must
+    // reserve its maximum size also for a single operation
+    const std::string fname("BPWriteReadBZip2Incompressible1D.bp");
+
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 1024 * 1024;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    std::vector<uint64_t> u64(Nx);
+    std::mt19937_64 generator(static_cast<uint64_t>(mpiRank));
+    for (auto &value : u64)
+    {
+        value = generator();
+    }
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        const adios2::Dims shape{static_cast<size_t>(Nx * mpiSize)};
+        const adios2::Dims start{static_cast<size_t>(Nx * mpiRank)};
+        const adios2::Dims count{Nx};
+
+        auto var_u64 = io.DefineVariable<uint64_t>("u64", shape, start, count);
+        var_u64.AddOperation(adios.DefineOperator("bzip2", "bzip2"));
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+        bpWriter.BeginStep();
+        bpWriter.Put(var_u64, u64.data());
+        bpWriter.EndStep();
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+        auto var_u64 = io.InquireVariable<uint64_t>("u64");
+        ASSERT_TRUE(var_u64);
+        var_u64.SetSelection({{Nx * mpiRank}, {Nx}});
+
+        std::vector<uint64_t> data;
+        bpReader.Get(var_u64, data, adios2::Mode::Sync);
+        bpReader.Close();
+
+        EXPECT_EQ(data, u64);
+    }
+}
+#endif
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+
+    result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
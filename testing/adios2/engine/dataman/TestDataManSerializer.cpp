@@ -0,0 +1,153 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * TestDataManSerializer.cpp : DataMan packs decoded without a transport,
+ * binary metadata must reject truncated or forged packs
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include "adios2/toolkit/format/dataman/DataManSerializer.h"
+#include "adios2/toolkit/format/dataman/DataManSerializer.tcc"
+
+#include <gtest/gtest.h>
+
+using adios2::format::DataManSerializer;
+using adios2::format::VecPtr;
+
+class DataManSerializerTest : public ::testing::TestWithParam<std::string>
+{
+public:
+    DataManSerializerTest() = default;
+};
+
+namespace
+{
+
+const size_t Nx = 10;
+const size_t NVars = 3;
+
+VecPtr WritePack(const std::string &method, const size_t step)
+{
+    DataManSerializer writer(true, true, true, MPI_COMM_WORLD, method);
+    writer.New(1024);
+    for (size_t v = 0; v < NVars; ++v)
+    {
+        std::vector<double> data(Nx);
+        for (size_t i = 0; i < Nx; ++i)
+        {
+            data[i] = static_cast<double>(step * 1000 + v * 100 + i);
+        }
+        writer.PutVar(data.data(), "var" + std::to_string(v), {NVars * Nx},
+                      {v * Nx}, {Nx}, {}, {}, "", step, 0, "",
+                      adios2::Params());
+    }
+    return writer.GetLocalPack();
+}
+
+// pack with the metadata starting at a fixed offset past the control
+// signal size
+VecPtr MetadataPack(const std::vector<char> &metadata)
+{
+    const size_t position = 128;
+    auto pack = std::make_shared<std::vector<char>>(
+        position + metadata.size(), '\0');
+    std::memcpy(pack->data() + position, metadata.data(), metadata.size());
+    reinterpret_cast<uint64_t *>(pack->data())[0] = position;
+    reinterpret_cast<uint64_t *>(pack->data())[1] = metadata.size();
+    return pack;
+}
+
+} // end empty namespace
+
+TEST_P(DataManSerializerTest, RoundTrip)
+{
+    const std::string method = GetParam();
+    const size_t step = 5;
+
+    DataManSerializer reader(true, true, true, MPI_COMM_WORLD, method);
+    ASSERT_EQ(reader.PutPack(WritePack(method, step)), 0);
+
+    auto vars = reader.GetMetaData(step);
+    ASSERT_NE(vars, nullptr);
+    ASSERT_EQ(vars->size(), NVars);
+
+    for (size_t v = 0; v < NVars; ++v)
+    {
+        const std::string name = "var" + std::to_string(v);
+        const auto &var = (*vars)[v];
+        EXPECT_EQ(var.name, name);
+        EXPECT_EQ(var.type, "double");
+        EXPECT_EQ(var.shape, adios2::Dims({NVars * Nx}));
+        EXPECT_EQ(var.start, adios2::Dims({v * Nx}));
+        EXPECT_EQ(var.count, adios2::Dims({Nx}));
+
+        std::vector<double> data(Nx);
+        ASSERT_EQ(reader.GetVar(data.data(), name, {v * Nx}, {Nx}, step), 0);
+        for (size_t i = 0; i < Nx; ++i)
+        {
+            EXPECT_EQ(data[i], static_cast<double>(step * 1000 + v * 100 + i));
+        }
+    }
+}
+
+TEST(DataManSerializerBinary, Truncated)
+{
+    const VecPtr pack = WritePack("binary", 0);
+    const uint64_t position = reinterpret_cast<uint64_t *>(pack->data())[0];
+    const uint64_t metadataSize = reinterpret_cast<uint64_t *>(pack->data())[1];
+
+    // every cut after the magic bytes
+    for (uint64_t size = 4; size < metadataSize; ++size)
+    {
+        auto truncated = std::make_shared<std::vector<char>>(
+            pack->begin(), pack->begin() + position + size);
+        reinterpret_cast<uint64_t *>(truncated->data())[1] = size;
+
+        DataManSerializer reader(true, true, true, MPI_COMM_WORLD, "binary");
+        EXPECT_THROW(reader.PutPack(truncated), std::runtime_error);
+        EXPECT_EQ(reader.Steps(), 0u);
+    }
+}
+
+TEST(DataManSerializerBinary, ForgedCounts)
+{
+    const std::vector<char> magic = {'D', 'M', 'B', 1};
+    // 2^56 - 1
+    const std::vector<char> huge = {'\xff', '\xff', '\xff', '\xff',
+                                    '\xff', '\xff', '\xff', '\x7f'};
+
+    // strings
+    std::vector<char> metadata = magic;
+    metadata.insert(metadata.end(), huge.begin(), huge.end());
+    DataManSerializer stringsReader(true, true, true, MPI_COMM_WORLD,
+                                    "binary");
+    EXPECT_THROW(stringsReader.PutPack(MetadataPack(metadata)),
+                 std::runtime_error);
+
+    // variables, after an empty string table
+    metadata = magic;
+    metadata.push_back('\0');
+    metadata.insert(metadata.end(), huge.begin(), huge.end());
+    DataManSerializer varsReader(true, true, true, MPI_COMM_WORLD, "binary");
+    EXPECT_THROW(varsReader.PutPack(MetadataPack(metadata)),
+                 std::runtime_error);
+}
+
+INSTANTIATE_TEST_CASE_P(MetadataSerialization, DataManSerializerTest,
+                        ::testing::Values("string", "msgpack", "binary"));
+
+int main(int argc, char **argv)
+{
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleTest(&argc, argv);
+    int result = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return result;
+}
@@ -3137,6 +3137,135 @@ TEST_F(HDF5WriteReadTest, /*DISABLE_*/ ATTRTESTADIOS2vsHDF5)
     }
 }
 
+// ADIOS2 write with automatic chunking, native HDF5 layout check, ADIOS2 read
+TEST_F(HDF5WriteReadTest, ADIOS2HDF5WriteAutoChunk2D)
+{
+    const std::string fname = "ADIOS2HDF5WriteAutoChunk2D.h5";
+
+    int mpiRank = 0, mpiSize = 1;
+    // Number of rows and columns of the block of each rank
+    const std::size_t Nx = 16;
+    const std::size_t Ny = 64;
+    const std::size_t NSteps = 2;
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD, adios2::DebugON);
+#else
+    adios2::ADIOS adios(true);
+#endif
+
+    const adios2::Dims shape{mpiSize * Nx, Ny};
+    const adios2::Dims start{mpiRank * Nx, 0};
+    const adios2::Dims count{Nx, Ny};
+
+    std::vector<double> r64(Nx * Ny);
+    std::vector<float> r32(Nx * Ny);
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+        io.SetEngine("HDF5");
+        // 16 x 64 doubles are 8 KiB per rank, so chunks of at most 4 KiB
+        // are expected to split the rows in half
+        io.SetParameters({{"H5ChunkDim", "auto"},
+                          {"H5ChunkBytes", "4096"},
+                          {"H5ChunkVars", "r64"},
+                          {"H5Alignment", "4096"},
+                          {"H5MetaBlockSize", "65536"}});
+
+        auto var_r64 = io.DefineVariable<double>("r64", shape, start, count);
+        auto var_r32 = io.DefineVariable<float>("r32", shape, start, count);
+
+        adios2::Engine engine = io.Open(fname, adios2::Mode::Write);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            for (size_t i = 0; i < r64.size(); ++i)
+            {
+                r64[i] = static_cast<double>(step * 1000000 +
+                                             mpiRank * Nx * Ny + i);
+                r32[i] = static_cast<float>(r64[i]);
+            }
+            engine.BeginStep();
+            engine.Put(var_r64, r64.data());
+            engine.Put(var_r32, r32.data());
+            engine.EndStep();
+        }
+        engine.Close();
+    }
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+
+    // only the variable listed in H5ChunkVars is chunked
+    {
+        hid_t fileId = H5Fopen(fname.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+        ASSERT_GE(fileId, 0);
+
+        hid_t dsetId = H5Dopen(fileId, "/Step0/r64", H5P_DEFAULT);
+        ASSERT_GE(dsetId, 0);
+        hid_t plistId = H5Dget_create_plist(dsetId);
+        ASSERT_EQ(H5Pget_layout(plistId), H5D_CHUNKED);
+        hsize_t chunk[2];
+        ASSERT_EQ(H5Pget_chunk(plistId, 2, chunk), 2);
+        // chunks follow the block of each rank, so no chunk spans two ranks
+        EXPECT_EQ(chunk[0], Nx / 2);
+        EXPECT_EQ(Nx % chunk[0], 0);
+        EXPECT_EQ(chunk[1], Ny);
+        H5Pclose(plistId);
+        H5Dclose(dsetId);
+
+        dsetId = H5Dopen(fileId, "/Step0/r32", H5P_DEFAULT);
+        ASSERT_GE(dsetId, 0);
+        plistId = H5Dget_create_plist(dsetId);
+        EXPECT_EQ(H5Pget_layout(plistId), H5D_CONTIGUOUS);
+        H5Pclose(plistId);
+        H5Dclose(dsetId);
+
+        H5Fclose(fileId);
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("HDF5ReadIO");
+        io.SetEngine("HDF5");
+        adios2::Engine engine = io.Open(fname, adios2::Mode::Read);
+
+        auto var_r64 = io.InquireVariable<double>("r64");
+        EXPECT_TRUE(var_r64);
+        ASSERT_EQ(var_r64.Steps(), NSteps);
+        ASSERT_EQ(var_r64.Shape(), shape);
+        auto var_r32 = io.InquireVariable<float>("r32");
+        EXPECT_TRUE(var_r32);
+
+        var_r64.SetSelection({start, count});
+        var_r32.SetSelection({start, count});
+
+        std::vector<double> in64(Nx * Ny);
+        std::vector<float> in32(Nx * Ny);
+        for (size_t t = 0; t < NSteps; ++t)
+        {
+            var_r64.SetStepSelection({t, 1});
+            var_r32.SetStepSelection({t, 1});
+            engine.BeginStep();
+            engine.Get(var_r64, in64.data());
+            engine.Get(var_r32, in32.data());
+            engine.EndStep();
+            for (size_t i = 0; i < in64.size(); ++i)
+            {
+                const double expected = static_cast<double>(
+                    t * 1000000 + mpiRank * Nx * Ny + i);
+                ASSERT_EQ(in64[i], expected) << "t=" << t << " i=" << i;
+                ASSERT_EQ(in32[i], static_cast<float>(expected))
+                    << "t=" << t << " i=" << i;
+            }
+        }
+        engine.Close();
+    }
+}
+
 //******************************************************************************
 // main
 //******************************************************************************
@@ -0,0 +1,75 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * TestSstWriterStats.cpp : writer queue statistics of the SST engine
+ */
+#include <cstdint>
+
+#include <iostream>
+#include <stdexcept>
+
+#include "adios2/core/ADIOS.h"
+#include "adios2/core/IO.h"
+#include "adios2/engine/sst/SstWriter.h"
+
+#include <gtest/gtest.h>
+
+TEST(SstWriterStats, StepsProvided)
+{
+    const size_t NSteps = 5;
+
+#ifdef ADIOS2_HAVE_MPI
+    adios2::core::ADIOS adios(MPI_COMM_WORLD, true, "C++");
+#else
+    adios2::core::ADIOS adios(true, "C++");
+#endif
+    adios2::core::IO &io = adios.DeclareIO("TestIO");
+    io.SetEngine("Sst");
+    io.SetParameters({{"RendezvousReaderCount", "0"},
+                      {"QueueLimit", "2"},
+                      {"QueueFullPolicy", "Discard"}});
+
+    auto &var_r64 = io.DefineVariable<double>("r64");
+
+    adios2::core::Engine &engine =
+        io.Open("ADIOS2SstWriterStats", adios2::Mode::Write);
+    auto *writer = dynamic_cast<adios2::core::engine::SstWriter *>(&engine);
+    ASSERT_NE(writer, nullptr);
+
+    struct _SstStats stats = writer->GetStats();
+    EXPECT_EQ(stats.TimestepsProvided, 0u);
+
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        engine.BeginStep(adios2::StepMode::Append, -1.0);
+        engine.Put(var_r64, static_cast<double>(step), adios2::Mode::Sync);
+        engine.EndStep();
+    }
+
+    stats = writer->GetStats();
+    EXPECT_EQ(stats.TimestepsProvided, NSteps);
+    // without readers no step waits in the queue
+    EXPECT_EQ(stats.TimestepsDiscarded, 0u);
+    EXPECT_GE(stats.WriterStallSecs, 0.0);
+    EXPECT_GE(stats.ValidTimeSecs, 0.0);
+    EXPECT_EQ(stats.SlowestReaderStepsPerSec, 0.0);
+
+    engine.Close();
+}
+
+int main(int argc, char **argv)
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(nullptr, nullptr);
+#endif
+
+    ::testing::InitGoogleTest(&argc, argv);
+    int result = RUN_ALL_TESTS();
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -34,6 +34,7 @@ int Latest = 0;
 int Discard = 0;
 int BeginStepFailedPolls = 0;
 int SkippedSteps = 0;
+size_t MaxSkippedRun = 0; // largest allowed gap in discarded steps, 0 is any
 int DelayMS = 500;
 int LongFirstDelay = 0;
 // Number of steps
@@ -178,6 +179,10 @@ TEST_F(SstReadTest, ADIOS2SstRead)
                 (ExpectedStep != currentStep))
             {
                 SkippedSteps++;
+                if (MaxSkippedRun)
+                {
+                    EXPECT_LE(currentStep - ExpectedStep, MaxSkippedRun);
+                }
             }
             ExpectedStep = currentStep; // starting out
         }
@@ -441,6 +446,14 @@ int main(int argc, char **argv)
             IncreasingDelay = 1;
             Discard = 1;
         }
+        else if (std::string(argv[1]) == "--max_skip")
+        {
+            std::istringstream ss(argv[2]);
+            if (!(ss >> MaxSkippedRun))
+                std::cerr << "Invalid number for max_skip " << argv[1] << '\n';
+            argv++;
+            argc--;
+        }
         else if (std::string(argv[1]) == "--precious_first")
         {
             FirstTimestepMustBeZero = 1;
@@ -107,7 +107,7 @@ public:
     const std::string streamName = "TestStream";
 
     void MainWriters(MPI_Comm comm, size_t npx, size_t npy, int steps,
-                     unsigned int sleeptime)
+                     unsigned int sleeptime, bool lockDefinitions)
     {
         int rank, nproc;
         MPI_Comm_rank(comm, &rank);
@@ -125,7 +125,10 @@ public:
         size_t offsx = posx * ndx;
         size_t offsy = posy * ndy;
 
-        std::vector<float> myArray(ndx * ndy);
+        // alternate between two buffers so that engines caching the user
+        // pointer across steps have to notice the change
+        std::vector<float> myArrays[2] = {std::vector<float>(ndx * ndy),
+                                          std::vector<float>(ndx * ndy)};
 
         adios2::ADIOS adios(comm);
         adios2::IO io = adios.DeclareIO("writer");
@@ -139,10 +142,16 @@ public:
         adios2::Variable<double> varScalar =
             io.DefineVariable<double>("myScalar");
 
+        if (lockDefinitions)
+        {
+            io.LockDefinitions();
+        }
+
         adios2::Engine writer = io.Open(streamName, adios2::Mode::Write, comm);
 
         for (size_t step = 0; step < steps; ++step)
         {
+            std::vector<float> &myArray = myArrays[step % 2];
             size_t idx = 0;
             for (size_t x = 0; x < ndx; ++x)
             {
@@ -154,7 +163,9 @@ public:
             }
             writer.BeginStep(adios2::StepMode::Append);
             writer.Put<float>(varArray, myArray.data());
-            if (wrank == 0)
+            // single values are only sent with the metadata of the first
+            // step if the definitions are locked
+            if (wrank == 0 && (!lockDefinitions || step == 0))
                 writer.Put<double>(varScalar, 1.5 * (step + 1));
             writer.EndStep();
             std::this_thread::sleep_for(std::chrono::milliseconds(sleeptime));
@@ -203,7 +214,8 @@ public:
     }
 
     void MainReaders(MPI_Comm comm, size_t npx, size_t npy,
-                     unsigned int sleeptime, float reader_timeout)
+                     unsigned int sleeptime, float reader_timeout,
+                     bool lockDefinitions)
     {
         int rank, nproc;
         MPI_Comm_rank(comm, &rank);
@@ -242,8 +254,10 @@ public:
                 throw std::ios_base::failure("Missing 'myArray' variable.");
             }
 
+            // engines that only expose the variables of the current step,
+            // like SST, don't have it in later steps with locked definitions
             vMyScalar = io.InquireVariable<double>("myScalar");
-            if (!vMyScalar)
+            if (!vMyScalar && (!lockDefinitions || step == 0))
             {
                 throw std::ios_base::failure("Missing 'myScalar' variable.");
             }
@@ -274,13 +288,24 @@ public:
             size_t elementsSize = count[0] * count[1];
             myArray.resize(elementsSize);
 
+            if (lockDefinitions && step == 0)
+            {
+                io.LockDefinitions();
+            }
+
             reader.Get(vMyArray, myArray.data());
-            reader.Get(vMyScalar, myIncomingScalar);
+            if (!lockDefinitions || step == 0)
+            {
+                reader.Get(vMyScalar, myIncomingScalar);
+            }
             reader.EndStep();
-            float expectedScalarValue = 1.5 * (step + 1);
-            EXPECT_EQ(myIncomingScalar, expectedScalarValue)
-                << "Error in read, did not receive the expected value:"
-                << " rank " << rank << ", step " << step;
+            if (!lockDefinitions || step == 0)
+            {
+                float expectedScalarValue = 1.5 * (step + 1);
+                EXPECT_EQ(myIncomingScalar, expectedScalarValue)
+                    << "Error in read, did not receive the expected value:"
+                    << " rank " << rank << ", step " << step;
+            }
             CheckData(myArray, gndx, gndy, offsx, offsy, ndx, ndy, step, rank);
             std::this_thread::sleep_for(std::chrono::milliseconds(sleeptime));
             ++step;
@@ -289,7 +314,8 @@ public:
     }
 
     void TestCommon(RunParams p, int steps, unsigned int writer_sleeptime,
-                    unsigned int reader_sleeptime, float reader_timeout)
+                    unsigned int reader_sleeptime, float reader_timeout,
+                    bool lockDefinitions = false)
     {
         std::cout << "test " << p.npx_w << "x" << p.npy_w << " writers "
                   << p.npx_r << "x" << p.npy_r << " readers " << std::endl;
@@ -330,14 +356,15 @@ public:
         {
             std::cout << "Process wrank " << wrank << " rank " << rank
                       << " calls MainWriters " << std::endl;
-            MainWriters(comm, p.npx_w, p.npy_w, steps, writer_sleeptime);
+            MainWriters(comm, p.npx_w, p.npy_w, steps, writer_sleeptime,
+                        lockDefinitions);
         }
         else if (color == 1)
         {
             std::cout << "Process wrank " << wrank << " rank " << rank
                       << " calls MainReaders " << std::endl;
             MainReaders(comm, p.npx_r, p.npy_r, reader_sleeptime,
-                        reader_timeout);
+                        reader_timeout, lockDefinitions);
         }
         std::cout << "Process wrank " << wrank << " rank " << rank
                   << " enters MPI barrier..." << std::endl;
@@ -379,6 +406,13 @@ TEST_P(TestStagingMPMD, SlowReader)
     TestCommon(p, 4, 0, 100, -1.0);
 }
 
+TEST_P(TestStagingMPMD, FixedSchedule)
+{
+    RunParams p = GetParam();
+    // both sides lock their definitions, the schedule is reused every step
+    TestCommon(p, 10, 0, 0, -1.0, true);
+}
+
 INSTANTIATE_TEST_CASE_P(NxM, TestStagingMPMD,
                         ::testing::ValuesIn(CreateRunParams()));
 
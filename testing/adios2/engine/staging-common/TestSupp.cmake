@@ -123,6 +123,9 @@ set (LatestReader_PROPERTIES "RUN_SERIAL;1")
 # A faster writer and a queue policy that will cause timesteps to be discarded
 set (DiscardWriter_CMD "run_test.py --test_protocol one_client -nw 1 -nr 1 --warg=--engine_params --warg=QueueLimit:1,QueueFullPolicy:discard,ENGINE_PARAMS --warg=--ms_delay --warg=250 --rarg=--discard")
 
+# The same slow reader with the adaptive policy, which may discard at most two steps in a row
+set (AdaptiveWriter_CMD "run_test.py --test_protocol one_client -nw 1 -nr 1 --warg=--engine_params --warg=QueueLimit:1,QueueFullPolicy:adaptive,GuaranteedStepInterval:3,ENGINE_PARAMS --warg=--ms_delay --warg=250 --rarg=--discard --rarg=--max_skip --rarg=2")
+
 function(remove_engine_params_placeholder dst_str src_str )
     string(REGEX REPLACE "([^ 		  ]*),ENGINE_PARAMS" "\\1" src_str "${src_str}")
     if ("${src_str}" MATCHES "ENGINE_PARAMS")
@@ -0,0 +1,142 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+
+#include <algorithm> //std::minmax_element
+#include <complex>
+#include <numeric> //std::iota
+#include <vector>
+
+#include <adios2.h>
+#include <adios2/ADIOSTypes.h>
+#include <adios2/helper/adiosMath.h>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+template <class T>
+std::vector<T> GenerateValues(const size_t size)
+{
+    std::vector<T> values(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        // non-monotonic with extremes away from the ends
+        values[i] = static_cast<T>((i * 37 + 11) % 101);
+    }
+    return values;
+}
+
+template <class T>
+void CheckMinMax(const size_t size)
+{
+    const std::vector<T> values = GenerateValues<T>(size);
+    const auto bounds = std::minmax_element(values.begin(), values.end());
+
+    T min, max;
+    adios2::helper::GetMinMax(values.data(), values.size(), min, max);
+    EXPECT_EQ(min, *bounds.first) << "size " << size;
+    EXPECT_EQ(max, *bounds.second) << "size " << size;
+
+    adios2::helper::GetMinMaxThreads(values.data(), values.size(), min, max,
+                                     4);
+    EXPECT_EQ(min, *bounds.first) << "size " << size;
+    EXPECT_EQ(max, *bounds.second) << "size " << size;
+}
+
+} // end anonymous namespace
+
+TEST(ADIOS2HelperMath, ADIOS2HelperMathMinMax)
+{
+    for (const size_t size : {1, 2, 15, 16, 17, 63, 64, 65, 1000, 300001})
+    {
+        CheckMinMax<int8_t>(size);
+        CheckMinMax<uint16_t>(size);
+        CheckMinMax<int32_t>(size);
+        CheckMinMax<uint64_t>(size);
+        CheckMinMax<float>(size);
+        CheckMinMax<double>(size);
+        CheckMinMax<long double>(size);
+    }
+}
+
+TEST(ADIOS2HelperMath, ADIOS2HelperMathMinMaxComplex)
+{
+    const size_t size = 1003;
+    std::vector<std::complex<double>> values(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        const double x = static_cast<double>((i * 37 + 11) % 101);
+        values[i] = std::complex<double>(x, -x);
+    }
+    // same modulus as the minimum and maximum, later occurrences don't count
+    values[500] = std::complex<double>(0., 0.);
+    values[700] = std::complex<double>(100., 100.);
+
+    std::complex<double> min, max;
+    adios2::helper::GetMinMax(values.data(), size, min, max);
+    EXPECT_EQ(min, values[27]);
+    EXPECT_EQ(max, values[57]);
+
+    std::vector<std::complex<float>> valuesFloat(values.begin(), values.end());
+    std::complex<float> minFloat, maxFloat;
+    adios2::helper::GetMinMax(valuesFloat.data(), size, minFloat, maxFloat);
+    EXPECT_EQ(minFloat, valuesFloat[27]);
+    EXPECT_EQ(maxFloat, valuesFloat[57]);
+}
+
+TEST(ADIOS2HelperMath, ADIOS2HelperMathMinMaxSelection)
+{
+    const adios2::Dims shape{7, 9, 11};
+    std::vector<int32_t> values(adios2::helper::GetTotalSize(shape));
+    std::iota(values.begin(), values.end(), 0);
+
+    auto lf_Check = [&](const adios2::Dims &start, const adios2::Dims &count,
+                        const bool isRowMajor) {
+        // reference from every element in the box
+        const adios2::Dims zero(shape.size(), 0);
+        int32_t expectedMin = values.back();
+        int32_t expectedMax = values.front();
+        for (size_t i = start[0]; i < start[0] + count[0]; ++i)
+        {
+            for (size_t j = start[1]; j < start[1] + count[1]; ++j)
+            {
+                for (size_t k = start[2]; k < start[2] + count[2]; ++k)
+                {
+                    const size_t index = adios2::helper::LinearIndex(
+                        zero, shape, {i, j, k}, isRowMajor);
+                    expectedMin = std::min(expectedMin, values[index]);
+                    expectedMax = std::max(expectedMax, values[index]);
+                }
+            }
+        }
+
+        int32_t min, max;
+        adios2::helper::GetMinMaxSelection(values.data(), shape, start, count,
+                                           isRowMajor, min, max);
+        EXPECT_EQ(min, expectedMin);
+        EXPECT_EQ(max, expectedMax);
+    };
+
+    for (const bool isRowMajor : {true, false})
+    {
+        lf_Check({0, 0, 0}, shape, isRowMajor);
+        lf_Check({1, 2, 3}, {4, 5, 6}, isRowMajor);
+        lf_Check({2, 3, 4}, {3, 4, 1}, isRowMajor);
+        lf_Check({2, 3, 4}, {3, 1, 1}, isRowMajor);
+        lf_Check({6, 8, 10}, {1, 1, 1}, isRowMajor);
+    }
+}
+
+int main(int argc, char **argv)
+{
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+    result = RUN_ALL_TESTS();
+
+    return result;
+}
@@ -11,6 +11,7 @@
 #include <adios2.h>
 #include <adios2/ADIOSTypes.h>
 #include <adios2/helper/adiosString.h>
+#include <adios2/helper/adiosType.h>
 
 #include <gtest/gtest.h>
 
@@ -127,6 +128,21 @@ TEST(ADIOS2HelperString, ADIOS2HelperGlobalName)
     ASSERT_EQ(adios2::helper::GlobalName(localName, prefix, separator), global);
 }
 
+TEST(ADIOS2HelperString, ADIOS2HelperDataTypeFromString)
+{
+#define declare_type(T)                                                        \
+    ASSERT_EQ(adios2::helper::GetDataTypeFromString(                           \
+                  adios2::helper::GetType<T>()),                               \
+              adios2::helper::GetDataType<T>());
+    ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
+#undef declare_type
+
+    ASSERT_EQ(adios2::helper::GetDataTypeFromString("compound"),
+              adios2::DataType::Compound);
+    ASSERT_EQ(adios2::helper::GetDataTypeFromString("nosuchtype"),
+              adios2::DataType::None);
+}
+
 int main(int argc, char **argv)
 {
 
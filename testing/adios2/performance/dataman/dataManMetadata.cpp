@@ -0,0 +1,107 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * dataManMetadata.cpp : encode and decode rates of the DataMan metadata
+ * serializations for many small variables per step
+ *
+ * Usage: PerfDataManMetadata [variables per step] [steps]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+#include "adios2/toolkit/format/dataman/DataManSerializer.h"
+#include "adios2/toolkit/format/dataman/DataManSerializer.tcc"
+
+using Clock = std::chrono::steady_clock;
+
+double Microseconds(const Clock::duration &duration)
+{
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+int main(int argc, char *argv[])
+{
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Init(&argc, &argv);
+#endif
+
+    const size_t nVariables = (argc > 1) ? std::stoul(argv[1]) : 1000;
+    const size_t nSteps = (argc > 2) ? std::stoul(argv[2]) : 20;
+    const adios2::Dims count{16};
+
+    std::vector<std::string> names(nVariables);
+    for (size_t v = 0; v < nVariables; ++v)
+    {
+        names[v] = "sensor_" + std::to_string(v);
+    }
+    std::vector<double> data(count[0], 1.5);
+
+    std::cout << nVariables << " variables of " << count[0]
+              << " doubles, " << nSteps << " steps\n";
+    std::cout << std::setw(10) << "method" << std::setw(16) << "metadata B"
+              << std::setw(16) << "encode us/var" << std::setw(16)
+              << "decode us/var\n";
+
+    for (const std::string method :
+         {"string", "msgpack", "cbor", "ubjson", "binary"})
+    {
+        adios2::format::DataManSerializer writer(true, true, true,
+                                                 MPI_COMM_WORLD, method);
+        adios2::format::DataManSerializer reader(true, true, true,
+                                                 MPI_COMM_WORLD, method);
+
+        Clock::duration encode(0);
+        Clock::duration decode(0);
+        size_t metadataSize = 0;
+
+        for (size_t step = 0; step < nSteps; ++step)
+        {
+            writer.New(nVariables * count[0] * sizeof(double) * 2);
+
+            const auto encodeStart = Clock::now();
+            for (size_t v = 0; v < nVariables; ++v)
+            {
+                writer.PutVar(data.data(), names[v], {nVariables * count[0]},
+                              {v * count[0]}, count, {}, {}, "", step, 0,
+                              "", adios2::Params());
+            }
+            const adios2::format::VecPtr pack = writer.GetLocalPack();
+            encode += Clock::now() - encodeStart;
+            metadataSize =
+                pack->size() - reinterpret_cast<uint64_t *>(pack->data())[0];
+
+            const auto decodeStart = Clock::now();
+            reader.PutPack(pack);
+            decode += Clock::now() - decodeStart;
+
+            const adios2::format::DmvVecPtr vars = reader.GetMetaData(step);
+            if (vars == nullptr || vars->size() != nVariables ||
+                vars->back().start[0] != (nVariables - 1) * count[0])
+            {
+                std::cerr << method << " decoded wrong metadata\n";
+                return EXIT_FAILURE;
+            }
+            reader.Erase(step);
+        }
+
+        const double variables = static_cast<double>(nVariables * nSteps);
+        std::cout << std::setw(10) << method << std::setw(16) << metadataSize
+                  << std::setw(16) << std::fixed << std::setprecision(3)
+                  << Microseconds(encode) / variables << std::setw(15)
+                  << Microseconds(decode) / variables << "\n";
+    }
+
+#ifdef ADIOS2_HAVE_MPI
+    MPI_Finalize();
+#endif
+
+    return EXIT_SUCCESS;
+}